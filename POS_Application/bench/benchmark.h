@@ -0,0 +1,138 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "imagestore.h"
+#include "money.h"
+#include "product.h"
+#include "supply.h"
+
+/**
+ * @class Benchmark
+ * @brief Non-instantiable class with the helpers shared by the benchmarks.
+ *
+ * The benchmarks write their backups next to the executable, as the
+ * application does, and print their results as a table.
+ */
+class Benchmark {
+  // Delete the constructors to prevent instantiation.
+  Benchmark() = delete;
+  ~Benchmark() = delete;
+
+public:
+  /// Categories of the generated catalogs.
+  static const size_t CATEGORY_COUNT = 20;
+  /// Ingredients of each product of the generated catalogs.
+  static const size_t INGREDIENT_COUNT = 3;
+
+  /**
+   * @brief Lets the benchmarks create the application without a display.
+   */
+  static void prepare() {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  /**
+   * @brief Measures how long a function takes.
+   *
+   * @param function Function to measure.
+   * @return Elapsed time in microseconds.
+   */
+  template <typename Function>
+  static double elapsedMicroseconds(Function&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+  }
+
+  /**
+   * @brief Gets the best of several runs of a function.
+   *
+   * @param runs Number of runs.
+   * @param function Function to measure.
+   * @return Shortest elapsed time in microseconds.
+   */
+  template <typename Function>
+  static double bestMicroseconds(const size_t runs, Function&& function) {
+    double best = elapsedMicroseconds(function);
+    for (size_t run = 1; run < runs; ++run) {
+      best = std::min(best, elapsedMicroseconds(function));
+    }
+    return best;
+  }
+
+  /**
+   * @brief Gets a percentile of the measured times.
+   *
+   * @param samples Measured times.
+   * @param fraction Fraction of the samples below the percentile, 0.5 for the
+   *     median.
+   * @return The time of the percentile, 0 without samples.
+   */
+  static double percentile(std::vector<double> samples
+      , const double fraction) {
+    if (samples.empty()) {
+      return 0;
+    }
+    const size_t position = std::min(samples.size() - 1
+        , static_cast<size_t>(fraction * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + position
+        , samples.end());
+    return samples[position];
+  }
+
+  /**
+   * @brief Gets the name of a generated product.
+   *
+   * @param index Number of the product, from 0.
+   * @return Name of the product.
+   */
+  static std::string productName(const size_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "Producto %06zu", index);
+    return name;
+  }
+
+  /**
+   * @brief Generates a catalog with the products split in categories.
+   *
+   * The products get the IDs from 1, three ingredients and a price. The image
+   * of each one is taken from the given function, if any.
+   *
+   * @param productCount Number of products.
+   * @param imageOf Gets the image of a product by its index, or nullptr.
+   * @return Map of the categories to their products.
+   */
+  static std::map<std::string, std::vector<Product>> makeCatalog(
+      const size_t productCount
+      , ImageStore::ImageID (*imageOf)(size_t) = nullptr) {
+    std::map<std::string, std::vector<Product>> catalog;
+    for (size_t index = 0; index < productCount; ++index) {
+      char category[32];
+      std::snprintf(category, sizeof(category), "Categoria %02zu"
+          , index % CATEGORY_COUNT);
+      std::vector<Supply> ingredients;
+      for (size_t ingredient = 0; ingredient < INGREDIENT_COUNT
+          ; ++ingredient) {
+        ingredients.emplace_back("Insumo "
+            + std::to_string((index + ingredient) % 500), 1 + ingredient);
+      }
+      catalog[category].emplace_back(index + 1, productName(index)
+          , std::move(ingredients), Money::fromCents(100 + index % 5000)
+          , imageOf == nullptr ? ImageStore::NO_IMAGE : imageOf(index));
+    }
+    return catalog;
+  }
+};
+
+#endif // BENCHMARK_H
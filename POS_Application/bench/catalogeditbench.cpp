@@ -0,0 +1,120 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the latency of a product edit against the size of the catalog.
+//
+// Each edit gives the product a new image, as the product form does, so the
+// edit appends its change to the model log and the worker encodes and writes
+// the PNG file of the image. The snapshot of the whole catalog is only
+// written by the checkpoints, every POS_Model::CHECKPOINT_INTERVAL changes.
+#include <QApplication>
+#include <QColor>
+#include <QImage>
+#include <QPixmap>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "backupmodule.h"
+#include "benchmark.h"
+#include "modelcommand.h"
+#include "modelsnapshot.h"
+
+/// Edits measured for each size of the catalog, less than a checkpoint.
+static const size_t EDIT_COUNT = 200;
+/// Side of the edited images, the size of the image of the product form.
+static const int IMAGE_SIDE = 200;
+
+/**
+ * @brief Gives each product its own small image.
+ *
+ * @param index Number of the product.
+ * @return ID of the image in the ImageStore.
+ */
+static ImageStore::ImageID productImage(const size_t index) {
+  QImage image(32, 32, QImage::Format_ARGB32);
+  image.fill(QColor::fromRgb(static_cast<QRgb>(0xFF000000u | index)));
+  return ImageStore::getInstance().addPixmap(QPixmap::fromImage(image));
+}
+
+/**
+ * @brief Makes the new image of an edit.
+ *
+ * The pixels are a gradient with some noise, so the PNG encoder has to
+ * compress it as it would compress a photo.
+ *
+ * @param edit Number of the edit.
+ * @return ID of the image in the ImageStore.
+ */
+static ImageStore::ImageID editedImage(const size_t edit) {
+  QImage image(IMAGE_SIDE, IMAGE_SIDE, QImage::Format_ARGB32);
+  uint32_t noise = static_cast<uint32_t>(edit) * 2654435761u + 1;
+  for (int y = 0; y < IMAGE_SIDE; ++y) {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+    for (int x = 0; x < IMAGE_SIDE; ++x) {
+      noise = noise * 1664525u + 1013904223u;
+      const uint32_t grain = noise >> 28;
+      const uint32_t red = (static_cast<uint32_t>(x + edit) + grain) & 0xFF;
+      const uint32_t green = (static_cast<uint32_t>(y) + grain) & 0xFF;
+      const uint32_t blue = (static_cast<uint32_t>(x + y) + grain) & 0xFF;
+      line[x] = 0xFF000000u | red << 16 | green << 8 | blue;
+    }
+  }
+  return ImageStore::getInstance().addPixmap(QPixmap::fromImage(image));
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  BackupModule& backupModule = BackupModule::getInstance();
+
+  std::printf("Edicion de la imagen de un producto, %zu ediciones por"
+      " catalogo\n", EDIT_COUNT);
+  std::printf("%10s %16s %16s %14s %18s\n", "productos", "llamada (us)"
+      , "en disco (us)", "p99 (us)", "checkpoint (ms)");
+  for (const size_t productCount : {100, 1000, 10000}) {
+    std::map<std::string, std::vector<Product>> catalog
+        = Benchmark::makeCatalog(productCount, productImage);
+    // Writes the whole catalog once, as the checkpoints do.
+    std::shared_ptr<ModelSnapshot> snapshot
+        = std::make_shared<ModelSnapshot>();
+    snapshot->categories
+        = std::make_shared<const ModelSnapshot::Categories>(catalog);
+    const double checkpoint = Benchmark::elapsedMicroseconds([&] {
+      backupModule.checkpointModelBackups(snapshot, productCount + 1);
+      backupModule.flushBackups();
+    });
+
+    std::vector<double> calls;
+    std::vector<double> edits;
+    calls.reserve(EDIT_COUNT);
+    edits.reserve(EDIT_COUNT);
+    for (size_t edit = 0; edit < EDIT_COUNT; ++edit) {
+      // Replaces the product with a new image and price, as the product
+      // form does.
+      auto category = catalog.begin();
+      std::advance(category, edit % catalog.size());
+      Product& product = category->second[edit % category->second.size()];
+      ModelCommand command{ModelCommand::EDIT_PRODUCT, category->first};
+      command.products.push_back(product);
+      product = Product(product.getID(), product.getName()
+          , product.getIngredients()
+          , product.getPrice() + Money::fromCents(5)
+          , editedImage(productCount + edit));
+      command.products.push_back(product);
+      // Measures the call in the calling thread, then waits until the
+      // change and the image are on the disk.
+      edits.push_back(Benchmark::elapsedMicroseconds([&] {
+        calls.push_back(Benchmark::elapsedMicroseconds([&] {
+          backupModule.appendModelCommand(command);
+        }));
+        backupModule.flushBackups();
+      }));
+    }
+    std::printf("%10zu %16.1f %16.1f %14.1f %18.2f\n", productCount
+        , Benchmark::percentile(calls, 0.5)
+        , Benchmark::percentile(edits, 0.5)
+        , Benchmark::percentile(edits, 0.99), checkpoint / 1000.0);
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the paging of catalogs of 100k items.
+//
+// Every page of the products, the categories and the supplies is read
+// through the views of the model, and for comparison as the previous
+// versions did: the products and the supplies of a page were copied, and a
+// page of categories walked the register from its first category.
+#include <QApplication>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "pageview.h"
+#include "productview.h"
+#include "supply.h"
+
+/// Items of each catalog.
+static const size_t ITEM_COUNT = 100000;
+/// Items shown by a page, as the catalogs of the interface do.
+static const size_t ITEMS_PER_PAGE = 9;
+
+/**
+ * @brief Reads every page of a catalog and prints what a page takes.
+ *
+ * @param name Name of the way the pages are read.
+ * @param pageOf Reads a page by its index, returns its number of items.
+ */
+template <typename PageOf>
+static void measurePages(const char* name, PageOf&& pageOf) {
+  const size_t pageCount = (ITEM_COUNT + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE;
+  std::vector<double> samples;
+  samples.reserve(pageCount);
+  size_t items = 0;
+  for (size_t page = 0; page < pageCount; ++page) {
+    samples.push_back(Benchmark::elapsedMicroseconds([&] {
+      items += pageOf(page);
+    }));
+  }
+  double total = 0;
+  for (const double sample : samples) {
+    total += sample;
+  }
+  std::printf("%28s %12.2f %12.2f %12.2f %10s\n", name
+      , Benchmark::percentile(samples, 0.5)
+      , Benchmark::percentile(samples, 0.99), total / 1000.0
+      , items == ITEM_COUNT ? "si" : "no");
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+
+  // Products in the categories register, and the flat copy of the previous
+  // versions.
+  const ProductView::Categories categories
+      = Benchmark::makeCatalog(ITEM_COUNT);
+  ProductView productView;
+  const double rebuild = Benchmark::elapsedMicroseconds([&] {
+    productView.rebuild(categories);
+  });
+  std::vector<std::pair<std::string, Product>> flatProducts;
+  for (const auto& category : categories) {
+    for (const Product& product : category.second) {
+      flatProducts.emplace_back(category.first, product);
+    }
+  }
+  // A register with a category per item, for the pages of categories.
+  ProductView::Categories manyCategories;
+  for (size_t index = 0; index < ITEM_COUNT; ++index) {
+    manyCategories[Benchmark::productName(index)];
+  }
+  ProductView categoryView;
+  categoryView.rebuild(manyCategories);
+  std::vector<Supply> supplies;
+  for (size_t index = 0; index < ITEM_COUNT; ++index) {
+    supplies.emplace_back("Insumo " + std::to_string(index), index, "kg");
+  }
+
+  std::printf("Paginacion de %zu elementos, %zu por pagina\n", ITEM_COUNT
+      , ITEMS_PER_PAGE);
+  std::printf("Vista de productos construida en %.2f ms\n"
+      , rebuild / 1000.0);
+  std::printf("%28s %12s %12s %12s %10s\n", "paginas", "mediana (us)"
+      , "p99 (us)", "total (ms)", "completas");
+  measurePages("productos, vista", [&](const size_t page) {
+    return productView.page(page, ITEMS_PER_PAGE).size();
+  });
+  measurePages("productos, copia previa", [&](const size_t page) {
+    const size_t start = page * ITEMS_PER_PAGE;
+    const size_t end = std::min(start + ITEMS_PER_PAGE, flatProducts.size());
+    std::vector<std::pair<std::string, Product>> pageProducts;
+    for (size_t index = start; index < end; ++index) {
+      pageProducts.push_back(flatProducts[index]);
+    }
+    return pageProducts.size();
+  });
+  measurePages("categorias, vista", [&](const size_t page) {
+    return categoryView.categoryPage(page, ITEMS_PER_PAGE).size();
+  });
+  measurePages("categorias, recorrido previo", [&](const size_t page) {
+    const size_t start = page * ITEMS_PER_PAGE;
+    const size_t end = std::min(start + ITEMS_PER_PAGE
+        , manyCategories.size());
+    std::vector<std::string> pageCategories;
+    size_t position = 0;
+    for (const auto& category : manyCategories) {
+      if (position >= start && position < end) {
+        pageCategories.push_back(category.first);
+      }
+      if (++position >= end) {
+        break;
+      }
+    }
+    return pageCategories.size();
+  });
+  measurePages("insumos, vista", [&](const size_t page) {
+    return PageView<Supply>(supplies, page, ITEMS_PER_PAGE).size();
+  });
+  measurePages("insumos, copia previa", [&](const size_t page) {
+    const PageView<Supply> view(supplies, page, ITEMS_PER_PAGE);
+    const std::vector<Supply> pageSupplies(view.begin(), view.end());
+    return pageSupplies.size();
+  });
+  return 0;
+}
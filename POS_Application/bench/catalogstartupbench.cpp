@@ -0,0 +1,67 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures how long the start takes to load the products catalog.
+//
+// The catalog is loaded from its binary snapshot, and for comparison from
+// the same products in the text catalog, with the current reader and with the
+// reader of the previous versions.
+//
+// Both current readers build the same products, and building them takes most
+// of the time, so the snapshot and the text catalog load in about the same
+// time. The snapshot is kept because its checksum detects a damaged catalog.
+#include <QApplication>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "backupmodule.h"
+#include "benchmark.h"
+#include "legacyproductsparser.h"
+
+/// Runs of each load, the best one is reported.
+static const size_t RUN_COUNT = 5;
+/// Text catalog written for the comparison.
+static const char* const TEXT_CATALOG_FILE = "catalogstartupbench.txt";
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  BackupModule& backupModule = BackupModule::getInstance();
+
+  std::printf("Carga del catalogo al iniciar, mejor de %zu corridas\n"
+      , RUN_COUNT);
+  std::printf("%10s %14s %14s %18s %14s\n", "productos", "snapshot (ms)"
+      , "texto (ms)", "texto previo (ms)", "mejora previo");
+  for (const size_t productCount : {1000, 10000}) {
+    const std::map<std::string, std::vector<Product>> catalog
+        = Benchmark::makeCatalog(productCount);
+    backupModule.updateProductsBackup(catalog, productCount + 1);
+    backupModule.flushBackups();
+    BackupModule::exportProductsText(catalog, TEXT_CATALOG_FILE);
+
+    // Keeps the loaded catalogs, so their destruction is not measured.
+    std::vector<std::map<std::string, std::vector<Product>>> loaded;
+    const double snapshot = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+      uint64_t nextProductID = 0;
+      loaded.push_back(backupModule.getProductsBackup(nextProductID));
+    });
+    const double text = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+      loaded.push_back(backupModule.importProductsText(TEXT_CATALOG_FILE));
+    });
+    const double legacy = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+      loaded.emplace_back();
+      LegacyProductsParser::readProducts(TEXT_CATALOG_FILE, "."
+          , loaded.back());
+    });
+    for (const auto& products : loaded) {
+      if (products.size() != catalog.size()) {
+        std::printf("El catalogo cargado no coincide.\n");
+        return 1;
+      }
+    }
+    std::printf("%10zu %14.2f %14.2f %18.2f %13.1fx\n", productCount
+        , snapshot / 1000.0, text / 1000.0, legacy / 1000.0
+        , legacy / snapshot);
+  }
+  return 0;
+}
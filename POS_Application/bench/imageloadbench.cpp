@@ -0,0 +1,112 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures whether loading the catalog at login depends on the size of the
+// product images.
+//
+// The same catalog is saved with bigger images each time, then loaded as the
+// login does. The images are only decoded when they are painted, so the load
+// and the decoded bytes kept in memory after it must not grow with the bytes
+// of the image files. The first page of the catalog is painted afterwards,
+// that is what decodes its images.
+#include <QApplication>
+#include <QImage>
+#include <QPixmap>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "backupmodule.h"
+#include "benchmark.h"
+#include "imagestore.h"
+
+/// Products of the catalog, all of them with an image.
+static const size_t PRODUCT_COUNT = 300;
+/// Products shown by a page of the catalog.
+static const size_t PAGE_SIZE = 20;
+/// Runs of the load, the best one is reported.
+static const size_t RUN_COUNT = 3;
+/// Side of the images of the current catalog.
+static int imageSide = 0;
+
+/**
+ * @brief Gives each product its own image of the current side.
+ *
+ * The pixels are a gradient with some noise, so the PNG files are about as
+ * big as the ones of photos.
+ *
+ * @param index Number of the product.
+ * @return ID of the image in the ImageStore.
+ */
+static ImageStore::ImageID productImage(const size_t index) {
+  QImage image(imageSide, imageSide, QImage::Format_ARGB32);
+  uint32_t noise = static_cast<uint32_t>(index) * 2654435761u + 1;
+  for (int y = 0; y < imageSide; ++y) {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+    for (int x = 0; x < imageSide; ++x) {
+      noise = noise * 1664525u + 1013904223u;
+      const uint32_t grain = noise >> 28;
+      const uint32_t red = (static_cast<uint32_t>(x + index) + grain) & 0xFF;
+      const uint32_t green = (static_cast<uint32_t>(y) + grain) & 0xFF;
+      const uint32_t blue = (static_cast<uint32_t>(x + y) + grain) & 0xFF;
+      line[x] = 0xFF000000u | red << 16 | green << 8 | blue;
+    }
+  }
+  return ImageStore::getInstance().addPixmap(QPixmap::fromImage(image));
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  BackupModule& backupModule = BackupModule::getInstance();
+  ImageStore& imageStore = ImageStore::getInstance();
+
+  std::printf("Carga de %zu productos con imagen, mejor de %zu corridas\n"
+      , PRODUCT_COUNT, RUN_COUNT);
+  std::printf("%8s %14s %12s %16s %14s %16s\n", "lado", "archivos (MB)"
+      , "carga (ms)", "en memoria (KB)", "pagina (ms)", "pagina (KB)");
+  for (const int side : {32, 128, 512}) {
+    imageSide = side;
+    {
+      const std::map<std::string, std::vector<Product>> catalog
+          = Benchmark::makeCatalog(PRODUCT_COUNT, productImage);
+      backupModule.updateProductsBackup(catalog, PRODUCT_COUNT + 1);
+      backupModule.flushBackups();
+    }
+    // Drops the images decoded by the previous catalog.
+    imageStore.setCapacity(0);
+    imageStore.setCapacity(ImageStore::DEFAULT_CAPACITY);
+
+    std::map<std::string, std::vector<Product>> loaded;
+    const double load = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+      uint64_t nextProductID = 0;
+      loaded = backupModule.getProductsBackup(nextProductID);
+    });
+    const size_t loadedBytes = imageStore.getMetrics().cachedBytes;
+
+    // Adds up the image files of the loaded catalog.
+    std::vector<ImageStore::ImageID> images;
+    uintmax_t fileBytes = 0;
+    for (const auto& category : loaded) {
+      for (const Product& product : category.second) {
+        images.push_back(product.getImage());
+        std::error_code error;
+        const uintmax_t size = std::filesystem::file_size(
+            imageStore.getPath(product.getImage()), error);
+        fileBytes += error ? 0 : size;
+      }
+    }
+    // Paints the first page, that decodes its images.
+    const double page = Benchmark::elapsedMicroseconds([&] {
+      for (size_t index = 0; index < PAGE_SIZE && index < images.size()
+          ; ++index) {
+        imageStore.getPixmap(images[index]);
+      }
+    });
+    std::printf("%8d %14.2f %12.2f %16.1f %14.2f %16.1f\n", side
+        , fileBytes / (1024.0 * 1024.0), load / 1000.0, loadedBytes / 1024.0
+        , page / 1000.0, imageStore.getMetrics().cachedBytes / 1024.0);
+  }
+  return 0;
+}
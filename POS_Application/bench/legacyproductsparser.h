@@ -0,0 +1,124 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef LEGACYPRODUCTSPARSER_H
+#define LEGACYPRODUCTSPARSER_H
+
+#include <QPixmap>
+#include <QString>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "imagestore.h"
+#include "money.h"
+#include "product.h"
+#include "supply.h"
+
+/**
+ * @class LegacyProductsParser
+ * @brief Non-instantiable class with the Products.txt reader of the previous
+ * versions, kept as the reference of the benchmarks.
+ *
+ * The reader is the former BackupModule::readProductsBackup, it reads the
+ * file line by line through std::istringstream, trims the names through
+ * QString and tells the image names apart by the exception of std::stod.
+ * Its products take the image as a pixmap, as the former Product did.
+ */
+class LegacyProductsParser {
+  // Delete the constructors to prevent instantiation.
+  LegacyProductsParser() = delete;
+  ~LegacyProductsParser() = delete;
+
+public:
+  /**
+   * @brief Reads a catalog in the text format.
+   *
+   * @param filename Text catalog to read.
+   * @param imageDirectory Directory of the product images.
+   * @param registeredProducts Map of the categories to their products.
+   * @throws std::runtime_error If an ingredient can't be parsed.
+   */
+  static void readProducts(const std::string& filename
+      , const std::string& imageDirectory
+      , std::map<std::string, std::vector<Product>>& registeredProducts) {
+    std::ifstream file(filename);
+    if (!file) {
+      return;
+    }
+    const std::filesystem::path parentPath(imageDirectory);
+
+    // Temporal variable to store a line of characters of the file.
+    std::string line;
+    // Temporal variables to store the category of the product and his name.
+    std::string productCategory;
+    std::string productName;
+    std::string imagePath;
+
+    while (std::getline(file, line)) {
+      // Ignores the empty lines.
+      if (line.empty()) continue;
+
+      // Identify the product categories.
+      if (line.back() == ':') {
+        productCategory = line.substr(0, line.size() - 1);
+        registeredProducts[productCategory] = {};
+      // identify the product's name.
+      } else if (line.back() == '-') {
+        // Parse the product name and trim it to avoid blank spaces.
+        QString name(line.substr(0, line.size() - 1).data());
+        productName = name.trimmed().toStdString();
+      // Reads the product ingredients and price.
+      } else {
+        std::istringstream stream(line);
+        std::string productInfo;
+        std::vector<Supply> productIngredients;
+        uint64_t productPrice = 0;
+
+        // While there's tabs of the actual line/stream
+        while (std::getline(stream, productInfo, '\t')) {
+          // Normalize the tabs in the strings.
+          productInfo.erase(0, productInfo.find_first_not_of(" \t"));
+          productInfo.erase(productInfo.find_last_not_of(" \t") + 1);
+
+          // Finds the ingredient's separator.
+          size_t separatorPos = productInfo.find(';');
+          if (separatorPos != std::string::npos) {
+            QString ingredientName(productInfo.substr(0, separatorPos).data());
+            ingredientName = ingredientName.trimmed();
+            std::string quantityStr = productInfo.substr(separatorPos + 1);
+            try {
+              uint64_t ingredientQuantity = std::stoull(quantityStr);
+              productIngredients.emplace_back(ingredientName.toStdString()
+                  , ingredientQuantity);
+            } catch (const std::exception&) {
+              throw std::runtime_error("Error al analizar: " + productInfo);
+            }
+          } else {
+            // If theres no spacer, then its the product's price.
+            try {
+              productPrice = std::stod(productInfo);
+            } catch (const std::exception& e) {
+              imagePath = productInfo;
+              imagePath.erase(std::remove_if(imagePath.begin()
+                  , imagePath.end(), isspace), imagePath.end());
+              std::filesystem::path fullPath = parentPath / imagePath;
+              imagePath = fullPath.string();
+            }
+          }
+        }
+
+        registeredProducts[productCategory].emplace_back(1, productName
+            , productIngredients, Money::fromDouble(productPrice)
+            , ImageStore::getInstance().addPixmap(
+                QPixmap(imagePath.c_str())));
+      }
+    }
+  }
+};
+
+#endif // LEGACYPRODUCTSPARSER_H
@@ -0,0 +1,126 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures what the sales cost to the calling thread with the persistence
+// worker, and the queue depth and write latency the worker reports.
+//
+// Each sale saves its receipt, the cashier session and the totals of its day,
+// as POS_Model::generateReceipt does. The sales come at the pace of a quick
+// cashier, so the session and the totals of a burst produce a single write.
+// For comparison, the same sales are saved waiting for the disk after each
+// one, as the previous versions did in the GUI thread.
+//
+// The worker keeps its maxima since the program started, so the deepest
+// queue and the longest write of the second run cover the first one too.
+#include <QApplication>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "backupmodule.h"
+#include "benchmark.h"
+#include "cashiersession.h"
+#include "persistenceworker.h"
+#include "receipt.h"
+#include "salesarchive.h"
+#include "salesrollups.h"
+#include "stringpool.h"
+
+/// Sales of each run.
+static const size_t SALE_COUNT = 200;
+/// Time between two sales.
+static const std::chrono::milliseconds SALE_PACE
+    = std::chrono::milliseconds(20);
+/// First second of the sales.
+static const int64_t FIRST_TIME = 1735722000;
+
+/**
+ * @brief Makes the receipt of a sale.
+ *
+ * @param id ID of the receipt.
+ * @return The receipt, with three line items.
+ */
+static Receipt makeReceipt(const uint64_t id) {
+  std::vector<Receipt::LineItem> lines(3);
+  for (size_t line = 0; line < lines.size(); ++line) {
+    const size_t product = (id * 7 + line * 13) % 500;
+    lines[line].productID = product + 1;
+    lines[line].name = StringPool::getInstance().intern(
+        Benchmark::productName(product));
+    lines[line].quantity = 1 + line;
+    lines[line].price = Money::fromCents(500 + product % 100 * 25);
+  }
+  return Receipt("Benchmark", id, FIRST_TIME + static_cast<int64_t>(id) * 30
+      , "ana", std::move(lines), "Efectivo", Money(), Money::fromCents(1000));
+}
+
+/**
+ * @brief Saves a run of sales and prints what they cost.
+ *
+ * @param backupModule The backup module.
+ * @param name Name of the run.
+ * @param firstID ID of the first receipt of the run.
+ * @param waitForDisk Waits until each sale is on the disk, as the previous
+ *     versions did.
+ */
+static void measureSales(BackupModule& backupModule, const char* name
+    , const uint64_t firstID, const bool waitForDisk) {
+  const PersistenceWorker::Metrics before
+      = backupModule.getPersistenceMetrics();
+  CashierSession session;
+  session.open("ana", FIRST_TIME, firstID);
+  SalesRollups::Totals totals;
+  const std::vector<StringPool::StringID> categories(3, StringPool::EMPTY);
+  std::vector<double> calls;
+  calls.reserve(SALE_COUNT);
+  for (uint64_t id = firstID; id < firstID + SALE_COUNT; ++id) {
+    const Receipt receipt = makeReceipt(id);
+    calls.push_back(Benchmark::elapsedMicroseconds([&] {
+      backupModule.appendReceiptBackup(receipt);
+      session.addReceipt(receipt);
+      backupModule.updateCashierSessionBackup(session);
+      SalesRollups::addReceipt(totals, receipt, categories);
+      backupModule.updateSalesRollupBackup(
+          SalesArchive::dayOf(receipt.getTimestamp()), totals);
+      if (waitForDisk) {
+        backupModule.flushBackups();
+      }
+    }));
+    std::this_thread::sleep_for(SALE_PACE);
+  }
+  // Lets the last writes of the burst become due, as they would while the
+  // cashier waits for the next customer.
+  std::this_thread::sleep_for(PersistenceWorker::DEBOUNCE_DELAY * 2);
+  backupModule.flushBackups();
+
+  const PersistenceWorker::Metrics after
+      = backupModule.getPersistenceMetrics();
+  const uint64_t completed = after.completed - before.completed;
+  const double averageLatency = completed == 0 ? 0
+      : static_cast<double>((after.totalLatency - before.totalLatency)
+        .count()) / completed;
+  std::printf("%12s %10.1f %10.1f %10.1f %9llu %9llu %9llu %7zu %10.1f"
+      " %10.1f\n", name, Benchmark::percentile(calls, 0.5)
+      , Benchmark::percentile(calls, 0.99), Benchmark::percentile(calls, 1.0)
+      , static_cast<unsigned long long>(after.enqueued - before.enqueued)
+      , static_cast<unsigned long long>(after.coalesced - before.coalesced)
+      , static_cast<unsigned long long>(completed), after.maxQueueDepth
+      , averageLatency, static_cast<double>(after.maxLatency.count()));
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  BackupModule& backupModule = BackupModule::getInstance();
+  // Continues after the receipts of the previous runs.
+  const uint64_t firstID = backupModule.getLastReceiptID() + 1;
+
+  std::printf("Respaldo de %zu ventas, una cada %lld ms\n", SALE_COUNT
+      , static_cast<long long>(SALE_PACE.count()));
+  std::printf("%12s %10s %10s %10s %9s %9s %9s %7s %10s %10s\n", "escritura"
+      , "med (us)", "p99 (us)", "max (us)", "trabajos", "combin."
+      , "escritos", "cola", "lat. (us)", "lat. max");
+  measureSales(backupModule, "en segundo", firstID, false);
+  measureSales(backupModule, "esperando", firstID + SALE_COUNT, true);
+  return 0;
+}
@@ -0,0 +1,106 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the lookups of the products through the ProductIndex against the
+// walk through the categories that POS_Model::findProduct did before.
+#include <QApplication>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "productindex.h"
+
+/// Products of the catalog.
+static const size_t PRODUCT_COUNT = 20000;
+/// Products looked up by walking the categories, the walk is slow.
+static const size_t SCAN_LOOKUP_COUNT = 2000;
+/// Runs of the rebuild, the best one is reported.
+static const size_t RUN_COUNT = 5;
+
+/**
+ * @brief Finds a product walking the categories, as the model did before.
+ *
+ * @param categories The categories register.
+ * @param matches Tells if a product is the searched one.
+ * @return The product, or nullptr if it isn't registered.
+ */
+template <typename Matches>
+static const Product* scanProducts(
+    const std::map<std::string, std::vector<Product>>& categories
+    , Matches&& matches) {
+  for (const auto& category : categories) {
+    for (const Product& product : category.second) {
+      if (matches(product)) {
+        return &product;
+      }
+    }
+  }
+  return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+
+  const std::map<std::string, std::vector<Product>> catalog
+      = Benchmark::makeCatalog(PRODUCT_COUNT);
+  // Looks up the products in a random order.
+  std::vector<size_t> order(PRODUCT_COUNT);
+  for (size_t index = 0; index < PRODUCT_COUNT; ++index) {
+    order[index] = index;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(PRODUCT_COUNT));
+  std::vector<std::string> names;
+  names.reserve(PRODUCT_COUNT);
+  for (const size_t index : order) {
+    names.push_back(Benchmark::productName(index));
+  }
+
+  ProductIndex index;
+  const double rebuild = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+    index.rebuild(catalog);
+  });
+
+  // Counts the found products, so the lookups are not optimized out.
+  size_t found = 0;
+  const double indexByName = Benchmark::elapsedMicroseconds([&] {
+    for (const std::string& name : names) {
+      found += index.findByName(name) != nullptr;
+    }
+  }) / PRODUCT_COUNT;
+  const double indexByID = Benchmark::elapsedMicroseconds([&] {
+    for (const size_t product : order) {
+      found += index.findByID(product + 1) != nullptr;
+    }
+  }) / PRODUCT_COUNT;
+  const double scanByName = Benchmark::elapsedMicroseconds([&] {
+    for (size_t lookup = 0; lookup < SCAN_LOOKUP_COUNT; ++lookup) {
+      found += scanProducts(catalog, [&](const Product& product) {
+        return product.getName() == names[lookup];
+      }) != nullptr;
+    }
+  }) / SCAN_LOOKUP_COUNT;
+  const double scanByID = Benchmark::elapsedMicroseconds([&] {
+    for (size_t lookup = 0; lookup < SCAN_LOOKUP_COUNT; ++lookup) {
+      found += scanProducts(catalog, [&](const Product& product) {
+        return product.getID() == order[lookup] + 1;
+      }) != nullptr;
+    }
+  }) / SCAN_LOOKUP_COUNT;
+  if (found != 2 * (PRODUCT_COUNT + SCAN_LOOKUP_COUNT)) {
+    std::printf("No se encontraron todos los productos.\n");
+    return 1;
+  }
+
+  std::printf("Busqueda de productos, %zu productos\n", PRODUCT_COUNT);
+  std::printf("Reconstruccion del indice: %.2f ms\n", rebuild / 1000.0);
+  std::printf("%10s %14s %18s %10s\n", "busqueda", "indice (us)"
+      , "recorrido (us)", "mejora");
+  std::printf("%10s %14.3f %18.3f %9.0fx\n", "nombre", indexByName
+      , scanByName, scanByName / indexByName);
+  std::printf("%10s %14.3f %18.3f %9.0fx\n", "ID", indexByID, scanByID
+      , scanByID / indexByID);
+  return 0;
+}
@@ -0,0 +1,175 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the memory of the receipts of a cashier day.
+//
+// The receipts are kept as the compact records of Receipt, and for comparison
+// as the receipts of the previous versions, that held their text fields as
+// QStrings and a copy of the Product of each line. The memory of a receipt is
+// its object and the heap blocks only it owns, without the overhead of the
+// allocator. The interned strings and the pixmaps of the products are shared
+// by all the receipts, so they are not counted.
+#include <QApplication>
+#include <QPixmap>
+#include <QString>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "product.h"
+#include "receipt.h"
+#include "stringpool.h"
+#include "supply.h"
+
+/// Receipts of the cashier day.
+static const size_t RECEIPT_COUNT = 5000;
+/// First second of the day.
+static const int64_t FIRST_TIME = 1735722000;
+/// Products of the catalog.
+static const size_t PRODUCT_COUNT = 500;
+
+/**
+ * @struct LegacyProduct
+ * @brief Product as the previous versions kept it in the receipts.
+ */
+struct LegacyProduct {
+  uint64_t id = 0;                  ///< Identifier of the product.
+  std::string name;                 ///< Name of the product.
+  std::vector<Supply> ingredients;  ///< Ingredients of the product.
+  double price = 0;                 ///< Price of the product.
+  QPixmap image;                    ///< Image, shared with the catalog.
+};
+
+/**
+ * @struct LegacyReceipt
+ * @brief Receipt as the previous versions kept it in memory.
+ */
+struct LegacyReceipt {
+  QString businessName;   ///< Name of the business.
+  size_t id = 0;          ///< Identifier of the receipt.
+  QString dateTime;       ///< Formatted date and time.
+  QString user;           ///< Name of the user.
+  std::vector<std::pair<LegacyProduct, size_t>> products; ///< Lines.
+  QString paymentMethod;  ///< Payment method.
+  double receivedAmount = 0;  ///< Money received.
+  double price = 0;           ///< Total price.
+};
+
+/**
+ * @brief Gets the heap bytes owned by a string.
+ * @param value The string.
+ * @return Bytes of its buffer, 0 if it fits in the object.
+ */
+static size_t heapBytes(const std::string& value) {
+  return value.capacity() > std::string().capacity() ? value.capacity() + 1
+      : 0;
+}
+
+/**
+ * @brief Gets the heap bytes owned by a QString.
+ * @param value The string, not shared with another one.
+ * @return Bytes of its header and buffer.
+ */
+static size_t heapBytes(const QString& value) {
+  return value.isEmpty() ? 0
+      : 16 + (static_cast<size_t>(value.capacity()) + 1) * sizeof(char16_t);
+}
+
+/**
+ * @brief Gets the memory of a receipt of the previous versions.
+ * @param receipt The receipt.
+ * @return Bytes of the receipt.
+ */
+static size_t bytesOf(const LegacyReceipt& receipt) {
+  size_t bytes = sizeof(receipt) + heapBytes(receipt.businessName)
+      + heapBytes(receipt.dateTime) + heapBytes(receipt.user)
+      + heapBytes(receipt.paymentMethod)
+      + receipt.products.capacity() * sizeof(receipt.products[0]);
+  for (const auto& line : receipt.products) {
+    const LegacyProduct& product = line.first;
+    bytes += heapBytes(product.name)
+        + product.ingredients.capacity() * sizeof(Supply);
+    for (const Supply& ingredient : product.ingredients) {
+      bytes += heapBytes(ingredient.getName())
+          + heapBytes(ingredient.getMeasure());
+    }
+  }
+  return bytes;
+}
+
+/**
+ * @brief Gets the memory of a compact receipt.
+ * @param receipt The receipt.
+ * @return Bytes of the receipt.
+ */
+static size_t bytesOf(const Receipt& receipt) {
+  return sizeof(receipt)
+      + receipt.getLines().capacity() * sizeof(Receipt::LineItem);
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  // Gives the products of the catalog their ingredients, as the receipts of
+  // the previous versions copied them.
+  std::vector<Product> catalog;
+  for (const auto& category : Benchmark::makeCatalog(PRODUCT_COUNT)) {
+    catalog.insert(catalog.end(), category.second.begin()
+        , category.second.end());
+  }
+
+  std::mt19937 random(2025);
+  std::vector<Receipt> receipts;
+  std::vector<LegacyReceipt> legacyReceipts;
+  receipts.reserve(RECEIPT_COUNT);
+  legacyReceipts.reserve(RECEIPT_COUNT);
+  size_t bytes = 0;
+  size_t legacyBytes = 0;
+  for (size_t id = 1; id <= RECEIPT_COUNT; ++id) {
+    const size_t lineCount = 1 + random() % 4;
+    std::vector<Receipt::LineItem> lines(lineCount);
+    LegacyReceipt& legacy = legacyReceipts.emplace_back();
+    for (Receipt::LineItem& line : lines) {
+      const Product& product = catalog[random() % catalog.size()];
+      line.productID = product.getID();
+      line.name = StringPool::getInstance().intern(product.getName());
+      line.quantity = 1 + random() % 3;
+      line.price = product.getPrice();
+      legacy.products.emplace_back(LegacyProduct{product.getID()
+          , product.getName(), product.getIngredients()
+          , product.getPrice().toDouble(), QPixmap()}, line.quantity);
+    }
+    const int64_t timestamp = FIRST_TIME + static_cast<int64_t>(id) * 8;
+    receipts.emplace_back("Macana's Place", id, timestamp, "cajero"
+        , std::move(lines), "Efectivo", Money::fromCents(10000)
+        , Money::fromCents(5000));
+    // Each receipt of the previous versions had its own strings, read from
+    // the backup.
+    char dateTime[32];
+    std::snprintf(dateTime, sizeof(dateTime), "2025-01-01 %02lld:%02lld:%02lld"
+        , static_cast<long long>(8 + id * 8 / 3600)
+        , static_cast<long long>(id * 8 / 60 % 60)
+        , static_cast<long long>(id * 8 % 60));
+    legacy.businessName = QString::fromUtf8("Macana's Place");
+    legacy.id = id;
+    legacy.dateTime = QString::fromUtf8(dateTime);
+    legacy.user = QString::fromUtf8("cajero");
+    legacy.paymentMethod = QString::fromUtf8("Efectivo");
+    legacy.receivedAmount = 100;
+    legacy.price = 50;
+    bytes += bytesOf(receipts.back());
+    legacyBytes += bytesOf(legacy);
+  }
+
+  std::printf("Memoria de %zu recibos de un dia de caja\n", RECEIPT_COUNT);
+  std::printf("%12s %14s %14s\n", "recibos", "por recibo (B)"
+      , "total (KB)");
+  std::printf("%12s %14.1f %14.1f\n", "previos"
+      , static_cast<double>(legacyBytes) / RECEIPT_COUNT
+      , legacyBytes / 1024.0);
+  std::printf("%12s %14.1f %14.1f\n", "compactos"
+      , static_cast<double>(bytes) / RECEIPT_COUNT, bytes / 1024.0);
+  std::printf("Reduccion: %.1fx\n", static_cast<double>(legacyBytes) / bytes);
+  return 0;
+}
@@ -0,0 +1,240 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the receipt search over three years of history, against the
+// target of 50 ms per search.
+//
+// The postings are rebuilt and merged as the application does, by running
+// the jobs of the index, and the time the calling thread spends installing a
+// merge is measured too.
+#include <QApplication>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "receipt.h"
+#include "receiptarchive.h"
+#include "receiptjournal.h"
+#include "receiptsearchindex.h"
+#include "stringpool.h"
+
+/// Days of history.
+static const size_t DAY_COUNT = 3 * 365;
+/// Receipts generated each day.
+static const size_t RECEIPTS_PER_DAY = 250;
+/// Products of the catalog sold in the receipts.
+static const size_t PRODUCT_COUNT = 2000;
+/// Searches of each kind, the median and the slowest are reported.
+static const size_t SEARCH_COUNT = 25;
+/// Receipts shown by a search, as the search dialog does.
+static const size_t MAX_RESULTS = 200;
+/// Target of the slowest search.
+static const double TARGET_MILLISECONDS = 50;
+/// First second of the history.
+static const int64_t FIRST_TIME = 1640995200;
+/// Files of the benchmark, written next to the executable.
+static const char* const JOURNAL_FILE = "receiptsearchbench.journal";
+static const char* const INDEX_FILE = "receiptsearchbench.index";
+static const char* const TIME_INDEX_FILE = "receiptsearchbench.timeindex";
+static const char* const SEARCH_FILE = "receiptsearchbench.search";
+static const char* const SEARCH_LOG_FILE = "receiptsearchbench.searchlog";
+
+/// Users of the receipts.
+static const char* const USERS[] = {"ana", "beto", "caro", "dani", "eli"
+    , "fer", "gabi", "hugo"};
+/// Payment methods of the receipts.
+static const char* const PAYMENT_METHODS[] = {"Efectivo", "Tarjeta"
+    , "Sinpe"};
+
+/**
+ * @brief Generates the receipts of the history, one by one.
+ */
+class ReceiptGenerator {
+private:
+  std::mt19937 random{2025};  ///< Source of the fields.
+  uint64_t nextID = 1;        ///< ID of the next receipt.
+
+public:
+  /**
+   * @brief Generates the next receipt.
+   *
+   * The products follow a skewed popularity, and the last user never pays
+   * with the last payment method, for the searches without results.
+   *
+   * @param timestamp Time of the receipt.
+   * @return The receipt.
+   */
+  Receipt next(const int64_t timestamp) {
+    std::vector<Receipt::LineItem> lines(1 + this->random() % 4);
+    for (Receipt::LineItem& line : lines) {
+      const size_t popular = this->random() % 50;
+      const size_t product = this->random() % 4 == 0
+          ? this->random() % PRODUCT_COUNT : popular;
+      line.productID = product + 1;
+      line.name = StringPool::getInstance().intern(
+          Benchmark::productName(product));
+      line.quantity = 1 + this->random() % 3;
+      line.price = Money::fromCents(500 + product % 100 * 25);
+    }
+    const size_t user = this->random() % std::size(USERS);
+    const size_t methods = user + 1 == std::size(USERS)
+        ? std::size(PAYMENT_METHODS) - 1 : std::size(PAYMENT_METHODS);
+    return Receipt("Benchmark", this->nextID++, timestamp, USERS[user]
+        , std::move(lines), PAYMENT_METHODS[this->random() % methods]
+        , Money(), Money::fromCents(1000));
+  }
+};
+
+/**
+ * @brief Measures the searches of a kind.
+ *
+ * @param index The search index.
+ * @param name Name of the kind of search.
+ * @param queryOf Gets the query of each search.
+ * @return The slowest search, in milliseconds.
+ */
+template <typename QueryOf>
+static double measureSearches(ReceiptSearchIndex& index, const char* name
+    , QueryOf&& queryOf) {
+  std::vector<double> samples;
+  size_t found = 0;
+  for (size_t search = 0; search < SEARCH_COUNT; ++search) {
+    const ReceiptSearchIndex::Query query = queryOf(search);
+    samples.push_back(Benchmark::elapsedMicroseconds([&] {
+      found += index.search(query, MAX_RESULTS).size();
+    }) / 1000.0);
+  }
+  const double slowest = Benchmark::percentile(samples, 1.0);
+  std::printf("%22s %12.2f %12.2f %12.1f\n", name
+      , Benchmark::percentile(samples, 0.5), slowest
+      , static_cast<double>(found) / SEARCH_COUNT);
+  return slowest;
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  for (const char* file : {JOURNAL_FILE, INDEX_FILE, TIME_INDEX_FILE
+      , SEARCH_FILE, SEARCH_LOG_FILE}) {
+    std::filesystem::remove(file);
+  }
+
+  // Writes the history to the journal, the receipts spread over each day.
+  ReceiptGenerator generator;
+  const int64_t secondsApart = 12 * 3600 / RECEIPTS_PER_DAY;
+  int64_t timestamp = FIRST_TIME;
+  ReceiptJournal journal(JOURNAL_FILE);
+  journal.open();
+  for (size_t day = 0; day < DAY_COUNT; ++day) {
+    timestamp = FIRST_TIME + static_cast<int64_t>(day) * 86400 + 8 * 3600;
+    for (size_t receipt = 0; receipt < RECEIPTS_PER_DAY; ++receipt) {
+      journal.append(generator.next(timestamp));
+      timestamp += secondsApart;
+    }
+  }
+  ReceiptArchive archive(JOURNAL_FILE, INDEX_FILE, TIME_INDEX_FILE);
+  archive.open(journal.getDataEnd(), journal.getRecordCount());
+
+  // The postings are missing, so the index is rebuilt by its job.
+  ReceiptSearchIndex index(SEARCH_FILE, SEARCH_LOG_FILE, archive);
+  index.open(journal.getLastReceiptID());
+  std::function<void()> rebuild = index.takeMerge();
+  const double rebuildTime = Benchmark::elapsedMicroseconds([&] {
+    rebuild();
+  });
+
+  // Fills the log until a merge is pending, and runs the merge job.
+  std::function<void()> merge;
+  while (!merge) {
+    timestamp += secondsApart;
+    const Receipt receipt = generator.next(timestamp);
+    const uint64_t offset = journal.append(receipt);
+    archive.recordAppended(receipt.getID(), receipt.getTimestamp(), offset
+        , journal.getDataEnd());
+    index.add(receipt);
+    merge = index.takeMerge();
+  }
+  const double mergeTime = Benchmark::elapsedMicroseconds([&] {
+    merge();
+  });
+  // The next search installs the merged postings in the calling thread.
+  ReceiptSearchIndex::Query receiptQuery;
+  receiptQuery.receiptID = 1;
+  const double installTime = Benchmark::elapsedMicroseconds([&] {
+    index.search(receiptQuery, MAX_RESULTS);
+  });
+
+  const uint64_t receiptCount = journal.getLastReceiptID();
+  std::printf("Busqueda de recibos, %llu recibos en %zu dias\n"
+      , static_cast<unsigned long long>(receiptCount), DAY_COUNT);
+  std::printf("Reconstruccion del indice (hilo de respaldo): %.2f ms\n"
+      , rebuildTime / 1000.0);
+  std::printf("Mezcla del registro (hilo de respaldo): %.2f ms\n"
+      , mergeTime / 1000.0);
+  std::printf("Instalacion de la mezcla (hilo que busca): %.2f ms\n"
+      , installTime / 1000.0);
+  std::printf("%22s %12s %12s %12s\n", "busqueda", "mediana (ms)"
+      , "peor (ms)", "recibos");
+
+  std::mt19937 random(7);
+  const int64_t lastTime = timestamp;
+  auto randomTime = [&random, lastTime] {
+    return FIRST_TIME + static_cast<int64_t>(random()
+        % static_cast<uint64_t>(lastTime - FIRST_TIME));
+  };
+  double slowest = 0;
+  slowest = std::max(slowest, measureSearches(index, "numero", [&](size_t) {
+    ReceiptSearchIndex::Query query;
+    query.receiptID = 1 + random() % receiptCount;
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "usuario"
+      , [&](size_t search) {
+    ReceiptSearchIndex::Query query;
+    query.user = USERS[search % std::size(USERS)];
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "usuario y mes"
+      , [&](size_t search) {
+    ReceiptSearchIndex::Query query;
+    query.user = USERS[search % std::size(USERS)];
+    query.from = randomTime();
+    query.to = query.from + 30 * 86400;
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "dia", [&](size_t) {
+    ReceiptSearchIndex::Query query;
+    query.from = randomTime();
+    query.to = query.from + 86400;
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "producto poco vendido"
+      , [&](size_t) {
+    ReceiptSearchIndex::Query query;
+    query.productID = 51 + random() % (PRODUCT_COUNT - 50);
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "producto y pago"
+      , [&](size_t search) {
+    ReceiptSearchIndex::Query query;
+    query.productName = Benchmark::productName(random() % 50);
+    query.paymentMethod
+        = PAYMENT_METHODS[search % std::size(PAYMENT_METHODS)];
+    return query;
+  }));
+  slowest = std::max(slowest, measureSearches(index, "sin resultados"
+      , [&](size_t) {
+    ReceiptSearchIndex::Query query;
+    query.user = USERS[std::size(USERS) - 1];
+    query.paymentMethod = PAYMENT_METHODS[std::size(PAYMENT_METHODS) - 1];
+    return query;
+  }));
+  std::printf("Peor busqueda: %.2f ms, objetivo %.0f ms: %s\n", slowest
+      , TARGET_MILLISECONDS
+      , slowest <= TARGET_MILLISECONDS ? "cumple" : "no cumple");
+  return 0;
+}
@@ -0,0 +1,60 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+// Measures the reader of the text catalog against the one of the previous
+// versions, over a catalog of 50k lines.
+//
+// Each product takes two lines, its name and its ingredients, price and
+// image, so the catalog has 25k products.
+#include <QApplication>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "backupmodule.h"
+#include "benchmark.h"
+#include "legacyproductsparser.h"
+
+/// Products of the catalog, two lines each.
+static const size_t PRODUCT_COUNT = 25000;
+/// Runs of each reader, the best one is reported.
+static const size_t RUN_COUNT = 5;
+/// Text catalog written for the benchmark.
+static const char* const TEXT_CATALOG_FILE = "textparserbench.txt";
+
+int main(int argc, char* argv[]) {
+  Benchmark::prepare();
+  QApplication application(argc, argv);
+  BackupModule& backupModule = BackupModule::getInstance();
+
+  const std::map<std::string, std::vector<Product>> catalog
+      = Benchmark::makeCatalog(PRODUCT_COUNT);
+  BackupModule::exportProductsText(catalog, TEXT_CATALOG_FILE);
+
+  // Keeps the read catalogs, so their destruction is not measured.
+  std::vector<std::map<std::string, std::vector<Product>>> loaded;
+  const double current = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+    loaded.push_back(backupModule.importProductsText(TEXT_CATALOG_FILE));
+  });
+  const double legacy = Benchmark::bestMicroseconds(RUN_COUNT, [&] {
+    loaded.emplace_back();
+    LegacyProductsParser::readProducts(TEXT_CATALOG_FILE, "."
+        , loaded.back());
+  });
+  for (const auto& products : loaded) {
+    size_t productCount = 0;
+    for (const auto& category : products) {
+      productCount += category.second.size();
+    }
+    if (productCount != PRODUCT_COUNT) {
+      std::printf("El catalogo leido no coincide.\n");
+      return 1;
+    }
+  }
+
+  std::printf("Lectura del catalogo de texto, %zu productos"
+      ", mejor de %zu corridas\n", PRODUCT_COUNT, RUN_COUNT);
+  std::printf("%14s %18s %10s\n", "actual (ms)", "previo (ms)", "mejora");
+  std::printf("%14.2f %18.2f %9.1fx\n", current / 1000.0, legacy / 1000.0
+      , legacy / current);
+  return 0;
+}
@@ -0,0 +1,121 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "binaryreader.h"
+
+#include <cstring>
+
+#include "checksum.h"
+#include "littleendian.h"
+
+BinaryReader::BinaryReader(const void* bytes, const size_t length)
+    : data(static_cast<const char*>(bytes))
+    , size(length) {
+}
+
+const char* BinaryReader::consume(const size_t bytes) {
+  // Fails if a previous read failed or there are not enough bytes left.
+  if (!this->valid || bytes > this->remaining()) {
+    this->valid = false;
+    return nullptr;
+  }
+  const char* current = this->data + this->position;
+  this->position += bytes;
+  return current;
+}
+
+bool BinaryReader::readU8(uint8_t& value) {
+  const char* bytes = this->consume(1);
+  if (bytes == nullptr) {
+    return false;
+  }
+  value = static_cast<uint8_t>(*bytes);
+  return true;
+}
+
+bool BinaryReader::readU32(uint32_t& value) {
+  const char* bytes = this->consume(4);
+  if (bytes == nullptr) {
+    return false;
+  }
+  value = LittleEndian::read32(bytes);
+  return true;
+}
+
+bool BinaryReader::readU64(uint64_t& value) {
+  const char* bytes = this->consume(8);
+  if (bytes == nullptr) {
+    return false;
+  }
+  value = LittleEndian::read64(bytes);
+  return true;
+}
+
+bool BinaryReader::readF64(double& value) {
+  uint64_t bits = 0;
+  if (!this->readU64(bits)) {
+    return false;
+  }
+  std::memcpy(&value, &bits, sizeof(value));
+  return true;
+}
+
+bool BinaryReader::readMoney(Money& value) {
+  uint64_t cents = 0;
+  if (!this->readU64(cents)) {
+    return false;
+  }
+  value = Money::fromCents(static_cast<int64_t>(cents));
+  return true;
+}
+
+bool BinaryReader::readString(std::string& value, const uint32_t maxLength) {
+  uint32_t length = 0;
+  if (!this->readU32(length)) {
+    return false;
+  }
+  // Rejects the length before allocating anything.
+  if (length > maxLength) {
+    this->valid = false;
+    return false;
+  }
+  const char* bytes = this->consume(length);
+  if (bytes == nullptr) {
+    return false;
+  }
+  value.assign(bytes, length);
+  return true;
+}
+
+bool BinaryReader::readCount(uint32_t& count, const size_t minItemSize) {
+  if (!this->readU32(count)) {
+    return false;
+  }
+  // Each item needs some bytes, so the count is bounded by the rest.
+  if (minItemSize > 0 && count > this->remaining() / minItemSize) {
+    this->valid = false;
+    return false;
+  }
+  return true;
+}
+
+bool BinaryReader::readFrame(BinaryReader& payload, const uint32_t maxLength) {
+  uint32_t length = 0;
+  uint32_t checksum = 0;
+  if (!this->readU32(length) || !this->readU32(checksum)) {
+    return false;
+  }
+  if (length > maxLength) {
+    this->valid = false;
+    return false;
+  }
+  const char* bytes = this->consume(length);
+  if (bytes == nullptr) {
+    return false;
+  }
+  // Validates the payload before handing it out.
+  if (Checksum::crc32c(bytes, length) != checksum) {
+    this->valid = false;
+    return false;
+  }
+  payload = BinaryReader(bytes, length);
+  return true;
+}
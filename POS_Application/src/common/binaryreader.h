@@ -0,0 +1,131 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef BINARYREADER_H
+#define BINARYREADER_H
+
+#include <cstdint>
+#include <string>
+
+#include "money.h"
+
+/**
+ * @class BinaryReader
+ * @brief Decodes values written by a BinaryWriter from a single buffer.
+ *
+ * Every read is checked against the end of the buffer and every length
+ * against a limit, so corrupted data can't cause huge allocations. The first
+ * failed read invalidates the reader and the following ones fail too, so a
+ * whole record can be decoded and validated once at the end.
+ */
+class BinaryReader {
+public:
+  static const uint32_t MAX_STRING_LENGTH = 64u * 1024u; ///< Default limit.
+
+private:
+  const char* data = nullptr;  ///< First byte of the buffer.
+  size_t size = 0;             ///< Size of the buffer.
+  size_t position = 0;         ///< Position of the next read.
+  bool valid = true;           ///< False after the first failed read.
+
+public:
+  /**
+   * @brief Constructs a reader over a block of bytes, without copying them.
+   *
+   * @param bytes Pointer to the first byte of the block.
+   * @param length Number of bytes in the block.
+   */
+  BinaryReader(const void* bytes, const size_t length);
+
+  /**
+   * @brief Reads an 8 bits integer.
+   * @param value Where the value is stored.
+   * @return True if the value was read.
+   */
+  bool readU8(uint8_t& value);
+
+  /**
+   * @brief Reads a 32 bits integer.
+   * @param value Where the value is stored.
+   * @return True if the value was read.
+   */
+  bool readU32(uint32_t& value);
+
+  /**
+   * @brief Reads a 64 bits integer.
+   * @param value Where the value is stored.
+   * @return True if the value was read.
+   */
+  bool readU64(uint64_t& value);
+
+  /**
+   * @brief Reads a double stored as its IEEE 754 bits.
+   * @param value Where the value is stored.
+   * @return True if the value was read.
+   */
+  bool readF64(double& value);
+
+  /**
+   * @brief Reads an amount of money written by BinaryWriter::writeMoney().
+   * @param value Where the value is stored.
+   * @return True if the value was read.
+   */
+  bool readMoney(Money& value);
+
+  /**
+   * @brief Reads a length-prefixed string.
+   *
+   * @param value Where the string is stored.
+   * @param maxLength Maximum accepted length.
+   * @return True if the string was read and its length is within the limit.
+   */
+  bool readString(std::string& value
+      , const uint32_t maxLength = MAX_STRING_LENGTH);
+
+  /**
+   * @brief Reads a count of items that follow in the buffer.
+   *
+   * Rejects counts that can't fit in the rest of the buffer.
+   *
+   * @param count Where the count is stored.
+   * @param minItemSize Minimum size in bytes of each item.
+   * @return True if the count was read and is plausible.
+   */
+  bool readCount(uint32_t& count, const size_t minItemSize);
+
+  /**
+   * @brief Reads a record framed with its length and CRC32C checksum.
+   *
+   * @param payload Reader over the payload of the record.
+   * @param maxLength Maximum accepted payload length.
+   * @return True if the record is complete and its checksum is valid.
+   */
+  bool readFrame(BinaryReader& payload, const uint32_t maxLength);
+
+  /**
+   * @brief Checks if all the reads succeeded.
+   * @return True if no read has failed.
+   */
+  bool isValid() const { return this->valid; }
+
+  /**
+   * @brief Checks if the whole buffer was read.
+   * @return True if there are no bytes left.
+   */
+  bool atEnd() const { return this->position == this->size; }
+
+  /**
+   * @brief Gets the number of bytes left to read.
+   * @return Remaining bytes.
+   */
+  size_t remaining() const { return this->size - this->position; }
+
+private:
+  /**
+   * @brief Reserves the next bytes of the buffer for a read.
+   *
+   * @param bytes Number of bytes to read.
+   * @return Pointer to the bytes, or nullptr if there are not enough.
+   */
+  const char* consume(const size_t bytes);
+};
+
+#endif // BINARYREADER_H
@@ -0,0 +1,50 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "binarywriter.h"
+
+#include <cstring>
+#include <utility>
+
+#include "checksum.h"
+#include "littleendian.h"
+
+void BinaryWriter::writeU8(const uint8_t value) {
+  this->buffer.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeU32(const uint32_t value) {
+  LittleEndian::append32(this->buffer, value);
+}
+
+void BinaryWriter::writeU64(const uint64_t value) {
+  LittleEndian::append64(this->buffer, value);
+}
+
+void BinaryWriter::writeF64(const double value) {
+  // Stores the bits of the double as an integer.
+  uint64_t bits = 0;
+  static_assert(sizeof(bits) == sizeof(value), "double must be 64 bits");
+  std::memcpy(&bits, &value, sizeof(bits));
+  LittleEndian::append64(this->buffer, bits);
+}
+
+void BinaryWriter::writeMoney(const Money value) {
+  LittleEndian::append64(this->buffer, static_cast<uint64_t>(value.toCents()));
+}
+
+void BinaryWriter::writeString(const std::string& value) {
+  LittleEndian::append32(this->buffer, static_cast<uint32_t>(value.size()));
+  this->buffer += value;
+}
+
+void BinaryWriter::writeFrame(const std::string& payload) {
+  LittleEndian::append32(this->buffer, static_cast<uint32_t>(payload.size()));
+  LittleEndian::append32(this->buffer
+      , Checksum::crc32c(payload.data(), payload.size()));
+  this->buffer += payload;
+}
+
+std::string BinaryWriter::take() {
+  std::string bytes;
+  std::swap(bytes, this->buffer);
+  return bytes;
+}
@@ -0,0 +1,88 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef BINARYWRITER_H
+#define BINARYWRITER_H
+
+#include <cstdint>
+#include <string>
+
+#include "money.h"
+
+/**
+ * @class BinaryWriter
+ * @brief Encodes values in the portable binary format of the backup files.
+ *
+ * Integers are written with a fixed width in little-endian order, doubles as
+ * their IEEE 754 bits and strings as a 32 bits length followed by the bytes,
+ * so the files don't depend on the word size or byte order of the platform.
+ * Records are framed with their length and CRC32C checksum.
+ */
+class BinaryWriter {
+public:
+  static const size_t FRAME_SIZE = 8;  ///< Payload length and checksum.
+
+private:
+  std::string buffer;  ///< Encoded bytes.
+
+public:
+  /**
+   * @brief Appends an 8 bits integer.
+   * @param value Value to append.
+   */
+  void writeU8(const uint8_t value);
+
+  /**
+   * @brief Appends a 32 bits integer.
+   * @param value Value to append.
+   */
+  void writeU32(const uint32_t value);
+
+  /**
+   * @brief Appends a 64 bits integer.
+   * @param value Value to append.
+   */
+  void writeU64(const uint64_t value);
+
+  /**
+   * @brief Appends a double as its IEEE 754 bits.
+   * @param value Value to append.
+   */
+  void writeF64(const double value);
+
+  /**
+   * @brief Appends an amount of money as its céntimos, in two's complement.
+   * @param value Value to append.
+   */
+  void writeMoney(const Money value);
+
+  /**
+   * @brief Appends a length-prefixed string.
+   * @param value String to append.
+   */
+  void writeString(const std::string& value);
+
+  /**
+   * @brief Appends a record framed with its length and CRC32C checksum.
+   * @param payload Bytes of the record.
+   */
+  void writeFrame(const std::string& payload);
+
+  /**
+   * @brief Gets the encoded bytes.
+   * @return Reference to the encoded bytes.
+   */
+  const std::string& data() const { return this->buffer; }
+
+  /**
+   * @brief Moves the encoded bytes out of the writer, leaving it empty.
+   * @return The encoded bytes.
+   */
+  std::string take();
+
+  /**
+   * @brief Reserves space for the given number of bytes.
+   * @param bytes Expected size of the encoded data.
+   */
+  void reserve(const size_t bytes) { this->buffer.reserve(bytes); }
+};
+
+#endif // BINARYWRITER_H
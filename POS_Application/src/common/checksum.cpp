@@ -0,0 +1,74 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "checksum.h"
+
+#include <array>
+
+namespace {
+// Reflected polynomial of the CRC32C (Castagnoli) checksum.
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78u;
+
+// Builds the lookup tables of the slicing-by-8 algorithm, the first one has
+// the checksum of every possible byte, and each next one the checksum of the
+// byte followed by one more zero byte.
+constexpr std::array<std::array<uint32_t, 256>, 8> buildCrc32cTables() {
+  std::array<std::array<uint32_t, 256>, 8> tables{};
+  for (uint32_t byte = 0; byte < 256; ++byte) {
+    uint32_t crc = byte;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1u) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : (crc >> 1);
+    }
+    tables[0][byte] = crc;
+  }
+  for (size_t table = 1; table < 8; ++table) {
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+      const uint32_t previous = tables[table - 1][byte];
+      tables[table][byte] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+    }
+  }
+  return tables;
+}
+
+constexpr std::array<std::array<uint32_t, 256>, 8> CRC32C_TABLES
+    = buildCrc32cTables();
+
+// Prime multiplier of the 64 bits FNV-1a hash.
+constexpr uint64_t FNV_PRIME = 0x100000001B3ull;
+}  // namespace
+
+uint32_t Checksum::crc32c(const void* data, const size_t length
+    , const uint32_t seed) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  // Continues from the given seed, inverting it as the algorithm requires.
+  uint32_t crc = ~seed;
+  // Processes 8 bytes per step, with one lookup of each byte in its table.
+  const auto& tables = CRC32C_TABLES;
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const uint32_t low = crc ^ (uint32_t{bytes[i]}
+        | uint32_t{bytes[i + 1]} << 8 | uint32_t{bytes[i + 2]} << 16
+        | uint32_t{bytes[i + 3]} << 24);
+    const uint32_t high = uint32_t{bytes[i + 4]}
+        | uint32_t{bytes[i + 5]} << 8 | uint32_t{bytes[i + 6]} << 16
+        | uint32_t{bytes[i + 7]} << 24;
+    crc = tables[7][low & 0xFFu] ^ tables[6][(low >> 8) & 0xFFu]
+        ^ tables[5][(low >> 16) & 0xFFu] ^ tables[4][low >> 24]
+        ^ tables[3][high & 0xFFu] ^ tables[2][(high >> 8) & 0xFFu]
+        ^ tables[1][(high >> 16) & 0xFFu] ^ tables[0][high >> 24];
+  }
+  // Processes the last bytes one by one.
+  for (; i < length; ++i) {
+    crc = tables[0][(crc ^ bytes[i]) & 0xFFu] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+uint64_t Checksum::fnv1a64(const void* data, const size_t length
+    , const uint64_t seed) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  uint64_t hash = seed;
+  // Mixes every byte into the hash.
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ bytes[i]) * FNV_PRIME;
+  }
+  return hash;
+}
@@ -0,0 +1,50 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Checksum
+ * @brief Non-instantiable utility class for integrity checksums.
+ *
+ * Provides the CRC32C (Castagnoli) checksum used to validate the records
+ * stored in the binary backup files, and a 64 bits content hash used to
+ * detect changes in data that is expensive to write.
+ */
+class Checksum {
+  // Delete all constructors and assignment operators to prevent instantiation.
+  Checksum() = delete;
+  ~Checksum() = delete;
+  Checksum(const Checksum& other) = delete;
+  Checksum& operator=(const Checksum& other) = delete;
+
+public:
+  /**
+   * @brief Computes the CRC32C checksum of a block of bytes.
+   *
+   * The seed allows to continue a checksum over several non contiguous blocks,
+   * passing the result of the previous block as the seed of the next one.
+   *
+   * @param data Pointer to the first byte of the block.
+   * @param length Number of bytes in the block.
+   * @param seed Checksum of the previous block (default is 0).
+   * @return The CRC32C checksum of the block.
+   */
+  static uint32_t crc32c(const void* data, const size_t length
+      , const uint32_t seed = 0);
+
+  /**
+   * @brief Computes the 64 bits FNV-1a hash of a block of bytes.
+   *
+   * @param data Pointer to the first byte of the block.
+   * @param length Number of bytes in the block.
+   * @param seed Hash of the previous block (default is the FNV offset basis).
+   * @return The FNV-1a hash of the block.
+   */
+  static uint64_t fnv1a64(const void* data, const size_t length
+      , const uint64_t seed = 0xCBF29CE484222325ull);
+};
+
+#endif // CHECKSUM_H
@@ -0,0 +1,330 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "durablewriter.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+#include <QDebug>
+#include <QString>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+// Flushes the data of an open file descriptor to the disk.
+bool syncDescriptor(const int descriptor) {
+#ifdef _WIN32
+  return _commit(descriptor) == 0;
+#else
+  return fsync(descriptor) == 0;
+#endif
+}
+
+// Obtains the directory that contains a file.
+std::string parentDirectory(const std::string& filename) {
+  const std::filesystem::path parent
+      = std::filesystem::path(filename).parent_path();
+  return parent.empty() ? std::string(".") : parent.string();
+}
+}  // namespace
+
+DurableWriter::DurableWriter() {
+}
+
+DurableWriter::~DurableWriter() {
+  try {
+    this->setGroupCommit(false);
+  } catch (const std::exception& error) {
+    qDebug() << "No se pudieron guardar los respaldos: " << error.what();
+  }
+}
+
+void DurableWriter::setGroupCommit(const bool enabled) {
+  if (enabled == this->groupCommit) {
+    return;
+  }
+  if (enabled) {
+    // Starts the thread that commits the batches.
+    this->stopping = false;
+    this->groupCommit = true;
+    this->committer = std::thread(&DurableWriter::run, this);
+    return;
+  }
+  // Stops the commit thread once the pending updates are committed.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->pendingChanged.notify_all();
+  this->committer.join();
+  this->groupCommit = false;
+  // Reports the error of the last batch, if there was one.
+  std::string error;
+  std::swap(error, this->lastError);
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+void DurableWriter::write(const std::string& filename
+    , const std::string& content) {
+  if (!this->groupCommit) {
+    writeFile(filename, content);
+    return;
+  }
+  // Queues the content, replacing a previous update of the same file.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pendingWrites[filename] = content;
+  }
+  this->pendingChanged.notify_one();
+}
+
+void DurableWriter::sync(const std::string& filename) {
+  this->sync(std::vector<std::string>{filename});
+}
+
+void DurableWriter::sync(const std::vector<std::string>& filenames) {
+  if (!this->groupCommit) {
+    for (const std::string& filename : filenames) {
+      syncFile(filename);
+    }
+    return;
+  }
+  // Queues the flushes, several flushes of the same file become one.
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->pendingSyncs.insert(filenames.begin(), filenames.end());
+  const uint64_t batch = this->nextBatch;
+  std::pair<size_t, std::string>& waited = this->waitedBatches[batch];
+  ++waited.first;
+  this->pendingChanged.notify_one();
+  // Waits until the batch that holds the flush is on the disk.
+  this->batchCommitted.wait(lock, [this, batch] {
+    return this->committedBatch >= batch;
+  });
+  // Reports the error of that batch, the last waiting caller forgets it.
+  const std::string error = waited.second;
+  if (--waited.first == 0) {
+    this->waitedBatches.erase(batch);
+  }
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+void DurableWriter::syncAsync(const std::vector<std::string>& filenames
+    , std::function<void(const std::string& error)> done) {
+  if (!this->groupCommit || filenames.empty()) {
+    std::string error;
+    try {
+      for (const std::string& filename : filenames) {
+        syncFile(filename);
+      }
+    } catch (const std::exception& exception) {
+      error = exception.what();
+    }
+    if (done) {
+      done(error);
+    }
+    return;
+  }
+  // Queues the flushes, the commit thread calls back when they're done.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pendingSyncs.insert(filenames.begin(), filenames.end());
+    this->batchCallbacks[this->nextBatch].push_back(std::move(done));
+  }
+  this->pendingChanged.notify_one();
+}
+
+void DurableWriter::flush() {
+  if (!this->groupCommit) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(this->mutex);
+  // Wakes the commit thread and waits until there's nothing left to commit.
+  this->pendingChanged.notify_one();
+  this->batchCommitted.wait(lock, [this] {
+    return this->pendingWrites.empty() && this->pendingSyncs.empty()
+        && !this->committing;
+  });
+  // Reports the error of the last batch, if there was one.
+  std::string error;
+  std::swap(error, this->lastError);
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+void DurableWriter::run() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true) {
+    // Sleeps until there's something to commit.
+    this->pendingChanged.wait(lock, [this] {
+      return this->stopping || !this->pendingWrites.empty()
+          || !this->pendingSyncs.empty();
+    });
+    if (this->pendingWrites.empty() && this->pendingSyncs.empty()) {
+      break;
+    }
+    // Gives the next updates a moment to join a batch nobody waits for. A
+    // waited batch goes at once, the flushes that arrive while it commits
+    // join the next one.
+    if (!this->stopping) {
+      this->pendingChanged.wait_for(lock, GROUP_COMMIT_WINDOW, [this] {
+        return this->stopping
+            || this->waitedBatches.count(this->nextBatch) != 0
+            || this->batchCallbacks.count(this->nextBatch) != 0;
+      });
+    }
+
+    // Takes the batch and commits it without holding the lock.
+    std::map<std::string, std::string> writes;
+    std::set<std::string> syncs;
+    std::swap(writes, this->pendingWrites);
+    std::swap(syncs, this->pendingSyncs);
+    const uint64_t batch = this->nextBatch++;
+    this->committing = true;
+    lock.unlock();
+    std::string error;
+    try {
+      commit(writes, syncs);
+    } catch (const std::exception& exception) {
+      error = exception.what();
+      qDebug() << "No se pudo guardar el respaldo: " << exception.what();
+    }
+    lock.lock();
+    this->committedBatch = batch;
+    // The error goes to the flushes waiting for the batch, and to flush() if
+    // the batch replaced files or nobody waited for it.
+    const auto waited = this->waitedBatches.find(batch);
+    if (waited != this->waitedBatches.end()) {
+      waited->second.second = error;
+    }
+    std::vector<std::function<void(const std::string&)>> callbacks;
+    const auto called = this->batchCallbacks.find(batch);
+    if (called != this->batchCallbacks.end()) {
+      callbacks.swap(called->second);
+      this->batchCallbacks.erase(called);
+    }
+    if (!error.empty() && (waited == this->waitedBatches.end()
+        || !writes.empty() || !callbacks.empty())) {
+      this->lastError = error;
+    }
+    this->batchCommitted.notify_all();
+    // Tells the flushes that didn't wait, flush() waits for them too.
+    if (!callbacks.empty()) {
+      lock.unlock();
+      for (const auto& done : callbacks) {
+        if (done) {
+          done(error);
+        }
+      }
+      lock.lock();
+    }
+    this->committing = false;
+    this->batchCommitted.notify_all();
+  }
+}
+
+void DurableWriter::commit(const std::map<std::string, std::string>& writes
+    , const std::set<std::string>& syncs) {
+  // Replaces the files, collecting the directories whose entries changed.
+  std::set<std::string> directories;
+  for (const auto& [filename, content] : writes) {
+    writeFile(filename, content, false);
+    directories.insert(parentDirectory(filename));
+  }
+  // Flushes the files that were appended in place.
+  for (const auto& filename : syncs) {
+    syncFile(filename);
+  }
+  // Flushes each directory once for the whole batch.
+  for (const auto& directory : directories) {
+    syncDirectory(directory);
+  }
+}
+
+void DurableWriter::writeFile(const std::string& filename
+    , const std::string& content, const bool syncDirectory) {
+  // Writes the whole content to a temporary file next to the target.
+  const std::string temporal = filename + ".tmp";
+  FILE* file = std::fopen(temporal.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::runtime_error("No se pudo crear el archivo: " + temporal);
+  }
+  const bool written
+      = std::fwrite(content.data(), 1, content.size(), file) == content.size()
+      && std::fflush(file) == 0 && syncDescriptor(fileno(file));
+  std::fclose(file);
+  if (!written) {
+    std::remove(temporal.c_str());
+    throw std::runtime_error("No se pudo escribir en el archivo: " + temporal);
+  }
+  // Replaces the target with the complete temporary file.
+  replaceFile(temporal, filename, syncDirectory);
+}
+
+void DurableWriter::replaceFile(const std::string& source
+    , const std::string& target, const bool syncDirectory) {
+#ifdef _WIN32
+  // Asks Windows to flush the rename before returning.
+  const bool replaced = MoveFileExW(
+      std::filesystem::path(source).wstring().c_str()
+      , std::filesystem::path(target).wstring().c_str()
+      , MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  std::error_code error;
+  std::filesystem::rename(source, target, error);
+  const bool replaced = !error;
+#endif
+  if (!replaced) {
+    throw std::runtime_error("No se pudo reemplazar el archivo: " + target);
+  }
+  if (syncDirectory) {
+    DurableWriter::syncDirectory(parentDirectory(target));
+  }
+}
+
+void DurableWriter::syncFile(const std::string& filename) {
+#ifdef _WIN32
+  // Windows only flushes the buffers of a handle opened for writing.
+  const int descriptor = _open(filename.c_str(), _O_RDWR | _O_BINARY);
+#else
+  const int descriptor = open(filename.c_str(), O_RDONLY);
+#endif
+  if (descriptor < 0) {
+    throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+  }
+  const bool synced = syncDescriptor(descriptor);
+#ifdef _WIN32
+  _close(descriptor);
+#else
+  close(descriptor);
+#endif
+  if (!synced) {
+    throw std::runtime_error("No se pudo escribir en el archivo: " + filename);
+  }
+}
+
+void DurableWriter::syncDirectory(const std::string& directory) {
+#ifdef _WIN32
+  // The renames are flushed by MoveFileEx, directories cannot be flushed.
+  (void)directory;
+#else
+  const int descriptor = open(directory.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    qDebug() << "No se pudo abrir el directorio: "
+        << QString::fromStdString(directory);
+    return;
+  }
+  fsync(descriptor);
+  close(descriptor);
+#endif
+}
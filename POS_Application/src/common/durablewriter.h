@@ -0,0 +1,200 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef DURABLEWRITER_H
+#define DURABLEWRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DurableWriter
+ * @brief Crash-safe writer for the backup files.
+ *
+ * A file is never truncated in place: its new content is written to a
+ * temporary file that is flushed to the disk and then renamed over the
+ * original, and finally the directory is flushed so the rename survives a
+ * power cut. After a crash the file holds either its old or its new content.
+ *
+ * In group commit mode the updates are handed to a background thread that
+ * commits them in batches. Updates of the same file within a batch are
+ * coalesced, and every touched file and directory is flushed once per batch
+ * instead of once per update. The replaced files are committed in the
+ * background, and a batch of them waits a few milliseconds for more updates.
+ * A flush of a file appended in place waits for the batch that holds it, and
+ * that batch is committed at once: the appends made while it's on the way to
+ * the disk form the next batch, so concurrent appends share one flush and
+ * each caller still learns if its data is on the disk.
+ */
+class DurableWriter {
+public:
+  /// Time that a batch nobody waits for waits for more updates.
+  static constexpr std::chrono::milliseconds GROUP_COMMIT_WINDOW
+      = std::chrono::milliseconds(5);
+
+private:
+  bool groupCommit = false;  ///< True if the updates are batched.
+  std::map<std::string, std::string> pendingWrites; ///< Content by file.
+  std::set<std::string> pendingSyncs; ///< Files that must be flushed.
+  bool committing = false;   ///< True while a batch is being committed.
+  bool stopping = false;     ///< True when the commit thread must finish.
+  std::string lastError;     ///< Error of the last failed batch.
+  uint64_t nextBatch = 1;    ///< Number of the batch taking the updates.
+  uint64_t committedBatch = 0;  ///< Number of the last committed batch.
+  /// Error of each batch with flushes still waiting for it, and how many.
+  std::map<uint64_t, std::pair<size_t, std::string>> waitedBatches;
+  /// Callbacks of the flushes that don't wait for their batch.
+  std::map<uint64_t, std::vector<std::function<void(const std::string&)>>>
+      batchCallbacks;
+  std::mutex mutex;          ///< Protects the pending updates.
+  std::condition_variable pendingChanged;  ///< Wakes up the commit thread.
+  std::condition_variable batchCommitted;  ///< Wakes up the flush calls.
+  std::thread committer;     ///< Thread that commits the batches.
+
+public:
+  /**
+   * @brief Constructs a writer that commits every update immediately.
+   */
+  DurableWriter();
+
+  /**
+   * @brief Commits the pending updates and stops the commit thread.
+   */
+  ~DurableWriter();
+
+  /**
+   * @brief Enables or disables the group commit mode.
+   *
+   * Disabling it commits the pending updates first.
+   *
+   * @param enabled True to batch the updates.
+   */
+  void setGroupCommit(const bool enabled);
+
+  /**
+   * @brief Replaces the content of a file.
+   *
+   * In group commit mode the update is queued and this returns immediately,
+   * otherwise the file is committed before returning.
+   *
+   * @param filename Path to the file.
+   * @param content New content of the file.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  void write(const std::string& filename, const std::string& content);
+
+  /**
+   * @brief Flushes to the disk the data already written to a file.
+   *
+   * Used for the files that are appended in place, like the receipts journal.
+   * In group commit mode the flush joins the next batch, and this waits until
+   * that batch is committed.
+   *
+   * @param filename Path to the file.
+   *
+   * @throws std::runtime_error If the file cannot be flushed.
+   */
+  void sync(const std::string& filename);
+
+  /**
+   * @brief Flushes to the disk the data already written to several files.
+   *
+   * The flushes join the same batch, so the files cost one wait together.
+   *
+   * @param filenames Paths to the files.
+   *
+   * @throws std::runtime_error If a file cannot be flushed.
+   */
+  void sync(const std::vector<std::string>& filenames);
+
+  /**
+   * @brief Flushes several files in the same batch without waiting for it.
+   *
+   * In group commit mode the callback runs in the commit thread once the
+   * batch is on the disk, otherwise the files are flushed before returning.
+   *
+   * @param filenames Paths to the files.
+   * @param done Receives the error of the flush, empty if the data is on the
+   * disk. It must not call the writer.
+   */
+  void syncAsync(const std::vector<std::string>& filenames
+      , std::function<void(const std::string& error)> done);
+
+  /**
+   * @brief Waits until all the queued updates are on the disk.
+   *
+   * @throws std::runtime_error If a queued update could not be committed.
+   */
+  void flush();
+
+  /**
+   * @brief Writes a file through a flushed temporary file and a rename.
+   *
+   * @param filename Path to the file.
+   * @param content New content of the file.
+   * @param syncDirectory True to also flush the directory of the file.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  static void writeFile(const std::string& filename
+      , const std::string& content, const bool syncDirectory = true);
+
+  /**
+   * @brief Replaces a file with another one, flushing the rename.
+   *
+   * @param source Path to the complete, flushed file.
+   * @param target Path to the file that is replaced.
+   * @param syncDirectory True to also flush the directory of the target.
+   *
+   * @throws std::runtime_error If the file cannot be replaced.
+   */
+  static void replaceFile(const std::string& source, const std::string& target
+      , const bool syncDirectory = true);
+
+  /**
+   * @brief Flushes the content of a file to the disk.
+   *
+   * @param filename Path to the file.
+   *
+   * @throws std::runtime_error If the file cannot be flushed.
+   */
+  static void syncFile(const std::string& filename);
+
+  /**
+   * @brief Flushes the entries of a directory, making the renames durable.
+   *
+   * Does nothing on the platforms where directories cannot be flushed.
+   *
+   * @param directory Path to the directory.
+   */
+  static void syncDirectory(const std::string& directory);
+
+private:
+  /**
+   * @brief Body of the commit thread, commits the batches until stopped.
+   */
+  void run();
+
+  /**
+   * @brief Commits a batch of updates.
+   *
+   * @param writes New content of the files to replace.
+   * @param syncs Files appended in place that must be flushed.
+   */
+  static void commit(const std::map<std::string, std::string>& writes
+      , const std::set<std::string>& syncs);
+
+  // Copy and assignment constructors are disabled.
+  DurableWriter(const DurableWriter&) = delete;
+  DurableWriter& operator=(const DurableWriter&) = delete;
+};
+
+#endif // DURABLEWRITER_H
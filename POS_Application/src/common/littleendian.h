@@ -0,0 +1,74 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef LITTLEENDIAN_H
+#define LITTLEENDIAN_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class LittleEndian
+ * @brief Non-instantiable utility class to encode fixed-width integers.
+ *
+ * The binary backup files store every integer in little-endian order, so the
+ * files can be read on any platform regardless of its byte order.
+ */
+class LittleEndian {
+  // Delete all constructors and assignment operators to prevent instantiation.
+  LittleEndian() = delete;
+  ~LittleEndian() = delete;
+  LittleEndian(const LittleEndian& other) = delete;
+  LittleEndian& operator=(const LittleEndian& other) = delete;
+
+public:
+  /**
+   * @brief Appends a 32 bits integer to a buffer.
+   * @param buffer Buffer where the bytes are appended.
+   * @param value Value to append.
+   */
+  static void append32(std::string& buffer, const uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFFu));
+    }
+  }
+
+  /**
+   * @brief Appends a 64 bits integer to a buffer.
+   * @param buffer Buffer where the bytes are appended.
+   * @param value Value to append.
+   */
+  static void append64(std::string& buffer, const uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFFu));
+    }
+  }
+
+  /**
+   * @brief Reads a 32 bits integer from a block of bytes.
+   * @param bytes Pointer to the first byte of the integer.
+   * @return The decoded value.
+   */
+  static uint32_t read32(const void* bytes) {
+    const unsigned char* data = static_cast<const unsigned char*>(bytes);
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Reads a 64 bits integer from a block of bytes.
+   * @param bytes Pointer to the first byte of the integer.
+   * @return The decoded value.
+   */
+  static uint64_t read64(const void* bytes) {
+    const unsigned char* data = static_cast<const unsigned char*>(bytes);
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+      value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+  }
+};
+
+#endif // LITTLEENDIAN_H
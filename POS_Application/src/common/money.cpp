@@ -0,0 +1,53 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "money.h"
+
+#include <cmath>
+
+#include "textscanner.h"
+
+Money Money::fromDouble(const double amount) {
+  // Rounds half away from zero, like the prices typed with two decimals.
+  return Money(static_cast<int64_t>(std::llround(amount * 100)));
+}
+
+bool Money::parse(const std::string_view text, Money& amount) {
+  std::string_view rest = text;
+  const bool negative = !rest.empty() && rest.front() == '-';
+  if (negative) {
+    rest.remove_prefix(1);
+  }
+  // Splits the colones from the céntimos.
+  const size_t point = rest.find('.');
+  const std::string_view whole = rest.substr(0, point);
+  const std::string_view fraction = point == std::string_view::npos
+      ? std::string_view() : rest.substr(point + 1);
+  uint64_t colones = 0;
+  uint64_t cents = 0;
+  if (!TextScanner::parseUnsigned(whole, colones)
+      || colones > static_cast<uint64_t>(INT64_MAX / 100)
+      || fraction.size() > 2
+      || (point != std::string_view::npos
+          && !TextScanner::parseUnsigned(fraction, cents))) {
+    return false;
+  }
+  // A single decimal are tens of céntimos.
+  if (fraction.size() == 1) {
+    cents *= 10;
+  }
+  const int64_t total = static_cast<int64_t>(colones * 100 + cents);
+  amount = Money(negative ? -total : total);
+  return true;
+}
+
+std::string Money::toString() const {
+  const uint64_t magnitude = this->cents < 0
+      ? 0 - static_cast<uint64_t>(this->cents)
+      : static_cast<uint64_t>(this->cents);
+  const uint64_t fraction = magnitude % 100;
+  std::string text = this->cents < 0 ? "-" : "";
+  text += std::to_string(magnitude / 100);
+  text += '.';
+  text += static_cast<char>('0' + fraction / 10);
+  text += static_cast<char>('0' + fraction % 10);
+  return text;
+}
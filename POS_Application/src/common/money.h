@@ -0,0 +1,115 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class Money
+ * @brief Amount of money as an exact number of céntimos.
+ *
+ * The prices, totals and payments are kept as integers, so adding and
+ * subtracting them never accumulates rounding errors and the totals of a
+ * day always reconcile to the cent. The conversions from and to double are
+ * only for the spin boxes of the UI and the formats that stored doubles.
+ */
+class Money {
+private:
+  int64_t cents = 0;  ///< Amount in céntimos.
+
+  /**
+   * @brief Constructs an amount from its céntimos.
+   * @param myCents Amount in céntimos.
+   */
+  explicit constexpr Money(const int64_t myCents) : cents(myCents) {}
+
+public:
+  /**
+   * @brief Constructs a zero amount.
+   */
+  constexpr Money() = default;
+
+  /**
+   * @brief Constructs an amount from its céntimos.
+   * @param cents Amount in céntimos.
+   * @return The amount.
+   */
+  static constexpr Money fromCents(const int64_t cents) {
+    return Money(cents);
+  }
+
+  /**
+   * @brief Converts a decimal amount, rounding it to the nearest céntimo.
+   * @param amount Amount in colones.
+   * @return The amount.
+   */
+  static Money fromDouble(const double amount);
+
+  /**
+   * @brief Parses a decimal amount, like "1500" or "1500.25", exactly.
+   *
+   * @param text The amount, with at most two decimals.
+   * @param amount Where the amount is stored.
+   * @return True if the whole text is a valid amount.
+   */
+  static bool parse(const std::string_view text, Money& amount);
+
+  /**
+   * @brief Gets the amount in céntimos.
+   * @return Amount in céntimos.
+   */
+  constexpr int64_t toCents() const { return this->cents; }
+
+  /**
+   * @brief Gets the amount in colones, for the spin boxes.
+   * @return Amount in colones.
+   */
+  double toDouble() const { return static_cast<double>(this->cents) / 100; }
+
+  /**
+   * @brief Formats the amount with two decimals, like "1500.25".
+   * @return The formatted amount.
+   */
+  std::string toString() const;
+
+  constexpr Money operator+(const Money other) const {
+    return Money(this->cents + other.cents);
+  }
+  constexpr Money operator-(const Money other) const {
+    return Money(this->cents - other.cents);
+  }
+  constexpr Money operator-() const { return Money(-this->cents); }
+  constexpr Money operator*(const int64_t quantity) const {
+    return Money(this->cents * quantity);
+  }
+  Money& operator+=(const Money other) {
+    this->cents += other.cents;
+    return *this;
+  }
+  Money& operator-=(const Money other) {
+    this->cents -= other.cents;
+    return *this;
+  }
+  constexpr bool operator==(const Money other) const {
+    return this->cents == other.cents;
+  }
+  constexpr bool operator!=(const Money other) const {
+    return this->cents != other.cents;
+  }
+  constexpr bool operator<(const Money other) const {
+    return this->cents < other.cents;
+  }
+  constexpr bool operator<=(const Money other) const {
+    return this->cents <= other.cents;
+  }
+  constexpr bool operator>(const Money other) const {
+    return this->cents > other.cents;
+  }
+  constexpr bool operator>=(const Money other) const {
+    return this->cents >= other.cents;
+  }
+};
+
+#endif // MONEY_H
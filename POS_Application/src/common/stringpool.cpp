@@ -0,0 +1,37 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "stringpool.h"
+
+StringPool::StringPool() {
+  this->strings.emplace_back();
+  this->ids.emplace(this->strings.front(), EMPTY);
+}
+
+StringPool& StringPool::getInstance() {
+  // Creates an static instance of the class to avoid duplication.
+  static StringPool instance;
+  return instance;
+}
+
+StringPool::StringID StringPool::intern(const std::string_view text) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  // Reuses the ID of a string that was already interned.
+  const auto found = this->ids.find(text);
+  if (found != this->ids.end()) {
+    return found->second;
+  }
+  // The deque doesn't move its strings, so the key can point into them.
+  const StringID id = static_cast<StringID>(this->strings.size());
+  this->strings.emplace_back(text);
+  this->ids.emplace(this->strings.back(), id);
+  return id;
+}
+
+const std::string& StringPool::lookup(const StringID id) const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return id < this->strings.size() ? this->strings[id] : this->strings[EMPTY];
+}
+
+size_t StringPool::size() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->strings.size();
+}
@@ -0,0 +1,75 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class StringPool
+ * @brief Shared table of interned strings.
+ *
+ * Every distinct string is stored once and identified by a small ID, so the
+ * records that repeat a few values, like the users and the payment methods
+ * of the receipts, only keep the IDs. The strings are never removed, their
+ * references stay valid until the program finishes.
+ *
+ * The receipts are decoded by the persistence worker too, so the pool can be
+ * used from any thread.
+ */
+class StringPool {
+public:
+  typedef uint32_t StringID;  ///< Handle of an interned string.
+  static constexpr StringID EMPTY = 0;  ///< ID of the empty string.
+
+private:
+  std::deque<std::string> strings;  ///< Interned strings by ID.
+  /// IDs of the interned strings, the views point into the strings.
+  std::unordered_map<std::string_view, StringID> ids;
+  mutable std::mutex mutex;  ///< Guards the strings and the IDs.
+
+  /**
+   * @brief Constructs the pool with the empty string.
+   */
+  StringPool();
+
+public:
+  /**
+   * @brief Gets the singleton instance of the StringPool.
+   * @return Reference to the static StringPool instance.
+   */
+  static StringPool& getInstance();
+
+  /**
+   * @brief Interns a string.
+   *
+   * @param text The string.
+   * @return ID of the string, the same for equal strings.
+   */
+  StringID intern(const std::string_view text);
+
+  /**
+   * @brief Gets an interned string.
+   *
+   * @param id ID of the string.
+   * @return The string, or the empty string if the ID is unknown.
+   */
+  const std::string& lookup(const StringID id) const;
+
+  /**
+   * @brief Gets the number of interned strings.
+   * @return Number of strings, including the empty one.
+   */
+  size_t size() const;
+
+private:
+  // Copy and assignment constructors are disabled.
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+};
+
+#endif // STRINGPOOL_H
@@ -0,0 +1,94 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "taskpool.h"
+
+#include <algorithm>
+
+TaskPool::TaskPool(const size_t threads) {
+  // The submitter runs tasks too, so it takes one of the threads.
+  const size_t total = threads == 0
+      ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threads;
+  for (size_t worker = 1; worker < total; ++worker) {
+    this->workers.emplace_back(&TaskPool::run, this);
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->jobStarted.notify_all();
+  for (std::thread& worker : this->workers) {
+    worker.join();
+  }
+}
+
+void TaskPool::parallelFor(const size_t count
+    , const std::function<void(size_t)>& job) {
+  if (count == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> submitLock(this->submitMutex);
+  // Publishes the job and wakes up the workers.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->task = &job;
+    this->taskCount = count;
+    this->nextTask.store(0);
+    this->busyWorkers = this->workers.size();
+    this->error = nullptr;
+    ++this->generation;
+  }
+  this->jobStarted.notify_all();
+
+  // Runs tasks too, then waits for the workers to leave the job.
+  this->runTasks();
+  std::exception_ptr jobError;
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->jobFinished.wait(lock, [this] { return this->busyWorkers == 0; });
+    this->task = nullptr;
+    std::swap(jobError, this->error);
+  }
+  if (jobError) {
+    std::rethrow_exception(jobError);
+  }
+}
+
+void TaskPool::run() {
+  uint64_t lastGeneration = 0;
+  while (true) {
+    // Waits for a new job.
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->jobStarted.wait(lock, [this, lastGeneration] {
+        return this->stopping || this->generation != lastGeneration;
+      });
+      if (this->stopping) {
+        return;
+      }
+      lastGeneration = this->generation;
+    }
+    this->runTasks();
+    // The last worker to finish wakes up the submitter.
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (--this->busyWorkers == 0) {
+      this->jobFinished.notify_all();
+    }
+  }
+}
+
+void TaskPool::runTasks() {
+  // Takes the next pending task until there are none left.
+  for (size_t index = this->nextTask.fetch_add(1); index < this->taskCount
+      ; index = this->nextTask.fetch_add(1)) {
+    try {
+      (*this->task)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->error) {
+        this->error = std::current_exception();
+      }
+    }
+  }
+}
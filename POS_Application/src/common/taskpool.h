@@ -0,0 +1,88 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class TaskPool
+ * @brief Fixed set of threads that run the independent tasks of a job.
+ *
+ * The threads are started once and wait for jobs. A job is a number of tasks
+ * identified by their index; every thread, including the one that submits
+ * the job, takes the next pending task as soon as it finishes the previous
+ * one. A thread that gets a short task takes more of them, so the threads
+ * stay balanced without splitting the tasks beforehand.
+ */
+class TaskPool {
+private:
+  std::vector<std::thread> workers;  ///< Threads of the pool.
+  std::mutex mutex;                  ///< Protects the state of the job.
+  std::condition_variable jobStarted;   ///< Wakes up the workers.
+  std::condition_variable jobFinished;  ///< Wakes up the submitter.
+  std::mutex submitMutex;            ///< Allows a single job at a time.
+  const std::function<void(size_t)>* task = nullptr;  ///< Running job.
+  size_t taskCount = 0;              ///< Tasks of the running job.
+  std::atomic<size_t> nextTask{0};   ///< Index of the next pending task.
+  size_t busyWorkers = 0;            ///< Workers still in the job.
+  uint64_t generation = 0;           ///< Number of the running job.
+  std::exception_ptr error;          ///< First error of the running job.
+  bool stopping = false;             ///< True when the workers must finish.
+
+public:
+  /**
+   * @brief Starts the threads of the pool.
+   *
+   * @param threads Total threads that run a job, counting the submitter. 0
+   *     uses a thread per core.
+   */
+  explicit TaskPool(const size_t threads = 0);
+
+  /**
+   * @brief Stops and joins the threads of the pool.
+   */
+  ~TaskPool();
+
+  /**
+   * @brief Runs a task for every index and waits until all of them finish.
+   *
+   * The tasks run concurrently, they must only write their own results.
+   *
+   * @param count Number of tasks.
+   * @param job Function called with the index of each task.
+   *
+   * @throws The first exception thrown by a task, after all of them finish.
+   */
+  void parallelFor(const size_t count
+      , const std::function<void(size_t)>& job);
+
+  /**
+   * @brief Gets the number of threads that run a job.
+   * @return Threads of the pool, counting the submitter.
+   */
+  size_t getThreadCount() const { return this->workers.size() + 1; }
+
+private:
+  /**
+   * @brief Waits for the jobs and runs their tasks, in each worker.
+   */
+  void run();
+
+  /**
+   * @brief Runs the pending tasks of the current job.
+   */
+  void runTasks();
+
+  // Copy and assignment constructors are disabled.
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+};
+
+#endif // TASKPOOL_H
@@ -0,0 +1,56 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "textscanner.h"
+
+#include <charconv>
+#include <stdexcept>
+
+TextScanner::TextScanner(const std::string_view buffer
+    , const std::string& sourceName)
+    : text(buffer)
+    , source(sourceName) {
+}
+
+bool TextScanner::nextLine(std::string_view& line) {
+  if (this->position >= this->text.size()) {
+    return false;
+  }
+  // Finds the end of the line, the last one may have no line break.
+  size_t end = this->text.find('\n', this->position);
+  if (end == std::string_view::npos) {
+    end = this->text.size();
+  }
+  this->lineStart = this->position;
+  ++this->lineNumber;
+  line = this->text.substr(this->position, end - this->position);
+  // Ignores the carriage return of the files written on Windows.
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  this->position = end + 1;
+  return true;
+}
+
+void TextScanner::fail(const std::string_view token
+    , const std::string& reason) const {
+  // The column is the distance from the start of the line to the token.
+  const size_t column = static_cast<size_t>(token.data()
+      - (this->text.data() + this->lineStart)) + 1;
+  throw std::runtime_error("Error al analizar " + this->source + ":"
+      + std::to_string(this->lineNumber) + ":" + std::to_string(column)
+      + ": " + reason + " '" + std::string(token) + "'");
+}
+
+bool TextScanner::parseUnsigned(const std::string_view value
+    , uint64_t& number) {
+  const char* end = value.data() + value.size();
+  const std::from_chars_result result
+      = std::from_chars(value.data(), end, number);
+  return !value.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+bool TextScanner::parseDouble(const std::string_view value, double& number) {
+  const char* end = value.data() + value.size();
+  const std::from_chars_result result
+      = std::from_chars(value.data(), end, number);
+  return !value.empty() && result.ec == std::errc() && result.ptr == end;
+}
@@ -0,0 +1,131 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef TEXTSCANNER_H
+#define TEXTSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class TextScanner
+ * @brief Single-pass tokenizer over the whole content of a text file.
+ *
+ * The lines and fields are returned as views into the scanned buffer, so
+ * tokenizing allocates nothing, and numbers are parsed in place. The scanner
+ * remembers where each line starts, so a parse error can be reported with the
+ * exact line and column of the offending token.
+ */
+class TextScanner {
+private:
+  std::string_view text;    ///< Scanned buffer.
+  std::string source;       ///< Name of the scanned file, for the errors.
+  size_t position = 0;      ///< Start of the next line.
+  size_t lineStart = 0;     ///< Start of the current line.
+  size_t lineNumber = 0;    ///< Number of the current line, from 1.
+
+public:
+  /**
+   * @brief Constructs a scanner over a buffer, without copying it.
+   *
+   * @param buffer Text to scan, must outlive the scanner.
+   * @param sourceName Name of the scanned file, used in the errors.
+   */
+  TextScanner(const std::string_view buffer, const std::string& sourceName);
+
+  /**
+   * @brief Reads the next line, without its line break.
+   *
+   * @param line View of the read line.
+   * @return False if there are no more lines.
+   */
+  bool nextLine(std::string_view& line);
+
+  /**
+   * @brief Reports an error in the current line.
+   *
+   * @param token View of the offending token, inside the current line.
+   * @param reason Description of the error.
+   *
+   * @throws std::runtime_error Always, with the file, line and column.
+   */
+  [[noreturn]] void fail(const std::string_view token
+      , const std::string& reason) const;
+
+  /**
+   * @brief Removes the blank spaces at both ends of a view.
+   *
+   * @param value The view to trim.
+   * @return View without the leading and trailing blank spaces.
+   */
+  static std::string_view trim(std::string_view value) {
+    // Runs on every field, so it's inline and checks the blanks by hand.
+    size_t first = 0;
+    size_t last = value.size();
+    while (first < last && isBlank(value[first])) {
+      ++first;
+    }
+    while (last > first && isBlank(value[last - 1])) {
+      --last;
+    }
+    // An empty result keeps the position of the view, for the error columns.
+    return value.substr(first, last - first);
+  }
+
+  /**
+   * @brief Splits the next field of a view.
+   *
+   * @param rest View with the remaining fields, the field and its separator
+   *     are removed from it.
+   * @param separator Character that separates the fields.
+   * @param field View of the split field.
+   * @return False if there are no more fields.
+   */
+  static bool nextField(std::string_view& rest, const char separator
+      , std::string_view& field) {
+    if (rest.empty()) {
+      return false;
+    }
+    const size_t end = rest.find(separator);
+    if (end == std::string_view::npos) {
+      field = rest;
+      rest.remove_prefix(rest.size());
+    } else {
+      field = rest.substr(0, end);
+      rest.remove_prefix(end + 1);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Parses a whole view as an unsigned integer.
+   *
+   * @param value View of the number.
+   * @param number Where the number is stored.
+   * @return True if the whole view is a valid number.
+   */
+  static bool parseUnsigned(const std::string_view value, uint64_t& number);
+
+  /**
+   * @brief Parses a whole view as a decimal number.
+   *
+   * @param value View of the number.
+   * @param number Where the number is stored.
+   * @return True if the whole view is a valid number.
+   */
+  static bool parseDouble(const std::string_view value, double& number);
+
+private:
+  /**
+   * @brief Tells if a character is a blank space.
+   *
+   * @param character The character.
+   * @return True for spaces, tabs and line breaks.
+   */
+  static bool isBlank(const char character) {
+    return character == ' ' || character == '\t' || character == '\r'
+        || character == '\n';
+  }
+};
+
+#endif // TEXTSCANNER_H
@@ -39,3 +39,7 @@ QLabel* Util::cloneLabel(QLabel* original) {
   
   return newLabel;
 }
+
+QString Util::formatMoney(const Money amount) {
+  return QString::fromStdString(amount.toString());
+}
@@ -4,6 +4,8 @@
 
 #include <QLabel>
 
+#include "money.h"
+
 /**
  * @class Util
  * @brief Non-instantiable utility class for UI helper functions.
@@ -45,6 +47,14 @@ class Util {
    * @return A pointer to the newly created QLabel clone.
    */
   static QLabel* cloneLabel(QLabel* original);
+  
+  /**
+   * @brief Formats an amount of money with two decimals.
+   *
+   * @param amount The amount.
+   * @return The formatted amount, without the currency symbol.
+   */
+  static QString formatMoney(const Money amount);
 };
 
 #endif // UTIL_H
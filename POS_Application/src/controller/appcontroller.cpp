@@ -2,6 +2,8 @@
 #include "appcontroller.h"
 #include "posmodel.h"
 
+#include <QMessageBox>
+
 #include "user.h"
 #include "ui_mainwindow.h"
 #include "loginpage.h"
@@ -9,6 +11,7 @@
 #include "users.h"
 #include "settings/settings.h"
 #include "pos.h"
+#include "salespage.h"
 
 AppController::AppController(QWidget *parent)
   : QMainWindow(parent)
@@ -86,12 +89,14 @@ void AppController::prepareSystemPages() {
   // Creates the different program pages.
   Pos* posPage = new Pos(this, this->model);
   Inventory* inventoryPage = new Inventory(this, this->model);
+  SalesPage* salesPage = new SalesPage(this, this->model);
   Users* usersPage = new Users(this, this->model);
   Settings* settingsPage = new Settings(this, this->model);
   
   // Adds the program pages to the stack of pages.
   this->pageStack->addWidget(posPage);
   this->pageStack->addWidget(inventoryPage);
+  this->pageStack->addWidget(salesPage);
   this->pageStack->addWidget(usersPage);
   this->pageStack->addWidget(settingsPage);
   
@@ -166,20 +171,29 @@ void AppController::on_inventory_button_clicked() {
 }
 
 void AppController::on_sells_button_clicked() {
-  
+  this->refreshPageStack(3);
 }
 
 void AppController::on_users_button_clicked() {
-  this->refreshPageStack(3);
+  this->refreshPageStack(4);
 }
 
 void AppController::on_settings_button_clicked() {
-  this->refreshPageStack(4);
+  this->refreshPageStack(5);
 }
 
 void AppController::userAccepted(const User user) {
   // Start, tell the model to prepare his information.  
   if (this->model.start(user)) {
+    // Tells the user about the changes that the backups could not recover.
+    if (!this->model.getRecoveryErrors().empty()) {
+      QString lost;
+      for (const std::string& error : this->model.getRecoveryErrors()) {
+        lost += "- " + QString::fromStdString(error) + "\n";
+      }
+      QMessageBox::warning(this, "Cambios no recuperados."
+          , "Los respaldos no pudieron recuperar estos cambios:\n" + lost);
+    }
     // Creates 
     this->prepareSystemPages();
     // Enables the page buttons.
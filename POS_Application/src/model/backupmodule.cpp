@@ -1,22 +1,41 @@
 // Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include <QBuffer>
 #include <QString>
+#include <algorithm>
+#include <deque>
 #include <map>
 #include <fstream>
 #include <iostream>
 #include <qdebug.h>
 #include <qdir.h>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <sstream>
 #include <vector>
 #include <cstdint>
 #include <filesystem>
 
 #include "backupmodule.h"
+#include "binaryreader.h"
+#include "binarywriter.h"
+#include "checksum.h"
+#include "littleendian.h"
 #include "receipt.h"
 #include "user.h"
 #include "supply.h"
+#include "textscanner.h"
 
-BackupModule::BackupModule() {
+BackupModule::BackupModule()
+    : receiptJournal(RECEIPTS_JOURNAL_FILE)
+    , receiptArchive(RECEIPTS_JOURNAL_FILE, RECEIPTS_INDEX_FILE
+        , RECEIPTS_TIME_INDEX_FILE)
+    , receiptSearchIndex(RECEIPTS_SEARCH_FILE, RECEIPTS_SEARCH_LOG_FILE
+        , receiptArchive)
+    , salesArchive(SALES_DIRECTORY)
+    , commandLog(MODEL_LOG_FILE, MODEL_CHECKPOINT_FILE) {
+  // Batches the updates that land within a few milliseconds.
+  this->durableWriter.setGroupCommit(true);
 }
 
 BackupModule& BackupModule::getInstance() {
@@ -25,18 +44,61 @@ BackupModule& BackupModule::getInstance() {
   return instance;
 }
 
-std::map<std::string, std::vector<Product>> BackupModule::getProductsBackup() {
+std::map<std::string, std::vector<Product>> BackupModule::getProductsBackup(
+    uint64_t& nextProductID) {
   // Temporal map to store the products by a category key.
   std::map<std::string, std::vector<Product>> categoryRegisters;
-  // Reads the information contained in the products backup file and store it
-  // in the map.
-  this->readProductsBackup(this->PRODUCTS_BACKUP_FILE, categoryRegisters);
+  // Waits for the queued updates, so the read is not stale.
+  this->flushBackups();
+  // Forgets the state of the previously written catalog.
+  this->savedImageKeys.clear();
+  {
+    std::lock_guard<std::mutex> lock(this->pendingImagesMutex);
+    this->pendingProductImages.clear();
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+    this->savedImageHashes.clear();
+    this->savedProductsCatalog.clear();
+  }
+  
+  // Loads the catalog snapshot, that needs no parsing.
+  if (!this->readProductsCatalog(this->PRODUCTS_CATALOG_FILE
+      , categoryRegisters, nextProductID)) {
+    // Imports the text catalog of the previous versions, gives IDs to its
+    // products and saves it as a snapshot for the next start.
+    qDebug() << "Importando el catalogo de productos: "
+        << QString::fromStdString(this->PRODUCTS_BACKUP_FILE);
+    this->readProductsText(this->PRODUCTS_BACKUP_FILE, categoryRegisters);
+    nextProductID = assignProductIDs(categoryRegisters);
+    this->updateProductsBackup(categoryRegisters, nextProductID);
+  }
+  return categoryRegisters;
+}
+
+void BackupModule::exportProductsText(
+    const std::map<std::string, std::vector<Product>>& products
+    , const std::string& filename) {
+  // Writes the catalog in the text format, without touching the snapshot.
+  DurableWriter::writeFile(filename, encodeProductsText(products));
+}
+
+std::map<std::string, std::vector<Product>> BackupModule::importProductsText(
+    const std::string& filename) {
+  if (!std::filesystem::exists(filename)) {
+    throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+  }
+  // Parses the text catalog, the caller decides if it replaces the current.
+  std::map<std::string, std::vector<Product>> categoryRegisters;
+  this->readProductsText(filename, categoryRegisters);
   return categoryRegisters;
 }
 
 std::vector<Supply> BackupModule::getSuppliesBackup() {
   // Temporal vector to store the registered supplies.
   std::vector<Supply> registeredSupplies;
+  // Waits for the queued updates, so the read is not stale.
+  this->flushBackups();
   // Reads the supplies information contained in the supplies backup file.
   this->readSupplyItemsBackup(registeredSupplies);
   return registeredSupplies;
@@ -45,6 +107,8 @@ std::vector<Supply> BackupModule::getSuppliesBackup() {
 std::vector<User> BackupModule::getUsersBackup() {
   // Temporal vector to store the registered users's information.
   std::vector<User> registeredUsers;
+  // Waits for the queued updates, so the read is not stale.
+  this->flushBackups();
   // Obtains and store the users information into the temporal vector.
   this->readUsersBackup(registeredUsers);
   
@@ -52,19 +116,223 @@ std::vector<User> BackupModule::getUsersBackup() {
   return registeredUsers;
 }
 
-std::vector<Receipt> BackupModule::getReceiptsBackup() {
-  std::vector<Receipt> registeredReceipts;
-  this->readReceiptsBackup(registeredReceipts);
-  return registeredReceipts;
+bool BackupModule::findReceiptBackup(const size_t id, Receipt& receipt) {
+  // Decodes only the indexed record of the receipt.
+  this->openReceiptJournal();
+  return this->receiptArchive.find(id, receipt);
+}
+
+std::vector<Receipt> BackupModule::searchReceiptBackups(
+    const ReceiptSearchIndex::Query& query, const size_t maxResults) {
+  // Only the postings of the searched keys are read from the mapped file.
+  this->openReceiptJournal();
+  return this->receiptSearchIndex.search(query, maxResults);
+}
+
+size_t BackupModule::getReceiptsCount() {
+  // The index holds an entry per stored receipt.
+  this->openReceiptJournal();
+  return this->receiptArchive.size();
+}
+
+size_t BackupModule::getLastReceiptID() {
+  // The journal keeps the last receipt ID in its trailer.
+  this->openReceiptJournal();
+  return this->receiptJournal.getLastReceiptID();
 }
 
-void BackupModule::readProductsBackup(
+bool BackupModule::readWholeFile(const std::string& filename
+    , std::string& contents) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  // Sizes the buffer once and fills it with a single read.
+  const std::streamoff fileSize = file.tellg();
+  contents.assign(static_cast<size_t>(std::max<std::streamoff>(fileSize, 0))
+      , '\0');
+  file.seekg(0);
+  if (!file.read(contents.data(), fileSize)) {
+    throw std::runtime_error("No se pudo leer el archivo: " + filename);
+  }
+  return true;
+}
+
+bool BackupModule::readProductsCatalog(const std::string& filename
+    , std::map<std::string, std::vector<Product>>& registeredProducts
+    , uint64_t& nextProductID) {
+  // Reads the whole snapshot with a single read.
+  std::string bytes;
+  if (!readWholeFile(filename, bytes)) {
+    return false;
+  }
+  if (bytes.size() < CATALOG_HEADER_SIZE) {
+    qDebug() << "El catalogo de productos esta incompleto: "
+        << QString::fromStdString(filename);
+    return false;
+  }
+  
+  // Validates the header, the sections must fill the file exactly.
+  BinaryReader header(bytes.data(), bytes.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t categoryCount = 0;
+  uint32_t productCount = 0;
+  uint32_t ingredientCount = 0;
+  uint32_t stringsSize = 0;
+  uint32_t checksum = 0;
+  uint32_t reserved = 0;
+  header.readU32(magic);
+  header.readU32(version);
+  header.readU32(categoryCount);
+  header.readU32(productCount);
+  header.readU32(ingredientCount);
+  header.readU32(stringsSize);
+  header.readU32(checksum);
+  header.readU32(reserved);
+  nextProductID = 0;
+  header.readU64(nextProductID);
+  const uint64_t expectedSize = CATALOG_HEADER_SIZE
+      + uint64_t{categoryCount} * CATALOG_CATEGORY_SIZE
+      + uint64_t{productCount} * CATALOG_PRODUCT_SIZE
+      + uint64_t{ingredientCount} * CATALOG_INGREDIENT_SIZE
+      + stringsSize;
+  const char* body = bytes.data() + CATALOG_HEADER_SIZE;
+  // The checksum covers the next ID and the sections.
+  const char* checked = bytes.data() + CATALOG_CHECKED_OFFSET;
+  const size_t checkedSize = bytes.size() - CATALOG_CHECKED_OFFSET;
+  if (!header.isValid() || magic != CATALOG_MAGIC
+      || version != CATALOG_VERSION
+      || expectedSize != bytes.size()
+      || Checksum::crc32c(checked, checkedSize) != checksum
+      || nextProductID == 0) {
+    qDebug() << "El catalogo de productos no es valido: "
+        << QString::fromStdString(filename);
+    return false;
+  }
+  
+  // Locates the sections, the records refer to each other by position and
+  // to the strings by their offset in the strings table.
+  const char* categories = body;
+  const char* products = categories
+      + size_t{categoryCount} * CATALOG_CATEGORY_SIZE;
+  const char* ingredients = products
+      + size_t{productCount} * CATALOG_PRODUCT_SIZE;
+  const char* strings = ingredients
+      + size_t{ingredientCount} * CATALOG_INGREDIENT_SIZE;
+  auto readString = [&](const uint32_t offset, std::string& value) {
+    if (offset > stringsSize) {
+      return false;
+    }
+    BinaryReader reader(strings + offset, stringsSize - offset);
+    return reader.readString(value);
+  };
+  // Directory of the product images, with its separator to append the names.
+  const std::string imageDirectory = (std::filesystem::path(
+      this->PRODUCTS_BACKUP_FILE).parent_path() / "").string();
+  // Path of the current image, reused to avoid an allocation per product.
+  std::string imagePath = imageDirectory;
+  
+  std::map<std::string, std::vector<Product>> loadedProducts;
+  for (uint32_t category = 0; category < categoryCount; ++category) {
+    BinaryReader record(categories + size_t{category} * CATALOG_CATEGORY_SIZE
+        , CATALOG_CATEGORY_SIZE);
+    uint32_t nameOffset = 0;
+    uint32_t firstProduct = 0;
+    uint32_t categorySize = 0;
+    record.readU32(nameOffset);
+    record.readU32(firstProduct);
+    record.readU32(categorySize);
+    std::string categoryName;
+    if (!readString(nameOffset, categoryName) || firstProduct > productCount
+        || categorySize > productCount - firstProduct) {
+      return false;
+    }
+    std::vector<Product>& categoryProducts = loadedProducts[categoryName];
+    categoryProducts.reserve(categorySize);
+    
+    for (uint32_t product = firstProduct
+        ; product < firstProduct + categorySize; ++product) {
+      BinaryReader productRecord(products
+          + size_t{product} * CATALOG_PRODUCT_SIZE, CATALOG_PRODUCT_SIZE);
+      uint64_t productID = 0;
+      productRecord.readU64(productID);
+      uint32_t productNameOffset = 0;
+      uint32_t imageNameOffset = 0;
+      Money price;
+      uint32_t firstIngredient = 0;
+      uint32_t productIngredientCount = 0;
+      productRecord.readU32(productNameOffset);
+      productRecord.readU32(imageNameOffset);
+      productRecord.readMoney(price);
+      productRecord.readU32(firstIngredient);
+      productRecord.readU32(productIngredientCount);
+      std::string productName;
+      std::string imageName;
+      if (!readString(productNameOffset, productName)
+          || !readString(imageNameOffset, imageName)
+          || firstIngredient > ingredientCount
+          || productIngredientCount > ingredientCount - firstIngredient) {
+        return false;
+      }
+      
+      // Fixes up the ingredients of the product.
+      std::vector<Supply> productIngredients;
+      productIngredients.reserve(productIngredientCount);
+      for (uint32_t ingredient = firstIngredient
+          ; ingredient < firstIngredient + productIngredientCount
+          ; ++ingredient) {
+        BinaryReader ingredientRecord(ingredients
+            + size_t{ingredient} * CATALOG_INGREDIENT_SIZE
+            , CATALOG_INGREDIENT_SIZE);
+        uint32_t ingredientNameOffset = 0;
+        uint64_t quantity = 0;
+        ingredientRecord.readU32(ingredientNameOffset);
+        ingredientRecord.readU64(quantity);
+        std::string ingredientName;
+        if (!readString(ingredientNameOffset, ingredientName)) {
+          return false;
+        }
+        productIngredients.emplace_back(ingredientName, quantity);
+      }
+      
+      // The image is decoded by the store when it's painted.
+      ImageStore::ImageID productImage = ImageStore::NO_IMAGE;
+      if (!imageName.empty()) {
+        imagePath.resize(imageDirectory.size());
+        imagePath += imageName;
+        productImage = ImageStore::getInstance().addFile(imagePath);
+      }
+      categoryProducts.emplace_back(productID, productName
+          , std::move(productIngredients), price, productImage);
+    }
+  }
+  registeredProducts = std::move(loadedProducts);
+  // An unchanged catalog is not written again.
+  {
+    std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+    this->savedProductsCatalog = std::move(bytes);
+  }
+  return true;
+}
+
+uint64_t BackupModule::assignProductIDs(
+    std::map<std::string, std::vector<Product>>& registeredProducts) {
+  uint64_t nextProductID = 1;
+  for (auto& [category, products] : registeredProducts) {
+    for (auto& product : products) {
+      product.setID(nextProductID++);
+    }
+  }
+  return nextProductID;
+}
+
+void BackupModule::readProductsText(
     const std::string& filename
     , std::map<std::string, std::vector<Product>>& registeredProducts) {
-  
-  // Try to open the input file name/file path.
-  std::ifstream file(filename);
-  if (!file) {
+  // Reads the whole file, the parser works over this buffer.
+  std::string contents;
+  if (!readWholeFile(filename, contents)) {
     // Obtiene la ruta del directorio
     QFileInfo fileInfo(QString::fromStdString(filename));
     QDir dir = fileInfo.absoluteDir();
@@ -83,101 +351,137 @@ void BackupModule::readProductsBackup(
     }
     newFile.close();
     return;
-    // throw std::runtime_error("No se pudo abrir el archivo: " + filename);
   }
   
-  // Crear un objeto de tipo std::filesystem::path
-  std::filesystem::path filePath(PRODUCTS_BACKUP_FILE);
+  // Fields of a product, as views into the read buffer.
+  struct ParsedProduct {
+    std::vector<Product>* category;  ///< Products of its category.
+    std::string_view name;           ///< Name of the product.
+    std::vector<Supply> ingredients; ///< Ingredients of the product.
+    Money price;                     ///< Price of the product.
+  };
+  // The products are built after parsing, with their vectors sized once.
+  std::vector<ParsedProduct> parsedProducts;
+  std::vector<std::string_view> imageNames;
+  // Image names with blank spaces, kept to be viewed without them.
+  std::deque<std::string> cleanImageNames;
+  const auto isBlank = [](const char character) {
+    return character == ' ' || character == '\t' || character == '\v'
+        || character == '\f' || character == '\r' || character == '\n';
+  };
+  const auto startsAsNumber = [](const std::string_view field) {
+    return isdigit(static_cast<unsigned char>(field.front())) != 0
+        || field.front() == '-' || field.front() == '.';
+  };
+  // Each product takes two lines.
+  const size_t productCount
+      = std::count(contents.begin(), contents.end(), '\n') / 2 + 1;
+  parsedProducts.reserve(productCount);
+  imageNames.reserve(productCount);
   
-  // Obtener el padre del archivo (directorio que lo contiene)
-  std::filesystem::path parentPath = filePath.parent_path();
+  TextScanner scanner(contents, filename);
+  // Views of the current line, the category and the product name.
+  std::string_view line;
+  std::vector<Product>* categoryProducts = nullptr;
+  std::string_view productName;
   
-  // Temporal variable to store a line of characters of the file.
-  std::string line;
-  // Temporal variables to store the category of the product and his name.
-  std::string productCategory;
-  std::string productName;
-  std::string imagePath;
-  
-  // While there's a line on the input file.
-  while (std::getline(file, line)) {
+  // Walks through the lines without copying them.
+  while (scanner.nextLine(line)) {
     // Ignores the empty lines.
-    if (line.empty()) continue;
+    const std::string_view content = TextScanner::trim(line);
+    if (content.empty()) continue;
     
     // Identify the product categories.
-    if (line.back() == ':') {
-      productCategory = line.substr(0, line.size() - 1);
+    if (content.back() == ':') {
       // Initialize the category vector.
-      registeredProducts[productCategory] = {};
+      categoryProducts = &registeredProducts[std::string(
+          content.substr(0, content.size() - 1))];
     // identify the product's name.
-    } else if (line.back() == '-') {
-      // Parse the product name and trim it to avoid blank spaces.
-      QString name(line.substr(0, line.size() - 1).data());
-      // Sets the product name.
-      productName = name.trimmed().toStdString();
-    // Reads the product ingredients and price.
+    } else if (content.back() == '-') {
+      // Trims the product name to avoid blank spaces.
+      productName = TextScanner::trim(content.substr(0, content.size() - 1));
+    // Reads the product ingredients, price and image.
     } else {
-      // Creates a stream from the line.
-      std::istringstream stream(line);
-      // Temporal string that will be parsing the product information.
-      std::string productInfo;
-      // Temporal vector to store the product's supplies.
-      std::vector<Supply> productIngredients;
-      uint64_t productPrice = 0;
+      if (categoryProducts == nullptr) {
+        scanner.fail(content, "Producto sin categoria");
+      }
+      ParsedProduct& product = parsedProducts.emplace_back(ParsedProduct{
+          categoryProducts, productName, {}, Money()});
+      // Each ingredient has a separator, the vector is allocated once.
+      product.ingredients.reserve(std::count(line.begin(), line.end(), ';'));
+      std::string_view imageName;
       
-      // While there's tabs of the actual line/stream
-      while (std::getline(stream, productInfo, '\t')) {
-        // Normalize the tabs in the strings.
-        productInfo.erase(0, productInfo.find_first_not_of(" \t"));
-        productInfo.erase(productInfo.find_last_not_of(" \t") + 1);
+      // Reads the fields separated by tabs.
+      std::string_view rest = line;
+      std::string_view field;
+      while (TextScanner::nextField(rest, '\t', field)) {
+        field = TextScanner::trim(field);
+        if (field.empty()) continue;
         
-        // Finds the ingredient's separator.
-        size_t separatorPos = productInfo.find(';');
-        if (separatorPos != std::string::npos) {
-          // Separates the ingredient's name and quantity.
-          QString ingredientName(productInfo.substr(0, separatorPos).data());
-          // Obtain the name of the product's ingredient.
-          ingredientName = ingredientName.trimmed();
-          // Obtain the quantity of the product's ingredient.
-          std::string quantityStr = productInfo.substr(separatorPos + 1);
-          try {
-            // Extracts the ingredient quantity and creates an supplyItem.
-            uint64_t ingredientQuantity = std::stoull(quantityStr);
-            // Emplace a new ingredient on the product's ingredients vector.
-            productIngredients.emplace_back(ingredientName.toStdString()
-                , ingredientQuantity);
-          } catch (const std::exception&) {
-            throw std::runtime_error("Error al analizar: " + productInfo);
+        // The ingredients have a separator between name and quantity.
+        const size_t separatorPos = field.find(';');
+        if (separatorPos != std::string_view::npos) {
+          const std::string_view ingredientName
+              = TextScanner::trim(field.substr(0, separatorPos));
+          const std::string_view quantity
+              = TextScanner::trim(field.substr(separatorPos + 1));
+          uint64_t ingredientQuantity = 0;
+          if (!TextScanner::parseUnsigned(quantity, ingredientQuantity)) {
+            scanner.fail(quantity, "Cantidad de ingrediente no valida");
           }
-        } else {
-          // If theres no spacer, then its the product's price.
-          try {
-            productPrice = std::stod(productInfo);
-          } catch (const std::exception& e) {
-            imagePath = productInfo;
-            // Erase the blanck spaces on the image path.
-            imagePath.erase(
-                std::remove_if(imagePath.begin(), imagePath.end(), isspace),
-                imagePath.end());
-            // Construir la ruta completa usando std::filesystem::path
-            std::filesystem::path fullPath = parentPath / imagePath;
-            imagePath = fullPath.string();
+          product.ingredients.emplace_back(std::string(ingredientName)
+              , ingredientQuantity);
+        // A number is the price, anything else is the image name.
+        } else if (!Money::parse(field, product.price)) {
+          // The older backups wrote the prices as doubles, the image names
+          // don't start as a number.
+          double legacyPrice = 0;
+          if (startsAsNumber(field)
+              && TextScanner::parseDouble(field, legacyPrice)) {
+            product.price = Money::fromDouble(legacyPrice);
+          } else {
+            imageName = field;
           }
         }
       }
       
-      // Creates a new product for the corresponding category.
-      registeredProducts[productCategory].emplace_back(1, productName,
-        productIngredients, productPrice, QPixmap(imagePath.c_str()));
+      // Erase the blanck spaces on the image name.
+      if (std::any_of(imageName.begin(), imageName.end(), isBlank)) {
+        std::string& cleanName = cleanImageNames.emplace_back(imageName);
+        cleanName.erase(std::remove_if(cleanName.begin(), cleanName.end()
+            , isBlank), cleanName.end());
+        imageName = cleanName;
+      }
+      imageNames.push_back(imageName);
     }
   }
-  file.close();
+  
+  // The images are decoded by the store when they're painted.
+  std::vector<ImageStore::ImageID> images;
+  ImageStore::getInstance().addFiles((std::filesystem::path(
+      this->PRODUCTS_BACKUP_FILE).parent_path() / "").string(), imageNames
+      , images);
+  
+  // Sizes each category once for all of its products.
+  std::map<std::vector<Product>*, size_t> categorySizes;
+  for (const ParsedProduct& product : parsedProducts) {
+    ++categorySizes[product.category];
+  }
+  for (const auto& [category, size] : categorySizes) {
+    category->reserve(category->size() + size);
+  }
+  for (size_t index = 0; index < parsedProducts.size(); ++index) {
+    ParsedProduct& product = parsedProducts[index];
+    // Creates a new product for the corresponding category.
+    product.category->emplace_back(0, std::string(product.name)
+        , std::move(product.ingredients), product.price, images[index]);
+  }
 }
 
 void BackupModule::readSupplyItemsBackup(std::vector<Supply>& supplies) {
-  std::ifstream file(this->SUPPLIES_BACKUP_FILE);
-  // Try to open the input file name/file path.  
-  if(!file) {
+  // Reads the whole file, the parser works over this buffer.
+  std::string contents;
+  if (!readWholeFile(this->SUPPLIES_BACKUP_FILE, contents)) {
     // Obtiene la ruta del directorio
     QFileInfo fileInfo(QString::fromStdString(this->SUPPLIES_BACKUP_FILE));
     QDir dir = fileInfo.absoluteDir();
@@ -200,21 +504,36 @@ void BackupModule::readSupplyItemsBackup(std::vector<Supply>& supplies) {
     return;
   }
   
-  // Temporal to store the indexed line of the supply's file.
-  std::string line;
-  // Temporals to store the supply's information.
-  std::string name;;
-  uint64_t quantity;
-  std::string measure;
-  
+  TextScanner scanner(contents, this->SUPPLIES_BACKUP_FILE);
+  std::string_view line;
   // While there's line to read on the file.
-  while(std::getline(file, line)) {
-    // Creates a buffer from the actual line.
-    std::istringstream stream(line);
-    // Reads the name, quantity and measure of the supply backup.
-    stream >> name >> quantity >> measure;
+  while (scanner.nextLine(line)) {
+    line = TextScanner::trim(line);
+    if (line.empty()) continue;
+    
+    // The name may have spaces, so the line is read from its end: the last
+    // word is the measure, unless it's the quantity of a supply without one.
+    size_t split = line.find_last_of(" \t");
+    if (split == std::string_view::npos) {
+      scanner.fail(line, "Insumo sin cantidad");
+    }
+    std::string_view measure = line.substr(split + 1);
+    std::string_view rest = TextScanner::trim(line.substr(0, split));
+    uint64_t quantity = 0;
+    if (TextScanner::parseUnsigned(measure, quantity)) {
+      measure = std::string_view();
+    } else {
+      split = rest.find_last_of(" \t");
+      const std::string_view quantityField = split == std::string_view::npos
+          ? rest : rest.substr(split + 1);
+      if (split == std::string_view::npos
+          || !TextScanner::parseUnsigned(quantityField, quantity)) {
+        scanner.fail(quantityField, "Cantidad de insumo no valida");
+      }
+      rest = TextScanner::trim(rest.substr(0, split));
+    }
     // Emplace a new supply on the givel vector of supplies.
-    supplies.emplace_back(name, quantity, measure);
+    supplies.emplace_back(std::string(rest), quantity, std::string(measure));
   }
 }
 
@@ -235,12 +554,6 @@ void BackupModule::readUsersBackup(std::vector<User>& registeredUsers) {
       }
     }
     
-    // Intenta crear el archivo
-    std::ofstream newFile(this->USERS_BACKUP_FILE, std::ios::out | std::ios::binary);
-    if (!newFile) {
-      throw std::runtime_error(
-          "No se pudo crear el archivo: " + this->USERS_BACKUP_FILE);
-    }
     const std::vector<User::PageAccess> adminPermissions {
       User::PageAccess(0, User::PageAccess::EDITABLE)
       , User::PageAccess(1, User::PageAccess::EDITABLE)
@@ -252,75 +565,172 @@ void BackupModule::readUsersBackup(std::vector<User>& registeredUsers) {
     User admin(0, "admin", adminPermissions);
     admin.setPassword("Svndda03");
     
-    // Save the users quantity into the file.
-    size_t numUsers = 1;
-    newFile.write(reinterpret_cast<const char*>(&numUsers), sizeof(numUsers));
-    
-    admin.saveToBinary(newFile);
-    newFile.close();
+    // Creates the file with the admin user.
+    this->writeUsersBackup({admin});
+    this->durableWriter.flush();
+    return;
+  }
+  
+  // Reads the whole file into a single buffer.
+  const std::string content((std::istreambuf_iterator<char>(inFile))
+      , std::istreambuf_iterator<char>());
+  inFile.close();
+  
+  // Files without the magic number use the legacy format.
+  if (content.size() < 4
+      || LittleEndian::read32(content.data()) != USERS_MAGIC) {
+    this->readLegacyUsersBackup(registeredUsers);
+    // Rewrites the users in the current format.
+    this->writeUsersBackup(registeredUsers);
     return;
   }
   
+  // Validates the header and the number of users.
+  BinaryReader reader(content.data(), content.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t numUsers = 0;
+  reader.readU32(magic);
+  reader.readU32(version);
+  if (version != USERS_VERSION) {
+    throw std::runtime_error("Version no soportada del archivo: "
+        + this->USERS_BACKUP_FILE);
+  }
+  reader.readCount(numUsers, BinaryWriter::FRAME_SIZE);
+  
+  // Cleans the given vector before hand.
+  registeredUsers.clear();
+  registeredUsers.reserve(reader.isValid() ? numUsers : 0);
+  // Decodes each user record, validating its checksum.
+  for (uint32_t i = 0; reader.isValid() && i < numUsers; ++i) {
+    BinaryReader record(nullptr, 0);
+    User user;
+    if (reader.readFrame(record, MAX_USER_RECORD_SIZE) && user.decode(record)
+        && record.atEnd()) {
+      registeredUsers.push_back(user);
+    }
+  }
+  if (!reader.isValid() || registeredUsers.size() != numUsers) {
+    throw std::runtime_error("El respaldo de usuarios esta danado: "
+        + this->USERS_BACKUP_FILE);
+  }
+}
+
+void BackupModule::readLegacyUsersBackup(std::vector<User>& registeredUsers) {
+  // Opens the users's backup file in binary read mode.
+  std::ifstream inFile(this->USERS_BACKUP_FILE, std::ios::binary);
+  
   // Reads the number of registered users.
-  size_t numUsers = -1;
+  size_t numUsers = 0;
   inFile.read(reinterpret_cast<char*>(&numUsers), sizeof(numUsers));
   // Cleans the given vector before hand.
   registeredUsers.clear();
-  // Reads the user's information.
-  for (size_t i = 0; i < numUsers; ++i) {
+  // Reads the user's information while the file is valid.
+  for (size_t i = 0; inFile && i < numUsers; ++i) {
     // Creates a user data object.
     User user;
     // Reads an user information the backup file.
     user.loadFromBinary(inFile);
     // Add the user data into the program memory.
-    registeredUsers.push_back(user);
+    if (inFile) {
+      registeredUsers.push_back(user);
+    }
+  }
+  if (registeredUsers.size() != numUsers) {
+    throw std::runtime_error("El respaldo de usuarios esta danado: "
+        + this->USERS_BACKUP_FILE);
+  }
+}
+
+void BackupModule::openReceiptJournal() {
+  // Nothing to do if the journal is already opened.
+  if (this->receiptJournal.isOpen() && this->receiptArchive.isOpen()
+      && this->receiptSearchIndex.isOpen()) {
+    return;
+  }
+  // Obtains the directory of the receipts files.
+  QFileInfo fileInfo(QString::fromStdString(this->RECEIPTS_JOURNAL_FILE));
+  QDir dir = fileInfo.absoluteDir();
+  
+  // Creates the directory if it does not exist.
+  if (!dir.exists() && !dir.mkpath(".")) {
+    throw std::runtime_error(
+        "No se pudo crear el directorio para el archivo: "
+        + this->RECEIPTS_JOURNAL_FILE);
+  }
+  
+  // Imports the legacy receipts the first time the journal is created.
+  if (!this->receiptJournal.exists()) {
+    std::vector<Receipt> legacyReceipts;
+    this->readLegacyReceiptsBackup(legacyReceipts);
+    this->receiptJournal.rewrite(legacyReceipts);
+  }
+  
+  this->receiptJournal.open();
+  // Rewrites the journal if the last session left a damaged tail.
+  const bool damaged = this->receiptJournal.isDamaged();
+  if (damaged) {
+    this->receiptJournal.compact();
+  }
+  // Maps the journal, the index is rebuilt if the journal was rewritten.
+  this->receiptArchive.open(this->receiptJournal.getDataEnd()
+      , this->receiptJournal.getRecordCount(), damaged);
+  // Indexes the receipts that the search postings are missing.
+  this->receiptSearchIndex.open(this->receiptJournal.getLastReceiptID());
+  this->startSearchMerge();
+}
+
+void BackupModule::startSearchMerge() {
+  // Merges or rebuilds the postings in the worker, out of the sales.
+  std::function<void()> merge = this->receiptSearchIndex.takeMerge();
+  if (merge) {
+    this->persistenceWorker.submit(std::move(merge));
+  }
+}
+
+void BackupModule::openModelLog(const CommandLog::Visitor& visitor) {
+  // Creates the directory of the log if it does not exist.
+  QFileInfo fileInfo(QString::fromStdString(this->MODEL_LOG_FILE));
+  QDir dir = fileInfo.absoluteDir();
+  if (!dir.exists() && !dir.mkpath(".")) {
+    throw std::runtime_error(
+        "No se pudo crear el directorio para el archivo: "
+        + this->MODEL_LOG_FILE);
+  }
+  // The log is read again, the appended changes are already on the file.
+  this->commandLog.open(visitor);
+}
+
+const std::string& BackupModule::snapshotFile(const size_t index) const {
+  switch (index) {
+    case 0: return this->PRODUCTS_CATALOG_FILE;
+    case 1: return this->SUPPLIES_BACKUP_FILE;
+    default: return this->USERS_BACKUP_FILE;
   }
-  // Close the backup file.
-  inFile.close();
 }
 
-void BackupModule::readReceiptsBackup(
+void BackupModule::readLegacyReceiptsBackup(
     std::vector<Receipt>& registeredReceipts) {
-  // Abre el archivo en modo binario
+  // Opens the legacy file in binary mode, if there's one.
   std::ifstream inFile(this->RECEIPTS_BACKUP_FILE, std::ios::binary);
   if (!inFile) {
-    // Obtiene la ruta del directorio
-    QFileInfo fileInfo(QString::fromStdString(this->RECEIPTS_BACKUP_FILE));
-    QDir dir = fileInfo.absoluteDir();
-    
-    // Crea la carpeta si no existe
-    if (!dir.exists() && !dir.mkpath(".")) {
-      throw std::runtime_error(
-          "No se pudo crear el directorio para el archivo: "
-          + this->RECEIPTS_BACKUP_FILE);
-    }
-    
-    // Intenta crear el archivo vacío
-    std::ofstream newFile(this->RECEIPTS_BACKUP_FILE
-        , std::ios::out | std::ios::binary);
-    if (!newFile) {
-      throw std::runtime_error(
-          "No se pudo crear el archivo: " + this->RECEIPTS_BACKUP_FILE);
-    }
-    newFile.close();
-    return;  // Archivo recién creado, no hay nada que leer
+    return;
   }
   
-  // Lee la cantidad de recibos almacenados
+  // Reads the quantity of stored receipts.
   size_t receiptsQuantity = 0;
   if (!inFile.read(reinterpret_cast<char*>(&receiptsQuantity)
       , sizeof(receiptsQuantity))) {
-    throw std::runtime_error(
-        "Error al leer la cantidad de recibos desde el archivo.");
+    return;
   }
   
-  // Limpia el vector antes de cargar los datos
+  // Cleans the vector before loading the data.
   registeredReceipts.clear();
   
-  // Lee cada recibo del archivo y lo almacena en el vector
+  // Reads each receipt of the file and stores it in the vector.
   for (size_t i = 0; i < receiptsQuantity; ++i) {
     Receipt receipt;
-    if (!(inFile >> receipt)) {  // Verifica si la lectura fue exitosa
+    if (!(inFile >> receipt)) {  // Checks if the receipt was read.
       throw std::runtime_error("Error al leer un recibo desde el archivo.");
     }
     registeredReceipts.push_back(receipt);
@@ -328,87 +738,488 @@ void BackupModule::readReceiptsBackup(
 }
 
 
-void BackupModule::updateProductsBackup(
-    const std::map<std::string, std::vector<Product>>& products) {
-  // Writes out the given products information into the product's backup files.
-  this->writeProductsBackup(this->PRODUCTS_BACKUP_FILE, products);
+bool BackupModule::getCashierSessionBackup(CashierSession& session) {
+  // Waits for the queued updates, so the read is not stale.
+  this->durableWriter.flush();
+  std::string content;
+  if (!readWholeFile(this->CASHIER_SESSION_FILE, content)) {
+    return false;
+  }
+  // Validates the header and the checksum of the session record.
+  BinaryReader reader(content.data(), content.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  reader.readU32(magic);
+  reader.readU32(version);
+  BinaryReader record(nullptr, 0);
+  if (!reader.isValid() || magic != CashierSession::SESSION_MAGIC
+      || version != CashierSession::SESSION_VERSION
+      || !reader.readFrame(record, CashierSession::MAX_SESSION_SIZE)
+      || !session.decode(record) || !record.atEnd()) {
+    qDebug() << "La sesion de caja esta danada: "
+        << QString::fromStdString(this->CASHIER_SESSION_FILE);
+    return false;
+  }
+  return true;
 }
 
-void BackupModule::updateSuppliesBackup(
-    const std::vector<Supply>& supplies) {
-  // Writes out the given supplies information into the supplies's backup files.
-  this->writeSuppliesBackup(supplies);
+bool BackupModule::getSalesRollupBackup(const std::string& day
+    , SalesRollups::Totals& totals) {
+  // Waits for the queued updates only if the totals of the day are being
+  // written, the other days are read without blocking.
+  if (this->persistenceWorker.isPending(this->rollupPath(day))) {
+    this->flushBackups();
+  }
+  std::string content;
+  if (!readWholeFile(this->rollupPath(day), content)) {
+    return false;
+  }
+  // Validates the header and the checksum of the totals record.
+  BinaryReader reader(content.data(), content.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  reader.readU32(magic);
+  reader.readU32(version);
+  BinaryReader record(nullptr, 0);
+  if (!reader.isValid() || magic != SalesRollups::ROLLUP_MAGIC
+      || version != SalesRollups::ROLLUP_VERSION
+      || !reader.readFrame(record, SalesRollups::MAX_ROLLUP_SIZE)
+      || !SalesRollups::decode(record, totals) || !record.atEnd()) {
+    qDebug() << "Los totales de ventas estan danados: "
+        << QString::fromStdString(this->rollupPath(day));
+    return false;
+  }
+  return true;
 }
 
-void BackupModule::updateUsersBackup(const std::vector<User>& users) {
-  // Writes out the given users information into the users's backup files.
-  this->writeUsersBackup(users);
+std::string BackupModule::getLastSalesRollupDay() const {
+  // The totals are named after their day, so the last name is the latest.
+  const QStringList names = QDir(QString::fromStdString(
+      this->ROLLUPS_DIRECTORY)).entryList(QStringList("*.rollup")
+      , QDir::Files, QDir::Name);
+  return names.isEmpty() ? std::string()
+      : names.last().section('.', 0, 0).toStdString();
 }
 
-void BackupModule::updateReceiptsBackup(const size_t newReceiptsQuantity,
-    const std::vector<Receipt>& receipts) {
-  int numReceipts = newReceiptsQuantity;
-  this->writeReceiptsBackup(numReceipts, receipts);
+void BackupModule::updateProductsBackup(
+    const std::map<std::string, std::vector<Product>>& products
+    , const uint64_t nextProductID) {
+  // Takes the snapshot here, the pixmaps can only be used in this thread.
+  for (const auto& category : products) {
+    for (const Product& product : category.second) {
+      this->stageProductImage(product.getImage(), productImageName(product));
+    }
+  }
+  const std::string catalog = encodeProductsBackup(products, nextProductID);
+  // Writes out the snapshot into the product's backup files in the worker.
+  this->persistenceWorker.enqueue(this->PRODUCTS_CATALOG_FILE
+      , [this, catalog] {
+        this->writeProductsBackup(this->PRODUCTS_CATALOG_FILE, catalog);
+      });
 }
 
-void BackupModule::writeReceiptsBackup(const int lastReceiptID
-    , const std::vector<Receipt>& receipts) {
-  // Opens the file in binary write mode.
-  std::ofstream outFile(this->RECEIPTS_BACKUP_FILE, std::ios::binary);
-  if (!outFile) {
-    std::cerr << "Error: No se pudo abrir el archivo para escritura.\n";
-    return;
+std::vector<ModelCommand> BackupModule::getModelCommands(
+    const uint8_t registers) {
+  // Waits for the queued updates, so the snapshots are not stale.
+  this->flushBackups();
+  // A snapshot that matches the checkpoint holds its changes, any other one
+  // was written by the previous checkpoint.
+  CommandLog::Checkpoint checkpoint;
+  const bool checkpointed = this->commandLog.readCheckpoint(checkpoint);
+  for (size_t index = 0; index < CommandLog::REGISTER_COUNT; ++index) {
+    std::string content;
+    if (!checkpointed) {
+      this->snapshotSequences[index] = 0;
+    } else if (readWholeFile(this->snapshotFile(index), content)
+        && Checksum::crc32c(content.data(), content.size())
+            == checkpoint.checksums[index]) {
+      this->snapshotSequences[index] = checkpoint.sequences[index];
+    } else {
+      this->snapshotSequences[index] = checkpoint.previousSequences[index];
+    }
   }
   
-  // Save the receipts quantity into the file.
-  size_t numReceipts = receipts.size();
-  outFile.write(reinterpret_cast<const char*>(&numReceipts)
-      , sizeof(numReceipts));
-  
-  // Writes out the receipts information binary into the given file.
-  for (const auto& receipt : receipts) {
-    outFile << receipt;
+  // Keeps the changes of the registers that their snapshot misses.
+  const std::string imageDirectory = (std::filesystem::path(
+      this->PRODUCTS_BACKUP_FILE).parent_path() / "").string();
+  const ModelCommand::ImageLoader loadImage
+      = [&imageDirectory](const std::string& imageName) {
+        return ImageStore::getInstance().addFile(imageDirectory + imageName);
+      };
+  std::vector<ModelCommand> commands;
+  this->openModelLog([&](const uint64_t sequence, BinaryReader& record) {
+    ModelCommand command;
+    if (!command.decode(record, loadImage)) {
+      qDebug() << "Cambio danado en el registro:" << sequence;
+      return;
+    }
+    const uint8_t changed = command.getRegister();
+    const size_t index = changed == ModelSnapshot::PRODUCTS ? 0
+        : changed == ModelSnapshot::SUPPLIES ? 1 : 2;
+    if ((registers & changed) != 0
+        && sequence > this->snapshotSequences[index]) {
+      commands.push_back(std::move(command));
+    }
+  });
+  return commands;
+}
+
+void BackupModule::appendModelCommand(const ModelCommand& command
+    , std::function<void(const std::string& error)> durable) {
+  // Encodes the change here, the images can only be used in this thread.
+  const std::string record = this->encodeModelRecord(command);
+  // Appends it in the worker, and hears about the flush without waiting.
+  this->persistenceWorker.submit([this, record, durable] {
+    try {
+      this->appendModelRecord(record);
+    } catch (const std::exception& error) {
+      if (durable) {
+        durable(error.what());
+      }
+      throw;
+    }
+    this->durableWriter.syncAsync({this->MODEL_LOG_FILE}, durable);
+  });
+}
+
+std::string BackupModule::encodeModelRecord(const ModelCommand& command) {
+  // Stores the images by the name of their file, staging the changed ones.
+  bool stagedImages = false;
+  BinaryWriter writer;
+  command.encode(writer, [this, &stagedImages](const Product& product) {
+    if (product.getImage() == ImageStore::NO_IMAGE) {
+      return std::string();
+    }
+    const std::string imageName = productImageName(product);
+    this->stageProductImage(product.getImage(), imageName);
+    stagedImages = true;
+    return imageName;
+  });
+  // Writes out the images in the worker.
+  if (stagedImages) {
+    const std::string directory = std::filesystem::path(
+        this->PRODUCTS_BACKUP_FILE).parent_path().string();
+    this->persistenceWorker.enqueue(directory
+        , [this, directory] { this->writeStagedImages(directory); });
+  }
+  return writer.take();
+}
+
+void BackupModule::appendModelRecord(const std::string& record) {
+  if (!this->commandLog.isOpen()) {
+    this->openModelLog([](const uint64_t, BinaryReader&) {});
   }
+  this->commandLog.append(record);
+}
+
+void BackupModule::checkpointModelBackups(
+    std::shared_ptr<const ModelSnapshot> snapshot
+    , const uint64_t nextProductID) {
+  // Encodes and writes the snapshots in the worker, after the changes they
+  // hold were appended to the log.
+  this->persistenceWorker.submit([this, snapshot, nextProductID] {
+    if (!this->commandLog.isOpen()) {
+      this->openModelLog([](const uint64_t, BinaryReader&) {});
+    }
+    // Their checksums go into the checkpoint.
+    const std::string snapshots[CommandLog::REGISTER_COUNT] = {
+      encodeProductsBackup(*snapshot->categories, nextProductID)
+      , encodeSuppliesBackup(*snapshot->supplies)
+      , encodeUsersBackup(*snapshot->users)
+    };
+    CommandLog::Checkpoint checkpoint;
+    for (size_t index = 0; index < CommandLog::REGISTER_COUNT; ++index) {
+      checkpoint.sequences[index] = this->commandLog.getLastSequence();
+      checkpoint.checksums[index] = Checksum::crc32c(snapshots[index].data()
+          , snapshots[index].size());
+      checkpoint.previousSequences[index] = this->snapshotSequences[index];
+    }
+    // The checkpoint is on the disk before any snapshot is replaced.
+    DurableWriter::writeFile(this->commandLog.getCheckpointFilename()
+        , CommandLog::encodeCheckpoint(checkpoint));
+    
+    // Writes out the snapshots and waits until they are on the disk.
+    this->writeProductsBackup(this->PRODUCTS_CATALOG_FILE, snapshots[0]);
+    this->durableWriter.write(this->SUPPLIES_BACKUP_FILE, snapshots[1]);
+    this->durableWriter.write(this->USERS_BACKUP_FILE, snapshots[2]);
+    this->durableWriter.flush();
+    
+    // Every snapshot holds the logged changes now.
+    for (size_t index = 0; index < CommandLog::REGISTER_COUNT; ++index) {
+      this->snapshotSequences[index] = checkpoint.sequences[index];
+    }
+    this->commandLog.reset();
+  });
+}
+
+void BackupModule::appendReceiptBackup(const Receipt& receipt
+    , const ModelCommand* deduction
+    , std::function<void(const std::string& error)> durable) {
+  // Appends the given receipt at the end of the receipts journal.
+  this->openReceiptJournal();
+  const uint64_t offset = this->receiptJournal.append(receipt);
+  // Registers the new record in the receipts index.
+  this->receiptArchive.recordAppended(receipt.getID()
+      , receipt.getTimestamp(), offset, this->receiptJournal.getDataEnd());
+  this->receiptSearchIndex.add(receipt);
+  this->startSearchMerge();
   
-  outFile.close();
+  // Logs the supplies deducted by the sale in the worker, after the changes
+  // made before, and flushes both files in the same batch.
+  const std::string record = deduction == nullptr ? std::string()
+      : this->encodeModelRecord(*deduction);
+  this->persistenceWorker.submit([this, record, durable] {
+    std::vector<std::string> appended = {this->RECEIPTS_JOURNAL_FILE};
+    if (!record.empty()) {
+      try {
+        this->appendModelRecord(record);
+      } catch (const std::exception& error) {
+        if (durable) {
+          durable(error.what());
+        }
+        throw;
+      }
+      appended.push_back(this->MODEL_LOG_FILE);
+    }
+    this->durableWriter.syncAsync(appended, durable);
+  });
 }
 
-void BackupModule::writeUsersBackup(const std::vector<User>& users) {
-  // Opens the file in binary write mode.
-  std::ofstream outFile(this->USERS_BACKUP_FILE, std::ios::binary);
-  if (!outFile) {
-    std::cerr << "Error: No se pudo abrir el archivo para escritura.\n";
+void BackupModule::updateCashierSessionBackup(
+    const CashierSession& session) {
+  // Creates the directory of the session if it doesn't exist.
+  QFileInfo fileInfo(QString::fromStdString(this->CASHIER_SESSION_FILE));
+  QDir dir = fileInfo.absoluteDir();
+  if (!dir.exists() && !dir.mkpath(".")) {
+    throw std::runtime_error(
+        "No se pudo crear el directorio para el archivo: "
+        + this->CASHIER_SESSION_FILE);
+  }
+  // Writes out the header and the session as a record with its checksum.
+  BinaryWriter writer;
+  BinaryWriter record;
+  writer.writeU32(CashierSession::SESSION_MAGIC);
+  writer.writeU32(CashierSession::SESSION_VERSION);
+  session.encode(record);
+  writer.writeFrame(record.take());
+  this->durableWriter.write(this->CASHIER_SESSION_FILE, writer.take());
+}
+
+void BackupModule::updateSalesRollupBackup(const std::string& day
+    , const SalesRollups::Totals& totals) {
+  // Writes out a copy of the totals, a newer copy replaces a pending one.
+  this->persistenceWorker.enqueue(this->rollupPath(day)
+      , [this, day, totals] { this->writeSalesRollup(day, totals); });
+}
+
+void BackupModule::appendSalesBackup(const std::vector<Receipt>& receipts) {
+  if (receipts.empty()) {
+    return;
+  }
+  // Converts the receipts here, the worker only merges the rows.
+  {
+    std::lock_guard<std::mutex> lock(this->pendingSalesMutex);
+    for (const Receipt& receipt : receipts) {
+      this->pendingSales.push_back(SalesArchive::toSale(receipt));
+    }
+  }
+  // A coalesced job still merges every pending sale.
+  this->persistenceWorker.enqueue(this->SALES_DIRECTORY
+      , [this] { this->writeSalesBackup(); });
+}
+
+void BackupModule::flushBackups() {
+  // Runs the pending snapshots, then waits until they are on the disk.
+  this->persistenceWorker.flush();
+  this->durableWriter.flush();
+}
+
+PersistenceWorker::Metrics BackupModule::getPersistenceMetrics() const {
+  return this->persistenceWorker.getMetrics();
+}
+
+bool BackupModule::compactReceiptsBackup() {
+  this->openReceiptJournal();
+  if (!this->receiptJournal.needsCompaction()) {
+    return false;
+  }
+  // The queued flushes of the journal must finish before it's replaced.
+  this->flushBackups();
+  // The journal cannot be replaced while it's mapped.
+  this->receiptArchive.close();
+  this->receiptJournal.compact();
+  this->receiptArchive.open(this->receiptJournal.getDataEnd()
+      , this->receiptJournal.getRecordCount(), true);
+  return true;
+}
+
+void BackupModule::writeSalesBackup() {
+  // Takes all the sales queued until now.
+  std::vector<SalesArchive::Sale> sales;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingSalesMutex);
+    sales.swap(this->pendingSales);
+  }
+  if (sales.empty()) {
     return;
   }
+  // Creates the directory of the segments if it doesn't exist.
+  QDir dir(QString::fromStdString(this->SALES_DIRECTORY));
+  if (!dir.exists() && !dir.mkpath(".")) {
+    throw std::runtime_error("No se pudo crear el directorio: "
+        + this->SALES_DIRECTORY);
+  }
+  // Writes only the new sales, the stored runs are left as they are.
+  for (const auto& [path, run] : this->salesArchive.appendSales(sales)) {
+    this->durableWriter.write(path, run);
+  }
+  this->compactSalesBackup();
+}
+
+void BackupModule::compactSalesBackup() {
+  const std::vector<std::string> days = this->salesArchive.takeClosedDays(
+      SalesArchive::dayOf(QDateTime::currentSecsSinceEpoch()));
+  if (days.empty()) {
+    return;
+  }
+  // The queued runs must be on the disk before they are merged.
+  this->durableWriter.flush();
+  for (const std::string& day : days) {
+    std::string segment;
+    std::vector<std::string> runs;
+    if (!this->salesArchive.compactDay(day, segment, runs)) {
+      continue;
+    }
+    if (!segment.empty()) {
+      DurableWriter::writeFile(this->salesArchive.segmentPath(day), segment);
+    }
+    // The segment records its last run, so a run that isn't removed here is
+    // skipped by the readers and removed by a later merge.
+    for (const std::string& run : runs) {
+      QFile::remove(QString::fromStdString(run));
+    }
+  }
+}
+
+std::string BackupModule::rollupPath(const std::string& day) const {
+  return this->ROLLUPS_DIRECTORY + "\\" + day + ".rollup";
+}
+
+void BackupModule::writeSalesRollup(const std::string& day
+    , const SalesRollups::Totals& totals) {
+  // Creates the directory of the totals if it doesn't exist.
+  QDir dir(QString::fromStdString(this->ROLLUPS_DIRECTORY));
+  if (!dir.exists() && !dir.mkpath(".")) {
+    throw std::runtime_error("No se pudo crear el directorio: "
+        + this->ROLLUPS_DIRECTORY);
+  }
+  // Writes out the header and the totals as a record with its checksum.
+  BinaryWriter writer;
+  BinaryWriter record;
+  writer.writeU32(SalesRollups::ROLLUP_MAGIC);
+  writer.writeU32(SalesRollups::ROLLUP_VERSION);
+  SalesRollups::encode(totals, record);
+  writer.writeFrame(record.take());
+  this->durableWriter.write(this->rollupPath(day), writer.take());
+}
+
+void BackupModule::writeUsersBackup(const std::vector<User>& users) {
+  // The file is replaced in a single step.
+  this->durableWriter.write(this->USERS_BACKUP_FILE, encodeUsersBackup(users));
+}
+
+std::string BackupModule::encodeUsersBackup(const std::vector<User>& users) {
+  // Serializes the users in memory.
+  BinaryWriter writer;
   
-  // Save the users quantity into the file.
-  size_t numUsers = users.size();
-  outFile.write(reinterpret_cast<const char*>(&numUsers), sizeof(numUsers));
+  // Writes out the header and the users quantity.
+  writer.writeU32(USERS_MAGIC);
+  writer.writeU32(USERS_VERSION);
+  writer.writeU32(static_cast<uint32_t>(users.size()));
   
-  // Writes out the user information binary into the given file.
+  // Writes out each user as a record with its own checksum.
+  BinaryWriter record;
   for (const auto& user : users) {
-    user.saveToBinary(outFile);
+    user.encode(record);
+    writer.writeFrame(record.take());
   }
-  
-  outFile.close();
+  return writer.take();
 }
 
-void BackupModule::writeProductsBackup(
-    const std::string& filename,
-    const std::map<std::string, std::vector<Product>>& registeredProducts) {
+std::string BackupModule::encodeProductsBackup(
+    const std::map<std::string, std::vector<Product>>& registeredProducts
+    , const uint64_t nextProductID) {
+  // Stores each different string once, the ingredient names repeat a lot.
+  std::map<std::string, uint32_t> stringOffsets;
+  BinaryWriter strings;
+  auto intern = [&](const std::string& value) {
+    const auto found = stringOffsets.find(value);
+    if (found != stringOffsets.end()) {
+      return found->second;
+    }
+    const uint32_t offset = static_cast<uint32_t>(strings.data().size());
+    strings.writeString(value);
+    stringOffsets.emplace(value, offset);
+    return offset;
+  };
   
-  // Open the file in write mode and erase the content.
-  std::ofstream file(filename);
-  if (!file) {
-    throw std::runtime_error("No se pudo abrir el archivo para escritura: "
-        + filename);
+  // Writes the fixed size records of each section.
+  BinaryWriter categories;
+  BinaryWriter products;
+  BinaryWriter ingredients;
+  uint32_t productCount = 0;
+  uint32_t ingredientCount = 0;
+  for (const auto& [category, categoryProducts] : registeredProducts) {
+    categories.writeU32(intern(category));
+    categories.writeU32(productCount);
+    categories.writeU32(static_cast<uint32_t>(categoryProducts.size()));
+    for (const auto& product : categoryProducts) {
+      const std::string imageName = productImageName(product);
+      products.writeU64(product.getID());
+      products.writeU32(intern(product.getName()));
+      products.writeU32(intern(imageName));
+      products.writeMoney(product.getPrice());
+      products.writeU32(ingredientCount);
+      products.writeU32(
+          static_cast<uint32_t>(product.getIngredients().size()));
+      for (const auto& ingredient : product.getIngredients()) {
+        ingredients.writeU32(intern(ingredient.getName()));
+        ingredients.writeU64(ingredient.getQuantity());
+        ++ingredientCount;
+      }
+      ++productCount;
+    }
   }
   
-  // Creates a std::filesystem::path object.
-  std::filesystem::path filePath(filename);
-  
-  // Obtains the parent directory's name.
-  std::filesystem::path parentPath = filePath.parent_path();
+  // Joins the next ID and the sections after a header with their sizes and
+  // checksum.
+  BinaryWriter nextID;
+  nextID.writeU64(nextProductID);
+  std::string body = nextID.take();
+  body += categories.take();
+  body += products.take();
+  body += ingredients.take();
+  const uint32_t stringsSize = static_cast<uint32_t>(strings.data().size());
+  body += strings.take();
+  BinaryWriter catalog;
+  catalog.reserve(CATALOG_CHECKED_OFFSET + body.size());
+  catalog.writeU32(CATALOG_MAGIC);
+  catalog.writeU32(CATALOG_VERSION);
+  catalog.writeU32(static_cast<uint32_t>(registeredProducts.size()));
+  catalog.writeU32(productCount);
+  catalog.writeU32(ingredientCount);
+  catalog.writeU32(stringsSize);
+  catalog.writeU32(Checksum::crc32c(body.data(), body.size()));
+  catalog.writeU32(0);
+  std::string bytes = catalog.take();
+  bytes += body;
+  return bytes;
+}
+
+std::string BackupModule::encodeProductsText(
+    const std::map<std::string, std::vector<Product>>& registeredProducts) {
+  // Builds the catalog text in memory.
+  std::ostringstream file;
   
   // Transverse the map through all the product categories.
   for (const auto& [category, products] : registeredProducts) {
@@ -430,51 +1241,135 @@ void BackupModule::writeProductsBackup(
         file << ingredientName.toStdString() << " ; "
             << ingredient.getQuantity() << "\t";
       }
-      // Creates the string name of the product's image backup file.
-      std::string imageName = product.getName() +  ".png";
-      // Erase the blanck spaces on the image path.
-      imageName.erase(
-          std::remove_if(imageName.begin(), imageName.end(), isspace),
-          imageName.end());
       // Writes out the product's price as the last character of the line.
-      file << product.getPrice() << "\t" << imageName << std::endl;
-      
-      // Saves the product image in the save directory as the backup file.
-      const QPixmap& productImage = product.getImage();
-      const std::string directory = parentPath.string() + "\\" + imageName;
-      
-      // Checks if the direcoty already exist, if not, creates it.
-      QDir dir(QString::fromStdString(parentPath.string()));
-      if (!dir.exists()) {
-        dir.mkpath(".");
-      }
-      
-      try {
-        productImage.save(QString::fromStdString(directory));
-      } catch(std::runtime_error& e) {
-        qDebug() << "El producto: " << product.getImage()
-            << ". No tiene imagen";
-      }
+      file << product.getPrice().toString() << "\t"
+          << productImageName(product)
+          << std::endl;
     }
     // Writes out a blank line between categories.
     file << std::endl;
   }
-  file.close();
+  return file.str();
 }
 
-void BackupModule::writeSuppliesBackup(
-    const std::vector<Supply>& supplies) {
-  // Try to open the specified file of the supplies backup.
-  std::ofstream file(this->SUPPLIES_BACKUP_FILE);
-  if (!file) {
-    throw std::runtime_error("No se pudo abrir el archivo para escritura: "
-        + this->SUPPLIES_BACKUP_FILE);
+std::string BackupModule::productImageName(const Product& product) {
+  // Creates the string name of the product's image backup file.
+  std::string imageName = product.getName() +  ".png";
+  // Erase the blanck spaces on the image path.
+  imageName.erase(
+      std::remove_if(imageName.begin(), imageName.end(), isspace),
+      imageName.end());
+  return imageName;
+}
+
+void BackupModule::stageProductImage(const ImageStore::ImageID image
+    , const std::string& imageName) {
+  // Products without image have nothing to write.
+  if (image == ImageStore::NO_IMAGE) {
+    return;
+  }
+  const std::string imagePath = (std::filesystem::path(
+      this->PRODUCTS_BACKUP_FILE).parent_path() / imageName).string();
+  auto savedImage = this->savedImageKeys.find(imageName);
+  if (savedImage == this->savedImageKeys.end()) {
+    // The images loaded from their files are only known by the store.
+    savedImage = this->savedImageKeys.emplace(imageName
+        , ImageStore::getInstance().findFile(imagePath)).first;
+  }
+  // The same image than the last staged one can't have changed.
+  if (savedImage->second == image) {
+    return;
+  }
+  savedImage->second = image;
+  // The file is going to change, so the store must not reuse its old image.
+  ImageStore::getInstance().forgetFile(imagePath);
+  // Decodes only the changed image, in a form the worker thread can use.
+  const QImage content = ImageStore::getInstance().getPixmap(image).toImage();
+  if (content.isNull()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->pendingImagesMutex);
+  this->pendingProductImages[imageName] = content;
+}
+
+void BackupModule::writeProductsBackup(const std::string& filename
+    , const std::string& catalog) {
+  // Writes the images staged since the last write.
+  this->writeStagedImages(
+      std::filesystem::path(filename).parent_path().string());
+  
+  // Nothing else to write if the catalog didn't change.
+  std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+  if (catalog == this->savedProductsCatalog) {
+    return;
+  }
+  
+  // Replaces the file without ever leaving a half written catalog.
+  this->durableWriter.write(filename, catalog);
+  this->savedProductsCatalog = catalog;
+}
+
+void BackupModule::writeStagedImages(const std::string& directory) {
+  // Takes the images staged since the last write, even by coalesced updates.
+  std::map<std::string, QImage> images;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingImagesMutex);
+    std::swap(images, this->pendingProductImages);
+  }
+  for (const auto& [imageName, image] : images) {
+    this->writeProductImage(image, directory, imageName);
+  }
+}
+
+bool BackupModule::writeProductImage(const QImage& image
+    , const std::string& directory, const std::string& imageName) {
+  // A different image may have the same content, compares the pixels hash.
+  uint64_t hash = Checksum::fnv1a64(image.constBits()
+      , static_cast<size_t>(image.sizeInBytes()));
+  const uint64_t size = (static_cast<uint64_t>(image.width()) << 32)
+      | static_cast<uint32_t>(image.height());
+  hash = Checksum::fnv1a64(&size, sizeof(size), hash);
+  {
+    std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+    const auto saved = this->savedImageHashes.find(imageName);
+    if (saved != this->savedImageHashes.end() && saved->second == hash) {
+      return false;
+    }
   }
   
+  // Checks if the direcoty already exist, if not, creates it.
+  QDir dir(QString::fromStdString(directory));
+  if (!dir.exists()) {
+    dir.mkpath(".");
+  }
+  
+  // Encodes the image and saves it as any other backup file.
+  const std::string path = directory + "\\" + imageName;
+  QByteArray encoded;
+  QBuffer buffer(&encoded);
+  buffer.open(QIODevice::WriteOnly);
+  if (!image.save(&buffer, "PNG")) {
+    qDebug() << "No se pudo guardar la imagen: "
+        << QString::fromStdString(path);
+    std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+    this->savedImageHashes.erase(imageName);
+    return false;
+  }
+  this->durableWriter.write(path
+      , std::string(encoded.constData(), encoded.size()));
+  std::lock_guard<std::mutex> lock(this->savedBackupsMutex);
+  this->savedImageHashes[imageName] = hash;
+  return true;
+}
+
+std::string BackupModule::encodeSuppliesBackup(
+    const std::vector<Supply>& supplies) {
+  // Serializes the supplies in memory.
+  std::ostringstream file;
+  
   // Writes out the supplies information into the file.
   for (const auto& supply : supplies) {
     file << supply << "\n";
   }
-  
-  file.close();
+  return file.str();
 }
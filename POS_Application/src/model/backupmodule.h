@@ -2,12 +2,29 @@
 #ifndef BACKUPMODULE_H
 #define BACKUPMODULE_H
 
+#include <QImage>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <qapplication.h>
 #include <string>
+#include <unordered_map>
 
+#include "cashiersession.h"
+#include "commandlog.h"
+#include "durablewriter.h"
+#include "imagestore.h"
+#include "modelcommand.h"
+#include "modelsnapshot.h"
+#include "persistenceworker.h"
 #include "product.h"
 #include "receipt.h"
+#include "receiptarchive.h"
+#include "receiptjournal.h"
+#include "receiptsearchindex.h"
+#include "salesarchive.h"
+#include "salesrollups.h"
 #include "user.h"
 
 /**
@@ -17,14 +34,46 @@
  * The BackupModule class facilitates reading and writing product, supply, and user data
  * from backup files, ensuring persistent storage of data for the application.
  *
+ * The update functions take a snapshot of the data and hand it to a
+ * PersistenceWorker, so the disk is never touched from the GUI thread and a
+ * burst of edits produces a single write. The products are stored as a binary
+ * catalog snapshot, the text catalog is only used to import and export
+ * them. Every backup file is replaced
+ * through a DurableWriter, so a power cut in the middle of a write never
+ * leaves a half written file.
+ *
+ * The changes of the products, supplies and users are appended to a
+ * CommandLog instead of rewriting their files. The files are snapshots
+ * written at the checkpoints, the start replays the logged changes that each
+ * snapshot misses. The changes are appended and the checkpoints written by
+ * the worker too, in the order they were made, and the caller learns through
+ * a callback when a change is on the disk instead of waiting for it.
+ *
  * This class implements the singleton pattern, ensuring that only one instance is used
  * throughout the application.
  */
 class BackupModule {
+public:
+  static const uint32_t USERS_MAGIC = 0x52535550;  ///< "PUSR" in the file.
+  static const uint32_t USERS_VERSION = 2;         ///< Users format version.
+  static const uint32_t MAX_USER_RECORD_SIZE = 64u * 1024u; ///< Per user.
+  static const uint32_t CATALOG_MAGIC = 0x54414350;  ///< "PCAT" in the file.
+  /// Catalog version, the only one. It always carries the product IDs and
+  /// the next ID, the text catalog is imported when there's no snapshot.
+  static const uint32_t CATALOG_VERSION = 1;
+  static const size_t CATALOG_HEADER_SIZE = 40;      ///< Counts, next ID...
+  static const size_t CATALOG_CHECKED_OFFSET = 32;   ///< Next ID onwards.
+  static const size_t CATALOG_CATEGORY_SIZE = 12;    ///< Name and products.
+  static const size_t CATALOG_PRODUCT_SIZE = 32;     ///< Product record.
+  static const size_t CATALOG_INGREDIENT_SIZE = 12;  ///< Name and quantity.
+
 private:
   const std::string PRODUCTS_BACKUP_FILE
       = QApplication::applicationDirPath().toStdString()
         + "\\backup\\products\\Products.txt";
+  const std::string PRODUCTS_CATALOG_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\products\\catalog.bin";
   const std::string SUPPLIES_BACKUP_FILE
       = QApplication::applicationDirPath().toStdString()
         + "\\backup\\inventory\\primeMaterial.txt";
@@ -34,6 +83,59 @@ private:
   const std::string RECEIPTS_BACKUP_FILE
       = QApplication::applicationDirPath().toStdString()
         + "\\backup\\receipts\\receipts_data.bin";
+  const std::string RECEIPTS_JOURNAL_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\receipts.journal";
+  const std::string RECEIPTS_INDEX_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\receipts.index";
+  const std::string RECEIPTS_TIME_INDEX_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\receipts.timeindex";
+  const std::string RECEIPTS_SEARCH_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\receipts.search";
+  const std::string RECEIPTS_SEARCH_LOG_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\receipts.searchlog";
+  const std::string CASHIER_SESSION_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\cashier.session";
+  const std::string ROLLUPS_DIRECTORY
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\receipts\\rollups";
+  const std::string SALES_DIRECTORY
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\sales";
+  const std::string MODEL_LOG_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\changes\\model.log";
+  const std::string MODEL_CHECKPOINT_FILE
+      = QApplication::applicationDirPath().toStdString()
+        + "\\backup\\changes\\model.checkpoint";
+  ReceiptJournal receiptJournal; ///< Append-only journal of the receipts.
+  ReceiptArchive receiptArchive; ///< Mapped, indexed view of the journal.
+  ReceiptSearchIndex receiptSearchIndex; ///< Postings of the receipts.
+  SalesArchive salesArchive;     ///< Columnar segments of the sales by day.
+  CommandLog commandLog;         ///< Changes of the registers since snapshots.
+  /// Last change held by the snapshot of each register.
+  uint64_t snapshotSequences[CommandLog::REGISTER_COUNT] = {};
+  std::vector<SalesArchive::Sale> pendingSales; ///< Sales to archive.
+  std::mutex pendingSalesMutex;  ///< Protects the pending sales.
+  
+  // Used by the calling thread, that owns the images.
+  /// Last staged image by image file, the loaded ones are not included.
+  std::unordered_map<std::string, ImageStore::ImageID> savedImageKeys;
+  // Handed from the calling thread to the persistence worker.
+  std::map<std::string, QImage> pendingProductImages; ///< Changed images.
+  std::mutex pendingImagesMutex; ///< Protects the pending product images.
+  // Written by the persistence worker, reset by the calling thread on loads.
+  std::map<std::string, uint64_t> savedImageHashes; ///< Pixels hash by file.
+  std::string savedProductsCatalog; ///< Last written products catalog.
+  std::mutex savedBackupsMutex;  ///< Protects the written images and catalog.
+  
+  DurableWriter durableWriter;   ///< Crash-safe writer of the backup files.
+  PersistenceWorker persistenceWorker; ///< Writes the backups in background.
 public:
   /**
    * @brief Gets the singleton instance of the BackupModule.
@@ -47,15 +149,48 @@ public:
   /**
    * @brief Retrieves the products backup.
    *
-   * Reads product data from the backup file and returns a map
+   * Reads product data from the catalog snapshot and returns a map
    * where each key is a product category and the corresponding value is
-   * a vector of Product objects.
+   * a vector of Product objects. If there's no valid snapshot, the text
+   * catalog of the previous versions is imported and saved as a snapshot.
+   * The products of the catalogs without IDs are given new IDs.
    *
+   * @param nextProductID Where the next ID to give to a product is stored.
    * @return Map of product categories to Product vectors.
    *
    * @throws std::runtime_error If the backup file cannot be opened.
    */
-  std::map<std::string, std::vector<Product>> getProductsBackup();
+  std::map<std::string, std::vector<Product>> getProductsBackup(
+      uint64_t& nextProductID);
+  
+  /**
+   * @brief Exports the products to a text catalog.
+   *
+   * Uses no state of the module, so it can run in any thread over a snapshot
+   * of the products.
+   *
+   * @param products Map of product categories to vectors of Product objects.
+   * @param filename Path to the exported text file.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  static void exportProductsText(
+      const std::map<std::string, std::vector<Product>>& products
+      , const std::string& filename);
+  
+  /**
+   * @brief Imports the products of a text catalog.
+   *
+   * The imported products are not saved here, they get their IDs when they
+   * are added to the model.
+   *
+   * @param filename Path to the text file.
+   * @return Map of product categories to Product vectors.
+   *
+   * @throws std::runtime_error If the file cannot be opened or parsed.
+   */
+  std::map<std::string, std::vector<Product>> importProductsText(
+      const std::string& filename);
   
   /**
    * @brief Retrieves the supplies backup.
@@ -79,43 +214,243 @@ public:
    */
   std::vector<User> getUsersBackup();
   
-  std::vector<Receipt> getReceiptsBackup();
+  /**
+   * @brief Finds a stored receipt by its ID.
+   *
+   * Looks up the receipt in the receipts index and decodes only that record
+   * from the mapped journal.
+   *
+   * @param id ID of the receipt.
+   * @param receipt Receipt where the found receipt is stored.
+   * @return True if the receipt was found.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be opened.
+   */
+  bool findReceiptBackup(const size_t id, Receipt& receipt);
+  
+  /**
+   * @brief Searches the stored receipts, the newest first.
+   *
+   * @param query Fields of the search, the empty ones match any receipt.
+   * @param maxResults Maximum number of receipts returned.
+   * @return The found receipts.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be opened.
+   */
+  std::vector<Receipt> searchReceiptBackups(
+      const ReceiptSearchIndex::Query& query, const size_t maxResults);
+  
+  /**
+   * @brief Gets the number of stored receipts.
+   * @return Number of receipts in the receipts backup.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be opened.
+   */
+  size_t getReceiptsCount();
+  
+  /**
+   * @brief Retrieves the ID of the last stored receipt.
+   *
+   * Reads it from the receipts journal trailer, without reading the receipts.
+   *
+   * @return The last receipt ID, or 0 if there are no receipts.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be opened.
+   */
+  size_t getLastReceiptID();
+  
+  /**
+   * @brief Retrieves the cashier session backup.
+   *
+   * @param session Session replaced with the saved one, without its
+   *     receipts.
+   * @return False if there's no saved session or it's damaged.
+   */
+  bool getCashierSessionBackup(CashierSession& session);
+  
+  /**
+   * @brief Retrieves the sales totals of a day.
+   *
+   * Only waits for the persistence worker if the totals of the day are
+   * queued to be written, the model keeps the totals it wrote in memory.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param totals Totals replaced with the saved ones.
+   * @return False if the day has no saved totals or they are damaged.
+   */
+  bool getSalesRollupBackup(const std::string& day
+      , SalesRollups::Totals& totals);
+  
+  /**
+   * @brief Gets the latest day with saved sales totals.
+   * @return Day key as yyyyMMdd, empty if no totals were saved.
+   */
+  std::string getLastSalesRollupDay() const;
   
   /**
    * @brief Updates the products backup.
    *
-   * Writes the provided product data to the products backup file.
+   * Takes a snapshot of the provided product data and writes it to the
+   * products backup file in the background. The file is only written if its
+   * content changed, and only the product images that changed since they
+   * were last written or loaded are encoded again.
    *
    * @param products Map of product categories to vectors of Product objects.
+   * @param nextProductID Next ID to give to a product, saved with them.
    *
    * @throws std::runtime_error If the backup file cannot be opened for writing.
    */
-  void updateProductsBackup(const std::map<std::string, std::vector<Product>>& products);
+  void updateProductsBackup(
+      const std::map<std::string, std::vector<Product>>& products
+      , const uint64_t nextProductID);
   
   /**
-   * @brief Updates the supplies backup.
+   * @brief Gets the logged changes that the snapshots of some registers miss.
    *
-   * Writes the provided supply data to the supplies backup file.
+   * A snapshot holds the changes up to the checkpoint that wrote it, so only
+   * the newer changes of its register are returned.
    *
-   * @param supplies Vector of Supply objects to be saved.
+   * @param registers Flags of the registers, ModelSnapshot::Register.
+   * @return The changes, in the order they were made.
    *
-   * @throws std::runtime_error If the backup file cannot be opened for writing.
+   * @throws std::runtime_error If the change log cannot be opened.
    */
-  void updateSuppliesBackup(const std::vector<Supply>& supplies);
+  std::vector<ModelCommand> getModelCommands(const uint8_t registers);
   
   /**
-   * @brief Updates the users backup.
+   * @brief Appends a change of the products, supplies or users to the log.
    *
-   * Writes the provided user data to the users backup file in binary format.
+   * Encodes the record of the change here, and appends and flushes it in the
+   * background after the changes made before, with the changed product
+   * images.
    *
-   * @param users Vector of User objects to be saved.
+   * @param command The change.
+   * @param durable Receives the error of the flush, empty if the change is on
+   * the disk. Called in a background thread.
+   */
+  void appendModelCommand(const ModelCommand& command
+      , std::function<void(const std::string& error)> durable = nullptr);
+  
+  /**
+   * @brief Writes the snapshots of the registers and empties the change log.
    *
-   * @throws std::runtime_error If the backup file cannot be opened for writing.
+   * The snapshots are encoded and written in the background, after the
+   * changes logged before. The log is emptied once they are on the disk.
+   *
+   * @param snapshot Registers of the model holding every logged change.
+   * @param nextProductID Next ID to give to a product, saved with them.
    */
-  void updateUsersBackup(const std::vector<User>& users);
+  void checkpointModelBackups(std::shared_ptr<const ModelSnapshot> snapshot
+      , const uint64_t nextProductID);
   
-  void updateReceiptsBackup(const size_t newReceiptsQuantity
-      , const std::vector<Receipt>& receipts);
+  /**
+   * @brief Appends a receipt to the receipts backup.
+   *
+   * Writes only the new receipt at the end of the receipts journal and adds
+   * its entry to the receipts index, the cost does not depend on the number
+   * of stored receipts.
+   *
+   * The supplies deducted by the sale are logged with it, and the journal
+   * and the change log are flushed in the background in the same batch.
+   *
+   * @param receipt The Receipt to be saved.
+   * @param deduction Change of the supplies made by the sale, or nullptr.
+   * @param durable Receives the error of the flush, empty if the sale is on
+   * the disk. Called in a background thread.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be written.
+   */
+  void appendReceiptBackup(const Receipt& receipt
+      , const ModelCommand* deduction = nullptr
+      , std::function<void(const std::string& error)> durable = nullptr);
+  
+  /**
+   * @brief Updates the cashier session backup.
+   *
+   * The session is small, it's encoded here and replaced in the file
+   * together with the other queued updates, like the receipts journal.
+   *
+   * @param session The cashier session.
+   *
+   * @throws std::runtime_error If the session cannot be written.
+   */
+  void updateCashierSessionBackup(const CashierSession& session);
+  
+  /**
+   * @brief Updates the sales totals of a day.
+   *
+   * Writes a copy of the totals in the background, the totals updated by a
+   * burst of receipts produce a single write.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param totals Totals of the day.
+   */
+  void updateSalesRollupBackup(const std::string& day
+      , const SalesRollups::Totals& totals);
+  
+  /**
+   * @brief Archives the closed receipts in the columnar sales segments.
+   *
+   * The receipts are converted to rows here and written as new runs of
+   * their days in the background.
+   *
+   * @param receipts The closed receipts.
+   */
+  void appendSalesBackup(const std::vector<Receipt>& receipts);
+  
+  /**
+   * @brief Gets the sales segment files of a day, for the reports.
+   *
+   * The pending sales must be flushed before the segments are listed. The
+   * segments must be closed after the report, so they can be merged.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @return Paths to the segment and the runs of the day.
+   */
+  std::vector<std::string> getSalesSegments(const std::string& day) const {
+    return this->salesArchive.daySegments(day);
+  }
+  
+  /**
+   * @brief Gets the sales segment files of every day with sales.
+   *
+   * The pending sales must be flushed before the segments are listed.
+   *
+   * @return Day keys as yyyyMMdd, in order, with the paths of each day.
+   */
+  std::vector<std::pair<std::string, std::vector<std::string>>>
+      getSalesDays() const {
+    return this->salesArchive.listDays();
+  }
+  
+  /**
+   * @brief Waits until all the updated backups are on the disk.
+   *
+   * Writes the pending snapshots without waiting for their debounce delay.
+   *
+   * @throws std::runtime_error If a queued backup could not be written.
+   */
+  void flushBackups();
+  
+  /**
+   * @brief Gets the queue depth and write latency counters of the backups.
+   * @return Metrics of the persistence worker.
+   */
+  PersistenceWorker::Metrics getPersistenceMetrics() const;
+  
+  /**
+   * @brief Compacts the receipts backup if it holds records to drop.
+   *
+   * Rewrites the receipts journal keeping only its valid records, and
+   * rebuilds the receipts index over the new journal. A journal without a
+   * damaged tail or repeated receipts is left as it is, so the call costs
+   * nothing on most cashier closes.
+   *
+   * @return True if the journal was rewritten.
+   *
+   * @throws std::runtime_error If the receipts journal cannot be written.
+   */
+  bool compactReceiptsBackup();
   
 private:
   /**
@@ -124,22 +459,73 @@ private:
   BackupModule();
   
   /**
-   * @brief Reads product data from the backup file.
+   * @brief Reads the whole content of a file with a single read.
+   *
+   * @param filename Path to the file.
+   * @param contents Buffer replaced with the content of the file.
+   * @return False if the file doesn't exist.
+   *
+   * @throws std::runtime_error If the file cannot be read.
+   */
+  static bool readWholeFile(const std::string& filename
+      , std::string& contents);
+  
+  /**
+   * @brief Gets the file of the sales totals of a day.
+   * @param day Day key as yyyyMMdd.
+   * @return Path to the file.
+   */
+  std::string rollupPath(const std::string& day) const;
+  
+  /**
+   * @brief Reads the products from the binary catalog snapshot.
+   *
+   * The snapshot holds a header, the category, product and ingredient
+   * records and a table with all their strings. It's read with a single
+   * read, validated with its checksum, and the records are turned into
+   * products following their offsets. Every product carries its ID, and the
+   * header the next ID to give.
+   *
+   * @param filename Path to the catalog snapshot.
+   * @param registeredProducts Map replaced with the read products.
+   * @param nextProductID Where the next product ID of the snapshot is
+   *     stored.
+   * @return False if the snapshot doesn't exist or is not valid.
+   */
+  bool readProductsCatalog(const std::string& filename
+      , std::map<std::string, std::vector<Product>>& registeredProducts
+      , uint64_t& nextProductID);
+  
+  /**
+   * @brief Gives consecutive IDs to all the products, from the first ID.
+   *
+   * Used for the text catalogs, that have no IDs.
+   *
+   * @param registeredProducts Map of product categories to vectors of Product objects.
+   * @return Next ID to give to a product.
+   */
+  static uint64_t assignProductIDs(
+      std::map<std::string, std::vector<Product>>& registeredProducts);
+  
+  /**
+   * @brief Reads product data from a text catalog.
    *
-   * Parses the given backup file to extract product categories, names, ingredients, prices, and image paths.
+   * Parses the given text file to extract product categories, names, ingredients, prices, and image paths.
+   * The file is read at once and tokenized in place with a TextScanner.
    *
-   * @param filename Path to the products backup file.
+   * @param filename Path to the products text file.
    * @param registeredProducts Map to store the parsed product data.
    *
    * @throws std::runtime_error If the file cannot be opened or read.
    */
-  void readProductsBackup(const std::string& filename
+  void readProductsText(const std::string& filename
       , std::map<std::string, std::vector<Product>>& registeredProducts);
   
   /**
    * @brief Reads supply data from the backup file.
    *
-   * Parses the supplies backup file and extracts supply details.
+   * Parses the supplies backup file and extracts supply details. Each line
+   * holds the name, that may have spaces, the quantity and the measure.
    *
    * @param supplies Vector to store the parsed Supply objects.
    *
@@ -150,7 +536,9 @@ private:
   /**
    * @brief Reads user data from the backup file.
    *
-   * Parses the users backup file (binary format) and extracts user details.
+   * Reads the whole users backup file into a buffer and decodes the framed
+   * user records, validating their checksums. Files in the legacy format are
+   * read with readLegacyUsersBackup() and rewritten in the current format.
    *
    * @param registeredUsers Vector to store the parsed User objects.
    *
@@ -158,35 +546,210 @@ private:
    */
   void readUsersBackup(std::vector<User>& registeredUsers);
   
-  void readReceiptsBackup(std::vector<Receipt>& registeredReceipts);
+  /**
+   * @brief Reads user data from a legacy backup file.
+   *
+   * Parses the users backup written before the versioned format, that stores
+   * the users quantity followed by every user.
+   *
+   * @param registeredUsers Vector to store the parsed User objects.
+   *
+   * @throws std::runtime_error If a user cannot be read.
+   */
+  void readLegacyUsersBackup(std::vector<User>& registeredUsers);
   
   /**
-   * @brief Writes product data to the backup file.
+   * @brief Opens the receipts journal and its archive.
+   *
+   * Creates the receipts directory if needed and imports the legacy receipts
+   * backup the first time the journal is created. The journal is compacted
+   * when the last session left a damaged tail.
+   *
+   * @throws std::runtime_error If the journal cannot be created or opened.
+   */
+  void openReceiptJournal();
+  
+  /**
+   * @brief Hands the pending merge of the receipt search postings to the
+   * persistence worker.
+   */
+  void startSearchMerge();
+  
+  /**
+   * @brief Reads receipt data from the legacy backup file.
+   *
+   * Parses the legacy receipts backup, that stores the receipts quantity
+   * followed by every receipt.
+   *
+   * @param registeredReceipts Vector to store the parsed Receipt objects.
    *
-   * Saves the provided product data in the appropriate format to the backup file.
+   * @throws std::runtime_error If a receipt cannot be read.
+   */
+  void readLegacyReceiptsBackup(std::vector<Receipt>& registeredReceipts);
+  
+  /**
+   * @brief Encodes the products catalog.
+   *
+   * Only reads the products, so it runs in any thread. Their images are
+   * staged apart, by the thread that owns them.
    *
-   * @param filename Path to the backup file.
    * @param registeredProducts Map of product categories to vectors of Product objects.
+   * @param nextProductID Next ID to give to a product.
+   * @return Bytes of the catalog snapshot.
+   */
+  static std::string encodeProductsBackup(
+      const std::map<std::string, std::vector<Product>>& registeredProducts
+      , const uint64_t nextProductID);
+  
+  /**
+   * @brief Encodes the products in the text catalog format.
    *
-   * @throws std::runtime_error If the file cannot be opened for writing.
+   * @param registeredProducts Map of product categories to vectors of Product objects.
+   * @return Text of the catalog.
    */
-  void writeProductsBackup(const std::string& filename, const std::map<std::string, std::vector<Product>>& registeredProducts);
+  static std::string encodeProductsText(
+      const std::map<std::string, std::vector<Product>>& registeredProducts);
   
   /**
-   * @brief Writes supply data to the backup file.
+   * @brief Gets the file name of a product image.
    *
-   * Saves the provided supply data to the supplies backup file.
+   * @param product The product.
+   * @return Name of the product without blank spaces and with png extension.
+   */
+  static std::string productImageName(const Product& product);
+  
+  /**
+   * @brief Stages a product image if it changed.
+   *
+   * An image is unchanged if it's the last one staged for its file, or the
+   * one loaded from its file, that the ImageStore remembers.
+   *
+   * @param image ID of the product image in the ImageStore.
+   * @param imageName File name of the image.
+   */
+  void stageProductImage(const ImageStore::ImageID image
+      , const std::string& imageName);
+  
+  /**
+   * @brief Writes product data to the backup file.
+   *
+   * Writes the staged product images and the catalog snapshot, if it
+   * changed.
+   *
+   * @param filename Path to the catalog snapshot.
+   * @param catalog Bytes of the catalog snapshot.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  void writeProductsBackup(const std::string& filename
+      , const std::string& catalog);
+  
+  /**
+   * @brief Writes a product image if it changed since it was last written.
+   *
+   * Compares the hash of its pixels with the last written one, so unchanged
+   * images are never encoded again.
+   *
+   * @param image The product image.
+   * @param directory Directory of the product images.
+   * @param imageName File name of the image.
+   * @return True if the image was written.
+   */
+  bool writeProductImage(const QImage& image, const std::string& directory
+      , const std::string& imageName);
+  
+  /**
+   * @brief Writes the pending sales as new runs of their days.
+   *
+   * The runs of the days before today are merged into their segments, so
+   * each day is merged once.
+   *
+   * @throws std::runtime_error If a segment cannot be written.
+   */
+  void writeSalesBackup();
+  
+  /**
+   * @brief Merges the runs of the closed days into their segments.
+   *
+   * @throws std::runtime_error If a segment cannot be written.
+   */
+  void compactSalesBackup();
+  
+  /**
+   * @brief Writes the sales totals of a day.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param totals Totals of the day.
+   *
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  void writeSalesRollup(const std::string& day
+      , const SalesRollups::Totals& totals);
+  
+  /**
+   * @brief Opens the change log, creating its directory if needed.
+   * @param visitor Receives every logged change.
+   */
+  void openModelLog(const CommandLog::Visitor& visitor);
+  
+  /**
+   * @brief Encodes the record of a change for the log.
+   *
+   * Runs in the calling thread, stages the changed product images and writes
+   * them in the worker.
+   *
+   * @param command The change.
+   * @return Bytes of the record.
+   */
+  std::string encodeModelRecord(const ModelCommand& command);
+  
+  /**
+   * @brief Appends a record to the change log without flushing it.
+   *
+   * Runs in the worker, that is the only writer of the log after the start.
+   *
+   * @param record Bytes of the record.
+   *
+   * @throws std::runtime_error If the change log cannot be written.
+   */
+  void appendModelRecord(const std::string& record);
+  
+  /**
+   * @brief Gets the snapshot file of a register.
+   * @param index Index of the register, its bit in ModelSnapshot::Register.
+   * @return Path to the snapshot file.
+   */
+  const std::string& snapshotFile(const size_t index) const;
+  
+  /**
+   * @brief Writes the product images staged since the last write.
+   * @param directory Directory of the product images.
+   */
+  void writeStagedImages(const std::string& directory);
+  
+  /**
+   * @brief Encodes supply data as the content of the backup file.
    *
    * @param supplies Vector of Supply objects to be written.
+   * @return Text of the supplies backup.
+   */
+  static std::string encodeSuppliesBackup(const std::vector<Supply>& supplies);
+  
+  /**
+   * @brief Encodes user data as the content of the backup file.
    *
-   * @throws std::runtime_error If the file cannot be opened for writing.
+   * The file has a versioned header and one checksummed record per user.
+   *
+   * @param users Vector of User objects to be written.
+   * @return Bytes of the users backup.
    */
-  void writeSuppliesBackup(const std::vector<Supply>& supplies);
+  static std::string encodeUsersBackup(const std::vector<User>& users);
   
   /**
    * @brief Writes user data to the backup file in binary format.
    *
-   * Saves the provided user data to the users backup file.
+   * Saves the provided user data to the users backup file, with a versioned
+   * header and one checksummed record per user.
    *
    * @param users Vector of User objects to be written.
    *
@@ -194,9 +757,6 @@ private:
    */
   void writeUsersBackup(const std::vector<User>& users);
   
-  void writeReceiptsBackup(const int lastReceiptID
-      , const std::vector<Receipt>& receipts);
-  
   // Copy and assignment constructors are disabled.
   BackupModule(const BackupModule&) = delete;
   BackupModule& operator=(const BackupModule&) = delete;
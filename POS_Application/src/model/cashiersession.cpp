@@ -0,0 +1,114 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "cashiersession.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+
+void CashierSession::open(const std::string_view openedBy
+    , const int64_t timestamp, const size_t firstReceipt, const Money cash) {
+  // Starts from an empty session.
+  this->close();
+  this->opened = true;
+  this->user = std::string(openedBy);
+  this->openedAt = timestamp;
+  this->openingCash = cash;
+  this->firstReceiptID = firstReceipt;
+}
+
+void CashierSession::close() {
+  this->opened = false;
+  this->user.clear();
+  this->openedAt = 0;
+  this->openingCash = Money();
+  this->firstReceiptID = 0;
+  this->receiptCount = 0;
+  std::fill(std::begin(this->totals), std::end(this->totals), Money());
+  this->expenses.clear();
+  this->expensesTotal = Money();
+}
+
+void CashierSession::addReceipt(const Receipt& receipt) {
+  // Adds the receipt to the total of its payment method.
+  this->totals[receipt.getPaymentMethodCode()] += receipt.getPrice();
+  ++this->receiptCount;
+}
+
+void CashierSession::addExpense(const Expense& expense) {
+  this->expenses.push_back(expense);
+  this->expensesTotal += expense.amount;
+}
+
+Money CashierSession::getSalesTotal() const {
+  Money total;
+  for (const Money methodTotal : this->totals) {
+    total += methodTotal;
+  }
+  return total;
+}
+
+Money CashierSession::getCashInRegister() const {
+  return this->openingCash + this->totals[Receipt::PAYMENT_CASH]
+      - this->expensesTotal;
+}
+
+Money CashierSession::getBalance() const {
+  return this->openingCash + this->getSalesTotal() - this->expensesTotal;
+}
+
+void CashierSession::encode(BinaryWriter& writer) const {
+  // Writes out the opening of the session.
+  writer.writeU8(this->opened ? 1 : 0);
+  writer.writeString(this->user);
+  writer.writeU64(static_cast<uint64_t>(this->openedAt));
+  writer.writeMoney(this->openingCash);
+  writer.writeU64(this->firstReceiptID);
+  // Writes out each expense.
+  writer.writeU32(static_cast<uint32_t>(this->expenses.size()));
+  for (const Expense& expense : this->expenses) {
+    writer.writeString(expense.name);
+    writer.writeU64(static_cast<uint64_t>(expense.timestamp));
+    writer.writeMoney(expense.amount);
+  }
+}
+
+bool CashierSession::decode(BinaryReader& reader) {
+  uint8_t sessionOpened = 0;
+  std::string sessionUser;
+  uint64_t sessionOpenedAt = 0;
+  Money cash;
+  uint64_t firstReceipt = 0;
+  uint32_t numExpenses = 0;
+  // Reads the opening of the session.
+  reader.readU8(sessionOpened);
+  reader.readString(sessionUser, MAX_NAME_LENGTH);
+  reader.readU64(sessionOpenedAt);
+  reader.readMoney(cash);
+  reader.readU64(firstReceipt);
+  // Each expense takes at least its name length, time and amount.
+  reader.readCount(numExpenses, 20);
+  std::vector<Expense> sessionExpenses;
+  sessionExpenses.reserve(reader.isValid() ? numExpenses : 0);
+  for (uint32_t i = 0; reader.isValid() && i < numExpenses; ++i) {
+    Expense expense;
+    uint64_t timestamp = 0;
+    reader.readString(expense.name, MAX_NAME_LENGTH);
+    reader.readU64(timestamp);
+    reader.readMoney(expense.amount);
+    expense.timestamp = static_cast<int64_t>(timestamp);
+    sessionExpenses.push_back(expense);
+  }
+  // Any failed read invalidates the whole session.
+  if (!reader.isValid()) {
+    return false;
+  }
+  this->open(sessionUser, static_cast<int64_t>(sessionOpenedAt)
+      , firstReceipt, cash);
+  this->opened = sessionOpened != 0;
+  for (const Expense& expense : sessionExpenses) {
+    this->addExpense(expense);
+  }
+  return true;
+}
@@ -0,0 +1,181 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef CASHIERSESSION_H
+#define CASHIERSESSION_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "money.h"
+#include "receipt.h"
+
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * @class CashierSession
+ * @brief State and running totals of the opened cashier.
+ *
+ * The totals by payment method are updated as each receipt and expense is
+ * added, so showing or closing the cashier never scans the receipts. The
+ * session is saved after every change to survive a restart in the middle of
+ * a shift. Its receipts are not saved with it, they are already in the
+ * receipts journal and are added again when the session is restored.
+ */
+class CashierSession {
+public:
+  static const uint32_t SESSION_MAGIC = 0x48534143;  ///< "CASH" in the file.
+  static const uint32_t SESSION_VERSION = 1;         ///< Session version.
+  static const uint32_t MAX_SESSION_SIZE = 16u * 1024u * 1024u; ///< Record.
+  static const uint32_t MAX_NAME_LENGTH = 1024;  ///< Users and expenses.
+  /// Cash in the register when the cashier is opened.
+  static constexpr Money OPENING_CASH = Money::fromCents(3000000);
+
+  /**
+   * @struct Expense
+   * @brief Money taken from the cashier during the session.
+   */
+  struct Expense {
+    std::string name;       ///< Description of the expense.
+    int64_t timestamp = 0;  ///< Date and time, in seconds since the epoch.
+    Money amount;           ///< Amount of the expense.
+  };
+
+private:
+  bool opened = false;        ///< Flag indicating if the cashier is opened.
+  std::string user;           ///< User that opened the cashier.
+  int64_t openedAt = 0;       ///< Opening time, in seconds since the epoch.
+  Money openingCash;          ///< Cash in the register when it was opened.
+  size_t firstReceiptID = 0;  ///< ID of the first receipt of the session.
+  size_t receiptCount = 0;    ///< Receipts added to the session.
+  /// Sum of the receipts by payment method, indexed by its code.
+  Money totals[Receipt::PAYMENT_METHOD_COUNT];
+  std::vector<Expense> expenses;  ///< Expenses of the session.
+  Money expensesTotal;        ///< Sum of the expenses.
+
+public:
+  /**
+   * @brief Opens a new session, forgetting the previous one.
+   *
+   * @param openedBy Name of the user that opens the cashier.
+   * @param timestamp Opening time, in seconds since the epoch.
+   * @param firstReceipt ID of the first receipt of the session.
+   * @param cash Cash in the register.
+   */
+  void open(const std::string_view openedBy, const int64_t timestamp
+      , const size_t firstReceipt, const Money cash = OPENING_CASH);
+
+  /**
+   * @brief Closes the session and clears its totals.
+   */
+  void close();
+
+  /**
+   * @brief Adds a receipt to the total of its payment method.
+   * @param receipt The receipt.
+   */
+  void addReceipt(const Receipt& receipt);
+
+  /**
+   * @brief Adds an expense to the session.
+   * @param expense The expense.
+   */
+  void addExpense(const Expense& expense);
+
+  /**
+   * @brief Checks if the cashier is opened.
+   * @return True if the session is opened.
+   */
+  bool isOpen() const { return this->opened; }
+
+  /**
+   * @brief Gets the user that opened the cashier.
+   * @return Name of the user.
+   */
+  const std::string& getUser() const { return this->user; }
+
+  /**
+   * @brief Gets the opening time.
+   * @return Seconds since the epoch.
+   */
+  int64_t getOpenedAt() const { return this->openedAt; }
+
+  /**
+   * @brief Gets the cash in the register when it was opened.
+   * @return The opening cash.
+   */
+  Money getOpeningCash() const { return this->openingCash; }
+
+  /**
+   * @brief Gets the ID of the first receipt of the session.
+   * @return ID of the receipt.
+   */
+  size_t getFirstReceiptID() const { return this->firstReceiptID; }
+
+  /**
+   * @brief Gets the number of receipts of the session.
+   * @return Number of receipts.
+   */
+  size_t getReceiptCount() const { return this->receiptCount; }
+
+  /**
+   * @brief Gets the sum of the receipts paid with a payment method.
+   * @param method Code of the payment method.
+   * @return The total of the payment method.
+   */
+  Money getTotal(const Receipt::PaymentMethod method) const {
+    return this->totals[method];
+  }
+
+  /**
+   * @brief Gets the sum of all the receipts.
+   * @return The total of the sales.
+   */
+  Money getSalesTotal() const;
+
+  /**
+   * @brief Gets the expenses of the session.
+   * @return The expenses, in the order they were added.
+   */
+  const std::vector<Expense>& getExpenses() const { return this->expenses; }
+
+  /**
+   * @brief Gets the sum of the expenses.
+   * @return The total of the expenses.
+   */
+  Money getExpensesTotal() const { return this->expensesTotal; }
+
+  /**
+   * @brief Gets the cash that should be in the register.
+   * @return Opening cash plus the cash sales minus the expenses.
+   */
+  Money getCashInRegister() const;
+
+  /**
+   * @brief Gets the balance of the cashier.
+   * @return Opening cash plus all the sales minus the expenses.
+   */
+  Money getBalance() const;
+
+  /**
+   * @brief Encodes the session in the portable binary format of the backups.
+   *
+   * The totals of the receipts are not encoded.
+   *
+   * @param writer Writer where the session is encoded.
+   */
+  void encode(BinaryWriter& writer) const;
+
+  /**
+   * @brief Decodes a session written by encode().
+   *
+   * The receipts of the session must be added again after decoding it.
+   *
+   * @param reader Reader positioned at the session.
+   * @return True if the session was complete and valid.
+   */
+  bool decode(BinaryReader& reader);
+};
+
+#endif // CASHIERSESSION_H
@@ -0,0 +1,155 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "commandlog.h"
+
+#include <QDebug>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+#include "durablewriter.h"
+
+CommandLog::CommandLog(const std::string& logFile
+    , const std::string& checkpointFile)
+    : filename(logFile)
+    , checkpointFilename(checkpointFile) {
+}
+
+void CommandLog::open(const Visitor& visitor) {
+  this->file.close();
+  // Creates an empty log the first time.
+  if (!std::filesystem::exists(this->filename)) {
+    DurableWriter::writeFile(this->filename, encodeHeader(0));
+  }
+  std::ifstream input(this->filename, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(input))
+      , std::istreambuf_iterator<char>());
+  input.close();
+
+  // Validates the header.
+  BinaryReader reader(content.data(), content.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint64_t baseSequence = 0;
+  reader.readU32(magic);
+  reader.readU32(version);
+  reader.readU64(baseSequence);
+  if (!reader.isValid() || magic != LOG_MAGIC || version != VERSION) {
+    throw std::runtime_error("No es un registro de cambios: "
+        + this->filename);
+  }
+
+  // Visits the records until the first damaged one.
+  this->lastSequence = baseSequence;
+  this->commandCount = 0;
+  size_t dataEnd = HEADER_SIZE;
+  BinaryReader record(nullptr, 0);
+  while (!reader.atEnd()) {
+    uint64_t sequence = 0;
+    if (!reader.readFrame(record, MAX_RECORD_SIZE)
+        || !record.readU64(sequence) || sequence <= this->lastSequence) {
+      break;
+    }
+    visitor(sequence, record);
+    this->lastSequence = sequence;
+    ++this->commandCount;
+    dataEnd = content.size() - reader.remaining();
+  }
+  // Cuts off the tail that a crash left half written.
+  if (dataEnd < content.size()) {
+    qDebug() << "Se descartaron" << content.size() - dataEnd
+        << "bytes danados del registro de cambios.";
+    std::filesystem::resize_file(this->filename, dataEnd);
+  }
+
+  this->file.open(this->filename, std::ios::binary | std::ios::app);
+  if (!this->file) {
+    throw std::runtime_error("No se pudo abrir el archivo: "
+        + this->filename);
+  }
+}
+
+uint64_t CommandLog::append(const std::string& command) {
+  if (!this->file.is_open()) {
+    throw std::runtime_error("El registro de cambios no esta abierto: "
+        + this->filename);
+  }
+  // Writes the record with its sequence number.
+  BinaryWriter payload;
+  payload.writeU64(this->lastSequence + 1);
+  std::string bytes = payload.take();
+  bytes += command;
+  BinaryWriter record;
+  record.writeFrame(bytes);
+  const std::string& frame = record.data();
+  if (!this->file.write(frame.data(), frame.size()) || !this->file.flush()) {
+    throw std::runtime_error("No se pudo escribir en el archivo: "
+        + this->filename);
+  }
+  ++this->commandCount;
+  return ++this->lastSequence;
+}
+
+void CommandLog::reset() {
+  // Replaces the log by an empty one that continues the sequence, the
+  // stream must be opened again on the new file.
+  this->file.close();
+  DurableWriter::writeFile(this->filename, encodeHeader(this->lastSequence));
+  this->commandCount = 0;
+  this->file.open(this->filename, std::ios::binary | std::ios::app);
+  if (!this->file) {
+    throw std::runtime_error("No se pudo abrir el archivo: "
+        + this->filename);
+  }
+}
+
+bool CommandLog::readCheckpoint(Checkpoint& checkpoint) const {
+  std::ifstream input(this->checkpointFilename, std::ios::binary);
+  if (!input) {
+    return false;
+  }
+  const std::string content((std::istreambuf_iterator<char>(input))
+      , std::istreambuf_iterator<char>());
+  // Validates the header and the checksum of the record.
+  BinaryReader reader(content.data(), content.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  reader.readU32(magic);
+  reader.readU32(version);
+  BinaryReader record(nullptr, 0);
+  if (!reader.isValid() || magic != CHECKPOINT_MAGIC || version != VERSION
+      || !reader.readFrame(record, 1024)) {
+    qDebug() << "El punto de control esta danado: "
+        << QString::fromStdString(this->checkpointFilename);
+    return false;
+  }
+  for (size_t index = 0; index < REGISTER_COUNT; ++index) {
+    record.readU64(checkpoint.sequences[index]);
+    record.readU32(checkpoint.checksums[index]);
+    record.readU64(checkpoint.previousSequences[index]);
+  }
+  return record.isValid() && record.atEnd();
+}
+
+std::string CommandLog::encodeCheckpoint(const Checkpoint& checkpoint) {
+  BinaryWriter writer;
+  BinaryWriter record;
+  writer.writeU32(CHECKPOINT_MAGIC);
+  writer.writeU32(VERSION);
+  for (size_t index = 0; index < REGISTER_COUNT; ++index) {
+    record.writeU64(checkpoint.sequences[index]);
+    record.writeU32(checkpoint.checksums[index]);
+    record.writeU64(checkpoint.previousSequences[index]);
+  }
+  writer.writeFrame(record.take());
+  return writer.take();
+}
+
+std::string CommandLog::encodeHeader(const uint64_t baseSequence) {
+  BinaryWriter header;
+  header.writeU32(LOG_MAGIC);
+  header.writeU32(VERSION);
+  header.writeU64(baseSequence);
+  return header.take();
+}
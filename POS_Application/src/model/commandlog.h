@@ -0,0 +1,158 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef COMMANDLOG_H
+#define COMMANDLOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+
+class BinaryReader;
+
+/**
+ * @class CommandLog
+ * @brief Append-only log of the changes of the model since its snapshots.
+ *
+ * The log file starts with a header holding the sequence number of the last
+ * command before the log, followed by one framed record per command (payload
+ * length, CRC32C and the payload: the sequence number of the command and its
+ * encoding). A change only appends its record, the snapshots of the registers
+ * are written at the checkpoints, and the log is emptied after them.
+ *
+ * The checkpoint file tells which commands each snapshot already holds. It's
+ * written before the snapshots with their checksums, so after a crash in the
+ * middle of a checkpoint a snapshot whose checksum matches holds the commands
+ * of the checkpoint, and any other still holds the commands of the previous
+ * one. Only the newer commands are replayed over each snapshot.
+ */
+class CommandLog {
+public:
+  static const uint32_t LOG_MAGIC = 0x4C434D50;        ///< "PMCL" in the file.
+  static const uint32_t CHECKPOINT_MAGIC = 0x4B434D50; ///< "PMCK" in the file.
+  static const uint32_t VERSION = 1;       ///< Format version.
+  static const size_t HEADER_SIZE = 16;    ///< Magic, version and base.
+  static const size_t REGISTER_COUNT = 3;  ///< Products, supplies and users.
+  /// Maximum size of a record, a category with all its products.
+  static const uint32_t MAX_RECORD_SIZE = 32u * 1024u * 1024u;
+
+  /**
+   * @struct Checkpoint
+   * @brief Commands held by the snapshot of each register.
+   */
+  struct Checkpoint {
+    /// Last command held by the snapshot written by the checkpoint.
+    uint64_t sequences[REGISTER_COUNT] = {};
+    /// CRC32C of the snapshot written by the checkpoint.
+    uint32_t checksums[REGISTER_COUNT] = {};
+    /// Last command held by the snapshot that it replaced.
+    uint64_t previousSequences[REGISTER_COUNT] = {};
+  };
+
+  /// Receives the sequence number and the encoding of each logged command.
+  typedef std::function<void(uint64_t, BinaryReader&)> Visitor;
+
+private:
+  std::string filename;            ///< Path to the log file.
+  std::string checkpointFilename;  ///< Path to the checkpoint file.
+  std::ofstream file;              ///< Log file, opened to append.
+  uint64_t lastSequence = 0;       ///< Sequence of the last command.
+  size_t commandCount = 0;         ///< Commands in the log.
+
+public:
+  /**
+   * @brief Constructs a log bound to the given files.
+   *
+   * The files are not touched until the log is opened.
+   *
+   * @param logFile Path to the log file.
+   * @param checkpointFile Path to the checkpoint file.
+   */
+  CommandLog(const std::string& logFile, const std::string& checkpointFile);
+
+  /**
+   * @brief Opens the log, creating it if it does not exist, and reads it.
+   *
+   * A damaged tail, left by a crash in the middle of an append, is cut off.
+   *
+   * @param visitor Receives every valid command, in order.
+   *
+   * @throws std::runtime_error If the file cannot be created or is not a
+   *     command log.
+   */
+  void open(const Visitor& visitor);
+
+  /**
+   * @brief Checks if the log is opened.
+   * @return True if the log is opened.
+   */
+  bool isOpen() const { return this->file.is_open(); }
+
+  /**
+   * @brief Appends a command at the end of the log.
+   *
+   * The record is handed to the operating system, the caller flushes the
+   * file to the disk.
+   *
+   * @param command Encoding of the command.
+   * @return Sequence number of the command.
+   *
+   * @throws std::runtime_error If the log is not opened or cannot be written.
+   */
+  uint64_t append(const std::string& command);
+
+  /**
+   * @brief Empties the log after all its commands are in the snapshots.
+   *
+   * @throws std::runtime_error If the log cannot be written.
+   */
+  void reset();
+
+  /**
+   * @brief Gets the sequence number of the last command.
+   * @return The sequence number, 0 if no command was ever logged.
+   */
+  uint64_t getLastSequence() const { return this->lastSequence; }
+
+  /**
+   * @brief Gets the number of commands since the last reset.
+   * @return Commands in the log.
+   */
+  size_t getCommandCount() const { return this->commandCount; }
+
+  /**
+   * @brief Reads the checkpoint file.
+   *
+   * @param checkpoint Where the checkpoint is stored.
+   * @return True if there's a valid checkpoint.
+   */
+  bool readCheckpoint(Checkpoint& checkpoint) const;
+
+  /**
+   * @brief Encodes a checkpoint as the content of the checkpoint file.
+   * @param checkpoint The checkpoint.
+   * @return Bytes of the checkpoint file.
+   */
+  static std::string encodeCheckpoint(const Checkpoint& checkpoint);
+
+  /**
+   * @brief Gets the path of the checkpoint file.
+   * @return Path to the checkpoint file.
+   */
+  const std::string& getCheckpointFilename() const {
+    return this->checkpointFilename;
+  }
+
+private:
+  /**
+   * @brief Encodes the header of the log.
+   * @param baseSequence Sequence of the last command before the log.
+   * @return Bytes of the header.
+   */
+  static std::string encodeHeader(const uint64_t baseSequence);
+
+  // Copy and assignment constructors are disabled.
+  CommandLog(const CommandLog&) = delete;
+  CommandLog& operator=(const CommandLog&) = delete;
+};
+
+#endif // COMMANDLOG_H
@@ -0,0 +1,181 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "imagestore.h"
+
+#include <QString>
+
+ImageStore::ImageStore() {
+  this->metrics.capacity = DEFAULT_CAPACITY;
+}
+
+ImageStore& ImageStore::getInstance() {
+  // Creates an static instance of the class to avoid duplication.
+  static ImageStore instance;
+  return instance;
+}
+
+ImageStore::ImageID ImageStore::addFile(const std::string& path) {
+  if (path.empty()) {
+    return NO_IMAGE;
+  }
+  // Reuses the ID of a file that was already added.
+  this->indexFiles();
+  const auto found = this->filePaths.find(path);
+  if (found != this->filePaths.end()) {
+    return found->second;
+  }
+  // Only remembers the path, the image is decoded when it's needed.
+  this->entries.emplace_back().path = path;
+  this->indexedEntries = this->entries.size();
+  this->filePaths.emplace(path, this->entries.size());
+  return this->entries.size();
+}
+
+void ImageStore::addFiles(const std::string& directory
+    , const std::vector<std::string_view>& names
+    , std::vector<ImageID>& ids) {
+  ids.resize(names.size());
+  this->entries.reserve(this->entries.size() + names.size());
+  for (size_t index = 0; index < names.size(); ++index) {
+    if (names[index].empty()) {
+      ids[index] = NO_IMAGE;
+      continue;
+    }
+    // Only appends the entry, its path is indexed by the next lookup.
+    std::string& path = this->entries.emplace_back().path;
+    path.reserve(directory.size() + names[index].size());
+    path += directory;
+    path += names[index];
+    ids[index] = this->entries.size();
+  }
+}
+
+ImageStore::ImageID ImageStore::findFile(const std::string& path) {
+  this->indexFiles();
+  const auto found = this->filePaths.find(path);
+  return found == this->filePaths.end() ? NO_IMAGE : found->second;
+}
+
+ImageStore::ImageID ImageStore::addPixmap(const QPixmap& pixmap) {
+  if (pixmap.isNull()) {
+    return NO_IMAGE;
+  }
+  // Keeps the pixmap outside of the LRU list, it can't be decoded again.
+  this->entries.emplace_back().pixmap = pixmap;
+  return this->entries.size();
+}
+
+void ImageStore::forgetFile(const std::string& path) {
+  this->indexFiles();
+  const auto found = this->filePaths.find(path);
+  if (found == this->filePaths.end()) {
+    return;
+  }
+  // Drops the decoded image, the old IDs decode the new content if used.
+  Entry& entry = this->entries[found->second - 1];
+  if (entry.cached) {
+    this->uncache(entry);
+  }
+  entry.missing = false;
+  this->filePaths.erase(found);
+}
+
+QPixmap ImageStore::getPixmap(const ImageID id) {
+  const ImageID entryID = this->resolve(id);
+  if (entryID == NO_IMAGE) {
+    return QPixmap();
+  }
+  Entry& entry = this->entries[entryID - 1];
+  // Images only in memory are always available.
+  if (entry.path.empty()) {
+    return entry.pixmap;
+  }
+  // Moves a cached image to the front of the LRU list.
+  if (entry.cached) {
+    ++this->metrics.hits;
+    this->recentlyUsed.splice(this->recentlyUsed.begin(), this->recentlyUsed
+        , entry.position);
+    return entry.pixmap;
+  }
+  // A file that could not be decoded is not tried again.
+  ++this->metrics.misses;
+  if (entry.missing) {
+    return QPixmap();
+  }
+  // Decodes the image and adds it to the cache.
+  const QPixmap pixmap(QString::fromStdString(entry.path));
+  if (pixmap.isNull()) {
+    entry.missing = true;
+    return pixmap;
+  }
+  entry.pixmap = pixmap;
+  entry.bytes = static_cast<size_t>(pixmap.width())
+      * static_cast<size_t>(pixmap.height())
+      * static_cast<size_t>(pixmap.depth() / 8);
+  entry.cached = true;
+  this->recentlyUsed.push_front(entryID);
+  entry.position = this->recentlyUsed.begin();
+  ++this->metrics.cachedImages;
+  this->metrics.cachedBytes += entry.bytes;
+  this->evict();
+  return pixmap;
+}
+
+std::string ImageStore::getPath(const ImageID id) const {
+  const ImageID entryID = this->resolve(id);
+  return entryID == NO_IMAGE ? std::string()
+      : this->entries[entryID - 1].path;
+}
+
+void ImageStore::setCapacity(const size_t bytes) {
+  this->metrics.capacity = bytes;
+  this->evict();
+}
+
+ImageStore::Metrics ImageStore::getMetrics() const {
+  return this->metrics;
+}
+
+void ImageStore::indexFiles() {
+  for (; this->indexedEntries < this->entries.size()
+      ; ++this->indexedEntries) {
+    Entry& entry = this->entries[this->indexedEntries];
+    if (entry.path.empty()) {
+      continue;
+    }
+    const auto [found, added] = this->filePaths.emplace(entry.path
+        , this->indexedEntries + 1);
+    if (!added) {
+      // A file added twice shows the image of its first entry.
+      if (entry.cached) {
+        this->uncache(entry);
+      }
+      entry.sameFile = found->second;
+    }
+  }
+}
+
+ImageStore::ImageID ImageStore::resolve(const ImageID id) const {
+  if (id == NO_IMAGE || id > this->entries.size()) {
+    return NO_IMAGE;
+  }
+  const ImageID sameFile = this->entries[id - 1].sameFile;
+  return sameFile == NO_IMAGE ? id : sameFile;
+}
+
+void ImageStore::uncache(Entry& entry) {
+  this->recentlyUsed.erase(entry.position);
+  this->metrics.cachedBytes -= entry.bytes;
+  --this->metrics.cachedImages;
+  entry.pixmap = QPixmap();
+  entry.bytes = 0;
+  entry.cached = false;
+}
+
+void ImageStore::evict() {
+  // Always keeps the most recent image, even if it's bigger than the limit.
+  while (this->metrics.cachedBytes > this->metrics.capacity
+      && this->recentlyUsed.size() > 1) {
+    this->uncache(this->entries[this->recentlyUsed.back() - 1]);
+    ++this->metrics.evictions;
+  }
+}
@@ -0,0 +1,194 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef IMAGESTORE_H
+#define IMAGESTORE_H
+
+#include <QPixmap>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ImageStore
+ * @brief Central owner of the product images.
+ *
+ * The products only keep the ID of their image. The images stored in a file
+ * are decoded the first time they are painted and kept in a cache bounded by
+ * its size in bytes, that drops the least recently used ones. The files of a
+ * whole catalog are added at once, and their paths are only indexed when a
+ * file is first looked up by its path. The images
+ * that only exist in memory, like the ones picked by the user before the
+ * backup writes them, are always kept.
+ *
+ * The pixmaps can only be used in the GUI thread, so this class too.
+ */
+class ImageStore {
+public:
+  typedef uint64_t ImageID;           ///< Handle of an image in the store.
+  static const ImageID NO_IMAGE = 0;  ///< Handle of a missing image.
+  /// Default size limit of the decoded images.
+  static const size_t DEFAULT_CAPACITY = 64u * 1024u * 1024u;
+
+  /**
+   * @struct Metrics
+   * @brief Counters of the image cache.
+   */
+  struct Metrics {
+    uint64_t hits = 0;       ///< Requests served from the cache.
+    uint64_t misses = 0;     ///< Requests that decoded the image.
+    uint64_t evictions = 0;  ///< Decoded images dropped from the cache.
+    size_t cachedImages = 0; ///< Decoded images in the cache.
+    size_t cachedBytes = 0;  ///< Bytes of the decoded images in the cache.
+    size_t capacity = 0;     ///< Size limit of the cache.
+  };
+
+private:
+  /**
+   * @struct Entry
+   * @brief Source and decoded pixmap of an image.
+   */
+  struct Entry {
+    std::string path;       ///< File of the image, empty if only in memory.
+    QPixmap pixmap;         ///< Decoded image, null if not cached.
+    size_t bytes = 0;       ///< Size of the decoded image.
+    bool cached = false;    ///< True if the image is in the LRU list.
+    bool missing = false;   ///< True if the file could not be decoded.
+    ImageID sameFile = NO_IMAGE; ///< Entry used instead, of the same file.
+    std::list<ImageID>::iterator position; ///< Position in the LRU list.
+  };
+
+  std::vector<Entry> entries;       ///< Images, the ID is the index plus 1.
+  std::unordered_map<std::string, ImageID> filePaths; ///< IDs of files.
+  size_t indexedEntries = 0;        ///< Entries whose paths are indexed.
+  std::list<ImageID> recentlyUsed;  ///< Cached file images, most recent first.
+  Metrics metrics;                  ///< Counters of the cache.
+
+  /**
+   * @brief Constructs the store with the default capacity.
+   */
+  ImageStore();
+
+public:
+  /**
+   * @brief Gets the singleton instance of the ImageStore.
+   * @return Reference to the static ImageStore instance.
+   */
+  static ImageStore& getInstance();
+
+  /**
+   * @brief Adds an image stored in a file, without decoding it.
+   *
+   * The same file always gets the same ID.
+   *
+   * @param path Path of the image file.
+   * @return ID of the image.
+   */
+  ImageID addFile(const std::string& path);
+
+  /**
+   * @brief Adds the image files of a catalog, without decoding them.
+   *
+   * Only appends the entries of the files, their paths are indexed the next
+   * time a file is looked up by its path. A file that was already added gets
+   * a new ID, that shows the same image as its first one.
+   *
+   * @param directory Directory of the images, with its separator.
+   * @param names Names of the image files, an empty name gets NO_IMAGE.
+   * @param ids Where the IDs are stored, in the order of the names.
+   */
+  void addFiles(const std::string& directory
+      , const std::vector<std::string_view>& names
+      , std::vector<ImageID>& ids);
+
+  /**
+   * @brief Gets the ID of a file that was already added.
+   *
+   * @param path Path of the image file.
+   * @return ID of the image, or NO_IMAGE if the file was not added.
+   */
+  ImageID findFile(const std::string& path);
+
+  /**
+   * @brief Adds an image that only exists in memory.
+   *
+   * @param pixmap The image, it's kept until the program finishes.
+   * @return ID of the image, or NO_IMAGE if the pixmap is null.
+   */
+  ImageID addPixmap(const QPixmap& pixmap);
+
+  /**
+   * @brief Stops reusing the ID of a file that is going to be replaced.
+   *
+   * The next time the file is added it gets a new ID, decoded from its new
+   * content.
+   *
+   * @param path Path of the image file.
+   */
+  void forgetFile(const std::string& path);
+
+  /**
+   * @brief Gets an image, decoding it if it's not cached.
+   *
+   * @param id ID of the image.
+   * @return The image, or a null pixmap if it doesn't exist.
+   */
+  QPixmap getPixmap(const ImageID id);
+
+  /**
+   * @brief Gets the file of an image.
+   *
+   * @param id ID of the image.
+   * @return Path of the image, empty if it's only in memory.
+   */
+  std::string getPath(const ImageID id) const;
+
+  /**
+   * @brief Sets the size limit of the decoded images.
+   *
+   * Drops the least recently used images until they fit.
+   *
+   * @param bytes New limit in bytes.
+   */
+  void setCapacity(const size_t bytes);
+
+  /**
+   * @brief Gets a copy of the cache counters.
+   * @return The current metrics.
+   */
+  Metrics getMetrics() const;
+
+private:
+  /**
+   * @brief Indexes the paths of the files added since the last lookup.
+   */
+  void indexFiles();
+
+  /**
+   * @brief Gets the entry that holds an image.
+   *
+   * @param id ID of the image.
+   * @return ID of the entry used for the image, or NO_IMAGE if it doesn't
+   *     exist.
+   */
+  ImageID resolve(const ImageID id) const;
+
+  /**
+   * @brief Drops the decoded image of an entry from the cache.
+   *
+   * @param entry The entry, it must be cached.
+   */
+  void uncache(Entry& entry);
+
+  /**
+   * @brief Drops the least recently used images until the cache fits.
+   */
+  void evict();
+
+  // Copy and assignment constructors are disabled.
+  ImageStore(const ImageStore&) = delete;
+  ImageStore& operator=(const ImageStore&) = delete;
+};
+
+#endif // IMAGESTORE_H
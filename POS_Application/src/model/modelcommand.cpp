@@ -0,0 +1,192 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "modelcommand.h"
+
+#include <utility>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+
+uint8_t ModelCommand::getRegister() const {
+  switch (this->type) {
+    case ADD_SUPPLY:
+    case REMOVE_SUPPLY:
+    case EDIT_SUPPLY:
+    case DEDUCT_SUPPLIES:
+      return ModelSnapshot::SUPPLIES;
+    case ADD_USER:
+    case REMOVE_USER:
+    case EDIT_USER:
+      return ModelSnapshot::USERS;
+    default:
+      return ModelSnapshot::PRODUCTS;
+  }
+}
+
+ModelCommand ModelCommand::inverse() const {
+  ModelCommand inverse = *this;
+  switch (this->type) {
+    // The additions and removals undo each other with the same data.
+    case ADD_PRODUCT: inverse.type = REMOVE_PRODUCT; break;
+    case REMOVE_PRODUCT: inverse.type = ADD_PRODUCT; break;
+    case ADD_CATEGORY: inverse.type = REMOVE_CATEGORY; break;
+    case REMOVE_CATEGORY: inverse.type = ADD_CATEGORY; break;
+    case ADD_SUPPLY: inverse.type = REMOVE_SUPPLY; break;
+    case REMOVE_SUPPLY: inverse.type = ADD_SUPPLY; break;
+    case ADD_USER: inverse.type = REMOVE_USER; break;
+    case REMOVE_USER: inverse.type = ADD_USER; break;
+    // The editions swap the old and the new data.
+    case EDIT_PRODUCT:
+      std::swap(inverse.category, inverse.newCategory);
+      std::swap(inverse.products[0], inverse.products[1]);
+      break;
+    case EDIT_CATEGORY:
+      std::swap(inverse.category, inverse.newCategory);
+      break;
+    case EDIT_SUPPLY:
+      std::swap(inverse.supplies[0], inverse.supplies[1]);
+      break;
+    case EDIT_USER:
+      std::swap(inverse.users[0], inverse.users[1]);
+      break;
+    default:
+      break;
+  }
+  return inverse;
+}
+
+std::string ModelCommand::describe() const {
+  static const char* const actions[TYPE_COUNT] = {
+    "", "Agregar el producto", "Eliminar el producto", "Editar el producto"
+    , "Agregar la categoria", "Eliminar la categoria", "Editar la categoria"
+    , "Agregar el suministro", "Eliminar el suministro"
+    , "Editar el suministro", "Agregar el usuario", "Eliminar el usuario"
+    , "Editar el usuario", "Descontar el suministro"
+  };
+  // Names the first changed item, or the category.
+  std::string item = this->category;
+  if (!this->products.empty() && this->type != ADD_CATEGORY
+      && this->type != REMOVE_CATEGORY) {
+    item = this->products[0].getName();
+  } else if (!this->supplies.empty()) {
+    item = this->supplies[0].getName();
+  } else if (!this->users.empty()) {
+    item = this->users[0].getUsername();
+  }
+  return std::string(actions[this->type]) + " \"" + item + "\"";
+}
+
+void ModelCommand::encode(BinaryWriter& writer
+    , const ImageNamer& imageName) const {
+  writer.writeU8(this->type);
+  writer.writeString(this->category);
+  writer.writeString(this->newCategory);
+  // Writes the products with their ingredients.
+  writer.writeU32(static_cast<uint32_t>(this->products.size()));
+  for (const Product& product : this->products) {
+    writer.writeU64(product.getID());
+    writer.writeString(product.getName());
+    writer.writeMoney(product.getPrice());
+    writer.writeString(imageName(product));
+    writer.writeU32(static_cast<uint32_t>(product.getIngredients().size()));
+    for (const Supply& ingredient : product.getIngredients()) {
+      writer.writeString(ingredient.getName());
+      writer.writeU64(ingredient.getQuantity());
+    }
+  }
+  // Writes the supplies.
+  writer.writeU32(static_cast<uint32_t>(this->supplies.size()));
+  for (const Supply& supply : this->supplies) {
+    writer.writeString(supply.getName());
+    writer.writeU64(supply.getQuantity());
+    writer.writeString(supply.getMeasure());
+  }
+  // Writes the users in their own format.
+  writer.writeU32(static_cast<uint32_t>(this->users.size()));
+  for (const User& user : this->users) {
+    user.encode(writer);
+  }
+}
+
+bool ModelCommand::decode(BinaryReader& reader
+    , const ImageLoader& loadImage) {
+  uint8_t commandType = 0;
+  if (!reader.readU8(commandType) || commandType < ADD_PRODUCT
+      || commandType >= TYPE_COUNT || !reader.readString(this->category)
+      || !reader.readString(this->newCategory)) {
+    return false;
+  }
+  this->type = static_cast<Type>(commandType);
+  // Reads the products, a product takes at least its fixed fields.
+  uint32_t productCount = 0;
+  if (!reader.readCount(productCount, 28)) {
+    return false;
+  }
+  this->products.clear();
+  this->products.reserve(productCount);
+  for (uint32_t product = 0; product < productCount; ++product) {
+    uint64_t productID = 0;
+    std::string name;
+    Money price;
+    std::string image;
+    uint32_t ingredientCount = 0;
+    if (!reader.readU64(productID) || !reader.readString(name)
+        || !reader.readMoney(price) || !reader.readString(image)
+        || !reader.readCount(ingredientCount, 12)) {
+      return false;
+    }
+    std::vector<Supply> ingredients;
+    ingredients.reserve(ingredientCount);
+    for (uint32_t ingredient = 0; ingredient < ingredientCount; ++ingredient) {
+      std::string ingredientName;
+      uint64_t quantity = 0;
+      if (!reader.readString(ingredientName) || !reader.readU64(quantity)) {
+        return false;
+      }
+      ingredients.emplace_back(ingredientName, quantity);
+    }
+    this->products.emplace_back(productID, name, std::move(ingredients)
+        , price, image.empty() ? ImageStore::NO_IMAGE : loadImage(image));
+  }
+  // Reads the supplies.
+  uint32_t supplyCount = 0;
+  if (!reader.readCount(supplyCount, 16)) {
+    return false;
+  }
+  this->supplies.clear();
+  this->supplies.reserve(supplyCount);
+  for (uint32_t supply = 0; supply < supplyCount; ++supply) {
+    std::string name;
+    uint64_t quantity = 0;
+    std::string measure;
+    if (!reader.readString(name) || !reader.readU64(quantity)
+        || !reader.readString(measure)) {
+      return false;
+    }
+    this->supplies.emplace_back(name, quantity, measure);
+  }
+  // Reads the users.
+  uint32_t userCount = 0;
+  if (!reader.readCount(userCount, 4)) {
+    return false;
+  }
+  this->users.assign(userCount, User());
+  for (User& user : this->users) {
+    if (!user.decode(reader)) {
+      return false;
+    }
+  }
+  // The editions need the old and the new item.
+  const size_t required = this->type == EDIT_PRODUCT
+      || this->type == EDIT_SUPPLY || this->type == EDIT_USER ? 2 : 1;
+  switch (this->getRegister()) {
+    case ModelSnapshot::PRODUCTS:
+      return this->type == ADD_CATEGORY || this->type == REMOVE_CATEGORY
+          || this->type == EDIT_CATEGORY
+          || this->products.size() == required;
+    case ModelSnapshot::SUPPLIES:
+      return this->type == DEDUCT_SUPPLIES ? !this->supplies.empty()
+          : this->supplies.size() == required;
+    default:
+      return this->users.size() == required;
+  }
+}
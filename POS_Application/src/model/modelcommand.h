@@ -0,0 +1,108 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef MODELCOMMAND_H
+#define MODELCOMMAND_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "imagestore.h"
+#include "modelsnapshot.h"
+#include "product.h"
+#include "supply.h"
+#include "user.h"
+
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * @struct ModelCommand
+ * @brief Change of the catalog, the supplies or the users of the model.
+ *
+ * Every change holds the complete data it replaced, so it can be inverted:
+ * a removal keeps the removed items, and an edition keeps the old and the new
+ * item. Applying the inverse of a command undoes it. The supplies deducted
+ * by a sale are logged too, so the stock can be recovered, but a sale is not
+ * undone from the inventory.
+ */
+struct ModelCommand {
+  /**
+   * @enum Type
+   * @brief Kinds of changes, also stored in the command log.
+   */
+  enum Type : uint8_t {
+    ADD_PRODUCT = 1,  ///< Adds products[0] to category.
+    REMOVE_PRODUCT,   ///< Removes products[0] from category.
+    EDIT_PRODUCT,     ///< Replaces products[0] of category by products[1].
+    ADD_CATEGORY,     ///< Adds category with the products, if any.
+    REMOVE_CATEGORY,  ///< Removes category, that held the products.
+    EDIT_CATEGORY,    ///< Renames category to newCategory.
+    ADD_SUPPLY,       ///< Adds supplies[0].
+    REMOVE_SUPPLY,    ///< Removes supplies[0].
+    EDIT_SUPPLY,      ///< Replaces supplies[0] by supplies[1].
+    ADD_USER,         ///< Adds users[0].
+    REMOVE_USER,      ///< Removes users[0].
+    EDIT_USER,        ///< Replaces users[0] by users[1].
+    /// Takes the quantity of each of supplies from the supply of its name.
+    DEDUCT_SUPPLIES,
+    TYPE_COUNT
+  };
+
+  /// Maximum size of an encoded command, a category with all its products.
+  static const uint32_t MAX_COMMAND_SIZE = 16u * 1024u * 1024u;
+
+  /// Gets the name of the image file of a product, empty if it has none.
+  typedef std::function<std::string(const Product&)> ImageNamer;
+  /// Gets the image of an image file name.
+  typedef std::function<ImageStore::ImageID(const std::string&)> ImageLoader;
+
+  Type type = ADD_PRODUCT;       ///< Kind of change.
+  std::string category;          ///< Category of the products, or old name.
+  std::string newCategory;       ///< New category of an edition.
+  std::vector<Product> products; ///< Changed products, the old one first.
+  std::vector<Supply> supplies;  ///< Changed supplies, the old one first.
+  std::vector<User> users;       ///< Changed users, the old one first.
+
+  /**
+   * @brief Gets the register changed by the command.
+   * @return Flag of the register, ModelSnapshot::Register.
+   */
+  uint8_t getRegister() const;
+
+  /**
+   * @brief Builds the command that undoes this one.
+   *
+   * The deductions have no inverse, they are returned as they are.
+   *
+   * @return The inverse command.
+   */
+  ModelCommand inverse() const;
+
+  /**
+   * @brief Describes the command for the user, as the error of a lost change.
+   * @return Kind of change and the name of the changed item.
+   */
+  std::string describe() const;
+
+  /**
+   * @brief Encodes the command in the portable binary format.
+   *
+   * The images of the products are stored by the name of their file.
+   *
+   * @param writer Writer where the command is encoded.
+   * @param imageName Gets the image file of each product.
+   */
+  void encode(BinaryWriter& writer, const ImageNamer& imageName) const;
+
+  /**
+   * @brief Decodes a command written by encode().
+   *
+   * @param reader Reader positioned at the command.
+   * @param loadImage Gets the image of each image file.
+   * @return True if the command was complete and valid.
+   */
+  bool decode(BinaryReader& reader, const ImageLoader& loadImage);
+};
+
+#endif // MODELCOMMAND_H
@@ -0,0 +1,58 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef MODELSNAPSHOT_H
+#define MODELSNAPSHOT_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cashiersession.h"
+#include "product.h"
+#include "supply.h"
+#include "user.h"
+
+/**
+ * @struct ModelSnapshot
+ * @brief Immutable version of the registers of the model.
+ *
+ * The model builds a snapshot when a reader asks for one, and never modifies
+ * a taken one, so any thread can read a snapshot without locks while the
+ * model keeps changing. Each register is shared by the versions that didn't
+ * change it, a new version only copies the registers changed since the last
+ * one.
+ */
+struct ModelSnapshot {
+  /// Registered products by category.
+  typedef std::map<std::string, std::vector<Product>> Categories;
+
+  /**
+   * @enum Register
+   * @brief Flags of the registers changed by a new version.
+   */
+  enum Register : uint8_t {
+    PRODUCTS = 1 << 0,  ///< Products and categories.
+    SUPPLIES = 1 << 1,  ///< Supplies and their stock.
+    USERS = 1 << 2,     ///< Registered users.
+    CASHIER = 1 << 3,   ///< Cashier session and receipts.
+    ALL = PRODUCTS | SUPPLIES | USERS | CASHIER
+  };
+
+  uint64_t version = 0;  ///< Number of the version, increases on each change.
+  /// Products by category.
+  std::shared_ptr<const Categories> categories
+      = std::make_shared<const Categories>();
+  /// Supplies and their stock.
+  std::shared_ptr<const std::vector<Supply>> supplies
+      = std::make_shared<const std::vector<Supply>>();
+  /// Registered users.
+  std::shared_ptr<const std::vector<User>> users
+      = std::make_shared<const std::vector<User>>();
+  /// Session of the cashier, with its totals.
+  std::shared_ptr<const CashierSession> cashierSession
+      = std::make_shared<const CashierSession>();
+  size_t lastReceiptID = 0;  ///< ID of the last generated receipt.
+};
+
+#endif // MODELSNAPSHOT_H
@@ -0,0 +1,82 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef PAGEVIEW_H
+#define PAGEVIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class PageView
+ * @brief Read-only view of a page of the elements of a vector.
+ *
+ * The view only holds a pointer to the first element of the page and the
+ * number of elements, so building it doesn't copy any element. It's valid
+ * until the vector changes, the elements that are kept after a change of the
+ * registers must be copied before.
+ *
+ * @tparam Type Type of the elements of the vector.
+ */
+template <typename Type>
+class PageView {
+private:
+  const Type* first = nullptr;  ///< First element of the page.
+  size_t count = 0;             ///< Number of elements of the page.
+
+public:
+  /**
+   * @brief Constructs an empty page.
+   */
+  PageView() = default;
+
+  /**
+   * @brief Constructs the view of a page of a vector.
+   *
+   * @param elements The paginated vector.
+   * @param pageIndex The page index.
+   * @param itemsPerPage Number of elements per page.
+   */
+  PageView(const std::vector<Type>& elements, const size_t pageIndex
+      , const size_t itemsPerPage) {
+    // The pages past the end of the vector are empty.
+    const size_t start = std::min(pageIndex * itemsPerPage, elements.size());
+    this->first = elements.data() + start;
+    this->count = std::min(itemsPerPage, elements.size() - start);
+  }
+
+  /**
+   * @brief Gets the number of elements of the page.
+   * @return Number of elements.
+   */
+  size_t size() const { return this->count; }
+
+  /**
+   * @brief Checks if the page has no elements.
+   * @return True if the page is empty.
+   */
+  bool empty() const { return this->count == 0; }
+
+  /**
+   * @brief Gets an element of the page.
+   *
+   * @param index Position in the page, lower than its size.
+   * @return The element.
+   */
+  const Type& operator[](const size_t index) const {
+    return this->first[index];
+  }
+
+  /**
+   * @brief Gets the first element of the page, for range loops.
+   * @return Pointer to the first element.
+   */
+  const Type* begin() const { return this->first; }
+
+  /**
+   * @brief Gets the end of the page, for range loops.
+   * @return Pointer past the last element.
+   */
+  const Type* end() const { return this->first + this->count; }
+};
+
+#endif // PAGEVIEW_H
@@ -0,0 +1,167 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "persistenceworker.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <QDebug>
+
+PersistenceWorker::PersistenceWorker()
+    : worker(&PersistenceWorker::run, this) {
+}
+
+PersistenceWorker::~PersistenceWorker() {
+  // Lets the thread run the pending jobs before it finishes.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->jobsChanged.notify_all();
+  this->worker.join();
+}
+
+void PersistenceWorker::enqueue(const std::string& key
+    , std::function<void()> task) {
+  const auto now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->metrics.enqueued;
+    auto found = this->pending.find(key);
+    if (found != this->pending.end()) {
+      // Replaces the pending snapshot, keeping when it was first requested.
+      found->second.task = std::move(task);
+      found->second.lastQueued = now;
+      ++this->metrics.coalesced;
+    } else {
+      this->pending.emplace(key, Job{std::move(task), now, now});
+    }
+    this->metrics.queueDepth = this->pending.size();
+    this->metrics.maxQueueDepth = std::max(this->metrics.maxQueueDepth
+        , this->metrics.queueDepth);
+  }
+  this->jobsChanged.notify_one();
+}
+
+void PersistenceWorker::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->metrics.enqueued;
+    this->ordered.push_back(std::move(task));
+    this->metrics.queueDepth = this->pending.size() + this->ordered.size();
+    this->metrics.maxQueueDepth = std::max(this->metrics.maxQueueDepth
+        , this->metrics.queueDepth);
+  }
+  this->jobsChanged.notify_one();
+}
+
+void PersistenceWorker::flush() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  // Asks the thread to run every pending job now and waits for them.
+  this->flushing = true;
+  this->jobsChanged.notify_one();
+  this->jobsDone.wait(lock, [this] {
+    return this->pending.empty() && this->ordered.empty()
+        && this->running == 0;
+  });
+  this->flushing = false;
+  // Reports the error of the last failed job, if there was one.
+  std::string error;
+  std::swap(error, this->lastError);
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+bool PersistenceWorker::isPending(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->pending.count(key) != 0 || this->runningKeys.count(key) != 0;
+}
+
+PersistenceWorker::Metrics PersistenceWorker::getMetrics() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->metrics;
+}
+
+void PersistenceWorker::run() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true) {
+    // Finds the jobs that are due and when the next one will be.
+    const auto now = std::chrono::steady_clock::now();
+    auto nextDue = std::chrono::steady_clock::time_point::max();
+    std::vector<std::pair<std::string, std::function<void()>>> due;
+    for (auto it = this->pending.begin(); it != this->pending.end();) {
+      const auto dueTime = std::min(it->second.lastQueued + DEBOUNCE_DELAY
+          , it->second.firstQueued + MAX_DELAY);
+      if (this->flushing || this->stopping || dueTime <= now) {
+        due.emplace_back(it->first, std::move(it->second.task));
+        this->runningKeys.insert(it->first);
+        it = this->pending.erase(it);
+      } else {
+        nextDue = std::min(nextDue, dueTime);
+        ++it;
+      }
+    }
+    // The submitted jobs go first, in their order.
+    if (!this->ordered.empty()) {
+      std::vector<std::pair<std::string, std::function<void()>>> next;
+      next.reserve(this->ordered.size() + due.size());
+      for (auto& task : this->ordered) {
+        next.emplace_back(std::string(), std::move(task));
+      }
+      this->ordered.clear();
+      std::move(due.begin(), due.end(), std::back_inserter(next));
+      due.swap(next);
+    }
+    this->metrics.queueDepth = this->pending.size();
+
+    if (due.empty()) {
+      if (this->stopping) {
+        break;
+      }
+      // Sleeps until the next job is due or something changes.
+      if (nextDue == std::chrono::steady_clock::time_point::max()) {
+        this->jobsChanged.wait(lock);
+      } else {
+        this->jobsChanged.wait_until(lock, nextDue);
+      }
+      continue;
+    }
+
+    // Runs the due jobs without holding the lock.
+    this->running = due.size();
+    lock.unlock();
+    for (auto& [key, task] : due) {
+      const auto start = std::chrono::steady_clock::now();
+      std::string error;
+      try {
+        task();
+      } catch (const std::exception& exception) {
+        error = exception.what();
+        qDebug() << "No se pudo guardar el respaldo: "
+            << QString::fromStdString(key) << exception.what();
+      }
+      const auto latency
+          = std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+      // Updates the counters of the worker.
+      lock.lock();
+      --this->running;
+      this->runningKeys.erase(key);
+      if (error.empty()) {
+        ++this->metrics.completed;
+      } else {
+        ++this->metrics.failed;
+        this->lastError = error;
+      }
+      this->metrics.lastLatency = latency;
+      this->metrics.maxLatency = std::max(this->metrics.maxLatency, latency);
+      this->metrics.totalLatency += latency;
+      lock.unlock();
+    }
+    lock.lock();
+    this->jobsDone.notify_all();
+  }
+}
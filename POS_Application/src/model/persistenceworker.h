@@ -0,0 +1,137 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+/**
+ * @class PersistenceWorker
+ * @brief Background thread that writes the backups out of the GUI thread.
+ *
+ * The callers take a snapshot of the data to save and enqueue a job that
+ * writes it, under the key of the file it writes. A job waits until its key
+ * had no new jobs for a short delay, and a newer job of the same key replaces
+ * the pending one, so a burst of edits produces a single write.
+ *
+ * The appends to a log can't be replaced, they are submitted without a key
+ * and run as soon as possible, in the order they were submitted.
+ */
+class PersistenceWorker {
+public:
+  /// Time without new jobs of a key before its pending job runs.
+  static constexpr std::chrono::milliseconds DEBOUNCE_DELAY
+      = std::chrono::milliseconds(250);
+  /// Longest time that a job can be postponed by newer jobs.
+  static constexpr std::chrono::milliseconds MAX_DELAY
+      = std::chrono::milliseconds(2000);
+
+  /**
+   * @struct Metrics
+   * @brief Counters of the work done by the persistence worker.
+   */
+  struct Metrics {
+    size_t queueDepth = 0;      ///< Jobs waiting to run.
+    size_t maxQueueDepth = 0;   ///< Most jobs that were waiting at once.
+    uint64_t enqueued = 0;      ///< Jobs enqueued.
+    uint64_t coalesced = 0;     ///< Jobs replaced by a newer one.
+    uint64_t completed = 0;     ///< Jobs that ran successfully.
+    uint64_t failed = 0;        ///< Jobs that threw an error.
+    std::chrono::microseconds lastLatency{0};   ///< Duration of the last job.
+    std::chrono::microseconds maxLatency{0};    ///< Longest job duration.
+    std::chrono::microseconds totalLatency{0};  ///< Sum of the durations.
+  };
+
+private:
+  /**
+   * @struct Job
+   * @brief Pending job of a key.
+   */
+  struct Job {
+    std::function<void()> task;  ///< Writes the snapshot.
+    std::chrono::steady_clock::time_point firstQueued; ///< First enqueue.
+    std::chrono::steady_clock::time_point lastQueued;  ///< Last enqueue.
+  };
+
+  std::map<std::string, Job> pending;  ///< Pending jobs by key.
+  std::deque<std::function<void()>> ordered; ///< Submitted jobs, in order.
+  Metrics metrics;             ///< Counters of the worker.
+  size_t running = 0;          ///< Jobs running right now.
+  std::set<std::string> runningKeys;   ///< Keys of the running jobs.
+  bool flushing = false;       ///< True while a flush waits for the jobs.
+  bool stopping = false;       ///< True when the thread must finish.
+  std::string lastError;       ///< Error of the last failed job.
+  mutable std::mutex mutex;    ///< Protects the state of the worker.
+  std::condition_variable jobsChanged;  ///< Wakes up the worker thread.
+  std::condition_variable jobsDone;     ///< Wakes up the flush calls.
+  std::thread worker;          ///< Thread that runs the jobs.
+
+public:
+  /**
+   * @brief Constructs the worker and starts its thread.
+   */
+  PersistenceWorker();
+
+  /**
+   * @brief Runs the pending jobs and stops the thread.
+   */
+  ~PersistenceWorker();
+
+  /**
+   * @brief Enqueues a job, replacing the pending job of the same key.
+   *
+   * @param key Key of the written file.
+   * @param task Job that writes the snapshot, must own all the data it uses.
+   */
+  void enqueue(const std::string& key, std::function<void()> task);
+
+  /**
+   * @brief Submits a job that runs without delay, after the submitted before.
+   *
+   * @param task Job that writes the data, must own all the data it uses.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Runs the pending jobs without waiting and waits for them.
+   *
+   * @throws std::runtime_error If a job failed since the last flush.
+   */
+  void flush();
+
+  /**
+   * @brief Checks if a key has a job that didn't finish yet.
+   *
+   * Lets the readers of a file wait only when the file is being written.
+   *
+   * @param key Key of the written file.
+   * @return True if the key has a pending or running job.
+   */
+  bool isPending(const std::string& key) const;
+
+  /**
+   * @brief Gets a copy of the worker counters.
+   * @return The current metrics.
+   */
+  Metrics getMetrics() const;
+
+private:
+  /**
+   * @brief Body of the worker thread, runs the jobs when they are due.
+   */
+  void run();
+
+  // Copy and assignment constructors are disabled.
+  PersistenceWorker(const PersistenceWorker&) = delete;
+  PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+};
+
+#endif // PERSISTENCEWORKER_H
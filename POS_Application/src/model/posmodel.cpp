@@ -1,7 +1,14 @@
 // Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <string>
+#include <utility>
 
+#include <QDateTime>
 #include <QDebug>
 #include <QPrinter>
 #include <QPrinterInfo>
@@ -10,6 +17,20 @@
 #include "posmodel.h"
 #include "backupmodule.h"
 #include "order.h"
+#include "salesarchive.h"
+
+namespace {
+// Builds the callback that tells if a logged change reached the disk.
+std::function<void(const std::string&)> reportUnsaved(
+    const std::string& change) {
+  return [change](const std::string& error) {
+    if (!error.empty()) {
+      qDebug() << "No se pudo guardar: " << QString::fromStdString(change)
+          << QString::fromStdString(error);
+    }
+  };
+}
+}  // namespace
 
 POS_Model::POS_Model(BackupModule& module)
     : backupModule(module) {
@@ -22,8 +43,11 @@ POS_Model& POS_Model::getInstance() {
 }
 
 bool POS_Model::start(const User& user) {
+  this->recoveryErrors.clear();
   // Obtains the registrered users information.
   this->registeredUsers = this->backupModule.getUsersBackup();
+  // The users changed since their snapshot can log in too.
+  this->replayModelCommands(ModelSnapshot::USERS);
   qDebug() << "usuarios registrados: " << this->registeredUsers.size();
   // Checks if the given user is registered.
   if (this->isUserRegistered(user)) {
@@ -32,6 +56,7 @@ bool POS_Model::start(const User& user) {
     qDebug() << "Model encendido.";
     // Change model state flag to true.
     this->started = true;
+    this->invalidateSnapshot(ModelSnapshot::ALL);
   }
   // Returns the model state flag.
   return this->started;
@@ -40,39 +65,129 @@ bool POS_Model::start(const User& user) {
 void POS_Model::shutdown() {
   // Cheks if the model is started.
   if (this->isStarted()) {
-    // Writes out the registers of the products information.
-    this->backupModule.updateProductsBackup(this->categories);
-    this->backupModule.updateSuppliesBackup(this->supplies);
-    this->closeCashier();
-    this->backupModule.updateReceiptsBackup(this->currentReceiptID
-        , this->registeredReceipts);
+    // Writes out the snapshots of the registers, that empties the change log.
+    this->backupModule.checkpointModelBackups(this->getSnapshot()
+        , this->nextProductID);
+    this->loggedChanges = 0;
+    this->loggedSales = 0;
+    // The opened cashier is already saved, it's restored on the next start.
+    // Waits until the backups are on the disk.
+    this->backupModule.flushBackups();
+    // Reports how the background writes behaved during the session.
+    const PersistenceWorker::Metrics metrics
+        = this->backupModule.getPersistenceMetrics();
+    qDebug() << "Respaldos escritos:" << metrics.completed
+        << "combinados:" << metrics.coalesced
+        << "cola maxima:" << metrics.maxQueueDepth
+        << "latencia maxima (us):" << metrics.maxLatency.count();
+    const ImageStore::Metrics images = ImageStore::getInstance().getMetrics();
+    qDebug() << "Imagenes en cache:" << images.hits
+        << "decodificadas:" << images.misses
+        << "descartadas:" << images.evictions;
     // Clears the model memory.
     this->categories.clear();
-    this->products.clear();
+    this->productView.rebuild(this->categories);
+    this->productIndex.clear();
     this->supplies.clear();
+    this->recipeBook.internSupplies(this->supplies);
     this->registeredUsers.clear();
     this->ongoingReceipts.clear();
+    this->cashierSession.close();
+    this->salesRollups.clear();
+    this->undoCommands.clear();
+    this->redoCommands.clear();
     this->user = User();
     // Sets the model state flag to false.
     this->started = false;
+    this->invalidateSnapshot(ModelSnapshot::ALL);
   }
 }
 
 void POS_Model::openCashier() {
   this->ongoingReceipts.clear();
-  this->cashierOpened = true;
+  // Starts the session with the next receipt, and saves it.
+  this->cashierSession.open(this->user.getUsername()
+      , QDateTime::currentSecsSinceEpoch(), this->currentReceiptID + 1);
+  this->backupModule.updateCashierSessionBackup(this->cashierSession);
+  this->invalidateSnapshot(ModelSnapshot::CASHIER);
 }
 
 void POS_Model::closeCashier() {
-  for (const auto& receipt : this->ongoingReceipts) {
-    this->registeredReceipts.emplace_back(receipt);
+  // The receipts were already appended to the journal when generated, the
+  // history is read from the receipts archive when it's needed.
+  // Copies the closed sales into the columnar archive, for the reports.
+  this->backupModule.appendSalesBackup(this->ongoingReceipts);
+  // Rewrites the receipts journal only if it holds records to drop.
+  if (this->backupModule.compactReceiptsBackup()) {
+    qDebug() << "Respaldo de recibos compactado.";
   }
-  if (!this->ongoingReceipts.empty()) {
-    this->backupModule.updateReceiptsBackup(this->registeredReceipts.size()
-        ,this->registeredReceipts);
-    this->ongoingReceipts.clear();
+  this->ongoingReceipts.clear();
+  this->cashierSession.close();
+  this->backupModule.updateCashierSessionBackup(this->cashierSession);
+  this->invalidateSnapshot(ModelSnapshot::CASHIER);
+}
+
+CashierSession::Expense POS_Model::addExpense(const std::string& name
+    , const Money amount) {
+  CashierSession::Expense expense;
+  expense.name = name;
+  expense.timestamp = QDateTime::currentSecsSinceEpoch();
+  expense.amount = amount;
+  // Takes the expense from the cashier totals, and saves the session.
+  this->cashierSession.addExpense(expense);
+  this->backupModule.updateCashierSessionBackup(this->cashierSession);
+  this->invalidateSnapshot(ModelSnapshot::CASHIER);
+  return expense;
+}
+
+bool POS_Model::findReceipt(const size_t id, Receipt& receipt) {
+  // Looks up the receipt in the archive, without loading the history.
+  return this->backupModule.findReceiptBackup(id, receipt);
+}
+
+SalesRollups::Totals POS_Model::getSalesSummary(const QDate& firstDay
+    , const QDate& lastDay) {
+  // Loads the days of the range that are not in memory yet.
+  for (QDate day = firstDay; day <= lastDay; day = day.addDays(1)) {
+    this->rollupOfDay(day.toString("yyyyMMdd").toStdString());
+  }
+  return this->salesRollups.summarize(
+      firstDay.toString("yyyyMMdd").toStdString()
+      , lastDay.toString("yyyyMMdd").toStdString());
+}
+
+ReportEngine::ZReport POS_Model::getZReport(const QDate& firstDay
+    , const QDate& lastDay) {
+  // The queued sales must be in the segments before they are read.
+  this->backupModule.flushBackups();
+  std::vector<ReportEngine::Day> days;
+  for (QDate day = firstDay; day <= lastDay; day = day.addDays(1)) {
+    days.push_back(ReportEngine::Day{this->backupModule.getSalesSegments(
+        day.toString("yyyyMMdd").toStdString())
+        , QDateTime(day, QTime(0, 0)).toSecsSinceEpoch()});
+  }
+  return this->reportEngine.build(days);
+}
+
+size_t POS_Model::getReceiptsCount() {
+  // The archive index holds the count, no receipt is read.
+  return this->backupModule.getReceiptsCount();
+}
+
+std::vector<Receipt> POS_Model::searchReceipts(
+    const ReceiptSearchIndex::Query& query, const size_t maxResults) {
+  // A product of the catalog is searched by its ID, so its receipts are found
+  // after it's renamed.
+  ReceiptSearchIndex::Query byID = query;
+  if (byID.productID == 0 && !byID.productName.empty()) {
+    const ProductIndex::Location* location
+        = this->productIndex.findByName(byID.productName);
+    if (location != nullptr) {
+      byID.productID = this->categories.at(location->category)
+          [location->position].getID();
+    }
   }
-  this->cashierOpened = false;
+  return this->backupModule.searchReceiptBackups(byID, maxResults);
 }
 
 size_t POS_Model::getPageAccess(const size_t page) {
@@ -98,148 +213,68 @@ size_t POS_Model::getSizeOfCategory(std::string category) {
   size_t no_value = std::numeric_limits<size_t>::max();
   // Checks that the category register name isn't empaty.
   if (!category.empty()) {
-    // Iterates through the category registers.
-    for (const auto& categoryRegister : this->categories) {
-      // Checks the category name matches.
-      if (categoryRegister.first == category) {
-        // Returns the number of products contained in the category.
-        return categoryRegister.second.size();
-      }
+    // Looks up the category register by its name.
+    const auto categoryRegister = this->categories.find(category);
+    if (categoryRegister != this->categories.end()) {
+      // Returns the number of products contained in the category.
+      return categoryRegister->second.size();
     }
   }
   return no_value;
 }
 
-std::vector<std::pair<std::string, Product>> POS_Model::getProductsForPage(
-    const size_t pageIndex, const size_t itemsPerPage) {
-  // Calculate the starting and end index for the products of this page.
-  size_t startIdx = pageIndex * itemsPerPage;
-  size_t endIdx = std::min(startIdx + itemsPerPage, this->products.size());
-  
-  // Temporal vector to store and return the products to display in this page.
-  std::vector<std::pair<std::string, Product>> pageProducts;
-  // Iterates between the start and ending indexes to access the products for
-  // this page.
-  for (size_t i = startIdx; i < endIdx; ++i) {
-    // Adds the indexed product into the page products vector.
-    pageProducts.push_back(this->products[i]);
-  }
-  return pageProducts;
-}
-
-std::vector<std::string> POS_Model::getCategoriesForPage(const size_t pageIndex
-    , const size_t itemsPerPage) {
-  // Calculate the starting and end index for the products of this page.  
-  size_t startIdx = pageIndex * itemsPerPage;  
-  size_t endIdx = std::min(startIdx + itemsPerPage, this->categories.size());
-  
-  // Temporal counter to manage the categories addition.
-  size_t currentIdx = 0;
-  // Temporal vector to store and return the categories to display in this page.  
-  std::vector<std::string> registeredCategories;
-  // Iterates through the categories map.
-  for (const auto& [category, product] : this->categories) {
-    if (currentIdx >= startIdx && currentIdx < endIdx) {
-      registeredCategories.push_back(category);
-    }
-    ++currentIdx;
-    if (currentIdx >= endIdx) {
-      break;
-    }
-  }
-  return registeredCategories;
-}
-
-std::vector<Supply> POS_Model::getSuppliesForPage(const size_t pageIndex
-    , const size_t itemsPerPage) {
-  // Calculate the starting and end index for the products of this page.  
-  size_t startIdx = pageIndex * itemsPerPage;  
-  size_t endIdx = std::min(startIdx + itemsPerPage, this->supplies.size());
-  
-  // Temporal counter to manage the categories addition.
-  size_t currentIdx = 0;
-  // Temporal vector to store and return the supplies to display in this page.    
-  std::vector<Supply> pageSupplies;
-  // Iterates between the start and ending indexes to access the supplies for
-  // this page.
-  for (size_t i = startIdx; i < endIdx; ++i) {
-    // Adds the indexed product into the page supplies vector.
-    pageSupplies.emplace_back(this->supplies[i]);
-  }
-  
-  return pageSupplies;
-}
-
-std::vector<User> POS_Model::getUsersForPage(const size_t pageIndex
-    , const size_t itemsPerPage) {
-  // Calculate the starting and end index for the user of this page.  
-  size_t startIdx = pageIndex * itemsPerPage;  
-  size_t endIdx = std::min(startIdx + itemsPerPage
-    , this->registeredUsers.size());
-  
-  // Temporal counter to manage the user addition.
-  size_t currentIdx = 0;
-  // Temporal vector to store and return the users to display in this page.    
-  std::vector<User> pageUsers;
-  // Iterates between the start and ending indexes to access the user for
-  // this page.
-  for (size_t i = startIdx; i < endIdx; ++i) {
-    // Adds the indexed user into the page users vector.
-    pageUsers.emplace_back(this->registeredUsers[i]);
-  }
-  
-  return pageUsers;
-}
-
 Product& POS_Model::findProduct(const std::string& productName) {
-  // Iterates through the categories register.
-  for (auto& [category, products] : this->categories) {
-    // Iterates through the category's products.
-    for (auto& product : products) {
-      // Compares the product name with the names in the registers.
-      if (product.getName() == productName) {
-        // Returns the matching product.
-        return product;
-      }
-    }
+  // Looks up the location of the product in the index.
+  const ProductIndex::Location* location
+      = this->productIndex.findByName(productName);
+  if (location == nullptr) {
+    throw std::runtime_error("Product not found: " + productName);
   }
-  throw std::runtime_error("Product not found: " + productName);  
+  return this->categories.at(location->category)[location->position];
 }
 
-bool POS_Model::generateReceipt(const Order& order) {
+bool POS_Model::generateReceipt(const Order& order
+    , std::vector<Supply>& shortages) {
   Receipt newReceipt("Macana's Place"
       , ++this->currentReceiptID, this->user.getUsername().data(), order
   );
   this->ongoingReceipts.emplace_back(newReceipt);
-  this->printReceipts();
   
-  std::vector<std::pair<Product, size_t>> orderElements
-      = order.getOrderProducts();
-  
-  for (const auto& element : orderElements) {
-    const size_t quantity = element.second;
-    const std::vector<Supply> productSupplies = element.first.getIngredients();
-    for (const auto& supply : productSupplies) {
-      const std::string supplyName = supply.getName();
-      auto it = std::find_if(this->supplies.begin(), this->supplies.end(),
-          [supplyName](const Supply& registeredSupply) {
-          return registeredSupply.getName() == supplyName;
-      });
-      
-      if (it != this->supplies.end()) {
-        const size_t registerIndex = std::distance(this->supplies.begin(), it);
-        for (size_t i = 0; i < quantity; ++i) {
-          if (this->supplies[registerIndex].getQuantity() > 0) {
-            this->supplies[registerIndex] - supply;
-          }
-        }
-      } else {
-        qDebug() << "Suministro no registrado.";
-      }
+  // Deducts the supplies used by the order through the compiled recipes.
+  std::vector<RecipeBook::Shortage> missing;
+  std::vector<RecipeBook::Deduction> deductions;
+  shortages.clear();
+  if (!this->recipeBook.deduct(order.getOrderProducts(), this->supplies
+      , missing, deductions)) {
+    // Reports the supplies that ran out of stock, with the missing quantity.
+    for (const RecipeBook::Shortage& shortage : missing) {
+      const Supply& supply = this->supplies[shortage.supply];
+      shortages.emplace_back(supply.getName(), shortage.missing
+          , supply.getMeasure());
     }
   }
+  // Logs the deducted stock, it's recovered with the other supply changes.
+  ModelCommand command{ModelCommand::DEDUCT_SUPPLIES};
+  for (const RecipeBook::Deduction& deduction : deductions) {
+    const Supply& supply = this->supplies[deduction.supply];
+    command.supplies.emplace_back(supply.getName(), deduction.quantity
+        , supply.getMeasure());
+  }
+  // Appends the receipt to the receipts journal, that restores the session,
+  // the deduction is flushed with it in the background.
+  this->backupModule.appendReceiptBackup(newReceipt
+      , deductions.empty() ? nullptr : &command
+      , reportUnsaved("recibo " + std::to_string(newReceipt.getID())));
+  if (!deductions.empty()) {
+    ++this->loggedSales;
+    this->checkpointIfNeeded();
+  }
+  this->cashierSession.addReceipt(newReceipt);
+  this->addToSalesRollups(newReceipt);
+  this->printReceipts();
   qDebug() << "Recibo anadido correctamente, recibo numero: "
       << this->ongoingReceipts.size();
+  this->invalidateSnapshot(ModelSnapshot::CASHIER | ModelSnapshot::SUPPLIES);
   return true;
 }
 
@@ -250,8 +285,11 @@ bool POS_Model::addProduct(const std::string& category
     // Try to emplace/add the product in the specifiec category.
     if (this->emplaceProduct(category, product, this->categories)) {
       qDebug() << "Producto anadido correctamente";
-      // Updates the files containing teh products information backup.
-      this->backupModule.updateProductsBackup(this->categories);
+      // Logs the added product, with the ID it took.
+      ModelCommand command{ModelCommand::ADD_PRODUCT, category};
+      command.products.push_back(this->categories.at(category).back());
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
       return true;
     } 
   }
@@ -266,14 +304,37 @@ bool POS_Model::addCategory(const std::string newCategory) {
         newCategory, std::vector<Product>());
     // If the emplacement was successful, then.
     if (result.second) {
-      // Updates the file that contains the products backup.
-      backupModule.updateProductsBackup(this->categories);
+      // The new category changes the order of the products view.
+      this->productView.rebuild(this->categories);
+      // Logs the added category.
+      this->recordCommand(ModelCommand{ModelCommand::ADD_CATEGORY
+          , newCategory});
+      this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
       return true;
     } 
   }
   return false;
 }
 
+size_t POS_Model::importProducts(const std::string& filename) {
+  // Parses the whole file before the model changes.
+  const std::map<std::string, std::vector<Product>> imported
+      = this->backupModule.importProductsText(filename);
+  size_t added = 0;
+  for (const auto& [category, products] : imported) {
+    if (this->categories.count(category) == 0) {
+      this->addCategory(category);
+    }
+    // Each added product is logged and saved like the ones of the forms.
+    for (const Product& product : products) {
+      if (this->addProduct(category, product)) {
+        ++added;
+      }
+    }
+  }
+  return added;
+}
+
 bool POS_Model::addSupply(const Supply newSupply) {
   // Temporal to adapt to avoid checking the measure, cause the ui always give
   // it.
@@ -281,14 +342,17 @@ bool POS_Model::addSupply(const Supply newSupply) {
   // Checks that the given supply to add isn't empty.
   if (!(newSupply == baseSupply)) {
     // Try to find the given supply in the registered supplies of the pos.
-    auto it = std::find(this->supplies.begin(), this->supplies.end()
-        , newSupply);
+    auto it = this->findSupply(newSupply.getName());
     // If the given supply aren't registed, then.
     if (it == this->supplies.end()) {
       // Adds the new supply into the supplies registered.
       this->supplies.emplace_back(newSupply);
-      // Updates the file containing the supplies backup information.
-      this->backupModule.updateSuppliesBackup(this->supplies);
+      this->recipeBook.internSupplies(this->supplies);
+      // Logs the added supply.
+      ModelCommand command{ModelCommand::ADD_SUPPLY};
+      command.supplies.push_back(newSupply);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::SUPPLIES);
       qDebug() << "Se añadió el suministro, correctamente.";
       return true;
     } else {
@@ -313,8 +377,11 @@ bool POS_Model::addUser(const User newUser) {
     if (it == this->registeredUsers.end()) {
       // Adds the new user into the users registered.
       this->registeredUsers.emplace_back(newUser);
-      // Updates the file containing the users backup information.
-      this->backupModule.updateUsersBackup(this->registeredUsers);
+      // Logs the added user.
+      ModelCommand command{ModelCommand::ADD_USER};
+      command.users.push_back(newUser);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::USERS);
       qDebug() << "Se añadió el usuario, correctamente.";
       return true;
     } else {
@@ -331,10 +398,14 @@ bool POS_Model::removeProduct(const std::string& category
   // Checks that the given category and product aren't empty.
   if (!category.empty() && !(product == Product())) {
     // Try to erase the product from the specific category register.
-    if (this->eraseProduct(category, product, this->categories)) {
+    ModelCommand command{ModelCommand::REMOVE_PRODUCT, category};
+    command.products.emplace_back();
+    if (this->eraseProduct(category, product, this->categories
+        , command.products.back())) {
       qDebug() << "producto elimnado correctamente";
-      // Update the registered products.
-      backupModule.updateProductsBackup(this->categories);
+      // Logs the whole removed product, to restore it.
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
       return true;
     } 
   }
@@ -344,13 +415,23 @@ bool POS_Model::removeProduct(const std::string& category
 bool POS_Model::removeCategory(const std::string category) {
   // Checks that the category isn't empty.
   if (!category.empty()) {
-    // Try to erase the category key and related data from the
-    // category registers.
-    size_t remove = this->categories.erase(category);
-    // If the deletion was successful
-    if (remove) {
-      // Update the registered products.
-      this->obtainProducts(this->products, this->categories);
+    // Try to find the category in the category registers.
+    auto existingCategory = this->categories.find(category);
+    // If the category exists, then.
+    if (existingCategory != this->categories.end()) {
+      // Keeps the category with its products, to restore them.
+      ModelCommand command{ModelCommand::REMOVE_CATEGORY, category};
+      command.products = existingCategory->second;
+      // Removes its products from the index, then the category and its data.
+      this->productIndex.eraseCategory(existingCategory->second);
+      for (const Product& product : existingCategory->second) {
+        this->recipeBook.forgetRecipe(product.getName());
+      }
+      this->categories.erase(existingCategory);
+      // Update the registered products view.
+      this->productView.rebuild(this->categories);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
       qDebug() << "Categoria eliminada";
       return true;
     }
@@ -361,14 +442,18 @@ bool POS_Model::removeCategory(const std::string category) {
 bool POS_Model::removeSupply(const Supply &supply) {
   // Checks that the supply contain or not information.
   if (!supply.empty()) {
-    // Try to find the supply in the exitisting supplies in the pos.
-    auto it = std::find(this->supplies.begin(), this->supplies.end(), supply);
-    // If there's a supply with the same name and measure in the pos, then.
+    // Try to find the supply in the exitisting supplies in the pos, its stock
+    // may have changed since it was shown.
+    auto it = this->findSupply(supply.getName());
+    // If there's a supply with the same name in the pos, then.
     if (it != this->supplies.end()) {
-      // Erase the supply from the existing supplies of the pos.
+      // Erase the supply from the existing supplies of the pos, then logs it.
+      ModelCommand command{ModelCommand::REMOVE_SUPPLY};
+      command.supplies.push_back(*it);
       this->supplies.erase(it);
-      // Updates the long-term memory.
-      this->backupModule.updateSuppliesBackup(this->supplies);
+      this->recipeBook.internSupplies(this->supplies);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::SUPPLIES);
       qDebug() << "Se eliminó el suministro, correctamente.";
       // Indicates that the supply was removed correctly.
       return true;
@@ -389,10 +474,12 @@ bool POS_Model::removeUser(const User& user) {
         , this->registeredUsers.end(), user);
     // If there's a user with the same name and measure in the pos, then.
     if (it != this->registeredUsers.end()) {
-      // Erase the user from the existing users of the pos.
+      // Erase the user from the existing users of the pos, then logs it.
+      ModelCommand command{ModelCommand::REMOVE_USER};
+      command.users.push_back(*it);
       this->registeredUsers.erase(it);
-      // Updates the long-term memory.
-      this->backupModule.updateUsersBackup(this->registeredUsers);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::USERS);
       qDebug() << "Se eliminó el usuario, correctamente.";
       // Indicates that the user was removed correctly.
       return true;
@@ -408,12 +495,27 @@ bool POS_Model::removeUser(const User& user) {
 bool POS_Model::editProduct(const std::string& oldCategory
     , const Product& oldProduct, const std::string& newCategory
     , const Product& newProduct) {
+  // The new product cannot take the name of another product, nor go to a
+  // category that doesn't exist, or it would be lost after the deletion.
+  const ProductIndex::Location* existing
+      = this->productIndex.findByName(newProduct.getName());
+  if ((existing != nullptr && newProduct.getName() != oldProduct.getName())
+      || this->categories.find(newCategory) == this->categories.end()) {
+    qDebug() << "No se edito el producto, el nombre o la categoria no son"
+        " validos.";
+    return false;
+  }
   // Try to erase the old product information from the category registers, then.
-  if (this->eraseProduct(oldCategory, oldProduct, this->categories)) {
+  ModelCommand command{ModelCommand::EDIT_PRODUCT, oldCategory, newCategory};
+  command.products.emplace_back();
+  if (this->eraseProduct(oldCategory, oldProduct, this->categories
+      , command.products.back())) {
     // Try emplace the new product into the specific category.
     this->emplaceProduct(newCategory, newProduct, this->categories);
-    // Updates the files that contains the pos products backup.
-    backupModule.updateProductsBackup(this->categories);
+    // Logs the whole old and new products, to swap them back.
+    command.products.push_back(this->categories.at(newCategory).back());
+    this->recordCommand(std::move(command));
+    this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
     return true;
   }
   return false;
@@ -421,22 +523,28 @@ bool POS_Model::editProduct(const std::string& oldCategory
 
 bool POS_Model::editCategory(const std::string oldCategory
     , const std::string newCategory) {
-  // Checks that the categories names aren't empty.
-  if (!oldCategory.empty() && !newCategory.empty()) {
+  // Checks that the categories names aren't empty, and that the new name is
+  // free, the products of a category would be lost otherwise.
+  if (!oldCategory.empty() && !newCategory.empty()
+      && this->categories.find(newCategory) == this->categories.end()) {
     // Try to find the existing category with the old category references.
     auto existingCategory = this->categories.find(oldCategory);
     // If there's a eisting category in  the pos system, then.
     if (existingCategory != this->categories.end()) {
-      // Saves the reference of the category's products.
-      std::vector<Product> categoryProducts = existingCategory->second;      
-      // Erase the existing category data contained in the map.
-      this->categories.erase(existingCategory);
-      qDebug() << "Categoria eliminada: " << this->categories.size();
-      // Emplace/Add the a new space in the map with the new category name and
-      // the old category's products.
-      this->categories.emplace(newCategory, categoryProducts);
+      // Takes the category out of the map, with its products, and renames it
+      // without copying them.
+      auto category = this->categories.extract(existingCategory);
+      category.key() = newCategory;
+      const auto renamed = this->categories.insert(std::move(category));
       qDebug() << "Mapa actualizado: " << this->categories.size();
-      this->obtainProducts(this->products, this->categories);
+      // Moves the products to the new name in the index.
+      this->productIndex.renameCategory(newCategory, renamed.position->second);
+      // The category moved in the order of the products view.
+      this->productView.rebuild(this->categories);
+      // Logs the rename.
+      this->recordCommand(ModelCommand{ModelCommand::EDIT_CATEGORY
+          , oldCategory, newCategory});
+      this->invalidateSnapshot(ModelSnapshot::PRODUCTS);
       return true;
     } 
   }
@@ -445,17 +553,22 @@ bool POS_Model::editCategory(const std::string oldCategory
 
 bool POS_Model::editSupply(const Supply& oldSupply
     , const Supply& newSupply) {
-  // Checks that the provided supplies aren't equal.
-  if (!(oldSupply == newSupply) && !newSupply.empty()) {
+  // Checks that the provided supplies aren't equal, and that a new name isn't
+  // taken by another supply.
+  if (!(oldSupply == newSupply) && !newSupply.empty()
+      && (newSupply.getName() == oldSupply.getName()
+      || this->findSupply(newSupply.getName()) == this->supplies.end())) {
     // Try to find the provided old supply on the registered supplies.
-    auto existingSupply = std::find(this->supplies.begin(), this->supplies.end()
-        , oldSupply);
+    auto existingSupply = this->findSupply(oldSupply.getName());
     // If there's a supply that matches, then.
     if (existingSupply != this->supplies.end()) {
-      // Update the supply propperties.
+      // Update the supply propperties, then logs the old and new supply.
+      ModelCommand command{ModelCommand::EDIT_SUPPLY};
+      command.supplies = {*existingSupply, newSupply};
       *existingSupply = newSupply;
-      // Update the supplies backup.
-      this->backupModule.updateSuppliesBackup(this->supplies);
+      this->recipeBook.internSupplies(this->supplies);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::SUPPLIES);
       qDebug() << "Suministro editado correctamente.";
       return true;
     } else {
@@ -480,10 +593,12 @@ bool POS_Model::editUser(const User& oldUser
     
     // If there's a user that matches, then.
     if (existingUser != this->registeredUsers.end()) {
-      // Update the user propperties.
+      // Update the user propperties, then logs the old and new user.
+      ModelCommand command{ModelCommand::EDIT_USER};
+      command.users = {*existingUser, newUser};
       *existingUser = newUser;
-      // Update the user backup.
-      this->backupModule.updateUsersBackup(this->registeredUsers);
+      this->recordCommand(std::move(command));
+      this->invalidateSnapshot(ModelSnapshot::USERS);
       qDebug() << "Usuario editado correctamente.";
       return true;
     } else {
@@ -495,6 +610,44 @@ bool POS_Model::editUser(const User& oldUser
   return false;
 }
 
+bool POS_Model::undo(const uint8_t registers) {
+  // Only the last change can be undone, if it's of the given registers.
+  if (this->undoCommands.empty()
+      || (this->undoCommands.back().getRegister() & registers) == 0) {
+    return false;
+  }
+  // Applies the inverse change, and logs it as any other change. A change
+  // that can't be undone stays in the history.
+  const ModelCommand inverse = this->undoCommands.back().inverse();
+  if (!this->apply(inverse)) {
+    qDebug() << "No se pudo deshacer el cambio, sus datos ya no existen.";
+    return false;
+  }
+  this->logCommand(inverse);
+  this->redoCommands.push_back(std::move(this->undoCommands.back()));
+  this->undoCommands.pop_back();
+  return true;
+}
+
+bool POS_Model::redo(const uint8_t registers) {
+  // Only the last undone change can be made again.
+  if (this->redoCommands.empty()
+      || (this->redoCommands.back().getRegister() & registers) == 0) {
+    return false;
+  }
+  // Applies the change again, and logs it. A change that can't be made
+  // again stays in the history.
+  const ModelCommand& command = this->redoCommands.back();
+  if (!this->apply(command)) {
+    qDebug() << "No se pudo rehacer el cambio, sus datos ya no existen.";
+    return false;
+  }
+  this->logCommand(command);
+  this->undoCommands.push_back(std::move(this->redoCommands.back()));
+  this->redoCommands.pop_back();
+  return true;
+}
+
 QString POS_Model::formatProductIngredients(
     const std::vector<Supply>& ingredients) {
   // Qstring temporal to contain all the product's ingredients information.
@@ -569,76 +722,401 @@ bool POS_Model::isUserRegistered(const User& user) {
 void POS_Model::loadSystemBackups() {
   // Reads and store the backup to the program memory to use them in the
   // program execution.
-  this->categories = this->backupModule.getProductsBackup();
-  this->obtainProducts(this->products, this->categories);
+  this->categories
+      = this->backupModule.getProductsBackup(this->nextProductID);
+  this->productView.rebuild(this->categories);
+  this->productIndex.rebuild(this->categories);
   this->supplies = this->backupModule.getSuppliesBackup();
-  this->registeredReceipts = this->backupModule.getReceiptsBackup();
-  this->currentReceiptID = this->registeredReceipts.size();
-}
-
-void POS_Model::obtainProducts(
-    std::vector<std::pair<std::string, Product>>& existingProducts
-    , const std::map<std::string, std::vector<Product>>& categoryRegisters) {
-  existingProducts.clear();
-  // Transverse all the product type categories and their products.
-  for (const auto& [category, products] : categoryRegisters) {
-    // Transverse all the products of the category and added them to the vector.
-    for (const auto& product : products) {
-      // Emplace the product in the the product register.
-      existingProducts.emplace_back(category, product);
+  this->recipeBook.internSupplies(this->supplies);
+  // Makes the changes logged after the snapshots.
+  this->replayModelCommands(ModelSnapshot::PRODUCTS | ModelSnapshot::SUPPLIES);
+  this->currentReceiptID = this->backupModule.getLastReceiptID();
+  this->restoreCashierSession();
+  this->restoreSalesRollups();
+}
+
+void POS_Model::restoreCashierSession() {
+  this->ongoingReceipts.clear();
+  if (!this->backupModule.getCashierSessionBackup(this->cashierSession)
+      || !this->cashierSession.isOpen()) {
+    this->cashierSession.close();
+    return;
+  }
+  // Reads the receipts generated since the cashier was opened.
+  for (size_t id = this->cashierSession.getFirstReceiptID()
+      ; id <= this->currentReceiptID; ++id) {
+    Receipt receipt;
+    if (this->backupModule.findReceiptBackup(id, receipt)) {
+      this->cashierSession.addReceipt(receipt);
+      this->ongoingReceipts.push_back(std::move(receipt));
+    }
+  }
+  qDebug() << "Caja restaurada con" << this->ongoingReceipts.size()
+      << "recibos.";
+}
+
+void POS_Model::restoreSalesRollups() {
+  this->salesRollups.clear();
+  // The totals are saved with each receipt, so only the days since the last
+  // saved ones can miss receipts. Without saved totals, the closed days are
+  // added up from the sales segments.
+  std::string lastDay = this->backupModule.getLastSalesRollupDay();
+  if (lastDay.empty()) {
+    lastDay = this->backfillSalesRollups();
+  }
+  // Without totals nor segments, only the receipts of the open cashier are
+  // not archived yet.
+  const size_t firstID = !lastDay.empty() ? 1
+      : this->cashierSession.isOpen()
+      ? this->cashierSession.getFirstReceiptID() : this->currentReceiptID + 1;
+  // Collects the receipts newer than the last one of the totals of its day.
+  std::vector<Receipt> missing;
+  for (size_t id = this->currentReceiptID; id >= firstID && id > 0; --id) {
+    Receipt receipt;
+    if (!this->backupModule.findReceiptBackup(id, receipt)) {
+      continue;
+    }
+    const std::string day = SalesArchive::dayOf(receipt.getTimestamp());
+    if (day < lastDay || this->rollupOfDay(day).lastReceiptID >= id) {
+      break;
+    }
+    missing.push_back(std::move(receipt));
+  }
+  // Adds them in the order they were generated.
+  for (auto receipt = missing.rbegin(); receipt != missing.rend(); ++receipt) {
+    this->addToSalesRollups(*receipt);
+  }
+  if (!missing.empty()) {
+    qDebug() << "Totales de ventas actualizados con" << missing.size()
+        << "recibos.";
+  }
+}
+
+std::string POS_Model::backfillSalesRollups() {
+  // The queued sales must be in the segments before they are listed.
+  this->backupModule.flushBackups();
+  const std::vector<std::pair<std::string, std::vector<std::string>>> dayFiles
+      = this->backupModule.getSalesDays();
+  if (dayFiles.empty()) {
+    return std::string();
+  }
+  // Adds up the columns of every segment on the threads of the engine.
+  std::vector<ReportEngine::Day> days;
+  days.reserve(dayFiles.size());
+  for (const auto& [day, paths] : dayFiles) {
+    days.push_back(ReportEngine::Day{paths, QDateTime(QDate::fromString(
+        QString::fromStdString(day), "yyyyMMdd"), QTime(0, 0))
+        .toSecsSinceEpoch()});
+  }
+  const std::vector<ReportEngine::ZReport> reports
+      = this->reportEngine.buildDays(days);
+  // Converts each day to its totals, with the current category of each
+  // product, and saves them in the background.
+  StringPool& pool = StringPool::getInstance();
+  for (size_t index = 0; index < reports.size(); ++index) {
+    const ReportEngine::ZReport& report = reports[index];
+    if (report.receiptCount == 0) {
+      continue;
+    }
+    SalesRollups::Totals totals;
+    totals.lastReceiptID = report.lastReceiptID;
+    totals.receiptCount = report.receiptCount;
+    totals.total = report.total;
+    std::copy(std::begin(report.byPaymentMethod)
+        , std::end(report.byPaymentMethod), totals.byPaymentMethod);
+    std::copy(std::begin(report.byHour), std::end(report.byHour)
+        , totals.byHour);
+    std::copy(std::begin(report.receiptsByHour)
+        , std::end(report.receiptsByHour), totals.receiptsByHour);
+    for (const auto& [key, sold] : report.products) {
+      const StringPool::StringID name = pool.intern(sold.name);
+      SalesRollups::ProductTotal& product = totals.products[
+          SalesRollups::ProductKey(sold.productID
+          , sold.productID == 0 ? name : StringPool::EMPTY)];
+      product.productID = sold.productID;
+      product.name = name;
+      product.quantity = sold.quantity;
+      product.amount = sold.amount;
+      const ProductIndex::Location* location
+          = this->productIndex.findByID(sold.productID);
+      SalesRollups::ItemTotal& category = totals.categories[location == nullptr
+          ? StringPool::EMPTY : pool.intern(location->category)];
+      category.quantity += sold.quantity;
+      category.amount += sold.amount;
+    }
+    const std::string& day = dayFiles[index].first;
+    this->backupModule.updateSalesRollupBackup(day, totals);
+    this->salesRollups.insertDay(day, std::move(totals));
+  }
+  qDebug() << "Totales de ventas de" << reports.size()
+      << "dias sumados de los segmentos.";
+  return dayFiles.back().first;
+}
+
+SalesRollups::Totals& POS_Model::rollupOfDay(const std::string& day) {
+  SalesRollups::Totals* totals = this->salesRollups.findDay(day);
+  if (totals != nullptr) {
+    return *totals;
+  }
+  // Loads the saved totals, a day without them starts empty.
+  SalesRollups::Totals loaded;
+  this->backupModule.getSalesRollupBackup(day, loaded);
+  return this->salesRollups.insertDay(day, std::move(loaded));
+}
+
+void POS_Model::addToSalesRollups(const Receipt& receipt) {
+  // Finds the current category of each product of the receipt.
+  StringPool& pool = StringPool::getInstance();
+  std::vector<StringPool::StringID> categories;
+  categories.reserve(receipt.getLines().size());
+  for (const Receipt::LineItem& line : receipt.getLines()) {
+    const ProductIndex::Location* location
+        = this->productIndex.findByID(line.productID);
+    categories.push_back(location == nullptr
+        ? StringPool::EMPTY : pool.intern(location->category));
+  }
+  const std::string day = SalesArchive::dayOf(receipt.getTimestamp());
+  SalesRollups::Totals& totals = this->rollupOfDay(day);
+  SalesRollups::addReceipt(totals, receipt, categories);
+  this->backupModule.updateSalesRollupBackup(day, totals);
+}
+
+void POS_Model::recordCommand(ModelCommand&& command) {
+  // The changes made by undo, redo and the recovery are logged by them.
+  if (this->applyingCommand) {
+    return;
+  }
+  this->logCommand(command);
+  // A new change discards the undone ones.
+  this->redoCommands.clear();
+  this->undoCommands.push_back(std::move(command));
+  if (this->undoCommands.size() > MAX_UNDO_COMMANDS) {
+    this->undoCommands.erase(this->undoCommands.begin());
+  }
+}
+
+void POS_Model::logCommand(const ModelCommand& command) {
+  // The change is flushed in the background, the model doesn't wait for it.
+  this->backupModule.appendModelCommand(command
+      , reportUnsaved(command.describe()));
+  ++this->loggedChanges;
+  this->checkpointIfNeeded();
+}
+
+bool POS_Model::deductSupplies(const std::vector<Supply>& deducted) {
+  bool found = true;
+  for (const Supply& deduction : deducted) {
+    auto supply = this->findSupply(deduction.getName());
+    if (supply == this->supplies.end()) {
+      found = false;
+      continue;
+    }
+    // The stock never goes below zero, as in the sale.
+    supply->setQuantity(supply->getQuantity()
+        - std::min(supply->getQuantity(), deduction.getQuantity()));
+  }
+  this->invalidateSnapshot(ModelSnapshot::SUPPLIES);
+  return found;
+}
+
+std::vector<Supply>::iterator POS_Model::findSupply(const std::string& name) {
+  return std::find_if(this->supplies.begin(), this->supplies.end()
+      , [&name](const Supply& supply) { return supply.getName() == name; });
+}
+
+bool POS_Model::apply(const ModelCommand& command) {
+  // Marks the change as already logged.
+  this->applyingCommand = true;
+  bool applied = false;
+  switch (command.type) {
+    case ModelCommand::ADD_PRODUCT:
+      applied = this->addProduct(command.category, command.products[0]);
+      break;
+    case ModelCommand::REMOVE_PRODUCT:
+      applied = this->removeProduct(command.category, command.products[0]);
+      break;
+    case ModelCommand::EDIT_PRODUCT:
+      applied = this->editProduct(command.category, command.products[0]
+          , command.newCategory, command.products[1]);
+      break;
+    case ModelCommand::ADD_CATEGORY:
+      // A restored category brings back its products too.
+      applied = this->addCategory(command.category);
+      for (size_t index = 0; applied && index < command.products.size()
+          ; ++index) {
+        this->addProduct(command.category, command.products[index]);
+      }
+      break;
+    case ModelCommand::REMOVE_CATEGORY:
+      applied = this->removeCategory(command.category);
+      break;
+    case ModelCommand::EDIT_CATEGORY:
+      applied = this->editCategory(command.category, command.newCategory);
+      break;
+    case ModelCommand::ADD_SUPPLY:
+      applied = this->addSupply(command.supplies[0]);
+      break;
+    case ModelCommand::REMOVE_SUPPLY:
+      applied = this->removeSupply(command.supplies[0]);
+      break;
+    case ModelCommand::EDIT_SUPPLY: {
+      // Keeps the stock moved by the sales since the change was made.
+      const auto current = this->findSupply(command.supplies[0].getName());
+      if (current == this->supplies.end()) {
+        break;
+      }
+      Supply target = command.supplies[1];
+      const int64_t moved = static_cast<int64_t>(current->getQuantity())
+          - static_cast<int64_t>(command.supplies[0].getQuantity());
+      target.setQuantity(static_cast<uint64_t>(std::max<int64_t>(0
+          , static_cast<int64_t>(target.getQuantity()) + moved)));
+      applied = this->editSupply(*current, target);
+      break;
+    }
+    case ModelCommand::DEDUCT_SUPPLIES:
+      applied = this->deductSupplies(command.supplies);
+      break;
+    case ModelCommand::ADD_USER:
+      applied = this->addUser(command.users[0]);
+      break;
+    case ModelCommand::REMOVE_USER:
+      applied = this->removeUser(command.users[0]);
+      break;
+    case ModelCommand::EDIT_USER:
+      applied = this->editUser(command.users[0], command.users[1]);
+      break;
+    default:
+      break;
+  }
+  this->applyingCommand = false;
+  return applied;
+}
+
+void POS_Model::replayModelCommands(const uint8_t registers) {
+  // Makes the logged changes in order, as they were made.
+  const std::vector<ModelCommand> commands
+      = this->backupModule.getModelCommands(registers);
+  for (const ModelCommand& command : commands) {
+    if (!this->apply(command)) {
+      // Keeps the lost change, the user is told after the start.
+      this->recoveryErrors.push_back(command.describe());
+      qDebug() << "No se pudo recuperar un cambio: "
+          << QString::fromStdString(this->recoveryErrors.back());
     }
   }
+  // The recovered changes are still in the log, until the next checkpoint.
+  for (const ModelCommand& command : commands) {
+    ++(command.type == ModelCommand::DEDUCT_SUPPLIES
+        ? this->loggedSales : this->loggedChanges);
+  }
+  if (!commands.empty()) {
+    qDebug() << "Cambios recuperados del registro:" << commands.size();
+  }
+}
+
+void POS_Model::checkpointIfNeeded() {
+  // Writes the snapshots, and empties the log, when it's long enough. The
+  // sales are counted apart, so they don't write the catalog every few sales.
+  if (this->loggedChanges >= CHECKPOINT_INTERVAL
+      || this->loggedSales >= SALES_CHECKPOINT_INTERVAL) {
+    this->backupModule.checkpointModelBackups(this->getSnapshot()
+        , this->nextProductID);
+    this->loggedChanges = 0;
+    this->loggedSales = 0;
+  }
+}
+
+std::shared_ptr<const ModelSnapshot> POS_Model::getSnapshot() {
+  // Returns the last version if nothing changed since it was taken.
+  if (this->staleRegisters == 0) {
+    return this->snapshot;
+  }
+  // Starts from the previous version, sharing all its registers.
+  std::shared_ptr<ModelSnapshot> next
+      = std::make_shared<ModelSnapshot>(*this->snapshot);
+  next->version = this->version;
+  // Copies only the registers changed since, once for all their changes.
+  if (this->staleRegisters & ModelSnapshot::PRODUCTS) {
+    next->categories
+        = std::make_shared<const ModelSnapshot::Categories>(this->categories);
+  }
+  if (this->staleRegisters & ModelSnapshot::SUPPLIES) {
+    next->supplies
+        = std::make_shared<const std::vector<Supply>>(this->supplies);
+  }
+  if (this->staleRegisters & ModelSnapshot::USERS) {
+    next->users
+        = std::make_shared<const std::vector<User>>(this->registeredUsers);
+  }
+  if (this->staleRegisters & ModelSnapshot::CASHIER) {
+    next->cashierSession
+        = std::make_shared<const CashierSession>(this->cashierSession);
+    next->lastReceiptID = this->currentReceiptID;
+  }
+  // The readers keep the versions they hold.
+  this->snapshot = std::move(next);
+  this->staleRegisters = 0;
+  return this->snapshot;
+}
+
+void POS_Model::invalidateSnapshot(const uint8_t changed) {
+  // The registers are copied when a reader asks for the new version.
+  this->staleRegisters |= changed;
+  ++this->version;
 }
 
 bool POS_Model::emplaceProduct(const std::string productCategory
     , const Product& product
     , std::map<std::string, std::vector<Product>>& categoriesRegister) {
-  // Transverse all the registered product categories.
-  for (auto& category : categoriesRegister) {
-    // Checks if the category matches.
-    if (category.first == productCategory) {
-      // Transverse all the registered products in the category.
-      for (auto& registeredProduct : category.second) {
-        // check if there's a registered product in the category.
-        if (registeredProduct == product) {
-          qDebug() << "Ya existe un elemento igual: "
-                   << registeredProduct.getName() << "," << product.getName();
-          return false;
-        }
-      }
-      qDebug() << "Categoria anadiendo producto a la categoria: "
-          << category.first;
-      // Adds the created product into the vector of registered products.
-      category.second.emplace_back(product);
-      this->products.clear();     
-      this->obtainProducts(this->products, this->categories);      
-      return true;
-    }
+  // Looks up the category in the register.
+  auto category = categoriesRegister.find(productCategory);
+  if (category == categoriesRegister.end()) {
+    return false;
   }
-  return false;
+  // Checks in the index if there's a registered product with the same name.
+  if (this->productIndex.findByName(product.getName()) != nullptr) {
+    qDebug() << "Ya existe un elemento igual: " << product.getName();
+    return false;
+  }
+  qDebug() << "Categoria anadiendo producto a la categoria: "
+      << category->first;
+  // Adds the created product into the vector of registered products.
+  category->second.emplace_back(product);
+  // New products get the next ID, the edited and restored ones keep theirs.
+  Product& added = category->second.back();
+  if (added.getID() == 0
+      || this->productIndex.findByID(added.getID()) != nullptr) {
+    added.setID(this->nextProductID++);
+  } else if (added.getID() >= this->nextProductID) {
+    this->nextProductID = added.getID() + 1;
+  }
+  this->productIndex.insert(category->first, category->second.size() - 1
+      , added);
+  this->productView.productInserted(category->first);
+  return true;
 }
 
 bool POS_Model::eraseProduct(const std::string productCategory
     , const Product& product
-    , std::map<std::string, std::vector<Product>>& categoriesRegister) {
-  // Transverse all the registered product categories.
-  for (auto& category : categoriesRegister) {
-    // Checks if the category matches.
-    qDebug() << category.first << ":" << productCategory;
-    if (category.first == productCategory) {
-      // Transverse all the registered products in the category.
-      for (size_t i = 0; i < category.second.size(); ++i) {
-        // Check if there's a registered product in the category that matches
-        // the product to delete.
-        if (category.second[i] == product) {
-          // Erase the product from the category.
-          category.second.erase(category.second.begin() + i);
-          this->products.clear();
-          this->obtainProducts(this->products, this->categories);
-          return true;
-        }
-      }
-    }
+    , std::map<std::string, std::vector<Product>>& categoriesRegister
+    , Product& erased) {
+  // Looks up the location of the product in the index.
+  const ProductIndex::Location* location
+      = this->productIndex.findByName(product.getName());
+  if (location == nullptr || location->category != productCategory) {
+    return false;
   }
-  return false;
+  auto category = categoriesRegister.find(productCategory);
+  if (category == categoriesRegister.end()) {
+    return false;
+  }
+  // Erase the product from the category, then from the index.
+  const size_t position = location->position;
+  erased = std::move(category->second[position]);
+  category->second.erase(category->second.begin() + position);
+  this->recipeBook.forgetRecipe(erased.getName());
+  this->productIndex.erase(productCategory, position, erased
+      , category->second);
+  this->productView.productErased(productCategory);
+  return true;
 }
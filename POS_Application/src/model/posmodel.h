@@ -2,16 +2,28 @@
 #ifndef POSMODEL_H
 #define POSMODEL_H
 
+#include <QDate>
+#include <QDateTime>
 #include <QString>
 #include <QPrinter>
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "user.h"
 #include "backupmodule.h"
+#include "cashiersession.h"
+#include "modelcommand.h"
+#include "modelsnapshot.h"
+#include "pageview.h"
 #include "product.h"
+#include "productindex.h"
+#include "productview.h"
 #include "receipt.h"
+#include "recipebook.h"
+#include "reportengine.h"
+#include "salesrollups.h"
 
 /**
  * @class POS_Model
@@ -20,23 +32,57 @@
  * POS_Model is responsible for handling products, categories, supplies and user data.
  * It interacts with the BackupModule to load and persist data, and provides functions
  * for adding, editing, and removing items in the system.
+ *
+ * Every change of the catalog, the supplies or the users is a ModelCommand,
+ * appended to the change log of the BackupModule and kept to be undone by
+ * applying its inverse.
+ *
+ * The model is changed only by the GUI thread. A reader that works in another
+ * thread, like the catalog export, takes an immutable snapshot of the
+ * registers with getSnapshot() and reads it without locks while the model
+ * keeps changing. The changes only mark their registers, a register is
+ * copied when a reader asks for a version newer than the last one taken, so
+ * the sales never copy the registers.
  */
 class POS_Model {
   // Deleted copy constructor and assignment operator to prevent copying.
   POS_Model(const POS_Model&) = delete;
   POS_Model operator=(const POS_Model) = delete;
+  
+public:
+  static const size_t MAX_UNDO_COMMANDS = 100;   ///< Changes kept to undo.
+  static const size_t CHECKPOINT_INTERVAL = 256; ///< Changes per snapshot.
+  /// Sales per snapshot, their deductions of the supplies are small.
+  static const size_t SALES_CHECKPOINT_INTERVAL = 4096;
 
 private:
   User user = User(); ///< Currently logged user.
   std::vector<User> registeredUsers;   ///< Registered users loaded from backup.
   BackupModule& backupModule; ///< Reference to the backup module for data persistence.
   std::map<std::string, std::vector<Product>> categories; ///< Map of product categories to their products.
-  std::vector<std::pair<std::string, Product>> products;   ///< Vector of products for interface display.
+  ProductView productView; ///< Flat view of the products for the display.
+  ProductIndex productIndex; ///< Locations of the products by name and ID.
+  uint64_t nextProductID = 1; ///< ID of the next added product.
   std::vector<Supply> supplies; ///< Inventory of supplies.
+  RecipeBook recipeBook; ///< Compiled recipes, deduct the supplies sold.
   std::vector<Receipt> ongoingReceipts;
-  std::vector<Receipt> registeredReceipts;
   size_t currentReceiptID;
-  bool cashierOpened = false;
+  CashierSession cashierSession; ///< Running totals of the opened cashier.
+  SalesRollups salesRollups; ///< Sales totals by day, for the dashboards.
+  ReportEngine reportEngine; ///< Builds the reports of the sales segments.
+  std::vector<ModelCommand> undoCommands; ///< Changes to undo, newest last.
+  std::vector<ModelCommand> redoCommands; ///< Undone changes, newest last.
+  bool applyingCommand = false; ///< True while a logged change is applied.
+  size_t loggedChanges = 0;  ///< Changes logged since the last checkpoint.
+  size_t loggedSales = 0;    ///< Sales logged since the last checkpoint.
+  /// Logged changes that could not be recovered by the last start.
+  std::vector<std::string> recoveryErrors;
+  /// Last version of the registers taken by a reader.
+  std::shared_ptr<const ModelSnapshot> snapshot
+      = std::make_shared<const ModelSnapshot>();
+  uint64_t version = 0;  ///< Number of the current version of the registers.
+  /// Registers changed since the last snapshot, ModelSnapshot::Register.
+  uint8_t staleRegisters = ModelSnapshot::ALL;
   bool started = false;       ///< Flag indicating if the model has been started.
   
 public:
@@ -50,7 +96,15 @@ public:
    * @brief Checks if a cashier has been opened.
    * @return True if the cashier is opened.
    */
-  inline bool isCashierOpened() { return this->cashierOpened;};
+  inline bool isCashierOpened() { return this->cashierSession.isOpen();};
+  
+  /**
+   * @brief Retrieves the session of the cashier.
+   * @return Reference to the cashier session and its totals.
+   */
+  const CashierSession& getCashierSession() const {
+    return this->cashierSession;
+  }
   
   size_t getPageAccess(const size_t page);
   
@@ -62,20 +116,34 @@ public:
   
   const size_t getNextReceiptID() {return this->currentReceiptID + 1;};
   
+  /**
+   * @brief Retrieves the current version of the registers.
+   *
+   * Called by the GUI thread, that hands the snapshot to the reader thread.
+   * Copies the registers changed since the last snapshot was taken and shares
+   * the others. The snapshot never changes, it stays valid while it's held
+   * even if the model changes.
+   *
+   * @return The current snapshot.
+   */
+  std::shared_ptr<const ModelSnapshot> getSnapshot();
+  
   /**
    * @brief Retrieves the registered products categorized.
    * @return Reference to the map of registered products.
    */
-  std::map<std::string, std::vector<Product>>& getRegisteredProductsMap() {
+  const ModelSnapshot::Categories& getRegisteredProductsMap() const {
     return this->categories;
   }
   
   /**
-   * @brief Retrieves the products vector for UI display.
-   * @return Reference to the vector of registered products.
+   * @brief Retrieves a product of the flat products view, without copying it.
+   *
+   * @param index Position of the product, lower than the number of products.
+   * @return The product and its category, valid until the products change.
    */
-  std::vector<std::pair<std::string, Product>>& getRegisteredProductsVector() {
-    return this->products;
+  ProductView::Row getProductRow(const size_t index) const {
+    return this->productView.at(index);
   }
   
   /**
@@ -88,19 +156,23 @@ public:
    * @brief Retrieves the registered supplies.
    * @return Reference to the vector of supplies.
    */
-  std::vector<Supply>& getRegisteredSupplies() { return this->supplies; }
+  const std::vector<Supply>& getRegisteredSupplies() const {
+    return this->supplies;
+  }
   
   /**
    * @brief Retrieves the registered users.
    * @return Reference to the vector of users.
    */
-  std::vector<User>& getRegisteredUsers() { return this->registeredUsers; }
+  const std::vector<User>& getRegisteredUsers() const {
+    return this->registeredUsers;
+  }
   
   /**
    * @brief Retrieves the total number of registered products.
    * @return Number of products.
    */
-  size_t getNumberOfProducts() { return this->products.size(); }
+  size_t getNumberOfProducts() { return this->productView.size(); }
   
   /**
    * @brief Retrieves the total number of registered categories.
@@ -131,55 +203,127 @@ public:
   /**
    * @brief Retrieves products for a given page.
    *
-   * Paginates the products vector based on the specified page index and items per page.
+   * Paginates the products view based on the specified page index and items per page.
+   * The rows point into the registers, they are valid until the registers
+   * change.
    *
    * @param pageIndex The page index.
    * @param itemsPerPage Number of products per page.
-   * @return Vector of products for the specified page.
+   * @return Rows of the products for the specified page.
    */
-  std::vector<std::pair<std::string, Product>> getProductsForPage(
-      const size_t pageIndex, const size_t itemsPerPage);
+  std::vector<ProductView::Row> getProductsForPage(
+      const size_t pageIndex, const size_t itemsPerPage) const {
+    return this->productView.page(pageIndex, itemsPerPage);
+  }
   
   /**
    * @brief Retrieves product categories for a given page.
    *
    * Paginates the category names based on the specified page index and items per page.
+   * The view is valid until the registers change.
    *
    * @param pageIndex The page index.
    * @param itemsPerPage Number of items per page.
-   * @return Vector of category names for the page.
+   * @return View of the categories entries for the page.
    */
-  std::vector<std::string> getCategoriesForPage(
-      const size_t pageIndex, const size_t itemsPerPage);
+  PageView<ProductView::Categories::const_iterator> getCategoriesForPage(
+      const size_t pageIndex, const size_t itemsPerPage) const {
+    return this->productView.categoryPage(pageIndex, itemsPerPage);
+  }
   
   /**
    * @brief Retrieves supplies for a given page.
    *
    * Paginates the supplies vector based on the specified page index and items per page.
+   * The view is valid until the registers change.
    *
    * @param pageIndex The page index.
    * @param itemsPerPage Number of supplies per page.
-   * @return Vector of supplies for the specified page.
+   * @return View of the supplies for the specified page.
    */
-  std::vector<Supply> getSuppliesForPage(
-      const size_t pageIndex, const size_t itemsPerPage);
+  PageView<Supply> getSuppliesForPage(
+      const size_t pageIndex, const size_t itemsPerPage) const {
+    return PageView<Supply>(this->supplies, pageIndex, itemsPerPage);
+  }
   
   /**
    * @brief Retrieves users for a given page.
    *
    * Paginates the users vector based on the specified page index and items per page.
+   * The view is valid until the registers change.
    *
    * @param pageIndex The page index.
    * @param itemsPerPage Number of users per page.
-   * @return Vector of users for the specified page.
+   * @return View of the users for the specified page.
    */
-  std::vector<User> getUsersForPage(
-      const size_t pageIndex, const size_t itemsPerPage);
+  PageView<User> getUsersForPage(
+      const size_t pageIndex, const size_t itemsPerPage) const {
+    return PageView<User>(this->registeredUsers, pageIndex, itemsPerPage);
+  }
   
   const std::vector<Receipt>& getOngoingReceipts() const {
     return this->ongoingReceipts;
   }
   
+  /**
+   * @brief Finds a registered receipt by its ID.
+   *
+   * The receipts history is not kept in memory, the receipt is read from the
+   * receipts archive.
+   *
+   * @param id ID of the receipt.
+   * @param receipt Receipt where the found receipt is stored.
+   * @return True if the receipt was found.
+   */
+  bool findReceipt(const size_t id, Receipt& receipt);
+  
+  /**
+   * @brief Gets the sales totals of a range of days.
+   *
+   * Merges the totals kept for each day, loading the days that weren't
+   * needed before. The receipts history is never read.
+   *
+   * @param firstDay First day of the range.
+   * @param lastDay Last day of the range, included.
+   * @return Totals by product, category, hour and payment method.
+   */
+  SalesRollups::Totals getSalesSummary(const QDate& firstDay
+      , const QDate& lastDay);
+  
+  /**
+   * @brief Builds the Z report of a range of days.
+   *
+   * The report is built in parallel from the sales segments of the days,
+   * that hold the receipts of the closed cashier sessions. It waits for the
+   * queued sales and only reads the segments, never the model, so it's
+   * called from a thread other than the GUI one.
+   *
+   * @param firstDay First day of the range.
+   * @param lastDay Last day of the range, included.
+   * @return Totals by payment method, product, hour and user.
+   */
+  ReportEngine::ZReport getZReport(const QDate& firstDay
+      , const QDate& lastDay);
+  
+  /**
+   * @brief Gets the number of receipts in the history.
+   * @return Number of registered receipts.
+   */
+  size_t getReceiptsCount();
+  
+  /**
+   * @brief Searches the receipts history, the newest receipts first.
+   *
+   * The search is answered by the indexes of the receipts backup, only the
+   * found receipts are read from the history.
+   *
+   * @param query Fields of the search, the empty ones match any receipt.
+   * @param maxResults Maximum number of receipts returned.
+   * @return The found receipts.
+   */
+  std::vector<Receipt> searchReceipts(const ReceiptSearchIndex::Query& query
+      , const size_t maxResults);
+  
 public:
   /**
    * @brief Retrieves the singleton instance of POS_Model.
@@ -208,18 +352,36 @@ public:
    * @brief Shuts down the POS model.
    *
    * Saves the current product and supply data to backup files and clears internal data.
+   * An opened cashier stays opened, its session is restored on the next
+   * start.
    */
   void shutdown();
   
+  /**
+   * @brief Opens the cashier with the opening cash, by the current user.
+   */
   void openCashier();
   
+  /**
+   * @brief Closes the cashier and archives its receipts.
+   */
   void closeCashier();
   
+  /**
+   * @brief Adds an expense to the opened cashier.
+   *
+   * @param name Description of the expense.
+   * @param amount Amount of the expense.
+   * @return The added expense.
+   */
+  CashierSession::Expense addExpense(const std::string& name
+      , const Money amount);
+  
   
   /**
    * @brief Finds a product by its name.
    *
-   * Searches all product categories for a product matching the provided name.
+   * Looks up the product in the products index, in constant time.
    *
    * @param productName The name of the product to search for.
    * @return Reference to the found Product.
@@ -248,6 +410,18 @@ public:
    */
   bool addCategory(const std::string newCategory);
   
+  /**
+   * @brief Adds the products of a text catalog.
+   *
+   * The missing categories are created, the products with a registered name
+   * are skipped and the new ones get their IDs.
+   *
+   * @param filename Path to the text catalog.
+   * @return Number of products added.
+   * @throws std::runtime_error If the file cannot be opened or parsed.
+   */
+  size_t importProducts(const std::string& filename);
+  
   /**
    * @brief Adds a new supply to the inventory.
    *
@@ -258,7 +432,19 @@ public:
    */
   bool addSupply(const Supply newSupply);
   
-  bool generateReceipt(const Order& order);
+  /**
+   * @brief Registers the receipt of an order and deducts its supplies.
+   *
+   * The supplies used by the whole order are deducted in a single pass over
+   * the compiled recipes. The supplies without enough stock are left at zero
+   * and reported.
+   *
+   * @param order The paid order.
+   * @param shortages Replaced with the supplies that were not in stock, each
+   *     with the quantity that was missing.
+   * @return True if the receipt was registered.
+   */
+  bool generateReceipt(const Order& order, std::vector<Supply>& shortages);
   
   /**
    * @brief Adds a new user to the pos system.
@@ -359,6 +545,39 @@ public:
    */
   bool editUser(const User& oldUser, const User& newUser);
   
+  /**
+   * @brief Undoes the last change, by applying its inverse.
+   *
+   * A change whose data was changed since, so its inverse doesn't apply, is
+   * discarded.
+   *
+   * @param registers Flags of the registers that may be changed,
+   *     ModelSnapshot::Register.
+   * @return True if the last change was of the registers and was undone.
+   */
+  bool undo(const uint8_t registers = ModelSnapshot::ALL);
+  
+  /**
+   * @brief Makes again the last undone change.
+   *
+   * @param registers Flags of the registers that may be changed,
+   *     ModelSnapshot::Register.
+   * @return True if the last undone change was of the registers and was made.
+   */
+  bool redo(const uint8_t registers = ModelSnapshot::ALL);
+  
+  /**
+   * @brief Gets the logged changes that the last start could not recover.
+   *
+   * A change that doesn't apply over its snapshot means that the backups
+   * were damaged or edited, the user must be told.
+   *
+   * @return Description of each change that was lost.
+   */
+  const std::vector<std::string>& getRecoveryErrors() const {
+    return this->recoveryErrors;
+  }
+  
   /**
    * @brief Formats product ingredients for display.
    *
@@ -407,21 +626,120 @@ private:
   void loadSystemBackups();
   
   /**
-   * @brief Populates the products vector from category registers.
+   * @brief Restores the cashier session saved by the last run.
+   *
+   * Reads the receipts of an opened session back from the receipts archive,
+   * adding them to its totals again.
+   */
+  void restoreCashierSession();
+  
+  /**
+   * @brief Adds the receipts missing from the sales totals.
+   *
+   * Walks back from the last receipt until it finds one already added to
+   * the totals of its day, or one older than the last day with saved
+   * totals, and adds the newer ones. The first start with the totals adds
+   * up the closed days from the sales segments instead.
+   */
+  void restoreSalesRollups();
+  
+  /**
+   * @brief Builds and saves the totals of every day of the sales segments.
+   *
+   * The segments are aggregated by their columns on the threads of the
+   * report engine, no receipt is decoded.
+   *
+   * @return Day key of the latest day, empty if there are no segments.
+   */
+  std::string backfillSalesRollups();
+  
+  /**
+   * @brief Gets the sales totals of a day, loading them if needed.
+   * @param day Day key as yyyyMMdd.
+   * @return The totals of the day, empty if it has no sales.
+   */
+  SalesRollups::Totals& rollupOfDay(const std::string& day);
+  
+  /**
+   * @brief Adds a receipt to the sales totals of its day, and saves them.
+   * @param receipt The receipt.
+   */
+  void addToSalesRollups(const Receipt& receipt);
+  
+  /**
+   * @brief Logs a change made by a public function, so it can be undone.
+   *
+   * The changes made by apply() are logged by its caller. Writes the
+   * snapshots when the log is long enough.
+   *
+   * @param command The change.
+   */
+  void recordCommand(ModelCommand&& command);
+  
+  /**
+   * @brief Appends a change to the log, without keeping it to be undone.
+   *
+   * Writes the snapshots when the log is long enough.
+   *
+   * @param command The change.
+   */
+  void logCommand(const ModelCommand& command);
+  
+  /**
+   * @brief Finds a registered supply by its name.
+   *
+   * The supplies are identified by their name, their stock changes with
+   * every sale.
+   *
+   * @param name Name of the supply.
+   * @return Iterator to the supply, or the end of the supplies.
+   */
+  std::vector<Supply>::iterator findSupply(const std::string& name);
+  
+  /**
+   * @brief Takes logged quantities from the stock of the supplies.
+   *
+   * @param deducted Supplies with the quantity taken from each one.
+   * @return True if every supply was found.
+   */
+  bool deductSupplies(const std::vector<Supply>& deducted);
+  
+  /**
+   * @brief Makes a logged change through the public functions.
+   * @param command The change.
+   * @return True if the change was made.
+   */
+  bool apply(const ModelCommand& command);
+  
+  /**
+   * @brief Makes the logged changes that the snapshots of some registers miss.
+   * @param registers Flags of the registers, ModelSnapshot::Register.
+   */
+  void replayModelCommands(const uint8_t registers);
+  
+  /**
+   * @brief Writes the snapshots of the registers when the log is long.
+   *
+   * The snapshots are written in the background, from the current version of
+   * the registers.
+   */
+  void checkpointIfNeeded();
+  
+  /**
+   * @brief Starts a new version of the registers after a change.
    *
-   * Iterates over the categories map and extracts products into a vector for UI display.
+   * Only marks the changed registers, getSnapshot() copies them when a
+   * reader asks for the new version.
    *
-   * @param existingProducts Vector to store the extracted products.
-   * @param categoryRegisters Map of categories to products.
+   * @param changed Flags of the changed registers, ModelSnapshot::Register.
    */
-  void obtainProducts(
-      std::vector<std::pair<std::string, Product>>& existingProducts
-      , const std::map<std::string, std::vector<Product>>& categoryRegisters);
+  void invalidateSnapshot(const uint8_t changed);
   
   /**
    * @brief Emplaces a product into the specified category.
    *
-   * Adds a product to the category register if it does not already exist.
+   * Adds a product to the category register if there is no product with its
+   * name, and indexes it.
    *
    * @param productCategory The target category.
    * @param product The Product to insert.
@@ -434,15 +752,18 @@ private:
   /**
    * @brief Erases a product from the specified category.
    *
-   * Removes a product from the category register.
+   * Removes a product from the category register, found through the products
+   * index by its name.
    *
    * @param productCategory The category from which to remove the product.
    * @param product The Product to remove.
    * @param categoriesRegister The map of categories to products.
+   * @param erased Where the removed product is stored.
    * @return True if the product was successfully removed.
    */
   bool eraseProduct(const std::string productCategory, const Product& product,
-      std::map<std::string, std::vector<Product>>& categoriesRegister);
+      std::map<std::string, std::vector<Product>>& categoriesRegister
+      , Product& erased);
 };
 
 #endif // APPMODEL_H
@@ -13,7 +13,7 @@ std::ostream& operator<<(std::ostream& os, const Product& product) {
   }
   
   // Prints the product's price.
-  os << "Price: $" << product.getPrice() << std::endl;
+  os << "Price: $" << product.getPrice().toString() << std::endl;
   
   return os;
 }
@@ -2,10 +2,12 @@
 #ifndef PRODUCT_H
 #define PRODUCT_H
 
-#include <QPixmap>
 #include <vector>
 #include <iostream>
+#include <utility>
 
+#include "imagestore.h"
+#include "money.h"
 #include "supply.h"
 
 /**
@@ -23,8 +25,8 @@ private:
   uint64_t id = 0; ///< Unique identifier for the product.
   std::string name = ""; ///< Name of the product.
   std::vector<Supply> ingredients; ///< List of ingredients for the product.
-  double price = 0; ///< Price of the product.
-  QPixmap image;
+  Money price; ///< Price of the product.
+  ImageStore::ImageID image = ImageStore::NO_IMAGE; ///< Image in the store.
 
   // Class constructor.
 public:
@@ -38,16 +40,18 @@ public:
    * @param myName The name of the product (default is an empty string).
    * @param myIngredients The list of ingredients for the product (default is an empty vector).
    * @param myPrice The price of the product (default is 0).
+   * @param myImage The ID of the product image in the ImageStore (default is
+   * no image).
    */
   Product(uint64_t myID = 0
       , const std::string &myName = ""
-      , const std::vector<Supply> myIngredients
+      , std::vector<Supply> myIngredients
           = std::vector<Supply>()
-      , double myPrice = 0
-      , const QPixmap myImage = QPixmap())
+      , const Money myPrice = Money()
+      , const ImageStore::ImageID myImage = ImageStore::NO_IMAGE)
       : id(myID)
       , name(myName)
-      , ingredients(myIngredients)
+      , ingredients(std::move(myIngredients))
       , price(myPrice)
       , image(myImage)  {
   }
@@ -82,13 +86,24 @@ public:
    * 
    * @return The product's price.
    */
-  inline const double getPrice() const {return this->price;}
+  inline Money getPrice() const {return this->price;}
   
-  
-  inline const QPixmap& getImage() const {return this->image;}
+  /**
+   * @brief Gets the image of the product.
+   * 
+   * @return The ID of the image in the ImageStore.
+   */
+  inline ImageStore::ImageID getImage() const {return this->image;}
     
   // Class Setters.
 public:
+  /**
+   * @brief Sets the unique identifier of the product.
+   * 
+   * @param newID The new ID of the product.
+   */
+  inline void setID(const uint64_t newID) {this->id = newID;}
+  
   /**
    * @brief Sets the name of the product.
    * 
@@ -112,7 +127,7 @@ public:
    * 
    * @param newPrice The new price of the product.
    */
-  inline void setPrice(const double newPrice) {this->price = newPrice;}
+  inline void setPrice(const Money newPrice) {this->price = newPrice;}
   
 // Class Operators.
 public:
@@ -125,6 +140,11 @@ public:
    */
   friend std::ostream& operator<<(std::ostream& os, const Product& product);
   
+  // Moving a product moves its ingredients instead of copying them.
+  Product(const Product& other) = default;
+  Product(Product&& other) = default;
+  Product& operator=(Product&& other) = default;
+  
   /**
    * @brief Overloads the assignment operator to copy the values of another product.
    * 
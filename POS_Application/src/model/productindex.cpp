@@ -0,0 +1,62 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "productindex.h"
+
+void ProductIndex::rebuild(
+    const std::map<std::string, std::vector<Product>>& categories) {
+  this->clear();
+  // Indexes every product of every category.
+  for (const auto& [category, products] : categories) {
+    this->indexCategory(category, products, 0);
+  }
+}
+
+void ProductIndex::clear() {
+  this->byName.clear();
+  this->byID.clear();
+}
+
+const ProductIndex::Location* ProductIndex::findByName(
+    const std::string& name) const {
+  const auto found = this->byName.find(name);
+  return found != this->byName.end() ? &found->second : nullptr;
+}
+
+const ProductIndex::Location* ProductIndex::findByID(const uint64_t id) const {
+  const auto found = this->byID.find(id);
+  return found != this->byID.end() ? &found->second : nullptr;
+}
+
+void ProductIndex::insert(const std::string& category, const size_t position
+    , const Product& product) {
+  const Location location{category, position};
+  this->byName[product.getName()] = location;
+  this->byID[product.getID()] = location;
+}
+
+void ProductIndex::erase(const std::string& category, const size_t position
+    , const Product& product, const std::vector<Product>& products) {
+  this->byName.erase(product.getName());
+  this->byID.erase(product.getID());
+  // The following products moved one position back.
+  this->indexCategory(category, products, position);
+}
+
+void ProductIndex::eraseCategory(const std::vector<Product>& products) {
+  for (const Product& product : products) {
+    this->byName.erase(product.getName());
+    this->byID.erase(product.getID());
+  }
+}
+
+void ProductIndex::renameCategory(const std::string& newCategory
+    , const std::vector<Product>& products) {
+  // The positions don't change, the products are indexed to the new name.
+  this->indexCategory(newCategory, products, 0);
+}
+
+void ProductIndex::indexCategory(const std::string& category
+    , const std::vector<Product>& products, const size_t first) {
+  for (size_t position = first; position < products.size(); ++position) {
+    this->insert(category, position, products[position]);
+  }
+}
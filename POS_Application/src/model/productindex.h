@@ -0,0 +1,129 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef PRODUCTINDEX_H
+#define PRODUCTINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "product.h"
+
+/**
+ * @class ProductIndex
+ * @brief Hash index from the name and ID of the products to their location.
+ *
+ * The location of a product is its category and its position in the vector
+ * of the category, so a product is found without walking the categories.
+ * The index is kept up to date by the model on every insertion, deletion
+ * and rename of the categories register.
+ *
+ * The names and the IDs are unique, each one identifies a single product.
+ */
+class ProductIndex {
+public:
+  /**
+   * @struct Location
+   * @brief Place of a product in the categories register.
+   */
+  struct Location {
+    std::string category;  ///< Category of the product.
+    size_t position = 0;   ///< Position in the vector of the category.
+  };
+
+private:
+  std::unordered_map<std::string, Location> byName; ///< Locations by name.
+  std::unordered_map<uint64_t, Location> byID;      ///< Locations by ID.
+
+public:
+  /**
+   * @brief Constructs an empty index.
+   */
+  ProductIndex() = default;
+
+  /**
+   * @brief Indexes again all the products of a categories register.
+   *
+   * @param categories The categories register.
+   */
+  void rebuild(const std::map<std::string, std::vector<Product>>& categories);
+
+  /**
+   * @brief Removes all the products from the index.
+   */
+  void clear();
+
+  /**
+   * @brief Finds the location of a product by its name.
+   *
+   * @param name Name of the product.
+   * @return Location of the product, or nullptr if it isn't indexed.
+   */
+  const Location* findByName(const std::string& name) const;
+
+  /**
+   * @brief Finds the location of a product by its ID.
+   *
+   * @param id ID of the product.
+   * @return Location of the product, or nullptr if it isn't indexed.
+   */
+  const Location* findByID(const uint64_t id) const;
+
+  /**
+   * @brief Indexes a product appended to its category.
+   *
+   * @param category Category of the product.
+   * @param position Position of the product in the category.
+   * @param product The product.
+   */
+  void insert(const std::string& category, const size_t position
+      , const Product& product);
+
+  /**
+   * @brief Removes a product erased from its category.
+   *
+   * The products that followed it moved one position back, they are indexed
+   * again.
+   *
+   * @param category Category of the product.
+   * @param position Position that the product had in the category.
+   * @param product The erased product.
+   * @param products Products of the category, after the deletion.
+   */
+  void erase(const std::string& category, const size_t position
+      , const Product& product, const std::vector<Product>& products);
+
+  /**
+   * @brief Removes all the products of a category.
+   *
+   * @param products Products of the category.
+   */
+  void eraseCategory(const std::vector<Product>& products);
+
+  /**
+   * @brief Moves the products of a category to its new name.
+   *
+   * @param newCategory New name of the category.
+   * @param products Products of the category.
+   */
+  void renameCategory(const std::string& newCategory
+      , const std::vector<Product>& products);
+
+private:
+  /**
+   * @brief Indexes the products of a category from a position to the end.
+   *
+   * @param category The category.
+   * @param products Products of the category.
+   * @param first Position of the first product to index.
+   */
+  void indexCategory(const std::string& category
+      , const std::vector<Product>& products, const size_t first);
+
+  // Copy and assignment constructors are disabled.
+  ProductIndex(const ProductIndex&) = delete;
+  ProductIndex& operator=(const ProductIndex&) = delete;
+};
+
+#endif // PRODUCTINDEX_H
@@ -0,0 +1,104 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "productview.h"
+
+#include <algorithm>
+
+void ProductView::rebuild(const Categories& categories) {
+  this->order.clear();
+  this->order.reserve(categories.size());
+  this->tree.assign(categories.size() + 1, 0);
+  this->count = 0;
+  // Builds the Fenwick tree in linear time, from the sizes of the categories.
+  for (auto category = categories.begin(); category != categories.end()
+      ; ++category) {
+    this->order.push_back(category);
+    const size_t node = this->order.size();
+    this->tree[node] += category->second.size();
+    const size_t parent = node + (node & (~node + 1));
+    if (parent < this->tree.size()) {
+      this->tree[parent] += this->tree[node];
+    }
+    this->count += category->second.size();
+  }
+}
+
+void ProductView::productInserted(const std::string& category) {
+  const size_t ordinal = this->ordinalOf(category);
+  if (ordinal < this->order.size()) {
+    this->add(ordinal, 1);
+    ++this->count;
+  }
+}
+
+void ProductView::productErased(const std::string& category) {
+  const size_t ordinal = this->ordinalOf(category);
+  if (ordinal < this->order.size()) {
+    this->add(ordinal, static_cast<size_t>(-1));
+    --this->count;
+  }
+}
+
+ProductView::Row ProductView::at(const size_t index) const {
+  // Descends the tree to the category that contains the position.
+  size_t node = 0;
+  size_t remaining = index;
+  size_t step = 1;
+  while (step * 2 < this->tree.size()) {
+    step *= 2;
+  }
+  for (; step > 0; step /= 2) {
+    if (node + step < this->tree.size()
+        && this->tree[node + step] <= remaining) {
+      node += step;
+      remaining -= this->tree[node];
+    }
+  }
+  // The node is the number of whole categories before the position.
+  const Categories::const_iterator category = this->order[node];
+  return Row{&category->first, &category->second[remaining]};
+}
+
+std::vector<ProductView::Row> ProductView::page(const size_t pageIndex
+    , const size_t itemsPerPage) const {
+  std::vector<Row> rows;
+  const size_t start = pageIndex * itemsPerPage;
+  if (start >= this->count) {
+    return rows;
+  }
+  const size_t end = std::min(start + itemsPerPage, this->count);
+  rows.reserve(end - start);
+  // Positions the page on its first product.
+  Row row = this->at(start);
+  size_t ordinal = this->ordinalOf(*row.category);
+  size_t position = static_cast<size_t>(
+      row.product - this->order[ordinal]->second.data());
+  for (size_t index = start; index < end; ++index) {
+    // Skips to the next category with products at the end of a category.
+    while (position == this->order[ordinal]->second.size()) {
+      ++ordinal;
+      position = 0;
+    }
+    const Categories::const_iterator category = this->order[ordinal];
+    rows.push_back(Row{&category->first, &category->second[position]});
+    ++position;
+  }
+  return rows;
+}
+
+size_t ProductView::ordinalOf(const std::string& category) const {
+  // The categories are in the order of the register, sorted by name.
+  const auto found = std::lower_bound(this->order.begin(), this->order.end()
+      , category, [](const Categories::const_iterator& entry
+          , const std::string& name) { return entry->first < name; });
+  if (found == this->order.end() || (*found)->first != category) {
+    return this->order.size();
+  }
+  return static_cast<size_t>(found - this->order.begin());
+}
+
+void ProductView::add(const size_t ordinal, const size_t delta) {
+  for (size_t node = ordinal + 1; node < this->tree.size()
+      ; node += node & (~node + 1)) {
+    this->tree[node] += delta;
+  }
+}
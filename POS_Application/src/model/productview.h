@@ -0,0 +1,145 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef PRODUCTVIEW_H
+#define PRODUCTVIEW_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pageview.h"
+#include "product.h"
+
+/**
+ * @class ProductView
+ * @brief Flat, paginated view of the products of the categories register.
+ *
+ * The view doesn't copy the products, it maps a flat position to the
+ * category and the position of the product in the register. The number of
+ * products of each category, in the order of the register, is kept in a
+ * Fenwick tree, so a row is found and a single insertion or deletion is
+ * registered in logarithmic time.
+ *
+ * The view also keeps the categories in the order of the register, so a
+ * page of categories is positioned in constant time.
+ *
+ * Adding, removing or renaming a category changes the order of the
+ * categories, the view must be rebuilt then.
+ */
+class ProductView {
+public:
+  /// Register of the products by category.
+  typedef std::map<std::string, std::vector<Product>> Categories;
+
+  /**
+   * @struct Row
+   * @brief Product in a position of the view.
+   *
+   * The pointers are valid until the register changes.
+   */
+  struct Row {
+    const std::string* category = nullptr;  ///< Category of the product.
+    const Product* product = nullptr;       ///< The product.
+  };
+
+private:
+  std::vector<Categories::const_iterator> order; ///< Categories in order.
+  std::vector<size_t> tree;  ///< Fenwick tree of the sizes of the categories.
+  size_t count = 0;          ///< Products in the view.
+
+public:
+  /**
+   * @brief Constructs an empty view.
+   */
+  ProductView() = default;
+
+  /**
+   * @brief Builds the view over a categories register.
+   *
+   * @param categories The categories register, must outlive the view.
+   */
+  void rebuild(const Categories& categories);
+
+  /**
+   * @brief Registers a product appended to a category.
+   *
+   * @param category Category of the product.
+   */
+  void productInserted(const std::string& category);
+
+  /**
+   * @brief Registers a product erased from a category.
+   *
+   * @param category Category of the product.
+   */
+  void productErased(const std::string& category);
+
+  /**
+   * @brief Gets the number of products of the view.
+   * @return Number of products.
+   */
+  size_t size() const { return this->count; }
+
+  /**
+   * @brief Gets the product in a position of the view.
+   *
+   * @param index Position in the view, lower than its size.
+   * @return The category and the product.
+   */
+  Row at(const size_t index) const;
+
+  /**
+   * @brief Gets the products of a page of the view.
+   *
+   * Only the first product is searched in the tree, the following ones are
+   * read in order from the register.
+   *
+   * @param pageIndex The page index.
+   * @param itemsPerPage Number of products per page.
+   * @return The rows of the page, empty past the last page.
+   */
+  std::vector<Row> page(const size_t pageIndex
+      , const size_t itemsPerPage) const;
+
+  /**
+   * @brief Gets the number of categories of the view.
+   * @return Number of categories.
+   */
+  size_t categoryCount() const { return this->order.size(); }
+
+  /**
+   * @brief Gets the categories of a page, without copying their names.
+   *
+   * @param pageIndex The page index.
+   * @param itemsPerPage Number of categories per page.
+   * @return View of the entries of the register for the page.
+   */
+  PageView<Categories::const_iterator> categoryPage(const size_t pageIndex
+      , const size_t itemsPerPage) const {
+    return PageView<Categories::const_iterator>(this->order, pageIndex
+        , itemsPerPage);
+  }
+
+private:
+  /**
+   * @brief Finds the ordinal of a category.
+   *
+   * @param category Name of the category.
+   * @return Ordinal of the category, or the number of categories if it's
+   *     not in the view.
+   */
+  size_t ordinalOf(const std::string& category) const;
+
+  /**
+   * @brief Adds a value to the size of a category.
+   *
+   * @param ordinal Ordinal of the category.
+   * @param delta Value to add, wraps around to subtract.
+   */
+  void add(const size_t ordinal, const size_t delta);
+
+  // Copy and assignment constructors are disabled.
+  ProductView(const ProductView&) = delete;
+  ProductView& operator=(const ProductView&) = delete;
+};
+
+#endif // PRODUCTVIEW_H
@@ -0,0 +1,466 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "receiptarchive.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#include <QDebug>
+
+#include "binaryreader.h"
+#include "checksum.h"
+#include "durablewriter.h"
+#include "littleendian.h"
+#include "receiptjournal.h"
+
+ReceiptArchive::ReceiptArchive(const std::string& journalFile
+    , const std::string& indexFile, const std::string& timeIndexFile)
+    : journalFilename(journalFile)
+    , indexFilename(indexFile)
+    , timeIndexFilename(timeIndexFile) {
+}
+
+ReceiptArchive::~ReceiptArchive() {
+  this->close();
+}
+
+void ReceiptArchive::open(const uint64_t journalDataEnd
+    , const uint64_t journalRecords, const bool rebuildIndex) {
+  this->close();
+  this->dataEnd = journalDataEnd;
+
+  // Validates the index header and that it has an entry per record.
+  bool validIndex = false;
+  std::error_code error;
+  const uint64_t indexSize = std::filesystem::file_size(this->indexFilename
+      , error);
+  if (!rebuildIndex && !error && indexSize >= INDEX_HEADER_SIZE
+      && (indexSize - INDEX_HEADER_SIZE) % INDEX_ENTRY_SIZE == 0
+      && (indexSize - INDEX_HEADER_SIZE) / INDEX_ENTRY_SIZE == journalRecords) {
+    std::ifstream in(this->indexFilename, std::ios::binary);
+    char header[INDEX_HEADER_SIZE];
+    validIndex = in.read(header, INDEX_HEADER_SIZE)
+        && LittleEndian::read32(header) == INDEX_MAGIC
+        && LittleEndian::read32(header + 4) == INDEX_VERSION;
+  }
+
+  // The last entry must point to the last record of the journal, otherwise
+  // the index belongs to a journal that was rewritten.
+  if (validIndex) {
+    this->entryCount = journalRecords;
+    RecordView last;
+    validIndex = journalRecords == 0
+        || (this->record(journalRecords - 1, last)
+        && static_cast<uint64_t>(last.payload + last.size
+            - reinterpret_cast<const char*>(this->journalMap))
+            == journalDataEnd);
+  }
+  // Rebuilds the index from the journal records if it can't be used.
+  if (!validIndex) {
+    this->rebuildIndex();
+  }
+
+  // Keeps the index open to append the entries of the new receipts.
+  this->indexWriter.open(this->indexFilename
+      , std::ios::binary | std::ios::app);
+  if (!this->indexWriter) {
+    throw std::runtime_error("No se pudo abrir el archivo: "
+        + this->indexFilename);
+  }
+  // The positions of the time index change whenever the index is rebuilt.
+  this->loadTimeIndex(!validIndex);
+  this->opened = true;
+}
+
+void ReceiptArchive::close() {
+  this->unmap();
+  if (this->indexWriter.is_open()) {
+    this->indexWriter.close();
+  }
+  if (this->timeIndexWriter.is_open()) {
+    this->timeIndexWriter.close();
+  }
+  this->timeEntries.clear();
+  this->opened = false;
+}
+
+void ReceiptArchive::recordAppended(const uint64_t id
+    , const int64_t timestamp, const uint64_t offset
+    , const uint64_t journalDataEnd) {
+  if (!this->opened) {
+    return;
+  }
+  // Appends the entry of the record, the mapping is extended when it's used.
+  std::string entry;
+  LittleEndian::append64(entry, id);
+  LittleEndian::append64(entry, offset);
+  this->indexWriter.write(entry.data(), entry.size());
+  this->indexWriter.flush();
+  // Appends an entry to the time index if the receipt starts a new hour.
+  if (this->addTimeEntry(this->entryCount, timestamp)) {
+    std::string timeEntry;
+    LittleEndian::append64(timeEntry, static_cast<uint64_t>(
+        this->timeEntries.back().bucket));
+    LittleEndian::append64(timeEntry, this->entryCount);
+    this->timeIndexWriter.write(timeEntry.data(), timeEntry.size());
+    this->timeIndexWriter.flush();
+  }
+  ++this->entryCount;
+  this->dataEnd = journalDataEnd;
+}
+
+bool ReceiptArchive::record(const uint64_t position, RecordView& view) {
+  this->ensureMapped();
+  if (position >= this->mappedEntries || this->journalMap == nullptr) {
+    return false;
+  }
+  // Reads the index entry of the record.
+  const uchar* entry = this->indexMap + INDEX_HEADER_SIZE
+      + position * INDEX_ENTRY_SIZE;
+  const uint64_t offset = LittleEndian::read64(entry + 8);
+  if (offset + ReceiptJournal::FRAME_SIZE > this->mappedJournalSize) {
+    return false;
+  }
+  // Reads the record frame and validates the payload.
+  const uchar* frame = this->journalMap + offset;
+  const uint32_t length = LittleEndian::read32(frame);
+  if (offset + ReceiptJournal::FRAME_SIZE + length > this->mappedJournalSize) {
+    return false;
+  }
+  const char* payload = reinterpret_cast<const char*>(frame)
+      + ReceiptJournal::FRAME_SIZE;
+  // Every receipt starts with its ID and its time.
+  if (length < 16
+      || LittleEndian::read32(frame + 4) != Checksum::crc32c(payload, length)) {
+    return false;
+  }
+  view.id = LittleEndian::read64(entry);
+  view.timestamp = static_cast<int64_t>(LittleEndian::read64(payload + 8));
+  view.payload = payload;
+  view.size = length;
+  return true;
+}
+
+bool ReceiptArchive::find(const uint64_t id, Receipt& receipt) {
+  uint64_t position = 0;
+  RecordView view;
+  return this->findPosition(id, position) && this->record(position, view)
+      && decode(view, receipt);
+}
+
+void ReceiptArchive::forEach(
+    const std::function<bool(const RecordView&)>& visitor) {
+  RecordView view;
+  for (uint64_t position = 0; position < this->entryCount; ++position) {
+    if (this->record(position, view) && !visitor(view)) {
+      break;
+    }
+  }
+}
+
+uint64_t ReceiptArchive::positionAt(const int64_t timestamp) {
+  // The receipts of the hour start at the last entry that isn't after it.
+  const size_t next = this->timeEntryAfter(bucketOf(timestamp));
+  if (next == 0) {
+    return 0;
+  }
+  const uint64_t end = next < this->timeEntries.size()
+      ? this->timeEntries[next].position : this->entryCount;
+  // Skips the receipts of the hour generated before the time.
+  RecordView view;
+  for (uint64_t position = this->timeEntries[next - 1].position
+      ; position < end; ++position) {
+    if (this->record(position, view) && view.timestamp >= timestamp) {
+      return position;
+    }
+  }
+  return end;
+}
+
+ReceiptArchive::Cursor ReceiptArchive::cursor(const uint64_t position) {
+  return Cursor(*this, position);
+}
+
+ReceiptArchive::Cursor::Cursor(ReceiptArchive& receiptArchive
+    , const uint64_t startPosition)
+    : archive(&receiptArchive)
+    , position(startPosition) {
+}
+
+bool ReceiptArchive::Cursor::next(Receipt& receipt) {
+  RecordView view;
+  // Skips the records that are damaged.
+  while (this->position < this->archive->size()) {
+    if (this->archive->record(this->position++, view)
+        && decode(view, receipt)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReceiptArchive::Cursor::previous(Receipt& receipt) {
+  RecordView view;
+  // A cursor past the end starts from the last receipt.
+  this->position = std::min(this->position, this->archive->size());
+  while (this->position > 0) {
+    if (this->archive->record(--this->position, view)
+        && decode(view, receipt)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t ReceiptArchive::Cursor::readPage(std::vector<Receipt>& page
+    , const size_t maxReceipts) {
+  page.clear();
+  page.reserve(static_cast<size_t>(std::min<uint64_t>(maxReceipts
+      , this->archive->size() - std::min(this->position
+          , this->archive->size()))));
+  Receipt receipt;
+  while (page.size() < maxReceipts && this->next(receipt)) {
+    page.push_back(receipt);
+  }
+  return page.size();
+}
+
+bool ReceiptArchive::Cursor::seekToID(const uint64_t id) {
+  return this->archive->findPosition(id, this->position);
+}
+
+void ReceiptArchive::Cursor::seekToTime(const int64_t timestamp) {
+  this->position = this->archive->positionAt(timestamp);
+}
+
+bool ReceiptArchive::decode(const RecordView& view, Receipt& receipt) {
+  // Reads the receipt directly from the mapped bytes.
+  BinaryReader reader(view.payload, view.size);
+  return Receipt::decode(reader, receipt) && reader.atEnd();
+}
+
+bool ReceiptArchive::findPosition(const uint64_t id, uint64_t& position) {
+  this->ensureMapped();
+  if (this->mappedEntries == 0) {
+    return false;
+  }
+  const uchar* entries = this->indexMap + INDEX_HEADER_SIZE;
+  auto entryID = [&](const uint64_t at) {
+    return LittleEndian::read64(entries + at * INDEX_ENTRY_SIZE);
+  };
+
+  // IDs are consecutive in most cases, so the position is tried directly.
+  const uint64_t firstID = entryID(0);
+  if (id >= firstID && id - firstID < this->mappedEntries
+      && entryID(id - firstID) == id) {
+    position = id - firstID;
+    return true;
+  }
+  // Otherwise searches the ID, the entries are sorted by ID.
+  uint64_t low = 0;
+  uint64_t high = this->mappedEntries;
+  while (low < high) {
+    const uint64_t middle = low + (high - low) / 2;
+    if (entryID(middle) < id) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low < this->mappedEntries && entryID(low) == id) {
+    position = low;
+    return true;
+  }
+  return false;
+}
+
+void ReceiptArchive::ensureMapped() {
+  // Maps the journal again if it grew since the last mapping.
+  if (this->mappedJournalSize < this->dataEnd) {
+    if (this->journalMap != nullptr) {
+      this->journal.unmap(const_cast<uchar*>(this->journalMap));
+      this->journalMap = nullptr;
+      this->mappedJournalSize = 0;
+    }
+    if (!this->journal.isOpen()) {
+      this->journal.setFileName(QString::fromStdString(this->journalFilename));
+      this->journal.open(QIODevice::ReadOnly);
+    }
+    this->journalMap = this->journal.map(0, this->dataEnd);
+    if (this->journalMap != nullptr) {
+      this->mappedJournalSize = this->dataEnd;
+    } else {
+      qDebug() << "No se pudo mapear el archivo: "
+          << QString::fromStdString(this->journalFilename);
+    }
+  }
+
+  // Maps the index again if new entries were appended.
+  if (this->mappedEntries < this->entryCount) {
+    if (this->indexMap != nullptr) {
+      this->index.unmap(const_cast<uchar*>(this->indexMap));
+      this->indexMap = nullptr;
+      this->mappedEntries = 0;
+    }
+    if (!this->index.isOpen()) {
+      this->index.setFileName(QString::fromStdString(this->indexFilename));
+      this->index.open(QIODevice::ReadOnly);
+    }
+    this->indexMap = this->index.map(0, INDEX_HEADER_SIZE
+        + this->entryCount * INDEX_ENTRY_SIZE);
+    if (this->indexMap != nullptr) {
+      this->mappedEntries = this->entryCount;
+    } else {
+      qDebug() << "No se pudo mapear el archivo: "
+          << QString::fromStdString(this->indexFilename);
+    }
+  }
+}
+
+void ReceiptArchive::unmap() {
+  if (this->journalMap != nullptr) {
+    this->journal.unmap(const_cast<uchar*>(this->journalMap));
+    this->journalMap = nullptr;
+  }
+  if (this->indexMap != nullptr) {
+    this->index.unmap(const_cast<uchar*>(this->indexMap));
+    this->indexMap = nullptr;
+  }
+  this->journal.close();
+  this->index.close();
+  this->mappedJournalSize = 0;
+  this->mappedEntries = 0;
+}
+
+void ReceiptArchive::rebuildIndex() {
+  qDebug() << "Reconstruyendo el indice de recibos: "
+      << QString::fromStdString(this->indexFilename);
+  // Maps the journal to walk through its records.
+  this->unmap();
+  this->entryCount = 0;
+  this->ensureMapped();
+
+  std::string entries;
+  LittleEndian::append32(entries, INDEX_MAGIC);
+  LittleEndian::append32(entries, INDEX_VERSION);
+  uint64_t offset = ReceiptJournal::HEADER_SIZE;
+  while (this->journalMap != nullptr
+      && offset + ReceiptJournal::FRAME_SIZE <= this->mappedJournalSize) {
+    // Stops at the first record that is incomplete or damaged.
+    const uchar* frame = this->journalMap + offset;
+    const uint32_t length = LittleEndian::read32(frame);
+    if (offset + ReceiptJournal::FRAME_SIZE + length
+        > this->mappedJournalSize) {
+      break;
+    }
+    RecordView view;
+    view.payload = reinterpret_cast<const char*>(frame)
+        + ReceiptJournal::FRAME_SIZE;
+    view.size = length;
+    Receipt receipt;
+    if (LittleEndian::read32(frame + 4)
+        != Checksum::crc32c(view.payload, length)
+        || !decode(view, receipt)) {
+      break;
+    }
+    LittleEndian::append64(entries, receipt.getID());
+    LittleEndian::append64(entries, offset);
+    ++this->entryCount;
+    offset += ReceiptJournal::FRAME_SIZE + length;
+  }
+
+  // Replaces the current index with the new one.
+  this->unmap();
+  DurableWriter::writeFile(this->indexFilename, entries);
+}
+
+void ReceiptArchive::loadTimeIndex(const bool rebuild) {
+  this->timeEntries.clear();
+  // Reads the saved entries, they must be sorted and point to indexed records.
+  bool validIndex = false;
+  std::error_code error;
+  const uint64_t indexSize = std::filesystem::file_size(
+      this->timeIndexFilename, error);
+  if (!rebuild && !error && indexSize >= INDEX_HEADER_SIZE
+      && (indexSize - INDEX_HEADER_SIZE) % TIME_INDEX_ENTRY_SIZE == 0) {
+    std::ifstream in(this->timeIndexFilename, std::ios::binary);
+    std::string bytes(static_cast<size_t>(indexSize), '\0');
+    validIndex = in.read(bytes.data(), bytes.size())
+        && LittleEndian::read32(bytes.data()) == TIME_INDEX_MAGIC
+        && LittleEndian::read32(bytes.data() + 4) == TIME_INDEX_VERSION;
+    for (size_t at = INDEX_HEADER_SIZE; validIndex && at < bytes.size()
+        ; at += TIME_INDEX_ENTRY_SIZE) {
+      TimeEntry entry;
+      entry.bucket = static_cast<int64_t>(LittleEndian::read64(
+          bytes.data() + at));
+      entry.position = LittleEndian::read64(bytes.data() + at + 8);
+      validIndex = entry.position < this->entryCount
+          && (this->timeEntries.empty()
+              || (entry.bucket > this->timeEntries.back().bucket
+                  && entry.position > this->timeEntries.back().position));
+      this->timeEntries.push_back(entry);
+    }
+  }
+  if (!validIndex) {
+    qDebug() << "Reconstruyendo el indice de tiempo de los recibos: "
+        << QString::fromStdString(this->timeIndexFilename);
+    this->timeEntries.clear();
+  }
+
+  // Adds the receipts appended after the last saved hour.
+  const size_t savedEntries = this->timeEntries.size();
+  RecordView view;
+  for (uint64_t position = this->timeEntries.empty() ? 0
+      : this->timeEntries.back().position; position < this->entryCount
+      ; ++position) {
+    if (this->record(position, view)) {
+      this->addTimeEntry(position, view.timestamp);
+    }
+  }
+  // Replaces the saved index if it was rebuilt or completed.
+  if (!validIndex || this->timeEntries.size() != savedEntries) {
+    std::string entries;
+    LittleEndian::append32(entries, TIME_INDEX_MAGIC);
+    LittleEndian::append32(entries, TIME_INDEX_VERSION);
+    for (const TimeEntry& entry : this->timeEntries) {
+      LittleEndian::append64(entries, static_cast<uint64_t>(entry.bucket));
+      LittleEndian::append64(entries, entry.position);
+    }
+    DurableWriter::writeFile(this->timeIndexFilename, entries);
+  }
+
+  // Keeps the time index open to append the hours of the new receipts.
+  this->timeIndexWriter.open(this->timeIndexFilename
+      , std::ios::binary | std::ios::app);
+  if (!this->timeIndexWriter) {
+    throw std::runtime_error("No se pudo abrir el archivo: "
+        + this->timeIndexFilename);
+  }
+}
+
+bool ReceiptArchive::addTimeEntry(const uint64_t position
+    , const int64_t timestamp) {
+  // A receipt older than the last hour, after a clock change, stays in it.
+  const int64_t bucket = bucketOf(timestamp);
+  if (!this->timeEntries.empty()
+      && bucket <= this->timeEntries.back().bucket) {
+    return false;
+  }
+  this->timeEntries.push_back(TimeEntry{bucket, position});
+  return true;
+}
+
+int64_t ReceiptArchive::bucketOf(const int64_t timestamp) {
+  const int64_t bucket = timestamp / SECONDS_PER_BUCKET;
+  return timestamp % SECONDS_PER_BUCKET < 0 ? bucket - 1 : bucket;
+}
+
+size_t ReceiptArchive::timeEntryAfter(const int64_t bucket) const {
+  // The entries are sorted by hour.
+  const auto after = std::upper_bound(this->timeEntries.begin()
+      , this->timeEntries.end(), bucket
+      , [](const int64_t value, const TimeEntry& entry) {
+        return value < entry.bucket;
+      });
+  return static_cast<size_t>(after - this->timeEntries.begin());
+}
@@ -0,0 +1,358 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef RECEIPTARCHIVE_H
+#define RECEIPTARCHIVE_H
+
+#include <QFile>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "receipt.h"
+
+/**
+ * @class ReceiptArchive
+ * @brief Read-only, memory-mapped view of the receipts journal.
+ *
+ * The archive maps the receipts journal into memory and keeps a sidecar index
+ * file with the receipt ID and the byte offset of every record. Any receipt
+ * can be found in O(1) through the index, and the records can be iterated
+ * directly over the mapped bytes without loading the history into memory.
+ *
+ * The index is appended together with the journal and is rebuilt from the
+ * journal when both files don't match.
+ *
+ * A second, sparse index keeps the position of the first receipt of every
+ * hour with sales. The receipts are appended in order of time, so a range of
+ * time is found with a binary search over the hours, and only the receipts of
+ * the range are read. The time index is small and is loaded into memory, the
+ * entries missing after a crash are added again from the journal when the
+ * archive is opened.
+ */
+class ReceiptArchive {
+public:
+  static const uint32_t INDEX_MAGIC = 0x58495250;  ///< "PRIX" in the file.
+  static const uint32_t INDEX_VERSION = 1;         ///< Index format version.
+  static const size_t INDEX_HEADER_SIZE = 8;       ///< Magic and version.
+  static const size_t INDEX_ENTRY_SIZE = 16;       ///< Receipt ID and offset.
+  static const uint32_t TIME_INDEX_MAGIC = 0x49545250;  ///< "PRTI" in the file.
+  static const uint32_t TIME_INDEX_VERSION = 1;     ///< Time index version.
+  static const size_t TIME_INDEX_ENTRY_SIZE = 16;   ///< Hour and position.
+  static const int64_t SECONDS_PER_BUCKET = 3600;   ///< Time of each entry.
+
+  /**
+   * @struct RecordView
+   * @brief Zero-copy view of a receipt record stored in the journal.
+   *
+   * The payload points into the mapped journal and stays valid until the
+   * archive is closed or remapped.
+   */
+  struct RecordView {
+    uint64_t id = 0;               ///< ID of the receipt.
+    int64_t timestamp = 0;         ///< Seconds since the epoch.
+    const char* payload = nullptr; ///< First byte of the encoded receipt.
+    uint32_t size = 0;             ///< Size of the encoded receipt.
+  };
+
+  /**
+   * @class Cursor
+   * @brief Pages through the receipts of the archive in order of creation.
+   *
+   * The cursor only keeps a position, so it stays valid while new receipts
+   * are appended. Each receipt is decoded from the mapped journal when it's
+   * read, so the history is never loaded into memory at once.
+   */
+  class Cursor {
+  private:
+    ReceiptArchive* archive = nullptr; ///< Archive that is read.
+    uint64_t position = 0;             ///< Position of the next receipt.
+
+  public:
+    /**
+     * @brief Constructs a cursor over an archive.
+     *
+     * @param receiptArchive Archive to read.
+     * @param startPosition Position of the first receipt to read.
+     */
+    Cursor(ReceiptArchive& receiptArchive, const uint64_t startPosition = 0);
+
+    /**
+     * @brief Reads the receipt at the cursor and moves past it.
+     *
+     * Skips the records that can't be decoded.
+     *
+     * @param receipt Receipt where the read receipt is stored.
+     * @return True if a receipt was read, false at the end of the archive.
+     */
+    bool next(Receipt& receipt);
+
+    /**
+     * @brief Moves the cursor back and reads the receipt before it.
+     *
+     * @param receipt Receipt where the read receipt is stored.
+     * @return True if a receipt was read, false at the start of the archive.
+     */
+    bool previous(Receipt& receipt);
+
+    /**
+     * @brief Reads the next receipts at the cursor.
+     *
+     * @param page Vector replaced with the read receipts.
+     * @param maxReceipts Maximum number of receipts to read.
+     * @return Number of read receipts.
+     */
+    size_t readPage(std::vector<Receipt>& page, const size_t maxReceipts);
+
+    /**
+     * @brief Moves the cursor to a receipt ID.
+     *
+     * @param id ID of the receipt.
+     * @return True if the receipt exists, the cursor doesn't move otherwise.
+     */
+    bool seekToID(const uint64_t id);
+
+    /**
+     * @brief Moves the cursor to the first receipt generated at a time.
+     * @param timestamp Seconds since the epoch.
+     */
+    void seekToTime(const int64_t timestamp);
+
+    /**
+     * @brief Moves the cursor to a position.
+     * @param newPosition Position of the next receipt to read.
+     */
+    void seek(const uint64_t newPosition) { this->position = newPosition; }
+
+    /**
+     * @brief Gets the position of the cursor.
+     * @return Position of the next receipt to read.
+     */
+    uint64_t getPosition() const { return this->position; }
+
+    /**
+     * @brief Checks if there are receipts after the cursor.
+     * @return True if the cursor is at the end of the archive.
+     */
+    bool atEnd() const { return this->position >= this->archive->size(); }
+  };
+
+private:
+  /**
+   * @struct TimeEntry
+   * @brief Entry of the time index.
+   */
+  struct TimeEntry {
+    int64_t bucket = 0;     ///< Hour since the epoch.
+    uint64_t position = 0;  ///< Position of the first receipt of the hour.
+  };
+
+  std::string journalFilename;  ///< Path to the receipts journal.
+  std::string indexFilename;    ///< Path to the sidecar index.
+  std::string timeIndexFilename;  ///< Path to the time index.
+  QFile journal;                ///< Journal file used for the mapping.
+  QFile index;                  ///< Index file used for the mapping.
+  const uchar* journalMap = nullptr; ///< Mapped journal bytes.
+  const uchar* indexMap = nullptr;   ///< Mapped index bytes.
+  uint64_t mappedJournalSize = 0;    ///< Number of mapped journal bytes.
+  uint64_t mappedEntries = 0;        ///< Number of mapped index entries.
+  uint64_t dataEnd = 0;              ///< Offset where the records end.
+  uint64_t entryCount = 0;           ///< Number of indexed receipts.
+  std::ofstream indexWriter;         ///< Appends the new index entries.
+  std::vector<TimeEntry> timeEntries;  ///< Loaded time index, by hour.
+  std::ofstream timeIndexWriter;     ///< Appends the new time entries.
+  bool opened = false;               ///< Flag indicating if it is open.
+
+public:
+  /**
+   * @brief Constructs an archive over the given journal and index files.
+   *
+   * @param journalFile Path to the receipts journal.
+   * @param indexFile Path to the sidecar index file.
+   * @param timeIndexFile Path to the time index file.
+   */
+  ReceiptArchive(const std::string& journalFile, const std::string& indexFile
+      , const std::string& timeIndexFile);
+
+  /**
+   * @brief Unmaps and closes the archive files.
+   */
+  ~ReceiptArchive();
+
+  /**
+   * @brief Opens the archive over the current journal content.
+   *
+   * Loads the sidecar index, rebuilding it from the journal if it is missing
+   * or doesn't match the number of records of the journal. The time index is
+   * loaded too, and rebuilt together with the sidecar index.
+   *
+   * @param journalDataEnd Offset where the records of the journal end.
+   * @param journalRecords Number of records stored in the journal.
+   * @param rebuildIndex Forces the indexes to be rebuilt.
+   *
+   * @throws std::runtime_error If the index cannot be written.
+   */
+  void open(const uint64_t journalDataEnd, const uint64_t journalRecords
+      , const bool rebuildIndex = false);
+
+  /**
+   * @brief Unmaps and closes the archive files.
+   */
+  void close();
+
+  /**
+   * @brief Checks if the archive is open.
+   * @return True if the archive is open.
+   */
+  bool isOpen() const { return this->opened; }
+
+  /**
+   * @brief Registers a record appended to the journal.
+   *
+   * Appends its entry to the sidecar index, and to the time index if it's
+   * the first receipt of its hour.
+   *
+   * @param id ID of the appended receipt.
+   * @param timestamp Time of the appended receipt.
+   * @param offset Offset of the appended record in the journal.
+   * @param journalDataEnd Offset where the records of the journal end now.
+   */
+  void recordAppended(const uint64_t id, const int64_t timestamp
+      , const uint64_t offset, const uint64_t journalDataEnd);
+
+  /**
+   * @brief Gets the number of receipts in the archive.
+   * @return Number of indexed receipts.
+   */
+  uint64_t size() const { return this->entryCount; }
+
+  /**
+   * @brief Gets the path to the receipts journal.
+   * @return Path to the journal file.
+   */
+  const std::string& getJournalFile() const { return this->journalFilename; }
+
+  /**
+   * @brief Gets where the indexed records of the journal end.
+   * @return Offset after the last indexed record.
+   */
+  uint64_t getDataEnd() const { return this->dataEnd; }
+
+  /**
+   * @brief Gets the view of the record stored at the given position.
+   *
+   * @param position Position of the record, in order of creation.
+   * @param view View where the record is stored.
+   * @return True if the record exists and its checksum is valid.
+   */
+  bool record(const uint64_t position, RecordView& view);
+
+  /**
+   * @brief Finds a receipt by its ID.
+   *
+   * @param id ID of the receipt.
+   * @param receipt Receipt where the found receipt is decoded.
+   * @return True if the receipt was found.
+   */
+  bool find(const uint64_t id, Receipt& receipt);
+
+  /**
+   * @brief Finds the first receipt generated at or after a time.
+   *
+   * Searches the hour of the time in the time index, then skips the receipts
+   * of that hour generated before the time.
+   *
+   * @param timestamp Seconds since the epoch.
+   * @return Position of the receipt, size() if there's none.
+   */
+  uint64_t positionAt(const int64_t timestamp);
+
+  /**
+   * @brief Gets a cursor to page through the receipts.
+   *
+   * @param position Position of the first receipt to read.
+   * @return Cursor over this archive.
+   */
+  Cursor cursor(const uint64_t position = 0);
+
+  /**
+   * @brief Iterates through the records of the archive in order.
+   *
+   * @param visitor Function called with each record view, returns false to
+   *     stop the iteration.
+   */
+  void forEach(const std::function<bool(const RecordView&)>& visitor);
+
+  /**
+   * @brief Decodes the receipt of a record view.
+   *
+   * @param view The record view.
+   * @param receipt Receipt where the view is decoded.
+   * @return True if the receipt was decoded.
+   */
+  static bool decode(const RecordView& view, Receipt& receipt);
+
+private:
+  /**
+   * @brief Finds the index position of a receipt ID.
+   *
+   * @param id ID of the receipt.
+   * @param position Position where the index entry was found.
+   * @return True if the receipt ID is indexed.
+   */
+  bool findPosition(const uint64_t id, uint64_t& position);
+
+  /**
+   * @brief Maps the journal and the index up to their current sizes.
+   */
+  void ensureMapped();
+
+  /**
+   * @brief Removes the current mappings of the journal and the index.
+   */
+  void unmap();
+
+  /**
+   * @brief Rebuilds the sidecar index scanning the journal records.
+   *
+   * @throws std::runtime_error If the index cannot be written.
+   */
+  void rebuildIndex();
+
+  /**
+   * @brief Loads the time index and adds the receipts missing from it.
+   *
+   * @param rebuild Discards the saved time index and builds it again.
+   * @throws std::runtime_error If the time index cannot be written.
+   */
+  void loadTimeIndex(const bool rebuild);
+
+  /**
+   * @brief Adds a receipt to the time index if it starts a new hour.
+   *
+   * @param position Position of the receipt.
+   * @param timestamp Time of the receipt.
+   * @return True if an entry was added.
+   */
+  bool addTimeEntry(const uint64_t position, const int64_t timestamp);
+
+  /**
+   * @brief Gets the hour since the epoch of a time.
+   * @param timestamp Seconds since the epoch.
+   * @return The hour, rounded down also before the epoch.
+   */
+  static int64_t bucketOf(const int64_t timestamp);
+
+  /**
+   * @brief Finds the first time entry of an hour after the given one.
+   * @param bucket Hour since the epoch.
+   * @return Position in timeEntries, its size if there's none.
+   */
+  size_t timeEntryAfter(const int64_t bucket) const;
+
+  // Copy and assignment constructors are disabled.
+  ReceiptArchive(const ReceiptArchive&) = delete;
+  ReceiptArchive& operator=(const ReceiptArchive&) = delete;
+};
+
+#endif // RECEIPTARCHIVE_H
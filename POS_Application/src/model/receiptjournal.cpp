@@ -0,0 +1,288 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "receiptjournal.h"
+
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+
+#include <QDebug>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+#include "checksum.h"
+#include "durablewriter.h"
+#include "littleendian.h"
+
+namespace {
+// Upper bound of a single receipt record, protects against corrupted lengths.
+const uint32_t MAX_RECORD_SIZE = 16u * 1024u * 1024u;
+
+// Builds the bytes of a journal trailer.
+std::string buildTrailer(const uint64_t lastID, const uint64_t count) {
+  std::string fields;
+  LittleEndian::append64(fields, lastID);
+  LittleEndian::append64(fields, count);
+  std::string trailer;
+  LittleEndian::append32(trailer, ReceiptJournal::TRAILER_MAGIC);
+  LittleEndian::append32(trailer
+      , Checksum::crc32c(fields.data(), fields.size()));
+  trailer += fields;
+  return trailer;
+}
+
+// Decodes the receipt contained in a record payload.
+bool decodeReceipt(const std::string& payload, Receipt& receipt) {
+  BinaryReader reader(payload.data(), payload.size());
+  return Receipt::decode(reader, receipt) && reader.atEnd();
+}
+}  // namespace
+
+ReceiptJournal::ReceiptJournal(const std::string& journalFile)
+    : filename(journalFile) {
+}
+
+ReceiptJournal::~ReceiptJournal() {
+  this->close();
+}
+
+bool ReceiptJournal::exists() const {
+  std::error_code error;
+  return std::filesystem::exists(this->filename, error);
+}
+
+void ReceiptJournal::open() {
+  // Nothing to do if the journal is already in use.
+  if (this->isOpen()) {
+    return;
+  }
+  // Creates an empty journal if there isn't one.
+  if (!this->exists()) {
+    writeJournalFile(this->filename, {}, 0);
+  }
+
+  this->file.open(this->filename
+      , std::ios::in | std::ios::out | std::ios::binary);
+  if (!this->file) {
+    throw std::runtime_error("No se pudo abrir el archivo: " + this->filename);
+  }
+
+  // Obtains the size of the journal.
+  this->file.seekg(0, std::ios::end);
+  const uint64_t fileSize = static_cast<uint64_t>(this->file.tellg());
+
+  // Validates the journal header.
+  char header[HEADER_SIZE];
+  this->file.seekg(0);
+  const bool validHeader = fileSize >= HEADER_SIZE
+      && this->file.read(header, HEADER_SIZE)
+      && LittleEndian::read32(header) == HEADER_MAGIC;
+  if (!validHeader || LittleEndian::read32(header + 4) != VERSION) {
+    this->file.close();
+    throw std::runtime_error("El archivo no es un diario de recibos valido: "
+        + this->filename);
+  }
+
+  // Reads the journal state from the trailer, or recovers it from the records.
+  this->damaged = false;
+  this->repeatedRecords = 0;
+  if (!this->readTrailer(fileSize)) {
+    this->recover(fileSize);
+  }
+}
+
+void ReceiptJournal::close() {
+  if (this->file.is_open()) {
+    this->file.close();
+  }
+}
+
+bool ReceiptJournal::readTrailer(const uint64_t fileSize) {
+  // Checks that there's space for a header and a trailer.
+  if (fileSize < HEADER_SIZE + TRAILER_SIZE) {
+    return false;
+  }
+  // Reads the trailer bytes from the end of the file.
+  char trailer[TRAILER_SIZE];
+  this->file.clear();
+  this->file.seekg(fileSize - TRAILER_SIZE);
+  if (!this->file.read(trailer, TRAILER_SIZE)) {
+    return false;
+  }
+  // Validates the trailer magic and checksum.
+  if (LittleEndian::read32(trailer) != TRAILER_MAGIC
+      || LittleEndian::read32(trailer + 4)
+          != Checksum::crc32c(trailer + 8, 16)) {
+    return false;
+  }
+  // Stores the journal state.
+  this->lastReceiptID = LittleEndian::read64(trailer + 8);
+  this->recordCount = LittleEndian::read64(trailer + 16);
+  this->dataEnd = fileSize - TRAILER_SIZE;
+  return true;
+}
+
+void ReceiptJournal::writeTrailer() {
+  const std::string trailer = buildTrailer(this->lastReceiptID
+      , this->recordCount);
+  this->file.clear();
+  this->file.seekp(this->dataEnd);
+  this->file.write(trailer.data(), trailer.size());
+}
+
+void ReceiptJournal::recover(const uint64_t fileSize) {
+  qDebug() << "Recuperando el diario de recibos: "
+      << QString::fromStdString(this->filename);
+  // Walks through the records while they are complete and valid.
+  uint64_t offset = HEADER_SIZE;
+  std::string payload;
+  this->lastReceiptID = 0;
+  this->recordCount = 0;
+  while (this->readRecord(offset, fileSize, payload)) {
+    Receipt receipt;
+    if (!decodeReceipt(payload, receipt)) {
+      break;
+    }
+    this->lastReceiptID = receipt.getID();
+    ++this->recordCount;
+    offset += FRAME_SIZE + payload.size();
+  }
+  this->dataEnd = offset;
+
+  // Keeps a copy of the discarded tail before it is overwritten.
+  if (this->dataEnd < fileSize) {
+    this->damaged = true;
+    std::string tail(fileSize - this->dataEnd, '\0');
+    this->file.clear();
+    this->file.seekg(this->dataEnd);
+    this->file.read(tail.data(), tail.size());
+    std::ofstream damagedFile(this->filename + ".damaged"
+        , std::ios::binary | std::ios::app);
+    damagedFile.write(tail.data(), this->file.gcount());
+  }
+
+  // Discards the tail and closes the journal with a new trailer.
+  this->file.close();
+  std::filesystem::resize_file(this->filename, this->dataEnd);
+  this->file.open(this->filename
+      , std::ios::in | std::ios::out | std::ios::binary);
+  this->writeTrailer();
+  this->file.flush();
+}
+
+bool ReceiptJournal::readRecord(const uint64_t offset, const uint64_t fileSize
+    , std::string& payload) {
+  // Checks that the frame fits in the file.
+  if (offset + FRAME_SIZE > fileSize) {
+    return false;
+  }
+  char frame[FRAME_SIZE];
+  this->file.clear();
+  this->file.seekg(offset);
+  if (!this->file.read(frame, FRAME_SIZE)) {
+    return false;
+  }
+  // Checks that the payload length is sane and fits in the file.
+  const uint32_t length = LittleEndian::read32(frame);
+  if (length > MAX_RECORD_SIZE
+      || offset + FRAME_SIZE + length > fileSize) {
+    return false;
+  }
+  // Reads the payload and validates its checksum.
+  payload.resize(length);
+  if (!this->file.read(payload.data(), length)) {
+    return false;
+  }
+  return LittleEndian::read32(frame + 4)
+      == Checksum::crc32c(payload.data(), length);
+}
+
+std::string ReceiptJournal::encodeRecord(const Receipt& receipt) {
+  // Serializes the receipt into the payload.
+  BinaryWriter payload;
+  receipt.encode(payload);
+  // Frames the payload with its length and checksum.
+  BinaryWriter record;
+  record.reserve(FRAME_SIZE + payload.data().size());
+  record.writeFrame(payload.data());
+  return record.take();
+}
+
+uint64_t ReceiptJournal::append(const Receipt& receipt) {
+  this->open();
+  const std::string record = encodeRecord(receipt);
+  const uint64_t offset = this->dataEnd;
+  // Writes the record over the previous trailer.
+  this->file.clear();
+  this->file.seekp(this->dataEnd);
+  this->file.write(record.data(), record.size());
+  // Updates the journal state and writes the new trailer after the record.
+  if (this->recordCount != 0 && receipt.getID() <= this->lastReceiptID) {
+    ++this->repeatedRecords;
+  }
+  this->dataEnd += record.size();
+  this->lastReceiptID = receipt.getID();
+  ++this->recordCount;
+  this->writeTrailer();
+  this->file.flush();
+  if (!this->file) {
+    throw std::runtime_error("No se pudo escribir en el archivo: "
+        + this->filename);
+  }
+  return offset;
+}
+
+void ReceiptJournal::compact() {
+  this->open();
+  // Collects the valid records, skipping the repeated receipt IDs.
+  std::vector<std::string> records;
+  std::set<uint64_t> storedIDs;
+  uint64_t lastID = 0;
+  uint64_t offset = HEADER_SIZE;
+  std::string payload;
+  while (offset < this->dataEnd
+      && this->readRecord(offset, this->dataEnd, payload)) {
+    Receipt receipt;
+    if (decodeReceipt(payload, receipt)
+        && storedIDs.insert(receipt.getID()).second) {
+      BinaryWriter record;
+      record.writeFrame(payload);
+      records.push_back(record.take());
+      lastID = receipt.getID();
+    }
+    offset += FRAME_SIZE + payload.size();
+  }
+
+  // Replaces the current journal with the compacted one.
+  this->close();
+  writeJournalFile(this->filename, records, lastID);
+  this->open();
+}
+
+void ReceiptJournal::rewrite(const std::vector<Receipt>& receipts) {
+  // Encodes all the receipts.
+  std::vector<std::string> records;
+  records.reserve(receipts.size());
+  for (const auto& receipt : receipts) {
+    records.push_back(encodeRecord(receipt));
+  }
+  const uint64_t lastID = receipts.empty() ? 0 : receipts.back().getID();
+
+  // Replaces the current journal with the new one.
+  this->close();
+  writeJournalFile(this->filename, records, lastID);
+  this->open();
+}
+
+void ReceiptJournal::writeJournalFile(const std::string& target
+    , const std::vector<std::string>& records, const uint64_t lastID) {
+  // Builds the header, the records and the trailer.
+  std::string journal;
+  LittleEndian::append32(journal, HEADER_MAGIC);
+  LittleEndian::append32(journal, VERSION);
+  for (const auto& record : records) {
+    journal += record;
+  }
+  journal += buildTrailer(lastID, records.size());
+  // Replaces the file without ever leaving a half written journal.
+  DurableWriter::writeFile(target, journal);
+}
@@ -0,0 +1,212 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef RECEIPTJOURNAL_H
+#define RECEIPTJOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "receipt.h"
+
+/**
+ * @class ReceiptJournal
+ * @brief Append-only binary journal that stores the generated receipts.
+ *
+ * The journal file starts with a small header, followed by one framed record
+ * per receipt (payload length, CRC32C of the payload and the payload itself)
+ * and ends with a trailer holding the last receipt ID and the number of
+ * records. Appending a receipt only writes its record and a new trailer over
+ * the previous one, so the cost of a sale does not depend on the size of the
+ * history.
+ *
+ * Every payload holds a receipt in the portable format of Receipt::encode().
+ *
+ * If the trailer is missing or damaged (for example after a power cut in the
+ * middle of an append) the journal is recovered by scanning the records, and
+ * the damaged tail is discarded after keeping a copy of it next to the
+ * journal.
+ */
+class ReceiptJournal {
+public:
+  static const uint32_t HEADER_MAGIC = 0x4C4A5250;   ///< "PRJL" in the file.
+  static const uint32_t TRAILER_MAGIC = 0x544A5250;  ///< "PRJT" in the file.
+  /// Format version, the only one. The receipts_data.bin file of the
+  /// previous versions is migrated into it, no other layout is read.
+  static const uint32_t VERSION = 1;
+  static const size_t HEADER_SIZE = 8;     ///< Magic and version.
+  static const size_t FRAME_SIZE = 8;      ///< Payload length and checksum.
+  static const size_t TRAILER_SIZE = 24;   ///< Magic, checksum, ID and count.
+
+private:
+  std::string filename;           ///< Path to the journal file.
+  std::fstream file;              ///< Journal file, kept open while in use.
+  uint64_t lastReceiptID = 0;     ///< ID of the last appended receipt.
+  uint64_t recordCount = 0;       ///< Number of valid records in the journal.
+  uint64_t dataEnd = HEADER_SIZE; ///< Offset where the next record is written.
+  bool damaged = false;           ///< True if the recovery found a bad tail.
+  /// Records appended since the open that repeat a stored receipt ID.
+  uint64_t repeatedRecords = 0;
+
+public:
+  /**
+   * @brief Constructs a journal bound to the given file.
+   *
+   * The file is not touched until the journal is opened.
+   *
+   * @param journalFile Path to the journal file.
+   */
+  explicit ReceiptJournal(const std::string& journalFile);
+
+  /**
+   * @brief Closes the journal file.
+   */
+  ~ReceiptJournal();
+
+  /**
+   * @brief Opens the journal, creating it if it does not exist.
+   *
+   * Reads the trailer to obtain the last receipt ID and the number of records.
+   * If the trailer is not valid the records are scanned to recover them.
+   *
+   * @throws std::runtime_error If the file cannot be created or is not a
+   *     receipt journal.
+   */
+  void open();
+
+  /**
+   * @brief Closes the journal file if it is open.
+   */
+  void close();
+
+  /**
+   * @brief Checks if the journal file is open.
+   * @return True if the journal is open.
+   */
+  bool isOpen() const { return this->file.is_open(); }
+
+  /**
+   * @brief Checks if the journal file exists on disk.
+   * @return True if the journal file exists.
+   */
+  bool exists() const;
+
+  /**
+   * @brief Appends a receipt to the end of the journal.
+   *
+   * Writes the framed record of the receipt followed by the new trailer.
+   *
+   * @param receipt The receipt to append.
+   * @return Offset of the appended record in the journal file.
+   *
+   * @throws std::runtime_error If the journal cannot be written.
+   */
+  uint64_t append(const Receipt& receipt);
+
+  /**
+   * @brief Rewrites the journal keeping only its valid records.
+   *
+   * Drops the damaged tail and the records that repeat an already stored
+   * receipt ID. The new journal replaces the current one through a durable
+   * write, so a crash leaves either the old or the new journal.
+   *
+   * @throws std::runtime_error If the compacted journal cannot be written.
+   */
+  void compact();
+
+  /**
+   * @brief Replaces the content of the journal with the given receipts.
+   *
+   * Used to import receipts from other backup formats.
+   *
+   * @param receipts The receipts that the journal will contain.
+   *
+   * @throws std::runtime_error If the journal cannot be written.
+   */
+  void rewrite(const std::vector<Receipt>& receipts);
+
+  /**
+   * @brief Gets the ID of the last appended receipt.
+   * @return The last receipt ID, or 0 if the journal is empty.
+   */
+  uint64_t getLastReceiptID() const { return this->lastReceiptID; }
+
+  /**
+   * @brief Gets the number of receipts stored in the journal.
+   * @return Number of valid records.
+   */
+  uint64_t getRecordCount() const { return this->recordCount; }
+
+  /**
+   * @brief Gets the offset where the records of the journal end.
+   * @return Offset of the first byte after the last record.
+   */
+  uint64_t getDataEnd() const { return this->dataEnd; }
+
+  /**
+   * @brief Checks if the last open had to discard a damaged tail.
+   * @return True if the journal needs a compaction.
+   */
+  bool isDamaged() const { return this->damaged; }
+
+  /**
+   * @brief Checks if the journal holds records that a compaction drops.
+   * @return True if it has a damaged tail or repeated receipt IDs.
+   */
+  bool needsCompaction() const {
+    return this->damaged || this->repeatedRecords != 0;
+  }
+
+private:
+  /**
+   * @brief Reads and validates the trailer at the end of the file.
+   * @param fileSize Size of the journal file in bytes.
+   * @return True if the trailer is valid.
+   */
+  bool readTrailer(const uint64_t fileSize);
+
+  /**
+   * @brief Writes the trailer at the current data end.
+   */
+  void writeTrailer();
+
+  /**
+   * @brief Scans all the records to recover the journal state.
+   * @param fileSize Size of the journal file in bytes.
+   */
+  void recover(const uint64_t fileSize);
+
+  /**
+   * @brief Reads the record that starts at the given offset.
+   *
+   * @param offset Offset of the record frame.
+   * @param fileSize Size of the journal file in bytes.
+   * @param payload String where the record payload is stored.
+   * @return True if a complete record with a valid checksum was read.
+   */
+  bool readRecord(const uint64_t offset, const uint64_t fileSize
+      , std::string& payload);
+
+  /**
+   * @brief Encodes a receipt as a framed journal record.
+   * @param receipt The receipt to encode.
+   * @return The bytes of the record.
+   */
+  static std::string encodeRecord(const Receipt& receipt);
+
+  /**
+   * @brief Durably writes a complete journal with the given records.
+   *
+   * @param target Path to the file to write.
+   * @param records Encoded records of the journal.
+   * @param lastID ID of the last receipt of the records.
+   */
+  static void writeJournalFile(const std::string& target
+      , const std::vector<std::string>& records, const uint64_t lastID);
+
+  // Copy and assignment constructors are disabled.
+  ReceiptJournal(const ReceiptJournal&) = delete;
+  ReceiptJournal& operator=(const ReceiptJournal&) = delete;
+};
+
+#endif // RECEIPTJOURNAL_H
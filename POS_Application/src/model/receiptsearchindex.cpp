@@ -0,0 +1,713 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "receiptsearchindex.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <QDebug>
+
+#include "checksum.h"
+#include "durablewriter.h"
+#include "littleendian.h"
+#include "receiptjournal.h"
+
+uint64_t ReceiptSearchIndex::Postings::size() const {
+  return this->sortedCount
+      + (this->logIDs == nullptr ? 0 : this->logIDs->size());
+}
+
+uint64_t ReceiptSearchIndex::Postings::at(const uint64_t position) const {
+  if (position < this->sortedCount) {
+    return LittleEndian::read64(this->entries + position * ENTRY_SIZE + 8);
+  }
+  return (*this->logIDs)[position - this->sortedCount];
+}
+
+uint64_t ReceiptSearchIndex::Postings::lowerBound(const uint64_t id) const {
+  uint64_t low = 0;
+  uint64_t high = this->size();
+  while (low < high) {
+    const uint64_t middle = low + (high - low) / 2;
+    if (this->at(middle) < id) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+uint64_t ReceiptSearchIndex::Postings::upperBound(const uint64_t id) const {
+  uint64_t low = 0;
+  uint64_t high = this->size();
+  while (low < high) {
+    const uint64_t middle = low + (high - low) / 2;
+    if (this->at(middle) <= id) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+ReceiptSearchIndex::ReceiptSearchIndex(const std::string& searchFile
+    , const std::string& searchLogFile, ReceiptArchive& receiptArchive)
+    : filename(searchFile)
+    , logFilename(searchLogFile)
+    , mergedFilename(searchFile + ".merge")
+    , archive(receiptArchive) {
+}
+
+void ReceiptSearchIndex::open(const uint64_t lastReceiptID) {
+  this->close();
+  // Maps the sorted postings and reads the newer ones from the log.
+  const bool validIndex = this->mapSorted();
+  if (validIndex) {
+    this->readLog();
+  }
+
+  // Postings of receipts that the journal doesn't have belong to another one.
+  if (!validIndex || this->lastIndexedID > lastReceiptID) {
+    // Rebuilds them out of this thread, meanwhile the log only holds the
+    // postings of the new receipts.
+    qDebug() << "Reconstruyendo el indice de busqueda de recibos: "
+        << QString::fromStdString(this->filename);
+    this->unmapSorted();
+    this->logPostings.clear();
+    this->logEntries = 0;
+    this->writeLog(std::string());
+    this->lastIndexedID = lastReceiptID;
+    this->rebuilding = true;
+    this->mergePending = true;
+  } else if (this->logEntries > MAX_LOG_ENTRIES) {
+    this->mergePending = true;
+  }
+
+  this->writer.open(this->logFilename, std::ios::binary | std::ios::app);
+  if (!this->writer) {
+    throw std::runtime_error("No se pudo abrir el archivo: "
+        + this->logFilename);
+  }
+  this->opened = true;
+
+  // Indexes the receipts appended after the last saved postings.
+  if (this->lastIndexedID < lastReceiptID) {
+    std::vector<Receipt> missing;
+    Receipt receipt;
+    ReceiptArchive::Cursor cursor = this->archive.cursor(this->archive.size());
+    while (cursor.previous(receipt) && receipt.getID() > this->lastIndexedID) {
+      missing.push_back(receipt);
+    }
+    for (auto next = missing.rbegin(); next != missing.rend(); ++next) {
+      this->add(*next);
+    }
+  }
+}
+
+void ReceiptSearchIndex::close() {
+  if (this->writer.is_open()) {
+    this->writer.close();
+  }
+  this->unmapSorted();
+  this->logPostings.clear();
+  this->logEntries = 0;
+  this->lastIndexedID = 0;
+  this->opened = false;
+}
+
+void ReceiptSearchIndex::add(const Receipt& receipt) {
+  // The receipts already indexed are not indexed again.
+  if (!this->opened || receipt.getID() <= this->lastIndexedID) {
+    return;
+  }
+  this->installMerge();
+  std::string entries;
+  appendEntries(receipt, entries);
+  this->writer.write(entries.data(), entries.size());
+  this->writer.flush();
+  this->lastIndexedID = receipt.getID();
+  // Keeps the postings of the log up to date.
+  for (const uint64_t key : keysOf(receipt)) {
+    this->logPostings[key].push_back(receipt.getID());
+    ++this->logEntries;
+  }
+  // A long log is merged out of this thread, in the middle of the sales.
+  if (!this->merging && this->logEntries > MAX_LOG_ENTRIES) {
+    this->mergePending = true;
+  }
+}
+
+std::function<void()> ReceiptSearchIndex::takeMerge() {
+  if (!this->mergePending || this->merging) {
+    return nullptr;
+  }
+  this->mergePending = false;
+  this->merging = true;
+  this->mergeError.clear();
+  // The job reads the journal and the log only up to their current ends, and
+  // the postings file is not replaced until the job is installed.
+  std::function<void()> write;
+  if (this->rebuilding) {
+    write = [journalFile = this->archive.getJournalFile()
+        , dataEnd = this->archive.getDataEnd(), lastID = this->lastIndexedID
+        , target = this->mergedFilename] {
+      writeRebuilt(journalFile, dataEnd, lastID, target);
+    };
+  } else {
+    this->writer.flush();
+    std::error_code error;
+    const uint64_t logEnd
+        = std::filesystem::file_size(this->logFilename, error);
+    write = [sortedFile = this->filename, logFile = this->logFilename
+        , logEnd = error ? 0 : logEnd, sortedLastID = this->sortedLastID
+        , lastID = this->lastIndexedID, target = this->mergedFilename] {
+      writeMerged(sortedFile, logFile, logEnd, sortedLastID, lastID, target);
+    };
+  }
+  // Tells the calling thread that the job ended, also if it failed.
+  return [this, write] {
+    try {
+      write();
+    } catch (const std::exception& error) {
+      this->mergeError = error.what();
+      this->mergeDone.store(true, std::memory_order_release);
+      throw;
+    }
+    this->mergeDone.store(true, std::memory_order_release);
+  };
+}
+
+std::vector<Receipt> ReceiptSearchIndex::search(const Query& query
+    , const size_t maxResults) {
+  this->installMerge();
+  std::vector<Receipt> results;
+  Receipt receipt;
+  // A receipt number is found directly through the ID index.
+  if (query.receiptID != 0) {
+    if (maxResults > 0 && this->archive.find(query.receiptID, receipt)
+        && matches(query, receipt)) {
+      results.push_back(receipt);
+    }
+    return results;
+  }
+
+  // Finds the posting lists of the fields of the query, a field without
+  // postings matches no receipt. While the postings are rebuilt they miss
+  // the older receipts, so the receipts are read instead.
+  std::vector<Postings> lists;
+  auto addList = [this, &lists](const uint64_t key) {
+    lists.push_back(this->postingsOf(key));
+    return lists.back().size() != 0;
+  };
+  if (!this->rebuilding) {
+    if (!query.user.empty() && !addList(keyOf(USER, query.user))) {
+      return results;
+    }
+    if (!query.paymentMethod.empty()
+        && !addList(keyOf(PAYMENT_METHOD, query.paymentMethod))) {
+      return results;
+    }
+    // The products are found by their ID across renames, and by the name
+    // they were sold with when they are not in the catalog.
+    if (query.productID != 0) {
+      if (!addList(keyOf(PRODUCT_ID, query.productID))) {
+        return results;
+      }
+    } else if (!query.productName.empty()
+        && !addList(keyOf(PRODUCT_NAME, query.productName))) {
+      return results;
+    }
+  }
+
+  // Limits the search to the receipt IDs of the range of time.
+  uint64_t firstID = 0;
+  uint64_t lastID = std::numeric_limits<uint64_t>::max();
+  const bool timed = query.from != std::numeric_limits<int64_t>::min()
+      || query.to != std::numeric_limits<int64_t>::max();
+  if (timed && !this->idsBetween(query.from, query.to, firstID, lastID)) {
+    return results;
+  }
+
+  // Without lists, the newest receipts of the range are read backwards.
+  if (lists.empty()) {
+    ReceiptArchive::Cursor cursor = this->archive.cursor(
+        query.to == std::numeric_limits<int64_t>::max()
+        ? this->archive.size() : this->archive.positionAt(query.to + 1));
+    while (results.size() < maxResults && cursor.previous(receipt)
+        && receipt.getID() >= firstID) {
+      if (matches(query, receipt)) {
+        results.push_back(receipt);
+      }
+    }
+    return results;
+  }
+  // Otherwise walks the shortest list from its newest ID of the range, and
+  // decodes only the IDs that are in every other list.
+  std::sort(lists.begin(), lists.end()
+      , [](const Postings& first, const Postings& second) {
+        return first.size() < second.size();
+      });
+  const Postings& shortest = lists.front();
+  const uint64_t begin = shortest.lowerBound(firstID);
+  for (uint64_t position = shortest.upperBound(lastID)
+      ; position > begin && results.size() < maxResults; ) {
+    --position;
+    const uint64_t id = shortest.at(position);
+    const bool inAll = std::all_of(lists.begin() + 1, lists.end()
+        , [id](const Postings& list) {
+          const uint64_t found = list.lowerBound(id);
+          return found < list.size() && list.at(found) == id;
+        });
+    if (inAll && this->archive.find(id, receipt) && matches(query, receipt)) {
+      results.push_back(receipt);
+    }
+  }
+  return results;
+}
+
+bool ReceiptSearchIndex::matches(const Query& query, const Receipt& receipt) {
+  if (query.receiptID != 0 && receipt.getID() != query.receiptID) {
+    return false;
+  }
+  if (receipt.getTimestamp() < query.from
+      || receipt.getTimestamp() > query.to) {
+    return false;
+  }
+  if (!query.user.empty() && receipt.getUser().toStdString() != query.user) {
+    return false;
+  }
+  if (!query.paymentMethod.empty()
+      && receipt.getPaymentMethod().toStdString() != query.paymentMethod) {
+    return false;
+  }
+  // The product must be in any of the lines of the receipt.
+  return (query.productID == 0 && query.productName.empty())
+      || std::any_of(receipt.getLines().begin(), receipt.getLines().end()
+          , [&query](const Receipt::LineItem& line) {
+            return query.productID != 0
+                ? line.productID == query.productID
+                : Receipt::getProductName(line) == query.productName;
+          });
+}
+
+bool ReceiptSearchIndex::mapSorted() {
+  this->unmapSorted();
+  this->file.setFileName(QString::fromStdString(this->filename));
+  if (!this->file.exists() || !this->file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  // The entries must fill the file after the header.
+  const uint64_t fileSize = static_cast<uint64_t>(this->file.size());
+  if (fileSize < HEADER_SIZE || (fileSize - HEADER_SIZE) % ENTRY_SIZE != 0) {
+    this->unmapSorted();
+    return false;
+  }
+  this->sortedMap = this->file.map(0, fileSize);
+  if (this->sortedMap == nullptr) {
+    qDebug() << "No se pudo mapear el archivo: "
+        << QString::fromStdString(this->filename);
+    this->unmapSorted();
+    return false;
+  }
+  const char* header = reinterpret_cast<const char*>(this->sortedMap);
+  if (LittleEndian::read32(header) != SEARCH_MAGIC
+      || LittleEndian::read32(header + 4) != SEARCH_VERSION) {
+    this->unmapSorted();
+    return false;
+  }
+  this->sortedLastID = LittleEndian::read64(header + 8);
+  this->sortedEntries = (fileSize - HEADER_SIZE) / ENTRY_SIZE;
+  this->lastIndexedID = this->sortedLastID;
+  return true;
+}
+
+void ReceiptSearchIndex::unmapSorted() {
+  if (this->sortedMap != nullptr) {
+    this->file.unmap(const_cast<uchar*>(this->sortedMap));
+    this->sortedMap = nullptr;
+  }
+  this->file.close();
+  this->sortedEntries = 0;
+  this->sortedLastID = 0;
+}
+
+void ReceiptSearchIndex::readLog() {
+  this->logPostings.clear();
+  this->logEntries = 0;
+  // Reads the whole log, it's sorted into the postings once it's long.
+  std::error_code error;
+  const uint64_t fileSize
+      = std::filesystem::file_size(this->logFilename, error);
+  std::string bytes(error ? 0 : static_cast<size_t>(fileSize), '\0');
+  std::ifstream in(this->logFilename, std::ios::binary);
+  if (bytes.size() < LOG_HEADER_SIZE || !in.read(bytes.data(), bytes.size())
+      || LittleEndian::read32(bytes.data()) != LOG_MAGIC
+      || LittleEndian::read32(bytes.data() + 4) != SEARCH_VERSION) {
+    in.close();
+    this->writeLog(std::string());
+    return;
+  }
+  in.close();
+  // Cuts a torn entry off the end, and the entries of the last receipt that
+  // might be incomplete, which is indexed again.
+  size_t end = LOG_HEADER_SIZE
+      + (bytes.size() - LOG_HEADER_SIZE) / ENTRY_SIZE * ENTRY_SIZE;
+  if (end > LOG_HEADER_SIZE) {
+    const uint64_t lastID = LittleEndian::read64(bytes.data() + end - 8);
+    while (end > LOG_HEADER_SIZE
+        && LittleEndian::read64(bytes.data() + end - 8) == lastID) {
+      end -= ENTRY_SIZE;
+    }
+  }
+  if (end != bytes.size()) {
+    std::filesystem::resize_file(this->logFilename, end, error);
+  }
+  for (size_t at = LOG_HEADER_SIZE; at < end; at += ENTRY_SIZE) {
+    const uint64_t id = LittleEndian::read64(bytes.data() + at + 8);
+    // The entries up to the last sorted receipt were already sorted.
+    if (id <= this->sortedLastID) {
+      continue;
+    }
+    std::vector<uint64_t>& list
+        = this->logPostings[LittleEndian::read64(bytes.data() + at)];
+    if (list.empty() || list.back() < id) {
+      list.push_back(id);
+      ++this->logEntries;
+    }
+    this->lastIndexedID = std::max(this->lastIndexedID, id);
+  }
+}
+
+ReceiptSearchIndex::Postings ReceiptSearchIndex::postingsOf(
+    const uint64_t key) const {
+  Postings list;
+  // Finds the sorted entries of the key with two binary searches, only the
+  // pages of the key are touched.
+  if (this->sortedEntries > 0) {
+    const char* entries = reinterpret_cast<const char*>(this->sortedMap)
+        + HEADER_SIZE;
+    auto keyAt = [entries](const uint64_t entry) {
+      return LittleEndian::read64(entries + entry * ENTRY_SIZE);
+    };
+    uint64_t low = 0;
+    uint64_t high = this->sortedEntries;
+    while (low < high) {
+      const uint64_t middle = low + (high - low) / 2;
+      if (keyAt(middle) < key) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    const uint64_t first = low;
+    high = this->sortedEntries;
+    while (low < high) {
+      const uint64_t middle = low + (high - low) / 2;
+      if (keyAt(middle) <= key) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    list.entries = entries + first * ENTRY_SIZE;
+    list.sortedCount = low - first;
+  }
+  const auto logged = this->logPostings.find(key);
+  if (logged != this->logPostings.end()) {
+    list.logIDs = &logged->second;
+  }
+  return list;
+}
+
+std::vector<uint64_t> ReceiptSearchIndex::keysOf(const Receipt& receipt) {
+  std::vector<uint64_t> keys;
+  keys.reserve(2 + 2 * receipt.getLines().size());
+  keys.push_back(keyOf(USER, receipt.getUser().toStdString()));
+  keys.push_back(keyOf(PAYMENT_METHOD
+      , receipt.getPaymentMethod().toStdString()));
+  for (const Receipt::LineItem& line : receipt.getLines()) {
+    if (line.productID != 0) {
+      keys.push_back(keyOf(PRODUCT_ID, line.productID));
+    }
+    keys.push_back(keyOf(PRODUCT_NAME, Receipt::getProductName(line)));
+  }
+  // A product sold in several lines is posted once.
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+uint64_t ReceiptSearchIndex::keyOf(const Field field
+    , const std::string& value) {
+  // FNV-1a hash of the field and its value.
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](const uint8_t byte) {
+    hash ^= byte;
+    hash *= 1099511628211ull;
+  };
+  mix(field);
+  for (const char byte : value) {
+    mix(static_cast<uint8_t>(byte));
+  }
+  return hash;
+}
+
+uint64_t ReceiptSearchIndex::keyOf(const Field field, const uint64_t value) {
+  // Hashes the value as its little-endian bytes.
+  std::string bytes;
+  LittleEndian::append64(bytes, value);
+  return keyOf(field, bytes);
+}
+
+void ReceiptSearchIndex::appendEntries(const Receipt& receipt
+    , std::string& entries) {
+  for (const uint64_t key : keysOf(receipt)) {
+    appendEntry(entries, key, receipt.getID());
+  }
+}
+
+void ReceiptSearchIndex::appendEntry(std::string& entries, const uint64_t key
+    , const uint64_t id) {
+  LittleEndian::append64(entries, key);
+  LittleEndian::append64(entries, id);
+}
+
+void ReceiptSearchIndex::writeLog(const std::string& entries) {
+  std::string log;
+  log.reserve(LOG_HEADER_SIZE + entries.size());
+  LittleEndian::append32(log, LOG_MAGIC);
+  LittleEndian::append32(log, SEARCH_VERSION);
+  log += entries;
+  DurableWriter::writeFile(this->logFilename, log);
+}
+
+void ReceiptSearchIndex::installMerge() {
+  if (!this->merging || !this->mergeDone.load(std::memory_order_acquire)) {
+    return;
+  }
+  this->merging = false;
+  this->mergeDone.store(false, std::memory_order_relaxed);
+  if (!this->mergeError.empty()) {
+    qDebug() << "No se pudo ordenar el indice de busqueda de recibos: "
+        << QString::fromStdString(this->mergeError);
+    return;
+  }
+  // The postings file cannot be replaced while it's mapped.
+  this->unmapSorted();
+  try {
+    DurableWriter::replaceFile(this->mergedFilename, this->filename);
+  } catch (const std::exception& error) {
+    qDebug() << error.what();
+  }
+  const uint64_t lastIndexed = this->lastIndexedID;
+  if (!this->mapSorted()) {
+    // Reads the receipts until the postings are rebuilt at the next open.
+    qDebug() << "No se pudo abrir el archivo: "
+        << QString::fromStdString(this->filename);
+    this->rebuilding = true;
+    return;
+  }
+  this->lastIndexedID = std::max(lastIndexed, this->sortedLastID);
+  this->rebuilding = false;
+
+  // Keeps in the log only the postings newer than the new file, in the order
+  // of their receipts.
+  std::vector<std::pair<uint64_t, uint64_t>> newer;
+  for (auto list = this->logPostings.begin()
+      ; list != this->logPostings.end(); ) {
+    std::vector<uint64_t>& ids = list->second;
+    ids.erase(ids.begin(), std::upper_bound(ids.begin(), ids.end()
+        , this->sortedLastID));
+    if (ids.empty()) {
+      list = this->logPostings.erase(list);
+      continue;
+    }
+    for (const uint64_t id : ids) {
+      newer.emplace_back(id, list->first);
+    }
+    ++list;
+  }
+  this->logEntries = newer.size();
+  std::sort(newer.begin(), newer.end());
+  std::string entries;
+  entries.reserve(newer.size() * ENTRY_SIZE);
+  for (const auto& [id, key] : newer) {
+    appendEntry(entries, key, id);
+  }
+  // An older log still works, its entries of the new file are skipped.
+  this->writer.close();
+  try {
+    this->writeLog(entries);
+  } catch (const std::exception& error) {
+    qDebug() << error.what();
+  }
+  this->writer.open(this->logFilename, std::ios::binary | std::ios::app);
+}
+
+void ReceiptSearchIndex::writeMerged(const std::string& sortedFile
+    , const std::string& logFile, const uint64_t logEnd
+    , const uint64_t sortedLastID, const uint64_t lastID
+    , const std::string& target) {
+  // Reads the entries of the log newer than the postings file, only these
+  // are sorted in memory.
+  std::string bytes(static_cast<size_t>(logEnd), '\0');
+  std::ifstream log(logFile, std::ios::binary);
+  if (bytes.size() < LOG_HEADER_SIZE
+      || !log.read(bytes.data(), bytes.size())) {
+    throw std::runtime_error("No se pudo leer el archivo: " + logFile);
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> logged;
+  for (size_t at = LOG_HEADER_SIZE; at + ENTRY_SIZE <= bytes.size()
+      ; at += ENTRY_SIZE) {
+    const uint64_t id = LittleEndian::read64(bytes.data() + at + 8);
+    if (id > sortedLastID && id <= lastID) {
+      logged.emplace_back(LittleEndian::read64(bytes.data() + at), id);
+    }
+  }
+  std::sort(logged.begin(), logged.end());
+  logged.erase(std::unique(logged.begin(), logged.end()), logged.end());
+
+  std::ifstream sorted(sortedFile, std::ios::binary);
+  char header[HEADER_SIZE];
+  if (!sorted.read(header, HEADER_SIZE)
+      || LittleEndian::read32(header) != SEARCH_MAGIC
+      || LittleEndian::read32(header + 4) != SEARCH_VERSION) {
+    throw std::runtime_error("No se pudo leer el archivo: " + sortedFile);
+  }
+  // Merges both sorted inputs, reading the postings file block by block.
+  std::string block(MERGE_BLOCK_ENTRIES * ENTRY_SIZE, '\0');
+  size_t blockEntries = 0;
+  size_t blockPosition = 0;
+  auto nextLogged = logged.begin();
+  writePostings(lastID, target, [&](uint64_t& key, uint64_t& id) {
+    if (blockPosition == blockEntries && sorted) {
+      sorted.read(block.data(), block.size());
+      blockEntries = static_cast<size_t>(sorted.gcount()) / ENTRY_SIZE;
+      blockPosition = 0;
+    }
+    const bool hasSorted = blockPosition < blockEntries;
+    const char* entry = block.data() + blockPosition * ENTRY_SIZE;
+    if (hasSorted && (nextLogged == logged.end()
+        || std::make_pair(LittleEndian::read64(entry)
+            , LittleEndian::read64(entry + 8)) < *nextLogged)) {
+      key = LittleEndian::read64(entry);
+      id = LittleEndian::read64(entry + 8);
+      ++blockPosition;
+      return true;
+    }
+    if (nextLogged == logged.end()) {
+      return false;
+    }
+    key = nextLogged->first;
+    id = nextLogged->second;
+    ++nextLogged;
+    return true;
+  });
+}
+
+void ReceiptSearchIndex::writeRebuilt(const std::string& journalFile
+    , const uint64_t dataEnd, const uint64_t lastID
+    , const std::string& target) {
+  // Decodes the receipts from the journal file, the archive belongs to the
+  // calling thread.
+  std::ifstream journal(journalFile, std::ios::binary);
+  if (!journal) {
+    throw std::runtime_error("No se pudo leer el archivo: " + journalFile);
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> entries;
+  uint64_t offset = ReceiptJournal::HEADER_SIZE;
+  uint64_t previousID = 0;
+  char frame[ReceiptJournal::FRAME_SIZE];
+  std::string payload;
+  journal.seekg(static_cast<std::streamoff>(offset));
+  while (offset + ReceiptJournal::FRAME_SIZE <= dataEnd
+      && journal.read(frame, ReceiptJournal::FRAME_SIZE)) {
+    const uint32_t length = LittleEndian::read32(frame);
+    if (offset + ReceiptJournal::FRAME_SIZE + length > dataEnd) {
+      break;
+    }
+    payload.resize(length);
+    if (!journal.read(payload.data(), length)) {
+      break;
+    }
+    offset += ReceiptJournal::FRAME_SIZE + length;
+    // Skips the damaged records, as the archive does.
+    ReceiptArchive::RecordView view;
+    view.payload = payload.data();
+    view.size = length;
+    Receipt receipt;
+    if (LittleEndian::read32(frame + 4)
+        != Checksum::crc32c(payload.data(), length)
+        || !ReceiptArchive::decode(view, receipt)
+        || receipt.getID() <= previousID || receipt.getID() > lastID) {
+      continue;
+    }
+    for (const uint64_t key : keysOf(receipt)) {
+      entries.emplace_back(key, receipt.getID());
+    }
+    previousID = receipt.getID();
+  }
+  // Sorts the entries by key, and the IDs of each key in order.
+  std::sort(entries.begin(), entries.end());
+  auto next = entries.begin();
+  writePostings(lastID, target, [&](uint64_t& key, uint64_t& id) {
+    if (next == entries.end()) {
+      return false;
+    }
+    key = next->first;
+    id = next->second;
+    ++next;
+    return true;
+  });
+}
+
+void ReceiptSearchIndex::writePostings(const uint64_t lastID
+    , const std::string& target
+    , const std::function<bool(uint64_t& key, uint64_t& id)>& next) {
+  std::ofstream out(target, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("No se pudo crear el archivo: " + target);
+  }
+  std::string bytes;
+  bytes.reserve(MERGE_BLOCK_ENTRIES * ENTRY_SIZE);
+  LittleEndian::append32(bytes, SEARCH_MAGIC);
+  LittleEndian::append32(bytes, SEARCH_VERSION);
+  LittleEndian::append64(bytes, lastID);
+  // Writes the entries block by block.
+  uint64_t key = 0;
+  uint64_t id = 0;
+  while (next(key, id)) {
+    appendEntry(bytes, key, id);
+    if (bytes.size() >= MERGE_BLOCK_ENTRIES * ENTRY_SIZE) {
+      out.write(bytes.data(), bytes.size());
+      bytes.clear();
+    }
+  }
+  out.write(bytes.data(), bytes.size());
+  out.close();
+  if (!out) {
+    throw std::runtime_error("No se pudo escribir en el archivo: " + target);
+  }
+  // The file must be on the disk before it replaces the postings.
+  DurableWriter::syncFile(target);
+}
+
+bool ReceiptSearchIndex::idsBetween(const int64_t from, const int64_t to
+    , uint64_t& firstID, uint64_t& lastID) {
+  // The receipt IDs grow with the positions of the archive.
+  const uint64_t first = this->archive.positionAt(from);
+  const uint64_t end = to == std::numeric_limits<int64_t>::max()
+      ? this->archive.size() : this->archive.positionAt(to + 1);
+  if (from > to || first >= end) {
+    return false;
+  }
+  ReceiptArchive::RecordView view;
+  firstID = this->archive.record(first, view) ? view.id : 0;
+  lastID = this->archive.record(end - 1, view) ? view.id
+      : std::numeric_limits<uint64_t>::max();
+  return true;
+}
@@ -0,0 +1,375 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef RECEIPTSEARCHINDEX_H
+#define RECEIPTSEARCHINDEX_H
+
+#include <QFile>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "receipt.h"
+#include "receiptarchive.h"
+
+/**
+ * @class ReceiptSearchIndex
+ * @brief Secondary indexes of the receipts history, for the receipt search.
+ *
+ * Keeps a posting list with the IDs of the receipts of every user, payment
+ * method and product. The products are posted by their stable ID, so a
+ * renamed product still finds its older receipts, and also by the name they
+ * were sold with, for the products that are no longer in the catalog.
+ *
+ * The postings are stored sorted by key in a file that is mapped, so a
+ * search only reads the entries of its keys through a binary search. The
+ * postings of the new receipts are appended to a log together with the
+ * receipts journal. Once the log is long, a job run out of the calling thread
+ * merges it with the postings file into a new one, streaming both sorted
+ * inputs, and the new file replaces the current one at the next add or
+ * search. The part held in memory stays small, and neither the history nor
+ * the log is sorted in the calling thread.
+ *
+ * A search walks the shortest posting list of the fields of the query, from
+ * the newest receipt ID of its range of time, found through the time index
+ * of the archive, and keeps the IDs found in the other lists. Only the
+ * receipts that are shown are decoded. The receipt numbers are found
+ * directly through the ID index of the archive.
+ *
+ * The postings are keyed by a hash of the field and its value, so the
+ * decoded receipts are checked against the query before they are returned.
+ */
+class ReceiptSearchIndex {
+public:
+  static const uint32_t SEARCH_MAGIC = 0x49535250;  ///< "PRSI" in the file.
+  static const uint32_t LOG_MAGIC = 0x4C535250;     ///< "PRSL" in the log.
+  static const uint32_t SEARCH_VERSION = 1;         ///< Index format version.
+  static const size_t HEADER_SIZE = 16;      ///< Magic, version and last ID.
+  static const size_t LOG_HEADER_SIZE = 8;   ///< Magic and version.
+  static const size_t ENTRY_SIZE = 16;       ///< Key and receipt ID.
+  /// Entries of the log that start a merge into the postings.
+  static const size_t MAX_LOG_ENTRIES = 64 * 1024;
+  /// Entries read and written at once by the merge.
+  static const size_t MERGE_BLOCK_ENTRIES = 64 * 1024;
+
+  /**
+   * @struct Query
+   * @brief Fields of a receipt search, the empty ones match any receipt.
+   */
+  struct Query {
+    uint64_t receiptID = 0;   ///< Number of the receipt, 0 for any.
+    /// First second of the range of time, since the epoch.
+    int64_t from = std::numeric_limits<int64_t>::min();
+    /// Last second of the range of time, included.
+    int64_t to = std::numeric_limits<int64_t>::max();
+    std::string user;           ///< User that generated the receipt.
+    std::string paymentMethod;  ///< Payment method of the receipt.
+    uint64_t productID = 0;     ///< ID of a product sold, 0 for any.
+    /// Name a product was sold with, only used without a product ID.
+    std::string productName;
+  };
+
+private:
+  /**
+   * @enum Field
+   * @brief Indexed fields of the receipts.
+   */
+  enum Field : uint8_t {
+    USER = 1,
+    PAYMENT_METHOD,
+    PRODUCT_NAME,
+    PRODUCT_ID
+  };
+
+  /**
+   * @struct Postings
+   * @brief Receipt IDs of a key, in the postings file and in the log.
+   *
+   * The IDs of the log are newer than the sorted ones, so the list is in
+   * order of ID from its first sorted entry to its last logged ID.
+   */
+  struct Postings {
+    const char* entries = nullptr;   ///< First sorted entry of the key.
+    uint64_t sortedCount = 0;        ///< Sorted entries of the key.
+    const std::vector<uint64_t>* logIDs = nullptr;  ///< IDs in the log.
+
+    /**
+     * @brief Gets the number of receipt IDs of the list.
+     * @return Number of IDs.
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief Gets a receipt ID of the list.
+     * @param position Position of the ID, less than size().
+     * @return The receipt ID.
+     */
+    uint64_t at(const uint64_t position) const;
+
+    /**
+     * @brief Finds the first position whose ID is not less than an ID.
+     * @param id The receipt ID.
+     * @return The position, size() if every ID is less.
+     */
+    uint64_t lowerBound(const uint64_t id) const;
+
+    /**
+     * @brief Finds the first position whose ID is greater than an ID.
+     * @param id The receipt ID.
+     * @return The position, size() if no ID is greater.
+     */
+    uint64_t upperBound(const uint64_t id) const;
+  };
+
+  std::string filename;         ///< Path to the sorted postings file.
+  std::string logFilename;      ///< Path to the log of the new postings.
+  std::string mergedFilename;   ///< New postings file written by a merge.
+  ReceiptArchive& archive;      ///< Archive of the indexed receipts.
+  std::ofstream writer;         ///< Appends the postings of new receipts.
+  QFile file;                   ///< Postings file used for the mapping.
+  const uchar* sortedMap = nullptr;  ///< Mapped postings file.
+  uint64_t sortedEntries = 0;   ///< Entries of the postings file.
+  uint64_t sortedLastID = 0;    ///< Last receipt in the postings file.
+  uint64_t lastIndexedID = 0;   ///< Last receipt with its postings saved.
+  size_t logEntries = 0;        ///< Entries of the log.
+  bool opened = false;          ///< Flag indicating if it is open.
+  /// Receipt IDs of each key of the log, in order.
+  std::unordered_map<uint64_t, std::vector<uint64_t>> logPostings;
+  bool mergePending = false;    ///< True if a merge job must be taken.
+  bool merging = false;         ///< True from a merge is taken to installed.
+  /// True while the postings are rebuilt, they miss the older receipts.
+  bool rebuilding = false;
+  std::atomic<bool> mergeDone{false};  ///< Set by the merge job when it ends.
+  std::string mergeError;       ///< Error of the merge job, read once done.
+
+public:
+  /**
+   * @brief Constructs the index of the receipts of an archive.
+   *
+   * @param searchFile Path to the sorted postings file.
+   * @param searchLogFile Path to the log of the new postings.
+   * @param receiptArchive Archive of the indexed receipts.
+   */
+  ReceiptSearchIndex(const std::string& searchFile
+      , const std::string& searchLogFile, ReceiptArchive& receiptArchive);
+
+  /**
+   * @brief Opens the postings file and indexes the receipts missing from it.
+   *
+   * The postings file is mapped and only the log is read, a merge is pending
+   * if it's long. If the postings are missing or belong to another journal,
+   * a rebuild from the journal is pending, and the searches read the
+   * receipts until it's installed.
+   *
+   * @param lastReceiptID Last receipt ID of the journal.
+   * @throws std::runtime_error If the postings file cannot be written.
+   */
+  void open(const uint64_t lastReceiptID);
+
+  /**
+   * @brief Closes the postings files and forgets the postings of the log.
+   */
+  void close();
+
+  /**
+   * @brief Checks if the index is open.
+   * @return True if the index is open.
+   */
+  bool isOpen() const { return this->opened; }
+
+  /**
+   * @brief Appends the postings of a new receipt.
+   *
+   * Installs a finished merge first, and leaves a merge pending once the log
+   * is long.
+   *
+   * @param receipt The receipt appended to the journal.
+   */
+  void add(const Receipt& receipt);
+
+  /**
+   * @brief Takes the pending merge or rebuild of the postings.
+   *
+   * The job only reads the files as they are now, and writes the new postings
+   * file next to the current one. It's meant to run in another thread, the
+   * next add or search installs its file once it's done.
+   *
+   * @return The job, or nullptr if there's nothing to merge.
+   */
+  std::function<void()> takeMerge();
+
+  /**
+   * @brief Finds the receipts that match a query, the newest first.
+   *
+   * Installs a finished merge first.
+   *
+   * @param query Fields of the search.
+   * @param maxResults Maximum number of receipts returned.
+   * @return The found receipts.
+   */
+  std::vector<Receipt> search(const Query& query, const size_t maxResults);
+
+  /**
+   * @brief Checks a receipt against all the fields of a query.
+   *
+   * @param query Fields of the search.
+   * @param receipt The receipt.
+   * @return True if the receipt matches the query.
+   */
+  static bool matches(const Query& query, const Receipt& receipt);
+
+private:
+  /**
+   * @brief Maps the postings file and validates its header.
+   * @return False if the file doesn't exist or is not valid.
+   */
+  bool mapSorted();
+
+  /**
+   * @brief Unmaps and closes the postings file.
+   */
+  void unmapSorted();
+
+  /**
+   * @brief Reads the postings of the log newer than the postings file.
+   *
+   * A missing or damaged log is replaced with an empty one, the receipts it
+   * had are indexed again from the archive. The entries of the last receipt
+   * of the log are dropped, since a crash may have cut them.
+   *
+   * @throws std::runtime_error If the log cannot be written.
+   */
+  void readLog();
+
+  /**
+   * @brief Gets the receipt IDs of a key.
+   * @param key Key of the postings.
+   * @return View of the IDs, valid until the postings change.
+   */
+  Postings postingsOf(const uint64_t key) const;
+
+  /**
+   * @brief Gets the keys of the postings of a receipt, without repeating.
+   * @param receipt The receipt.
+   * @return Key of each field value of the receipt.
+   */
+  static std::vector<uint64_t> keysOf(const Receipt& receipt);
+
+  /**
+   * @brief Gets the key of the posting list of a field value.
+   *
+   * @param field The field.
+   * @param value Value of the field.
+   * @return 64 bits hash of the field and its value.
+   */
+  static uint64_t keyOf(const Field field, const std::string& value);
+
+  /**
+   * @brief Gets the key of the posting list of a numeric field value.
+   *
+   * @param field The field.
+   * @param value Value of the field.
+   * @return 64 bits hash of the field and its value.
+   */
+  static uint64_t keyOf(const Field field, const uint64_t value);
+
+  /**
+   * @brief Encodes the postings of a receipt.
+   *
+   * @param receipt The receipt.
+   * @param entries Buffer where the entries are appended.
+   */
+  static void appendEntries(const Receipt& receipt, std::string& entries);
+
+  /**
+   * @brief Encodes a posting.
+   *
+   * @param entries Buffer where the entry is appended.
+   * @param key Key of the posting.
+   * @param id Receipt ID of the posting.
+   */
+  static void appendEntry(std::string& entries, const uint64_t key
+      , const uint64_t id);
+
+  /**
+   * @brief Replaces the log with one that holds the given entries.
+   *
+   * @param entries Encoded entries of the log, in order of receipt ID.
+   * @throws std::runtime_error If the log cannot be written.
+   */
+  void writeLog(const std::string& entries);
+
+  /**
+   * @brief Replaces the postings with the file of a finished merge.
+   *
+   * Drops the entries of the log that the new file holds. If the file cannot
+   * be installed, the current postings are kept and the log is merged again
+   * at the next open.
+   */
+  void installMerge();
+
+  /**
+   * @brief Writes the merge of a postings file and the entries of a log.
+   *
+   * Only the entries of the log are sorted in memory, the postings file is
+   * read and the merged file is written in blocks.
+   *
+   * @param sortedFile Current postings file.
+   * @param logFile Log of the new postings.
+   * @param logEnd Size of the log to read.
+   * @param sortedLastID Last receipt ID of the postings file.
+   * @param lastID Last receipt ID of the read log.
+   * @param target New postings file.
+   * @throws std::runtime_error If a file cannot be read or written.
+   */
+  static void writeMerged(const std::string& sortedFile
+      , const std::string& logFile, const uint64_t logEnd
+      , const uint64_t sortedLastID, const uint64_t lastID
+      , const std::string& target);
+
+  /**
+   * @brief Writes the postings of every receipt of a journal.
+   *
+   * @param journalFile The receipts journal.
+   * @param dataEnd Offset where the records to read end.
+   * @param lastID Last receipt ID to index.
+   * @param target New postings file.
+   * @throws std::runtime_error If a file cannot be read or written.
+   */
+  static void writeRebuilt(const std::string& journalFile
+      , const uint64_t dataEnd, const uint64_t lastID
+      , const std::string& target);
+
+  /**
+   * @brief Writes the sorted entries of a postings file in blocks.
+   *
+   * @param lastID Last receipt ID of the postings.
+   * @param target The postings file.
+   * @param next Gets the next entry in order, false after the last one.
+   * @throws std::runtime_error If the file cannot be written.
+   */
+  static void writePostings(const uint64_t lastID, const std::string& target
+      , const std::function<bool(uint64_t& key, uint64_t& id)>& next);
+
+  /**
+   * @brief Gets the receipt IDs generated in a range of time.
+   *
+   * @param from First second of the range.
+   * @param to Last second of the range, included.
+   * @param firstID First receipt ID of the range.
+   * @param lastID Last receipt ID of the range.
+   * @return False if the range has no receipts.
+   */
+  bool idsBetween(const int64_t from, const int64_t to, uint64_t& firstID
+      , uint64_t& lastID);
+
+  // Copy and assignment constructors are disabled.
+  ReceiptSearchIndex(const ReceiptSearchIndex&) = delete;
+  ReceiptSearchIndex& operator=(const ReceiptSearchIndex&) = delete;
+};
+
+#endif // RECEIPTSEARCHINDEX_H
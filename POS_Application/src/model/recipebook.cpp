@@ -0,0 +1,83 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "recipebook.h"
+
+#include <QDebug>
+#include <QString>
+
+void RecipeBook::internSupplies(const std::vector<Supply>& supplies) {
+  this->supplyIDs.clear();
+  this->recipes.clear();
+  // The first supply with a name keeps it, as the lookups by name did.
+  for (size_t position = 0; position < supplies.size(); ++position) {
+    this->supplyIDs.emplace(supplies[position].getName()
+        , static_cast<SupplyID>(position));
+  }
+  this->required.assign(supplies.size(), 0);
+  this->touched.clear();
+}
+
+const std::vector<RecipeBook::Step>& RecipeBook::compile(
+    const Product& product) {
+  // Returns the recipe if it was already compiled.
+  const auto compiled = this->recipes.find(product.getName());
+  if (compiled != this->recipes.end()) {
+    return compiled->second;
+  }
+  // Translates each ingredient to the ID of its supply.
+  std::vector<Step> steps;
+  steps.reserve(product.getIngredients().size());
+  for (const Supply& ingredient : product.getIngredients()) {
+    const auto supply = this->supplyIDs.find(ingredient.getName());
+    if (supply == this->supplyIDs.end()) {
+      qDebug() << "Suministro no registrado: "
+          << QString::fromStdString(ingredient.getName());
+      continue;
+    }
+    steps.push_back(Step{supply->second, ingredient.getQuantity()});
+  }
+  return this->recipes.emplace(product.getName(), std::move(steps))
+      .first->second;
+}
+
+void RecipeBook::forgetRecipe(const std::string& productName) {
+  this->recipes.erase(productName);
+}
+
+bool RecipeBook::deduct(const std::vector<std::pair<Product, size_t>>& lines
+    , std::vector<Supply>& supplies, std::vector<Shortage>& shortages
+    , std::vector<Deduction>& deductions) {
+  // The supplies may have been registered after they were interned.
+  if (this->required.size() != supplies.size()) {
+    this->internSupplies(supplies);
+  }
+  // Adds up the quantity of each supply used by the whole order.
+  for (const auto& [product, units] : lines) {
+    for (const Step& step : this->compile(product)) {
+      if (this->required[step.supply] == 0) {
+        this->touched.push_back(step.supply);
+      }
+      this->required[step.supply] += step.quantity * units;
+    }
+  }
+  // Subtracts the total of each supply once.
+  bool enough = true;
+  for (const SupplyID supply : this->touched) {
+    const uint64_t available = supplies[supply].getQuantity();
+    const uint64_t used = this->required[supply];
+    if (used > available) {
+      shortages.push_back(Shortage{supply, used - available});
+      supplies[supply].setQuantity(0);
+      enough = false;
+    } else {
+      supplies[supply].setQuantity(available - used);
+    }
+    // Keeps what was really taken, a shortage only takes the stock left.
+    const uint64_t taken = available - supplies[supply].getQuantity();
+    if (taken > 0) {
+      deductions.push_back(Deduction{supply, taken});
+    }
+    this->required[supply] = 0;
+  }
+  this->touched.clear();
+  return enough;
+}
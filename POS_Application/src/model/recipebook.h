@@ -0,0 +1,122 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef RECIPEBOOK_H
+#define RECIPEBOOK_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "product.h"
+#include "supply.h"
+
+/**
+ * @class RecipeBook
+ * @brief Compiled recipes of the products, used to deduct the inventory.
+ *
+ * The registered supplies are interned to dense IDs, their position in the
+ * supplies register. The recipe of a product is compiled the first time it's
+ * sold to a flat array of supply IDs and quantities, so deducting an order is
+ * a single pass of indexed subtractions, without looking up the supplies by
+ * name.
+ *
+ * The supplies must be interned again every time the supplies register
+ * changes, that discards the compiled recipes. The recipe of a product must
+ * be forgotten when the product changes.
+ */
+class RecipeBook {
+public:
+  typedef uint32_t SupplyID;  ///< Position of a supply in the register.
+
+  /**
+   * @struct Step
+   * @brief Supply used by a unit of a product.
+   */
+  struct Step {
+    SupplyID supply = 0;    ///< ID of the supply.
+    uint64_t quantity = 0;  ///< Quantity used by a unit.
+  };
+
+  /**
+   * @struct Shortage
+   * @brief Supply without enough stock for an order.
+   */
+  struct Shortage {
+    SupplyID supply = 0;   ///< ID of the supply.
+    uint64_t missing = 0;  ///< Quantity that was not in stock.
+  };
+
+  /**
+   * @struct Deduction
+   * @brief Quantity taken from the stock of a supply by an order.
+   */
+  struct Deduction {
+    SupplyID supply = 0;    ///< ID of the supply.
+    uint64_t quantity = 0;  ///< Quantity subtracted from the stock.
+  };
+
+private:
+  /// IDs of the registered supplies by name.
+  std::unordered_map<std::string, SupplyID> supplyIDs;
+  /// Compiled recipes by product name.
+  std::unordered_map<std::string, std::vector<Step>> recipes;
+  std::vector<uint64_t> required;  ///< Quantity required of each supply.
+  std::vector<SupplyID> touched;   ///< Supplies required by the order.
+
+public:
+  /**
+   * @brief Constructs an empty recipe book.
+   */
+  RecipeBook() = default;
+
+  /**
+   * @brief Assigns the IDs of the registered supplies.
+   *
+   * Discards the compiled recipes, their IDs may have changed.
+   *
+   * @param supplies The supplies register.
+   */
+  void internSupplies(const std::vector<Supply>& supplies);
+
+  /**
+   * @brief Gets the compiled recipe of a product, compiling it if needed.
+   *
+   * The ingredients that are not registered supplies are reported and left
+   * out of the recipe.
+   *
+   * @param product The product.
+   * @return Steps of the recipe.
+   */
+  const std::vector<Step>& compile(const Product& product);
+
+  /**
+   * @brief Discards the compiled recipe of a product.
+   *
+   * @param productName Name of the product.
+   */
+  void forgetRecipe(const std::string& productName);
+
+  /**
+   * @brief Deducts the supplies used by an order.
+   *
+   * The supplies without enough stock are left at zero and reported.
+   *
+   * @param lines Products of the order and their units.
+   * @param supplies The supplies register, interned in this book.
+   * @param shortages Vector where the supplies without stock are appended.
+   * @param deductions Vector where the quantity subtracted from each supply
+   *     is appended, so the change can be logged.
+   * @return False if a supply had not enough stock.
+   */
+  bool deduct(const std::vector<std::pair<Product, size_t>>& lines
+      , std::vector<Supply>& supplies, std::vector<Shortage>& shortages
+      , std::vector<Deduction>& deductions);
+
+private:
+  // Copy and assignment constructors are disabled.
+  RecipeBook(const RecipeBook&) = delete;
+  RecipeBook& operator=(const RecipeBook&) = delete;
+};
+
+#endif // RECIPEBOOK_H
@@ -0,0 +1,117 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "reportengine.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+void ReportEngine::ZReport::merge(const SalesArchive::Aggregate& aggregate) {
+  this->receiptCount += aggregate.receiptCount;
+  this->lastReceiptID = std::max(this->lastReceiptID
+      , aggregate.lastReceiptID);
+  this->total += Money::fromCents(aggregate.total);
+  for (size_t method = 0; method < Receipt::PAYMENT_METHOD_COUNT; ++method) {
+    this->byPaymentMethod[method]
+        += Money::fromCents(aggregate.byPaymentMethod[method]);
+  }
+  for (size_t hour = 0; hour < SalesArchive::HOURS_PER_DAY; ++hour) {
+    this->byHour[hour] += Money::fromCents(aggregate.byHour[hour]);
+    this->receiptsByHour[hour] += aggregate.receiptsByHour[hour];
+  }
+  // Joins the users by their name.
+  for (size_t user = 0; user < aggregate.users.size(); ++user) {
+    UserTotal& merged = this->users[aggregate.users[user]];
+    merged.receiptCount += aggregate.receiptsByUser[user];
+    merged.amount += Money::fromCents(aggregate.byUser[user]);
+  }
+  // Joins the products by their ID, keeping the name of the latest day.
+  for (size_t product = 0; product < aggregate.products.size(); ++product) {
+    const uint64_t productID = aggregate.productIDs[product];
+    const ProductKey key(productID
+        , productID == 0 ? aggregate.products[product] : std::string());
+    ProductTotal& merged = this->products[key];
+    merged.productID = productID;
+    merged.name = aggregate.products[product];
+    merged.quantity += aggregate.quantityByProduct[product];
+    merged.amount += Money::fromCents(aggregate.byProduct[product]);
+  }
+}
+
+ReportEngine::ReportEngine(const size_t threads)
+    : pool(threads) {
+}
+
+ReportEngine::ZReport ReportEngine::build(const std::vector<Day>& days) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<SalesArchive::Aggregate> aggregates;
+  std::vector<uint8_t> aggregated;
+  this->aggregate(days, aggregates, aggregated);
+
+  // Merges the segments in order of day, a listed segment that couldn't be
+  // read marks its day as damaged.
+  ZReport report;
+  size_t index = 0;
+  for (size_t day = 0; day < days.size(); ++day) {
+    bool sold = false;
+    bool damaged = false;
+    for (size_t path = 0; path < days[day].segmentPaths.size(); ++path) {
+      if (aggregated[index]) {
+        report.merge(aggregates[index]);
+        sold = true;
+      } else {
+        damaged = true;
+      }
+      ++index;
+    }
+    report.dayCount += sold;
+    report.damagedDays += damaged;
+  }
+  qDebug() << "Reporte de" << days.size() << "dias generado en"
+      << std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start).count() << "ms con"
+      << this->pool.getThreadCount() << "hilos.";
+  return report;
+}
+
+std::vector<ReportEngine::ZReport> ReportEngine::buildDays(
+    const std::vector<Day>& days) {
+  std::vector<SalesArchive::Aggregate> aggregates;
+  std::vector<uint8_t> aggregated;
+  this->aggregate(days, aggregates, aggregated);
+  // Merges the segments of each day in its own report.
+  std::vector<ZReport> reports(days.size());
+  size_t index = 0;
+  for (size_t day = 0; day < days.size(); ++day) {
+    for (size_t path = 0; path < days[day].segmentPaths.size(); ++path) {
+      if (aggregated[index]) {
+        reports[day].merge(aggregates[index]);
+        reports[day].dayCount = 1;
+      } else {
+        reports[day].damagedDays = 1;
+      }
+      ++index;
+    }
+  }
+  return reports;
+}
+
+void ReportEngine::aggregate(const std::vector<Day>& days
+    , std::vector<SalesArchive::Aggregate>& aggregates
+    , std::vector<uint8_t>& aggregated) {
+  // Lists the segment and the runs of every day, by their day.
+  std::vector<std::pair<size_t, const std::string*>> segments;
+  for (size_t day = 0; day < days.size(); ++day) {
+    for (const std::string& path : days[day].segmentPaths) {
+      segments.emplace_back(day, &path);
+    }
+  }
+  // Aggregates every segment in its own slot, on any thread of the pool.
+  aggregates.assign(segments.size(), SalesArchive::Aggregate());
+  aggregated.assign(segments.size(), 0);
+  this->pool.parallelFor(segments.size(), [&](const size_t index) {
+    SalesArchive::Segment segment;
+    const auto& [day, path] = segments[index];
+    aggregated[index] = segment.open(*path)
+        && segment.aggregate(days[day].start, aggregates[index]);
+  });
+}
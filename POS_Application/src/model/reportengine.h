@@ -0,0 +1,132 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef REPORTENGINE_H
+#define REPORTENGINE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "money.h"
+#include "receipt.h"
+#include "salesarchive.h"
+#include "taskpool.h"
+
+/**
+ * @class ReportEngine
+ * @brief Builds the Z reports of a range of days from the sales segments.
+ *
+ * Every day of sales is a segment of the sales archive, plus the runs not
+ * merged in it yet, so the segments are aggregated in parallel on a pool of
+ * threads, each one reading only the columns of its segment. The totals of
+ * the segments are then merged in order of day, so the report doesn't
+ * depend on the order the threads finished.
+ */
+class ReportEngine {
+public:
+  /**
+   * @struct Day
+   * @brief Segments of a day of the report.
+   */
+  struct Day {
+    std::vector<std::string> segmentPaths;  ///< Segment and runs of the day.
+    int64_t start = 0;   ///< Seconds since epoch of the start of the day.
+  };
+
+  /**
+   * @struct ProductTotal
+   * @brief Units and amount sold of a product.
+   */
+  struct ProductTotal {
+    uint64_t productID = 0;  ///< Stable ID of the product, 0 if unknown.
+    std::string name;        ///< Last name sold.
+    uint64_t quantity = 0;   ///< Units sold.
+    Money amount;            ///< Amount sold.
+  };
+
+  /**
+   * @struct UserTotal
+   * @brief Receipts and amount sold by a user.
+   */
+  struct UserTotal {
+    uint64_t receiptCount = 0;  ///< Receipts generated.
+    Money amount;               ///< Amount sold.
+  };
+
+  /// Products keyed by their ID, or by their name if they have none.
+  typedef std::pair<uint64_t, std::string> ProductKey;
+
+  /**
+   * @struct ZReport
+   * @brief Totals of the sales of a range of days.
+   */
+  struct ZReport {
+    size_t dayCount = 0;          ///< Days with sales.
+    size_t damagedDays = 0;       ///< Days with a segment not read.
+    uint64_t receiptCount = 0;    ///< Receipts of the range.
+    uint64_t lastReceiptID = 0;   ///< Highest receipt ID of the range.
+    Money total;                  ///< Amount of all the receipts.
+    /// Amount by payment method, indexed by its code.
+    Money byPaymentMethod[Receipt::PAYMENT_METHOD_COUNT];
+    Money byHour[SalesArchive::HOURS_PER_DAY];  ///< Amount by hour of day.
+    /// Receipts by hour of the day.
+    uint64_t receiptsByHour[SalesArchive::HOURS_PER_DAY] = {};
+    std::map<ProductKey, ProductTotal> products;  ///< Sold by product.
+    std::map<std::string, UserTotal> users;       ///< Sold by user.
+
+    /**
+     * @brief Adds the totals of a segment.
+     * @param aggregate Totals of the segment.
+     */
+    void merge(const SalesArchive::Aggregate& aggregate);
+  };
+
+private:
+  TaskPool pool;  ///< Threads that aggregate the segments.
+
+public:
+  /**
+   * @brief Constructs the engine and starts its threads.
+   * @param threads Threads of the engine, 0 uses a thread per core.
+   */
+  explicit ReportEngine(const size_t threads = 0);
+
+  /**
+   * @brief Builds the report of some days.
+   *
+   * The days without segments have no sales and are skipped.
+   *
+   * @param days Segments of the days of the report.
+   * @return Totals of the days.
+   */
+  ZReport build(const std::vector<Day>& days);
+
+  /**
+   * @brief Builds a report of each day, sharing the threads among them.
+   *
+   * @param days Segments of the days.
+   * @return Totals of each day, in the order of the days.
+   */
+  std::vector<ZReport> buildDays(const std::vector<Day>& days);
+
+private:
+  /**
+   * @brief Aggregates the segments of some days on the threads.
+   *
+   * @param days Segments of the days.
+   * @param aggregates Vector replaced with the totals of each segment, in
+   *     the order of the days.
+   * @param aggregated Vector replaced with a flag for each segment, set if
+   *     the segment was read.
+   */
+  void aggregate(const std::vector<Day>& days
+      , std::vector<SalesArchive::Aggregate>& aggregates
+      , std::vector<uint8_t>& aggregated);
+
+  // Copy and assignment constructors are disabled.
+  ReportEngine(const ReportEngine&) = delete;
+  ReportEngine& operator=(const ReportEngine&) = delete;
+};
+
+#endif // REPORTENGINE_H
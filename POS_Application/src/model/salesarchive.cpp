@@ -0,0 +1,588 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "salesarchive.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDebug>
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+#include "checksum.h"
+
+SalesArchive::Segment::~Segment() {
+  this->close();
+}
+
+bool SalesArchive::Segment::open(const std::string& filename) {
+  this->close();
+  this->file.setFileName(QString::fromStdString(filename));
+  if (!this->file.exists() || !this->file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  // Maps the whole segment, the columns are paged in when they are read.
+  this->size = static_cast<uint64_t>(this->file.size());
+  if (this->size < SEGMENT_HEADER_SIZE) {
+    this->close();
+    return false;
+  }
+  this->data = this->file.map(0, this->size);
+  if (this->data == nullptr) {
+    qDebug() << "No se pudo mapear el archivo: "
+        << QString::fromStdString(filename);
+    this->close();
+    return false;
+  }
+
+  // Reads the header and the directory of the columns.
+  BinaryReader header(this->data, this->size);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  header.readU32(magic);
+  header.readU32(version);
+  header.readU32(this->receiptCount);
+  header.readU32(this->lineCount);
+  header.readU32(this->lastRun);
+  for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+    header.readU32(this->columnOffsets[column]);
+    header.readU32(this->columnSizes[column]);
+    header.readU32(this->columnChecksums[column]);
+    this->columnChecked[column] = false;
+  }
+  bool valid = header.isValid() && magic == SEGMENT_MAGIC
+      && version == SEGMENT_VERSION;
+  // Every column must be inside the file.
+  for (size_t column = 0; valid && column < COLUMN_COUNT; ++column) {
+    valid = uint64_t{this->columnOffsets[column]} + this->columnSizes[column]
+        <= this->size;
+  }
+  // The fixed width columns must have a value per row.
+  const uint64_t receipts = this->receiptCount;
+  const uint64_t lines = this->lineCount;
+  valid = valid && this->columnSizes[TIMESTAMP] == receipts * 8
+      && this->columnSizes[RECEIPT_ID] == receipts * 8
+      && this->columnSizes[USER_ID] == receipts * 4
+      && this->columnSizes[PAYMENT_METHOD] == receipts
+      && this->columnSizes[TOTAL] == receipts * 8
+      && this->columnSizes[FIRST_LINE] == receipts * 4
+      && this->columnSizes[LINE_PRODUCT_ID] == lines * 4
+      && this->columnSizes[LINE_QUANTITY] == lines * 4
+      && this->columnSizes[LINE_UNIT_PRICE] == lines * 8;
+  if (!valid) {
+    qDebug() << "El segmento de ventas no es valido: "
+        << QString::fromStdString(filename);
+    this->close();
+  }
+  return valid;
+}
+
+void SalesArchive::Segment::close() {
+  if (this->data != nullptr) {
+    this->file.unmap(const_cast<uchar*>(this->data));
+    this->data = nullptr;
+  }
+  this->file.close();
+  this->size = 0;
+  this->receiptCount = 0;
+  this->lineCount = 0;
+  this->lastRun = 0;
+}
+
+const char* SalesArchive::Segment::column(const Column column) {
+  if (this->data == nullptr) {
+    return nullptr;
+  }
+  const char* bytes = reinterpret_cast<const char*>(this->data)
+      + this->columnOffsets[column];
+  // Validates the column the first time, only its pages are touched.
+  if (!this->columnChecked[column]) {
+    if (Checksum::crc32c(bytes, this->columnSizes[column])
+        != this->columnChecksums[column]) {
+      qDebug() << "Columna de ventas danada: " << static_cast<int>(column);
+      return nullptr;
+    }
+    this->columnChecked[column] = true;
+  }
+  return bytes;
+}
+
+bool SalesArchive::Segment::readNames(const Column column
+    , std::vector<std::string>& names) {
+  const char* bytes = this->column(column);
+  if (bytes == nullptr) {
+    return false;
+  }
+  // The dictionary is a count followed by the names.
+  BinaryReader reader(bytes, this->columnSizes[column]);
+  uint32_t count = 0;
+  reader.readCount(count, 4);
+  names.assign(reader.isValid() ? count : 0, std::string());
+  for (uint32_t name = 0; reader.isValid() && name < count; ++name) {
+    reader.readString(names[name]);
+  }
+  return reader.isValid() && reader.atEnd();
+}
+
+bool SalesArchive::Segment::readProductIDs(std::vector<uint64_t>& ids) {
+  const char* bytes = this->column(PRODUCT_IDS);
+  if (bytes == nullptr || this->columnSizes[PRODUCT_IDS] % 8 != 0) {
+    return false;
+  }
+  ids.resize(this->columnSizes[PRODUCT_IDS] / 8);
+  for (size_t product = 0; product < ids.size(); ++product) {
+    ids[product] = LittleEndian::read64(bytes + product * 8);
+  }
+  return true;
+}
+
+bool SalesArchive::Segment::sumTotals(Money& total) {
+  const char* totals = this->column(TOTAL);
+  if (totals == nullptr) {
+    return false;
+  }
+  // A plain sum of integers, without branches, that the compiler vectorizes.
+  int64_t cents = 0;
+  for (uint32_t receipt = 0; receipt < this->receiptCount; ++receipt) {
+    cents += readCents(totals, receipt);
+  }
+  total = Money::fromCents(cents);
+  return true;
+}
+
+bool SalesArchive::Segment::sumTotalsByPaymentMethod(
+    Money (&totals)[Receipt::PAYMENT_METHOD_COUNT]) {
+  const char* methods = this->column(PAYMENT_METHOD);
+  const char* receiptTotals = this->column(TOTAL);
+  if (methods == nullptr || receiptTotals == nullptr) {
+    return false;
+  }
+  std::fill(std::begin(totals), std::end(totals), Money());
+  for (uint32_t receipt = 0; receipt < this->receiptCount; ++receipt) {
+    uint8_t method = static_cast<uint8_t>(methods[receipt]);
+    if (method >= Receipt::PAYMENT_METHOD_COUNT) {
+      method = Receipt::PAYMENT_OTHER;
+    }
+    totals[method] += Money::fromCents(readCents(receiptTotals, receipt));
+  }
+  return true;
+}
+
+bool SalesArchive::Segment::sumQuantitiesByProduct(
+    std::vector<uint64_t>& quantities) {
+  const char* products = this->column(LINE_PRODUCT_ID);
+  const char* lineQuantities = this->column(LINE_QUANTITY);
+  if (products == nullptr || lineQuantities == nullptr) {
+    return false;
+  }
+  quantities.clear();
+  for (uint32_t line = 0; line < this->lineCount; ++line) {
+    const uint32_t product = LittleEndian::read32(products + line * 4);
+    if (product >= quantities.size()) {
+      quantities.resize(product + 1, 0);
+    }
+    quantities[product] += LittleEndian::read32(lineQuantities + line * 4);
+  }
+  return true;
+}
+
+bool SalesArchive::Segment::aggregate(const int64_t dayStart
+    , Aggregate& aggregate) {
+  Aggregate result;
+  if (!this->readNames(USER_NAMES, result.users)
+      || !this->readNames(PRODUCT_NAMES, result.products)
+      || !this->readProductIDs(result.productIDs)
+      || result.productIDs.size() != result.products.size()) {
+    return false;
+  }
+  const char* columns[COLUMN_COUNT] = {};
+  for (size_t column = 0; column < USER_NAMES; ++column) {
+    columns[column] = this->column(static_cast<Column>(column));
+    if (columns[column] == nullptr) {
+      return false;
+    }
+  }
+
+  // Adds each receipt to its payment method, hour and user.
+  result.receiptCount = this->receiptCount;
+  result.byUser.assign(result.users.size(), 0);
+  result.receiptsByUser.assign(result.users.size(), 0);
+  for (uint32_t receipt = 0; receipt < this->receiptCount; ++receipt) {
+    const int64_t amount = readCents(columns[TOTAL], receipt);
+    const uint8_t method = static_cast<uint8_t>(
+        columns[PAYMENT_METHOD][receipt]);
+    const int64_t elapsed = static_cast<int64_t>(
+        LittleEndian::read64(columns[TIMESTAMP] + receipt * 8)) - dayStart;
+    const size_t hour = static_cast<size_t>(std::clamp<int64_t>(
+        elapsed / SECONDS_PER_HOUR, 0, HOURS_PER_DAY - 1));
+    const uint32_t user = LittleEndian::read32(columns[USER_ID] + receipt * 4);
+    if (user >= result.users.size()) {
+      return false;
+    }
+    result.lastReceiptID = std::max<uint64_t>(result.lastReceiptID
+        , LittleEndian::read64(columns[RECEIPT_ID] + receipt * 8));
+    result.total += amount;
+    result.byPaymentMethod[method < Receipt::PAYMENT_METHOD_COUNT
+        ? method : Receipt::PAYMENT_OTHER] += amount;
+    result.byHour[hour] += amount;
+    ++result.receiptsByHour[hour];
+    result.byUser[user] += amount;
+    ++result.receiptsByUser[user];
+  }
+
+  // Adds each line item to its product.
+  result.byProduct.assign(result.products.size(), 0);
+  result.quantityByProduct.assign(result.products.size(), 0);
+  for (uint32_t line = 0; line < this->lineCount; ++line) {
+    const uint32_t product
+        = LittleEndian::read32(columns[LINE_PRODUCT_ID] + line * 4);
+    if (product >= result.products.size()) {
+      return false;
+    }
+    const uint32_t quantity
+        = LittleEndian::read32(columns[LINE_QUANTITY] + line * 4);
+    result.quantityByProduct[product] += quantity;
+    result.byProduct[product] += quantity
+        * readCents(columns[LINE_UNIT_PRICE], line);
+  }
+  aggregate = std::move(result);
+  return true;
+}
+
+bool SalesArchive::Segment::readSales(std::vector<Sale>& sales) {
+  std::vector<std::string> users;
+  std::vector<std::string> products;
+  std::vector<uint64_t> productIDs;
+  if (!this->readNames(USER_NAMES, users)
+      || !this->readNames(PRODUCT_NAMES, products)
+      || !this->readProductIDs(productIDs)
+      || productIDs.size() != products.size()) {
+    return false;
+  }
+  const char* columns[COLUMN_COUNT] = {};
+  for (size_t column = 0; column < USER_NAMES; ++column) {
+    columns[column] = this->column(static_cast<Column>(column));
+    if (columns[column] == nullptr) {
+      return false;
+    }
+  }
+  // Joins the columns back into rows.
+  sales.reserve(sales.size() + this->receiptCount);
+  for (uint32_t receipt = 0; receipt < this->receiptCount; ++receipt) {
+    Sale sale;
+    sale.timestamp = static_cast<int64_t>(
+        LittleEndian::read64(columns[TIMESTAMP] + receipt * 8));
+    sale.receiptID = LittleEndian::read64(columns[RECEIPT_ID] + receipt * 8);
+    const uint32_t user = LittleEndian::read32(columns[USER_ID] + receipt * 4);
+    sale.paymentMethod = static_cast<uint8_t>(columns[PAYMENT_METHOD][receipt]);
+    sale.total = Money::fromCents(readCents(columns[TOTAL], receipt));
+    // The line items of a receipt end where the next receipt's begin.
+    const uint32_t firstLine
+        = LittleEndian::read32(columns[FIRST_LINE] + receipt * 4);
+    const uint32_t endLine = receipt + 1 < this->receiptCount
+        ? LittleEndian::read32(columns[FIRST_LINE] + (receipt + 1) * 4)
+        : this->lineCount;
+    if (user >= users.size() || firstLine > endLine
+        || endLine > this->lineCount) {
+      return false;
+    }
+    sale.user = users[user];
+    for (uint32_t line = firstLine; line < endLine; ++line) {
+      LineItem item;
+      const uint32_t product
+          = LittleEndian::read32(columns[LINE_PRODUCT_ID] + line * 4);
+      if (product >= products.size()) {
+        return false;
+      }
+      item.productID = productIDs[product];
+      item.product = products[product];
+      item.quantity = LittleEndian::read32(columns[LINE_QUANTITY] + line * 4);
+      item.unitPrice
+          = Money::fromCents(readCents(columns[LINE_UNIT_PRICE], line));
+      sale.lines.push_back(item);
+    }
+    sales.push_back(std::move(sale));
+  }
+  return true;
+}
+
+SalesArchive::SalesArchive(const std::string& segmentsDirectory)
+    : directory(segmentsDirectory) {
+}
+
+SalesArchive::Sale SalesArchive::toSale(const Receipt& receipt) {
+  Sale sale;
+  sale.timestamp = receipt.getTimestamp();
+  sale.receiptID = receipt.getID();
+  sale.user = receipt.getUser().toStdString();
+  sale.paymentMethod = receipt.getPaymentMethodCode();
+  sale.total = receipt.getPrice();
+  for (const Receipt::LineItem& line : receipt.getLines()) {
+    sale.lines.push_back(LineItem{line.productID
+        , Receipt::getProductName(line), line.quantity, line.price});
+  }
+  return sale;
+}
+
+std::string SalesArchive::dayOf(const int64_t timestamp) {
+  return QDateTime::fromSecsSinceEpoch(timestamp).toString("yyyyMMdd")
+      .toStdString();
+}
+
+std::string SalesArchive::segmentPath(const std::string& day) const {
+  return this->directory + "\\" + day + ".seg";
+}
+
+std::string SalesArchive::runPath(const std::string& day
+    , const uint32_t run) const {
+  return this->directory + "\\" + day + "." + std::to_string(run) + ".seg";
+}
+
+std::vector<std::string> SalesArchive::daySegments(
+    const std::string& day) const {
+  return this->dayFiles(day
+      , QFile::exists(QString::fromStdString(this->segmentPath(day)))
+      , this->listRuns(day));
+}
+
+std::vector<std::pair<std::string, std::vector<std::string>>>
+    SalesArchive::listDays() const {
+  // Finds the segment and the runs of every day in a single listing.
+  std::map<std::string
+      , std::pair<bool, std::vector<std::pair<uint32_t, std::string>>>> found;
+  const QDir dir(QString::fromStdString(this->directory));
+  for (const QString& name
+      : dir.entryList(QStringList("*.seg"), QDir::Files)) {
+    const QString day = name.section('.', 0, 0);
+    auto& files = found[day.toStdString()];
+    if (name.size() == day.size() + 4) {
+      files.first = true;
+      continue;
+    }
+    bool valid = false;
+    const uint32_t run = name.mid(day.size() + 1
+        , name.size() - day.size() - 5).toUInt(&valid);
+    if (valid && run > 0) {
+      files.second.emplace_back(run, this->runPath(day.toStdString(), run));
+    }
+  }
+  std::vector<std::pair<std::string, std::vector<std::string>>> days;
+  for (auto& [day, files] : found) {
+    std::sort(files.second.begin(), files.second.end());
+    std::vector<std::string> paths
+        = this->dayFiles(day, files.first, files.second);
+    if (!paths.empty()) {
+      days.emplace_back(day, std::move(paths));
+    }
+  }
+  return days;
+}
+
+std::vector<std::string> SalesArchive::dayFiles(const std::string& day
+    , const bool segmentExists
+    , const std::vector<std::pair<uint32_t, std::string>>& runs) const {
+  std::vector<std::string> segments;
+  // The runs up to the last one merged are already in the day's segment.
+  uint32_t lastRun = 0;
+  if (segmentExists) {
+    const std::string path = this->segmentPath(day);
+    Segment segment;
+    if (segment.open(path)) {
+      lastRun = segment.getLastRun();
+    }
+    // A damaged segment is still listed, so the reports count it.
+    segments.push_back(path);
+  }
+  for (const auto& [run, runPath] : runs) {
+    if (run > lastRun) {
+      segments.push_back(runPath);
+    }
+  }
+  return segments;
+}
+
+std::string SalesArchive::encodeSegment(const std::vector<Sale>& sales
+    , const uint32_t lastRun) {
+  // Gives a code to each different user and product, the products are told
+  // apart by their ID, or by their name if they have none.
+  std::map<std::string, uint32_t> userCodes;
+  std::map<std::pair<uint64_t, std::string>, uint32_t> productCodes;
+  BinaryWriter userNames;
+  BinaryWriter productNames;
+  BinaryWriter productIDs;
+  auto userCode = [&](const std::string& name) {
+    const auto found = userCodes.find(name);
+    if (found != userCodes.end()) {
+      return found->second;
+    }
+    const uint32_t newCode = static_cast<uint32_t>(userCodes.size());
+    userCodes.emplace(name, newCode);
+    userNames.writeString(name);
+    return newCode;
+  };
+  auto productCode = [&](const LineItem& line) {
+    const std::pair<uint64_t, std::string> key(line.productID
+        , line.productID == 0 ? line.product : std::string());
+    const auto found = productCodes.find(key);
+    if (found != productCodes.end()) {
+      return found->second;
+    }
+    const uint32_t newCode = static_cast<uint32_t>(productCodes.size());
+    productCodes.emplace(key, newCode);
+    productNames.writeString(line.product);
+    productIDs.writeU64(line.productID);
+    return newCode;
+  };
+
+  // Splits the rows in columns.
+  BinaryWriter columns[COLUMN_COUNT];
+  uint32_t lineCount = 0;
+  for (const Sale& sale : sales) {
+    columns[TIMESTAMP].writeU64(static_cast<uint64_t>(sale.timestamp));
+    columns[RECEIPT_ID].writeU64(sale.receiptID);
+    columns[USER_ID].writeU32(userCode(sale.user));
+    columns[PAYMENT_METHOD].writeU8(sale.paymentMethod);
+    columns[TOTAL].writeMoney(sale.total);
+    columns[FIRST_LINE].writeU32(lineCount);
+    for (const LineItem& line : sale.lines) {
+      columns[LINE_PRODUCT_ID].writeU32(productCode(line));
+      columns[LINE_QUANTITY].writeU32(line.quantity);
+      columns[LINE_UNIT_PRICE].writeMoney(line.unitPrice);
+      ++lineCount;
+    }
+  }
+  columns[USER_NAMES].writeU32(static_cast<uint32_t>(userCodes.size()));
+  columns[PRODUCT_NAMES].writeU32(static_cast<uint32_t>(productCodes.size()));
+  std::string users = columns[USER_NAMES].take() + userNames.take();
+  std::string products = columns[PRODUCT_NAMES].take() + productNames.take();
+  columns[PRODUCT_IDS] = std::move(productIDs);
+
+  // Writes the header with the directory, followed by the columns.
+  std::string body;
+  BinaryWriter header;
+  header.writeU32(SEGMENT_MAGIC);
+  header.writeU32(SEGMENT_VERSION);
+  header.writeU32(static_cast<uint32_t>(sales.size()));
+  header.writeU32(lineCount);
+  header.writeU32(lastRun);
+  for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+    const std::string bytes = column == USER_NAMES ? users
+        : column == PRODUCT_NAMES ? products : columns[column].take();
+    header.writeU32(static_cast<uint32_t>(SEGMENT_HEADER_SIZE + body.size()));
+    header.writeU32(static_cast<uint32_t>(bytes.size()));
+    header.writeU32(Checksum::crc32c(bytes.data(), bytes.size()));
+    body += bytes;
+  }
+  std::string segment = header.take();
+  segment += body;
+  return segment;
+}
+
+std::vector<std::pair<std::string, std::string>> SalesArchive::appendSales(
+    const std::vector<Sale>& sales) {
+  // Groups the new sales by their day.
+  std::map<std::string, std::vector<Sale>> salesByDay;
+  for (const Sale& sale : sales) {
+    salesByDay[dayOf(sale.timestamp)].push_back(sale);
+  }
+  std::vector<std::pair<std::string, std::string>> runs;
+  for (const auto& [day, daySales] : salesByDay) {
+    auto lastRun = this->lastRuns.find(day);
+    if (lastRun == this->lastRuns.end()) {
+      // Continues after the runs of the day that are already on the disk.
+      uint32_t run = 0;
+      Segment segment;
+      if (segment.open(this->segmentPath(day))) {
+        run = segment.getLastRun();
+      }
+      const auto dayRuns = this->listRuns(day);
+      if (!dayRuns.empty()) {
+        run = std::max(run, dayRuns.back().first);
+      }
+      lastRun = this->lastRuns.emplace(day, run).first;
+    }
+    // Only the new sales are encoded, the stored ones are left as they are.
+    const uint32_t run = ++lastRun->second;
+    this->runDays.insert(day);
+    runs.emplace_back(this->runPath(day, run), encodeSegment(daySales));
+  }
+  return runs;
+}
+
+std::vector<std::string> SalesArchive::takeClosedDays(
+    const std::string& today) {
+  if (!this->runsScanned) {
+    // Finds the days whose runs weren't merged before the last exit.
+    const QDir dir(QString::fromStdString(this->directory));
+    for (const QString& name
+        : dir.entryList(QStringList("*.*.seg"), QDir::Files)) {
+      this->runDays.insert(name.section('.', 0, 0).toStdString());
+    }
+    this->runsScanned = true;
+  }
+  // The day keys are sorted as dates, so the closed days come first.
+  std::vector<std::string> days;
+  auto day = this->runDays.begin();
+  while (day != this->runDays.end() && *day < today) {
+    days.push_back(*day);
+    day = this->runDays.erase(day);
+  }
+  return days;
+}
+
+bool SalesArchive::compactDay(const std::string& day, std::string& segment
+    , std::vector<std::string>& runs) const {
+  // Reads the sales already merged for the day.
+  std::vector<Sale> sales;
+  uint32_t lastRun = 0;
+  const std::string path = this->segmentPath(day);
+  Segment file;
+  if (file.open(path)) {
+    if (!file.readSales(sales)) {
+      return false;
+    }
+    lastRun = file.getLastRun();
+  } else if (QFile::exists(QString::fromStdString(path))) {
+    return false;
+  }
+  file.close();
+  // Appends the sales of the runs that aren't merged yet, in order.
+  const uint32_t mergedRun = lastRun;
+  runs.clear();
+  for (const auto& [run, runPath] : this->listRuns(day)) {
+    if (run > mergedRun) {
+      if (!file.open(runPath) || !file.readSales(sales)) {
+        qDebug() << "No se pudo unir la tanda de ventas danada: "
+            << QString::fromStdString(runPath);
+        return false;
+      }
+      file.close();
+      lastRun = run;
+    }
+    runs.push_back(runPath);
+  }
+  // There is nothing to write if only merged runs were left behind.
+  segment = lastRun > mergedRun ? encodeSegment(sales, lastRun)
+      : std::string();
+  return true;
+}
+
+std::vector<std::pair<uint32_t, std::string>> SalesArchive::listRuns(
+    const std::string& day) const {
+  // The runs are named after their day and their number.
+  const QDir dir(QString::fromStdString(this->directory));
+  const QString prefix = QString::fromStdString(day) + ".";
+  std::vector<std::pair<uint32_t, std::string>> runs;
+  for (const QString& name
+      : dir.entryList(QStringList(prefix + "*.seg"), QDir::Files)) {
+    bool valid = false;
+    const uint32_t run = name.mid(prefix.size()
+        , name.size() - prefix.size() - 4).toUInt(&valid);
+    if (valid && run > 0) {
+      runs.emplace_back(run, this->runPath(day, run));
+    }
+  }
+  std::sort(runs.begin(), runs.end());
+  return runs;
+}
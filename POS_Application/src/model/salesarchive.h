@@ -0,0 +1,413 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef SALESARCHIVE_H
+#define SALESARCHIVE_H
+
+#include <QFile>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "littleendian.h"
+#include "money.h"
+#include "receipt.h"
+
+/**
+ * @class SalesArchive
+ * @brief Columnar copy of the closed sales, segmented by day.
+ *
+ * Each day of sales is stored in its own segment file, where every field of
+ * the receipts is a separate column: timestamp, receipt ID, user, payment
+ * method, total and the position of its first line item. The line items
+ * have their own columns: product, quantity and unit price. The users and
+ * products are stored once in the dictionaries of the segment and the
+ * columns only hold their codes. The products of the dictionary are keyed by
+ * their stable ID, so the sales of a product are joined across renames.
+ *
+ * The segments are mapped while they are read, so an aggregate query only
+ * touches the pages of the columns it uses. Each column has its checksum,
+ * validated the first time the column is read.
+ *
+ * The sales of each flush are written as a new run of their day, a small
+ * segment next to the day's one, so an append never rewrites the sales
+ * already stored. The runs of a closed day are merged once into its
+ * segment, which records the last run it contains, so the runs that are
+ * left behind by an interrupted merge are skipped by the readers.
+ */
+class SalesArchive {
+public:
+  static const uint32_t SEGMENT_MAGIC = 0x47455350;  ///< "PSEG" in the file.
+  /// Segment version, the only one. The segments first appeared with this
+  /// archive, so the amounts in céntimos and the product IDs are part of it.
+  static const uint32_t SEGMENT_VERSION = 1;
+
+  /**
+   * @brief Columns of a segment, in the order they are stored.
+   */
+  enum Column {
+    TIMESTAMP = 0,   ///< Seconds since epoch of each receipt, 64 bits.
+    RECEIPT_ID,      ///< ID of each receipt, 64 bits.
+    USER_ID,         ///< Code of the user of each receipt, 32 bits.
+    PAYMENT_METHOD,  ///< Payment method of each receipt, 8 bits.
+    TOTAL,           ///< Total price of each receipt, céntimos in 64 bits.
+    FIRST_LINE,      ///< Position of the first line item of each receipt.
+    LINE_PRODUCT_ID, ///< Code of the product of each line item, 32 bits.
+    LINE_QUANTITY,   ///< Quantity of each line item, 32 bits.
+    LINE_UNIT_PRICE, ///< Unit price of each line item, céntimos in 64 bits.
+    USER_NAMES,      ///< Dictionary of the user names.
+    PRODUCT_NAMES,   ///< Dictionary of the product names.
+    PRODUCT_IDS,     ///< Stable ID of each product of the dictionary.
+    COLUMN_COUNT
+  };
+
+  /// Magic, version, receipts and line items counts, last merged run, and
+  /// the directory.
+  static const size_t SEGMENT_HEADER_SIZE = 20 + COLUMN_COUNT * 12;
+  static const size_t HOURS_PER_DAY = 24;  ///< Hours of the aggregates.
+  static const int64_t SECONDS_PER_HOUR = 3600;  ///< Length of each hour.
+
+  /**
+   * @struct LineItem
+   * @brief Product sold in a receipt.
+   */
+  struct LineItem {
+    uint64_t productID = 0; ///< Stable ID of the product, 0 if unknown.
+    std::string product;    ///< Name of the product.
+    uint32_t quantity = 0;  ///< Units sold.
+    Money unitPrice;        ///< Price of each unit.
+  };
+
+  /**
+   * @struct Sale
+   * @brief Row of a closed receipt, before it's split in columns.
+   */
+  struct Sale {
+    int64_t timestamp = 0;        ///< Seconds since epoch.
+    uint64_t receiptID = 0;       ///< ID of the receipt.
+    std::string user;             ///< Name of the user.
+    /// Code of the payment method.
+    uint8_t paymentMethod = Receipt::PAYMENT_OTHER;
+    Money total;                  ///< Total price.
+    std::vector<LineItem> lines;  ///< Sold products.
+  };
+
+  /**
+   * @struct Aggregate
+   * @brief Totals of a segment, with its users and products by their codes.
+   *
+   * The amounts are céntimos in plain integers, so the columns are added up
+   * without converting each amount.
+   */
+  struct Aggregate {
+    uint64_t receiptCount = 0;  ///< Receipts of the segment.
+    uint64_t lastReceiptID = 0; ///< Highest receipt ID of the segment.
+    int64_t total = 0;          ///< Amount of all the receipts.
+    /// Amount by payment method, indexed by its code.
+    int64_t byPaymentMethod[Receipt::PAYMENT_METHOD_COUNT] = {};
+    int64_t byHour[HOURS_PER_DAY] = {};           ///< Amount by hour.
+    uint64_t receiptsByHour[HOURS_PER_DAY] = {};  ///< Receipts by hour.
+    std::vector<std::string> users;        ///< Dictionary of the users.
+    std::vector<int64_t> byUser;           ///< Amount by user code.
+    std::vector<uint64_t> receiptsByUser;  ///< Receipts by user code.
+    std::vector<std::string> products;     ///< Dictionary of the products.
+    std::vector<uint64_t> productIDs;      ///< Stable ID by product code.
+    std::vector<int64_t> byProduct;        ///< Amount by product code.
+    std::vector<uint64_t> quantityByProduct;  ///< Units by product code.
+  };
+
+  /**
+   * @class Segment
+   * @brief Read-only, memory-mapped view of the segment of a day.
+   */
+  class Segment {
+  private:
+    QFile file;                   ///< Mapped segment file.
+    const uchar* data = nullptr;  ///< Mapped bytes.
+    uint64_t size = 0;            ///< Number of mapped bytes.
+    uint32_t receiptCount = 0;    ///< Receipts in the segment.
+    uint32_t lineCount = 0;       ///< Line items in the segment.
+    uint32_t lastRun = 0;         ///< Last run merged in the segment.
+    uint32_t columnOffsets[COLUMN_COUNT] = {}; ///< Start of each column.
+    uint32_t columnSizes[COLUMN_COUNT] = {};   ///< Size of each column.
+    uint32_t columnChecksums[COLUMN_COUNT] = {}; ///< CRC32C of each column.
+    bool columnChecked[COLUMN_COUNT] = {};     ///< Checksum validated.
+
+  public:
+    /**
+     * @brief Constructs a closed segment.
+     */
+    Segment() = default;
+
+    /**
+     * @brief Unmaps and closes the segment.
+     */
+    ~Segment();
+
+    /**
+     * @brief Maps a segment file and validates its header.
+     *
+     * @param filename Path to the segment file.
+     * @return False if the file doesn't exist or is not a valid segment.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Unmaps and closes the segment file.
+     */
+    void close();
+
+    /**
+     * @brief Gets the number of receipts of the segment.
+     * @return Number of receipts.
+     */
+    uint32_t getReceiptCount() const { return this->receiptCount; }
+
+    /**
+     * @brief Gets the number of line items of the segment.
+     * @return Number of line items.
+     */
+    uint32_t getLineCount() const { return this->lineCount; }
+
+    /**
+     * @brief Gets the last run of the day merged in the segment.
+     * @return Number of the run, 0 if no run was merged.
+     */
+    uint32_t getLastRun() const { return this->lastRun; }
+
+    /**
+     * @brief Gets the bytes of a column, validating its checksum.
+     *
+     * @param column The column.
+     * @return First byte of the column, or nullptr if it's damaged.
+     */
+    const char* column(const Column column);
+
+    /**
+     * @brief Reads the names of a dictionary column.
+     *
+     * @param column USER_NAMES or PRODUCT_NAMES.
+     * @param names Vector replaced with the names, in order of their codes.
+     * @return False if the column is damaged.
+     */
+    bool readNames(const Column column, std::vector<std::string>& names);
+
+    /**
+     * @brief Reads the stable IDs of the products of the dictionary.
+     *
+     * @param ids Vector replaced with the IDs, in order of their codes.
+     * @return False if the column is damaged.
+     */
+    bool readProductIDs(std::vector<uint64_t>& ids);
+
+    /**
+     * @brief Adds up the totals of the receipts.
+     *
+     * Only reads the TOTAL column, the céntimos are added up exactly.
+     *
+     * @param total Where the sum is stored.
+     * @return False if the column is damaged.
+     */
+    bool sumTotals(Money& total);
+
+    /**
+     * @brief Adds up the totals of the receipts by payment method.
+     *
+     * Only reads the PAYMENT_METHOD and TOTAL columns.
+     *
+     * @param totals Sum of each payment method, indexed by its code.
+     * @return False if a column is damaged.
+     */
+    bool sumTotalsByPaymentMethod(
+        Money (&totals)[Receipt::PAYMENT_METHOD_COUNT]);
+
+    /**
+     * @brief Adds up the units sold of each product.
+     *
+     * Only reads the LINE_PRODUCT_ID and LINE_QUANTITY columns.
+     *
+     * @param quantities Vector replaced with the units, indexed by the
+     *     product code of the PRODUCT_NAMES dictionary.
+     * @return False if a column is damaged.
+     */
+    bool sumQuantitiesByProduct(std::vector<uint64_t>& quantities);
+
+    /**
+     * @brief Adds up every total of the segment, for a report.
+     *
+     * Makes a single pass over the receipts columns and another one over
+     * the line items columns, adding the amounts as integers.
+     *
+     * @param dayStart Seconds since epoch of the start of the day of the
+     *     segment, the hours are counted from it.
+     * @param aggregate Where the totals are stored.
+     * @return False if a column is damaged.
+     */
+    bool aggregate(const int64_t dayStart, Aggregate& aggregate);
+
+    /**
+     * @brief Decodes all the rows of the segment.
+     *
+     * @param sales Vector where the sales are appended.
+     * @return False if a column is damaged.
+     */
+    bool readSales(std::vector<Sale>& sales);
+
+  private:
+    /**
+     * @brief Reads an amount of an amounts column.
+     *
+     * @param bytes First byte of the column.
+     * @param row Position of the amount in the column.
+     * @return The amount in céntimos.
+     */
+    static int64_t readCents(const char* bytes, const size_t row) {
+      return static_cast<int64_t>(LittleEndian::read64(bytes + row * 8));
+    }
+
+    // Copy and assignment constructors are disabled.
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+  };
+
+private:
+  std::string directory;  ///< Directory of the segment files.
+  /// Last run written of each day, for the numbers of the next runs.
+  std::map<std::string, uint32_t> lastRuns;
+  std::set<std::string> runDays;  ///< Days with runs that aren't merged.
+  bool runsScanned = false;       ///< The runs on the disk were listed.
+
+public:
+  /**
+   * @brief Constructs an archive over a directory of segments.
+   * @param segmentsDirectory Directory of the segment files.
+   */
+  explicit SalesArchive(const std::string& segmentsDirectory);
+
+  /**
+   * @brief Converts a receipt to the row of its sale.
+   *
+   * @param receipt The closed receipt.
+   * @return Row of the sale.
+   */
+  static Sale toSale(const Receipt& receipt);
+
+  /**
+   * @brief Gets the day key of a timestamp.
+   *
+   * @param timestamp Seconds since epoch.
+   * @return Local date as yyyyMMdd.
+   */
+  static std::string dayOf(const int64_t timestamp);
+
+  /**
+   * @brief Gets the path of the segment of a day.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @return Path to the segment file.
+   */
+  std::string segmentPath(const std::string& day) const;
+
+  /**
+   * @brief Gets the path of a run of a day.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param run Number of the run.
+   * @return Path to the run file.
+   */
+  std::string runPath(const std::string& day, const uint32_t run) const;
+
+  /**
+   * @brief Lists the files that hold the sales of a day.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @return Path to the segment of the day, if it exists, followed by the
+   *     runs that are not merged in it, in the order they were written.
+   */
+  std::vector<std::string> daySegments(const std::string& day) const;
+
+  /**
+   * @brief Lists the days with sales, with the files of each one.
+   *
+   * The directory is scanned once, not once for each day.
+   *
+   * @return Day keys as yyyyMMdd, in order, with the files that
+   *     daySegments() lists for each one.
+   */
+  std::vector<std::pair<std::string, std::vector<std::string>>>
+      listDays() const;
+
+  /**
+   * @brief Encodes sales as a segment.
+   *
+   * @param sales Rows of the segment, in order of receipt.
+   * @param lastRun Last run of the day merged in the segment.
+   * @return Bytes of the segment file.
+   */
+  static std::string encodeSegment(const std::vector<Sale>& sales
+      , const uint32_t lastRun = 0);
+
+  /**
+   * @brief Encodes new sales as a new run of each of their days.
+   *
+   * Only called by the thread that writes the runs.
+   *
+   * @param sales Rows of the new sales.
+   * @return Bytes of every new run, by run path.
+   */
+  std::vector<std::pair<std::string, std::string>> appendSales(
+      const std::vector<Sale>& sales);
+
+  /**
+   * @brief Takes the days before a day whose runs must be merged.
+   *
+   * The first call also finds the runs left on the disk by earlier runs of
+   * the application. Only called by the thread that writes the runs.
+   *
+   * @param today Day key as yyyyMMdd, its runs are kept for later.
+   * @return Day keys of the closed days with runs.
+   */
+  std::vector<std::string> takeClosedDays(const std::string& today);
+
+  /**
+   * @brief Merges the segment of a day and its runs.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param segment Bytes of the new segment of the day, empty if every run
+   *     was already merged.
+   * @param runs Paths to the merged runs, they can be removed once the new
+   *     segment is written.
+   * @return False if a file of the day is damaged, nothing is merged then.
+   */
+  bool compactDay(const std::string& day, std::string& segment
+      , std::vector<std::string>& runs) const;
+
+private:
+  /**
+   * @brief Lists the files of a day, skipping the runs already merged.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param segmentExists True if the day has its segment file.
+   * @param runs Number and path of each run, in order of number.
+   * @return The files, as daySegments() lists them.
+   */
+  std::vector<std::string> dayFiles(const std::string& day
+      , const bool segmentExists
+      , const std::vector<std::pair<uint32_t, std::string>>& runs) const;
+
+  /**
+   * @brief Lists the runs of a day on the disk.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @return Number and path of each run, in order of number.
+   */
+  std::vector<std::pair<uint32_t, std::string>> listRuns(
+      const std::string& day) const;
+
+  // Copy and assignment constructors are disabled.
+  SalesArchive(const SalesArchive&) = delete;
+  SalesArchive& operator=(const SalesArchive&) = delete;
+};
+
+#endif // SALESARCHIVE_H
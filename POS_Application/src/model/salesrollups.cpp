@@ -0,0 +1,166 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include "salesrollups.h"
+
+#include <QDateTime>
+#include <algorithm>
+
+#include "binaryreader.h"
+#include "binarywriter.h"
+
+void SalesRollups::Totals::merge(const Totals& other) {
+  this->lastReceiptID = std::max(this->lastReceiptID, other.lastReceiptID);
+  this->receiptCount += other.receiptCount;
+  this->total += other.total;
+  for (size_t method = 0; method < Receipt::PAYMENT_METHOD_COUNT; ++method) {
+    this->byPaymentMethod[method] += other.byPaymentMethod[method];
+  }
+  for (size_t hour = 0; hour < HOURS_PER_DAY; ++hour) {
+    this->byHour[hour] += other.byHour[hour];
+    this->receiptsByHour[hour] += other.receiptsByHour[hour];
+  }
+  // Merges the products, keeping the name of the latest day.
+  for (const auto& [key, product] : other.products) {
+    ProductTotal& merged = this->products[key];
+    merged.productID = product.productID;
+    merged.name = product.name;
+    merged.quantity += product.quantity;
+    merged.amount += product.amount;
+  }
+  for (const auto& [category, categoryTotal] : other.categories) {
+    ItemTotal& merged = this->categories[category];
+    merged.quantity += categoryTotal.quantity;
+    merged.amount += categoryTotal.amount;
+  }
+}
+
+SalesRollups::Totals* SalesRollups::findDay(const std::string& day) {
+  const auto found = this->days.find(day);
+  return found == this->days.end() ? nullptr : &found->second;
+}
+
+SalesRollups::Totals& SalesRollups::insertDay(const std::string& day
+    , Totals totals) {
+  return this->days.insert_or_assign(day, std::move(totals)).first->second;
+}
+
+void SalesRollups::addReceipt(Totals& totals, const Receipt& receipt
+    , const std::vector<StringPool::StringID>& categories) {
+  const Money price = receipt.getPrice();
+  const size_t hour = static_cast<size_t>(
+      QDateTime::fromSecsSinceEpoch(receipt.getTimestamp()).time().hour());
+  // Adds the receipt to the totals of the day, its method and its hour.
+  totals.lastReceiptID = std::max(totals.lastReceiptID, receipt.getID());
+  ++totals.receiptCount;
+  totals.total += price;
+  totals.byPaymentMethod[receipt.getPaymentMethodCode()] += price;
+  totals.byHour[hour % HOURS_PER_DAY] += price;
+  ++totals.receiptsByHour[hour % HOURS_PER_DAY];
+  // Adds each line to its product and its category.
+  const std::vector<Receipt::LineItem>& lines = receipt.getLines();
+  for (size_t index = 0; index < lines.size(); ++index) {
+    const Receipt::LineItem& line = lines[index];
+    const Money amount = line.price * line.quantity;
+    const ProductKey key(line.productID
+        , line.productID == 0 ? line.name : StringPool::EMPTY);
+    ProductTotal& product = totals.products[key];
+    product.productID = line.productID;
+    product.name = line.name;
+    product.quantity += line.quantity;
+    product.amount += amount;
+    const StringPool::StringID category = index < categories.size()
+        ? categories[index] : StringPool::EMPTY;
+    ItemTotal& categoryTotal = totals.categories[category];
+    categoryTotal.quantity += line.quantity;
+    categoryTotal.amount += amount;
+  }
+}
+
+SalesRollups::Totals SalesRollups::summarize(const std::string& firstDay
+    , const std::string& lastDay) const {
+  // The day keys sort by date, the range is contiguous in the map.
+  Totals summary;
+  for (auto day = this->days.lower_bound(firstDay)
+      ; day != this->days.end() && day->first <= lastDay; ++day) {
+    summary.merge(day->second);
+  }
+  return summary;
+}
+
+void SalesRollups::encode(const Totals& totals, BinaryWriter& writer) {
+  const StringPool& pool = StringPool::getInstance();
+  // Writes out the totals of the receipts.
+  writer.writeU64(totals.lastReceiptID);
+  writer.writeU64(totals.receiptCount);
+  writer.writeMoney(totals.total);
+  for (const Money amount : totals.byPaymentMethod) {
+    writer.writeMoney(amount);
+  }
+  for (size_t hour = 0; hour < HOURS_PER_DAY; ++hour) {
+    writer.writeMoney(totals.byHour[hour]);
+    writer.writeU64(totals.receiptsByHour[hour]);
+  }
+  // Writes out the products and the categories with their names.
+  writer.writeU32(static_cast<uint32_t>(totals.products.size()));
+  for (const auto& [key, product] : totals.products) {
+    writer.writeU64(product.productID);
+    writer.writeString(pool.lookup(product.name));
+    writer.writeU64(product.quantity);
+    writer.writeMoney(product.amount);
+  }
+  writer.writeU32(static_cast<uint32_t>(totals.categories.size()));
+  for (const auto& [category, categoryTotal] : totals.categories) {
+    writer.writeString(pool.lookup(category));
+    writer.writeU64(categoryTotal.quantity);
+    writer.writeMoney(categoryTotal.amount);
+  }
+}
+
+bool SalesRollups::decode(BinaryReader& reader, Totals& totals) {
+  StringPool& pool = StringPool::getInstance();
+  Totals decoded;
+  uint64_t lastReceiptID = 0;
+  // Reads the totals of the receipts.
+  reader.readU64(lastReceiptID);
+  reader.readU64(decoded.receiptCount);
+  reader.readMoney(decoded.total);
+  for (Money& amount : decoded.byPaymentMethod) {
+    reader.readMoney(amount);
+  }
+  for (size_t hour = 0; hour < HOURS_PER_DAY; ++hour) {
+    reader.readMoney(decoded.byHour[hour]);
+    reader.readU64(decoded.receiptsByHour[hour]);
+  }
+  decoded.lastReceiptID = static_cast<size_t>(lastReceiptID);
+  // Each product takes its ID, name length, quantity and amount.
+  uint32_t numProducts = 0;
+  reader.readCount(numProducts, 28);
+  for (uint32_t i = 0; reader.isValid() && i < numProducts; ++i) {
+    ProductTotal product;
+    std::string name;
+    reader.readU64(product.productID);
+    reader.readString(name, MAX_NAME_LENGTH);
+    reader.readU64(product.quantity);
+    reader.readMoney(product.amount);
+    product.name = pool.intern(name);
+    const ProductKey key(product.productID
+        , product.productID == 0 ? product.name : StringPool::EMPTY);
+    decoded.products[key] = product;
+  }
+  // Each category takes its name length, quantity and amount.
+  uint32_t numCategories = 0;
+  reader.readCount(numCategories, 20);
+  for (uint32_t i = 0; reader.isValid() && i < numCategories; ++i) {
+    ItemTotal categoryTotal;
+    std::string name;
+    reader.readString(name, MAX_NAME_LENGTH);
+    reader.readU64(categoryTotal.quantity);
+    reader.readMoney(categoryTotal.amount);
+    decoded.categories[pool.intern(name)] = categoryTotal;
+  }
+  // Any failed read invalidates the whole day.
+  if (!reader.isValid()) {
+    return false;
+  }
+  totals = std::move(decoded);
+  return true;
+}
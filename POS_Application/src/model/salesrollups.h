@@ -0,0 +1,146 @@
+// Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#ifndef SALESROLLUPS_H
+#define SALESROLLUPS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "money.h"
+#include "receipt.h"
+#include "stringpool.h"
+
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * @class SalesRollups
+ * @brief Sales totals of each day, maintained as the receipts are generated.
+ *
+ * Every day keeps its totals by product, category, hour and payment method,
+ * so the dashboards of a day, a week or a month only merge a few day totals
+ * and never read the receipts history. The totals of each day are saved in
+ * their own file next to the receipts, and are only loaded when a dashboard
+ * needs them.
+ *
+ * Each day remembers the last receipt added to it, so the receipts that were
+ * generated after its last save are found and added again on the next start.
+ */
+class SalesRollups {
+public:
+  static const uint32_t ROLLUP_MAGIC = 0x4c4c4f52;  ///< "ROLL" in the file.
+  static const uint32_t ROLLUP_VERSION = 1;         ///< Rollup version.
+  static const uint32_t MAX_ROLLUP_SIZE = 64u * 1024u * 1024u; ///< Record.
+  static const uint32_t MAX_NAME_LENGTH = 1024;  ///< Products and categories.
+  static const size_t HOURS_PER_DAY = 24;        ///< Hours of the totals.
+
+  /**
+   * @struct ItemTotal
+   * @brief Units and amount sold of a product or a category.
+   */
+  struct ItemTotal {
+    uint64_t quantity = 0;  ///< Units sold.
+    Money amount;           ///< Amount sold.
+  };
+
+  /**
+   * @struct ProductTotal
+   * @brief Units and amount sold of a product.
+   */
+  struct ProductTotal : ItemTotal {
+    uint64_t productID = 0;  ///< Stable ID of the product, 0 if unknown.
+    StringPool::StringID name = StringPool::EMPTY;  ///< Last name sold.
+  };
+
+  /// Products keyed by their ID, or by their name if they have none.
+  typedef std::pair<uint64_t, StringPool::StringID> ProductKey;
+
+  /**
+   * @struct Totals
+   * @brief Totals of a day, or of a range of days.
+   */
+  struct Totals {
+    size_t lastReceiptID = 0;   ///< Last receipt added to the totals.
+    uint64_t receiptCount = 0;  ///< Receipts added to the totals.
+    Money total;                ///< Amount of all the receipts.
+    /// Amount by payment method, indexed by its code.
+    Money byPaymentMethod[Receipt::PAYMENT_METHOD_COUNT];
+    Money byHour[HOURS_PER_DAY];             ///< Amount by hour of the day.
+    uint64_t receiptsByHour[HOURS_PER_DAY] = {};  ///< Receipts by hour.
+    std::map<ProductKey, ProductTotal> products;  ///< Sold by product.
+    /// Sold by category, keyed by its interned name.
+    std::map<StringPool::StringID, ItemTotal> categories;
+
+    /**
+     * @brief Adds the totals of another day.
+     * @param other Totals of the day.
+     */
+    void merge(const Totals& other);
+  };
+
+private:
+  std::map<std::string, Totals> days;  ///< Loaded totals by day, yyyyMMdd.
+
+public:
+  /**
+   * @brief Gets the loaded totals of a day.
+   * @param day Day key as yyyyMMdd.
+   * @return The totals, or nullptr if the day isn't loaded.
+   */
+  Totals* findDay(const std::string& day);
+
+  /**
+   * @brief Keeps the totals of a day, loaded from its backup.
+   *
+   * @param day Day key as yyyyMMdd.
+   * @param totals Totals of the day, empty if it has no backup.
+   * @return The kept totals.
+   */
+  Totals& insertDay(const std::string& day, Totals totals);
+
+  /**
+   * @brief Adds a receipt to the totals of a day.
+   *
+   * @param totals Totals of the day of the receipt.
+   * @param receipt The receipt.
+   * @param categories Interned category of each line of the receipt,
+   *     StringPool::EMPTY if the product has none.
+   */
+  static void addReceipt(Totals& totals, const Receipt& receipt
+      , const std::vector<StringPool::StringID>& categories);
+
+  /**
+   * @brief Merges the loaded totals of a range of days.
+   *
+   * @param firstDay First day key of the range, as yyyyMMdd.
+   * @param lastDay Last day key of the range, included.
+   * @return The merged totals.
+   */
+  Totals summarize(const std::string& firstDay
+      , const std::string& lastDay) const;
+
+  /**
+   * @brief Forgets all the loaded totals.
+   */
+  void clear() { this->days.clear(); }
+
+  /**
+   * @brief Encodes the totals of a day in the portable binary format.
+   * @param totals Totals of the day.
+   * @param writer Writer where the totals are encoded.
+   */
+  static void encode(const Totals& totals, BinaryWriter& writer);
+
+  /**
+   * @brief Decodes the totals written by encode().
+   *
+   * @param reader Reader positioned at the totals.
+   * @param totals Totals where the decoded ones are stored.
+   * @return True if the totals were complete and valid.
+   */
+  static bool decode(BinaryReader& reader, Totals& totals);
+};
+
+#endif // SALESROLLUPS_H
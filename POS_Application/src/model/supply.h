@@ -65,6 +65,11 @@ public:
     return !(this == &other);
   }
   
+  // Moving a supply moves its names instead of copying them.
+  Supply(const Supply& other) = default;
+  Supply(Supply&& other) = default;
+  Supply& operator=(Supply&& other) = default;
+  
   /**
    * @brief Overloads the assignment operator to copy the values of another supply.
    * 
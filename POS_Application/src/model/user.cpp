@@ -2,6 +2,9 @@
 
 #include <iostream>
 
+#include "binaryreader.h"
+#include "binarywriter.h"
+
 User::User(const size_t userId, const std::string userName
     , const std::vector<PageAccess> userPermissions)
     : id(userId)
@@ -105,35 +108,48 @@ User::PageAccess& User::PageAccess::operator=(const PageAccess& other) {
   return *this;
 }
 
-void User::saveToBinary(std::ofstream& outFile) const {
-  // Checks if the given output file is already open.
-  if (outFile.is_open()) {
-    // Writes out the user's id information.
-    outFile.write(reinterpret_cast<const char*>(&this->id),
-        sizeof(this->id));
-    
-    // Writes out the user's name information.
-    size_t nameLength = this->name.size();
-    outFile.write(reinterpret_cast<const char*>(&nameLength),
-        sizeof(nameLength));
-    outFile.write(this->name.c_str(), nameLength);
-    
-    // Writes out the user's password information.
-    outFile.write(reinterpret_cast<const char*>(&this->password),
-        sizeof(this->password));
-    
-    // Writes out the number of the user's permissions information.
-    size_t numPermissions = this->permissions.size();
-    outFile.write(reinterpret_cast<const char*>(&numPermissions),
-        sizeof(numPermissions));
-    
-    // Writes out each user's permission information.
-    for (const auto& perm : this->permissions) {
-      perm.saveToBinary(outFile);
-    }
-  } else {
-    std::cerr << "Error: El archivo no se pudo abrir para escritura.\n";
+void User::encode(BinaryWriter& writer) const {
+  // Writes out the user's id, name and password.
+  writer.writeU64(this->id);
+  writer.writeString(this->name);
+  writer.writeU64(this->password);
+  // Writes out each user's permission.
+  writer.writeU32(static_cast<uint32_t>(this->permissions.size()));
+  for (const auto& perm : this->permissions) {
+    writer.writeU64(perm.pageIndex);
+    writer.writeU8(static_cast<uint8_t>(perm.access));
+  }
+}
+
+bool User::decode(BinaryReader& reader) {
+  uint64_t userId = 0;
+  uint64_t userPassword = 0;
+  std::string userName;
+  uint32_t numPermissions = 0;
+  // Reads the user's id, name and password.
+  reader.readU64(userId);
+  reader.readString(userName, MAX_NAME_LENGTH);
+  reader.readU64(userPassword);
+  // Each permission takes its page index and its access.
+  reader.readCount(numPermissions, 9);
+  std::vector<PageAccess> userPermissions;
+  userPermissions.reserve(reader.isValid() ? numPermissions : 0);
+  for (uint32_t i = 0; reader.isValid() && i < numPermissions; ++i) {
+    uint64_t pageIndex = 0;
+    uint8_t access = PageAccess::DENIED;
+    reader.readU64(pageIndex);
+    reader.readU8(access);
+    userPermissions.emplace_back(pageIndex, access);
+  }
+  // Any failed read invalidates the whole user.
+  if (!reader.isValid()) {
+    return false;
   }
+  this->id = userId;
+  this->name = userName;
+  this->password = userPassword;
+  this->permissions = userPermissions;
+  return true;
 }
 
 void User::loadFromBinary(std::ifstream& inFile) {
@@ -145,8 +161,13 @@ void User::loadFromBinary(std::ifstream& inFile) {
     this->id = tmpId;
     
     // Reads the user's name information.
-    size_t nameLength;
+    size_t nameLength = 0;
     inFile.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+    // Rejects corrupted lengths before allocating the name.
+    if (!inFile || nameLength > MAX_NAME_LENGTH) {
+      inFile.setstate(std::ios::failbit);
+      return;
+    }
     name.resize(nameLength);
     inFile.read(&name[0], nameLength);
     
@@ -155,9 +176,13 @@ void User::loadFromBinary(std::ifstream& inFile) {
         sizeof(password));
     
     // Reads the number of user's permissions.
-    size_t numPermissions;
+    size_t numPermissions = 0;
     inFile.read(reinterpret_cast<char*>(&numPermissions),
         sizeof(numPermissions));
+    if (!inFile || numPermissions > MAX_PERMISSIONS) {
+      inFile.setstate(std::ios::failbit);
+      return;
+    }
     
     // Prepares the user's permissions vector.
     permissions.clear();
@@ -172,20 +197,6 @@ void User::loadFromBinary(std::ifstream& inFile) {
   }
 }
 
-void User::PageAccess::saveToBinary(std::ofstream& outFile) const {
-  // Checks that the output file is already open.
-  if (outFile.is_open()) {
-    // Writes out the page access index.
-    outFile.write(reinterpret_cast<const char*>(&this->pageIndex)
-        , sizeof(this->pageIndex));
-    // Writes out the page access user's access state information.    
-    outFile.write(reinterpret_cast<const char*>(&this->access)
-        , sizeof(this->access));
-  } else {
-    std::cerr << "Error: El archivo no se pudo abrir para escritura.\n";
-  }
-}
-
 void User::PageAccess::loadFromBinary(std::ifstream& inFile) {
   if (inFile.is_open()) {
     // Reads out the page access index.  
@@ -1,12 +1,16 @@
 #ifndef USER_H
 #define USER_H
 
+#include <cstdint>
 #include <fstream>
 #include <qdebug.h>
 #include <qlogging.h>
 #include <string>
 #include <vector>
 
+class BinaryReader;
+class BinaryWriter;
+
 /**
  * @class User
  * @brief Represents a user in the POS system.
@@ -72,16 +76,7 @@ public:
     
   public:
     /**
-     * @brief Saves the PageAccess data to a binary file.
-     *
-     * Serializes the pageIndex, access, and dataAccess values to the output stream.
-     *
-     * @param outFile Output file stream (must be open).
-     */
-    void saveToBinary(std::ofstream& outFile) const;
-    
-    /**
-     * @brief Loads the PageAccess data from a binary file.
+     * @brief Loads the PageAccess data from a legacy binary file.
      *
      * Deserializes the pageIndex, access, and dataAccess values from the input stream.
      *
@@ -89,6 +84,9 @@ public:
      */
     void loadFromBinary(std::ifstream& inFile);
   };
+  
+  static const uint32_t MAX_NAME_LENGTH = 256;  ///< Longest accepted name.
+  static const uint32_t MAX_PERMISSIONS = 64;   ///< Most accepted permissions.
     
 private:
   size_t id = 0;                    ///< Unique identifier of the user.
@@ -207,18 +205,29 @@ public:
   void setUserPermissions(const std::vector<PageAccess> permissions);
   
   /**
-   * @brief Saves the user's data to a binary file.
+   * @brief Encodes the user's data in the portable binary format.
+   *
+   * Serializes the user's id, name, password, and permissions with fixed-width
+   * little-endian fields.
    *
-   * Serializes the user's id, name, password, and permissions to the output stream.
+   * @param writer Writer where the user is encoded.
+   */
+  void encode(BinaryWriter& writer) const;
+  
+  /**
+   * @brief Decodes the user's data written by encode().
    *
-   * @param outFile Output file stream (must be open).
+   * @param reader Reader positioned at the user.
+   * @return True if the user was complete and valid.
    */
-  void saveToBinary(std::ofstream& outFile) const;
+  bool decode(BinaryReader& reader);
   
   /**
-   * @brief Loads the user's data from a binary file.
+   * @brief Loads the user's data from a legacy binary file.
    *
-   * Deserializes the user's id, name, password, and permissions from the input stream.
+   * Deserializes the user's id, name, password, and permissions from the input
+   * stream, as they were written before the portable format. Fails the stream
+   * if a length is not plausible.
    *
    * @param inFile Input file stream (must be open).
    */
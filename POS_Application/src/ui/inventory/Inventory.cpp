@@ -1,6 +1,12 @@
 // Copyright [2025] Aaron Carmona Sanchez <aaron.carmona@ucr.ac.cr>
+#include <QFileDialog>
+#include <QKeySequence>
 #include <QMessageBox>
+#include <QShortcut>
 #include <QStackedWidget>
+#include <QThread>
+#include <memory>
+#include <string>
 
 #include "inventory.h"
 #include "ui_inventory.h"
@@ -8,6 +14,8 @@
 #include "categoriescatalog.h"
 #include "productscatalog.h"
 #include "suppliescatalog.h"
+#include "backupmodule.h"
+#include "modelsnapshot.h"
 #include "posmodel.h"
 
 Inventory::Inventory(QWidget *parent, POS_Model& appModel)
@@ -48,6 +56,11 @@ void Inventory::setupConnections() {
   // Connects the function that handles the supplies catalog button.
   this->connect(this->ui->suppliesCatalog_button, &QPushButton::clicked
       , this, &Inventory::on_suppliesCatalog_button_clicked);
+  // Connects the undo and redo shortcuts of the changes to the inventory.
+  this->connect(new QShortcut(QKeySequence::Undo, this)
+      , &QShortcut::activated, this, &Inventory::undo_shortcut_activated);
+  this->connect(new QShortcut(QKeySequence::Redo, this)
+      , &QShortcut::activated, this, &Inventory::redo_shortcut_activated);
 }
 
 void Inventory::refreshDisplay(const size_t pageItems) {
@@ -65,6 +78,84 @@ void Inventory::on_suppliesCatalog_button_clicked() {
   this->switchCatalog(2);
 }
 
+void Inventory::undo_shortcut_activated() {
+  // Only the users that can edit the inventory can undo its changes.
+  if (this->model.getPageAccess(2) == User::PageAccess::EDITABLE
+      && this->model.undo(ModelSnapshot::PRODUCTS | ModelSnapshot::SUPPLIES)) {
+    this->refreshCatalogs();
+  }
+}
+
+void Inventory::redo_shortcut_activated() {
+  // Only the users that can edit the inventory can redo its changes.
+  if (this->model.getPageAccess(2) == User::PageAccess::EDITABLE
+      && this->model.redo(ModelSnapshot::PRODUCTS | ModelSnapshot::SUPPLIES)) {
+    this->refreshCatalogs();
+  }
+}
+
+void Inventory::on_exportCatalog_button_clicked() {
+  const QString filename = QFileDialog::getSaveFileName(this
+      , "Exportar catálogo", "Products.txt", "Catálogo de texto (*.txt)");
+  if (filename.isEmpty()) {
+    return;
+  }
+  // The thread reads the snapshot, never the model, that keeps changing.
+  const std::shared_ptr<const ModelSnapshot> snapshot
+      = this->model.getSnapshot();
+  const std::shared_ptr<std::string> error = std::make_shared<std::string>();
+  QThread* exporter = QThread::create(
+      [snapshot, error, path = filename.toStdString()] {
+        try {
+          BackupModule::exportProductsText(*snapshot->categories, path);
+        } catch (const std::exception& exception) {
+          *error = exception.what();
+        }
+      });
+  // Reports the result in the GUI thread, if the page still exists.
+  this->connect(exporter, &QThread::finished, this, [this, error] {
+    if (error->empty()) {
+      QMessageBox::information(this, "Catálogo exportado."
+          , "El catálogo de productos se exportó correctamente.");
+    } else {
+      QMessageBox::warning(this, "No se exportó el catálogo."
+          , QString::fromStdString(*error));
+    }
+  });
+  this->connect(exporter, &QThread::finished, exporter, &QObject::deleteLater);
+  exporter->start();
+}
+
+void Inventory::on_importCatalog_button_clicked() {
+  // Only the users that can edit the inventory can import products.
+  if (this->model.getPageAccess(2) != User::PageAccess::EDITABLE) {
+    QMessageBox::warning(this, "No se importó el catálogo."
+        , "No tiene permisos para modificar el inventario.");
+    return;
+  }
+  const QString filename = QFileDialog::getOpenFileName(this
+      , "Importar catálogo", "Products.txt", "Catálogo de texto (*.txt)");
+  if (filename.isEmpty()) {
+    return;
+  }
+  try {
+    const size_t added = this->model.importProducts(filename.toStdString());
+    this->refreshCatalogs();
+    QMessageBox::information(this, "Catálogo importado."
+        , QString("Se agregaron %1 productos al inventario.").arg(added));
+  } catch (const std::exception& exception) {
+    QMessageBox::warning(this, "No se importó el catálogo."
+        , exception.what());
+  }
+}
+
+void Inventory::refreshCatalogs() {
+  // Every catalog may show the changed items.
+  for (int index = 0; index < this->catalogStack->count(); ++index) {
+    static_cast<Catalog*>(this->catalogStack->widget(index))->refresh();
+  }
+}
+
 void Inventory::switchCatalog(const size_t index) {
   // Set the current catalog page
   this->catalogStack->setCurrentIndex(index);
@@ -38,6 +38,11 @@ public:
    */
   virtual ~Catalog() {}
   
+  /**
+   * @brief Shows again the items of the current page, after the model changed.
+   */
+  void refresh() { this->refreshDisplay(this->itemsPerPage); }
+  
 protected:
   POS_Model& model;            ///< Reference to the application model.
   size_t currentPageIndex = 0; ///< Index of the currently displayed page.
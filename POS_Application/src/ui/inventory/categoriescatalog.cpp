@@ -59,7 +59,7 @@ void CategoriesCatalog::refreshDisplay(const size_t pageItems) {
 }
 
 void CategoriesCatalog::refreshCategoriesDisplay(
-    std::vector<std::string> visibleCategories
+    const PageView<ProductView::Categories::const_iterator>& visibleCategories
     , const size_t items) {
   // Initiazates the label index iterator.
   size_t labelIt = 0;
@@ -72,9 +72,9 @@ void CategoriesCatalog::refreshCategoriesDisplay(
     // If theres remaining products information to be displayed.
     if (index < visibleCategories.size()) {
       // Extracts all the product information to display it on the screen.
-      category = visibleCategories[index].data();
-      numberOfProducts = QString::number(this->model.getSizeOfCategory(
-          visibleCategories[index]));
+      category = visibleCategories[index]->first.data();
+      numberOfProducts = QString::number(
+          visibleCategories[index]->second.size());
     }
     // Updates the the different labels for each product information that is
     // displayed in the UI.
@@ -140,7 +140,7 @@ void CategoriesCatalog::delete_button_clicked() {
       // page to avoid an empty row.
       if (buttonIndex < categoriesForPage.size()) {
         // Gets the row category.
-        const std::string category = categoriesForPage[buttonIndex];
+        const std::string category = categoriesForPage[buttonIndex]->first;
         // Try to remove the category from the registered ones.
         if (this->model.removeCategory(category)) {
           // Refresh the categories display with the updated data.
@@ -171,7 +171,8 @@ void CategoriesCatalog::edit_button_clicked() {
       // page to avoid an empty row.
       if (buttonIndex < categoriesForPage.size()) {
         // Gets the row category.
-        const std::string oldCategory = categoriesForPage[buttonIndex];
+        const std::string oldCategory
+            = categoriesForPage[buttonIndex]->first;
         qDebug() << "Button clicked, index:" << buttonIndex << " " << oldCategory;
         // Creates a dialog to manage the existing category editing.
         CategoryFormDialog dialog(this, this->model.getRegisteredCategories()
@@ -51,10 +51,11 @@ protected:
 private:
   /**
    * @brief Refreshes the display for visible categories on the current page.
-   * @param visibleCategories A vector of category names to display.
+   * @param visibleCategories View of the category entries to display.
    * @param items The number of categories to display.
    */
-  void refreshCategoriesDisplay(std::vector<std::string> visibleCategories
+  void refreshCategoriesDisplay(
+      const PageView<ProductView::Categories::const_iterator>& visibleCategories
       , const size_t items);
   
 private slots:
@@ -66,6 +66,11 @@ protected:
    */
   void switchCatalog(const size_t index);
   
+  /**
+   * @brief Shows again the items of every catalog, after the model changed.
+   */
+  void refreshCatalogs();
+  
 private slots:
   /**
    * @brief Slot for handling the "ProductsCatalog" button click event.
@@ -81,6 +86,33 @@ private slots:
    * @brief Slot for handling the "SuppliesCatalog" button click event.
    */
   void on_suppliesCatalog_button_clicked();
+  
+  /**
+   * @brief Slot for handling the undo shortcut, undoes the last change of the
+   * products or the supplies.
+   */
+  void undo_shortcut_activated();
+  
+  /**
+   * @brief Slot for handling the redo shortcut, makes again the last undone
+   * change of the products or the supplies.
+   */
+  void redo_shortcut_activated();
+  
+  /**
+   * @brief Slot for handling the "ExportCatalog" button click event.
+   *
+   * Writes the products to a text catalog in another thread, from a snapshot
+   * of the model, so the inventory can keep changing meanwhile.
+   */
+  void on_exportCatalog_button_clicked();
+  
+  /**
+   * @brief Slot for handling the "ImportCatalog" button click event.
+   *
+   * Adds the products of a text catalog that the inventory doesn't have.
+   */
+  void on_importCatalog_button_clicked();
 };
 
 #endif // INVENTORY_H
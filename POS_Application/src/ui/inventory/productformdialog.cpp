@@ -9,12 +9,13 @@
 #include "ui_productformdialog.h"
 
 ProductFormDialog::ProductFormDialog(QWidget *parent
-    , std::map<std::string, std::vector<Product>>& products
+    , const std::map<std::string, std::vector<Product>>& products
     , Product product
     , QString category)
     : QDialog(parent)
     , registeredProducts(products)
     , createdProduct(product)
+    , productImage(product.getImage())
     , productCategory(category)
     , ui(new Ui::ProductFormDialog) {
   this->ui->setupUi(this);
@@ -80,11 +81,13 @@ void ProductFormDialog::productImageSelector_button_clicked() {
     QString filePath = dialog.selectedFiles().first();
     // Creates a pix map with the file information.
     QPixmap productImage(filePath);
-    // Stablish the product image label to show the selected image.
-    this->ui->producImage_label->setPixmap(productImage.scaled(
-        this->ui->producImage_label->size()
+    productImage = productImage.scaled(this->ui->producImage_label->size()
         , Qt::KeepAspectRatio
-        , Qt::SmoothTransformation));
+        , Qt::SmoothTransformation);
+    // Stablish the product image label to show the selected image.
+    this->ui->producImage_label->setPixmap(productImage);
+    // Keeps the image in the store until the backup writes it.
+    this->productImage = ImageStore::getInstance().addPixmap(productImage);
     // Updates the label to display the pixmap.
     // this->ui->producImage_label->update();
   }
@@ -100,8 +103,9 @@ void ProductFormDialog::acceptProduct_button_clicked() {
   QString productCategory = this->ui->productCategory_comboBox->currentText();
   QString productName = this->ui->productName_lineEdit->text();
   QString productIngredients = this->ui->productIngredients_lineEdit->text();
-  double productPrice = this->ui->productPrice_doubleSpinBox->value();
-  const QPixmap productImage = this->ui->producImage_label->pixmap();
+  // The spin box has two decimals, the price is kept in céntimos.
+  const Money productPrice = Money::fromDouble(
+      this->ui->productPrice_doubleSpinBox->value());
     
   QRegularExpression regex(R"(^\s*\p{L}+\s+\d+(\s*,\s*\p{L}+\s+\d+)*\s*$)");
   // Checks if product name were provided.
@@ -127,18 +131,20 @@ void ProductFormDialog::acceptProduct_button_clicked() {
         // Emplace a new ingredients to the product's vector ingredients.
         ingredients.emplace_back(name, quantity);
       }
-      // Store a new product into with information given by the user.      
+      // Store a new product into with information given by the user, an
+      // edited product keeps its ID and the new ones get it from the model.
+      const uint64_t productID = this->createdProduct.getID();
       // Checks if the product image pixmap is valid.
-      if (productImage.isNull()) {
+      if (this->productImage == ImageStore::NO_IMAGE) {
         qDebug() << "La imagen porporcionada por el usuario tiene un error o no"
                     " se ha porporcionado imagen para el producto.";
         // Create a new product with without a image
-        this->createdProduct = Product(1, productName.toStdString()
+        this->createdProduct = Product(productID, productName.toStdString()
             , ingredients, productPrice);
       } else {
         // Store a new product into with image information.
-        this->createdProduct = Product(1, productName.toStdString()
-            , ingredients, productPrice, productImage);
+        this->createdProduct = Product(productID, productName.toStdString()
+            , ingredients, productPrice, this->productImage);
       }
       // Stablish that the Qdialog has finished correctly.
       this->accept();
@@ -173,8 +179,12 @@ void ProductFormDialog::setProductInfo(
   // Sets the text of the lineEdit of the product ingredients.
   this->ui->productIngredients_lineEdit->setText(productIngredients);
   // Sets the value of the double spin box of the product price.
-  this->ui->productPrice_doubleSpinBox->setValue(productToEdit.getPrice());
-  this->ui->producImage_label->setPixmap(productToEdit.getImage().scaled(
+  this->ui->productPrice_doubleSpinBox->setValue(
+      productToEdit.getPrice().toDouble());
+  this->productImage = productToEdit.getImage();
+  const QPixmap productImage
+      = ImageStore::getInstance().getPixmap(this->productImage);
+  this->ui->producImage_label->setPixmap(productImage.scaled(
       this->ui->producImage_label->size()
       , Qt::KeepAspectRatio
       , Qt::SmoothTransformation));
@@ -38,6 +38,11 @@ private:
    */
   Product createdProduct;
   
+  /**
+   * @brief Image of the product, it's only replaced if the user picks one.
+   */
+  ImageStore::ImageID productImage = ImageStore::NO_IMAGE;
+  
   /**
    * @brief The category of the product being created or edited.
    */
@@ -56,7 +61,7 @@ public:
    * @param productCategory The initial category for the product.
    */
   explicit ProductFormDialog(QWidget *parent
-      , std::map<std::string, std::vector<Product>>& products
+      , const std::map<std::string, std::vector<Product>>& products
       , Product productToCreate
       , QString productCategory);
   
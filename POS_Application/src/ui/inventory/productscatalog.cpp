@@ -67,7 +67,7 @@ void ProductsCatalog::refreshDisplay(const size_t pageItems) {
 }
 
 void ProductsCatalog::refreshProductDisplay(
-    std::vector<std::pair<std::string, Product>> visibleProducts
+    const std::vector<ProductView::Row>& visibleProducts
     , const size_t items) {
   // Initiazates the label index iterator.
   size_t labelIt = 0;
@@ -83,14 +83,13 @@ void ProductsCatalog::refreshProductDisplay(
     // If theres remaining products information to be displayed.
     if (index < visibleProducts.size()) {
       // Extracts all the product information to display it on the screen.
-      productID = 
-          std::to_string(visibleProducts[index].second.getID()).data();
-      productName = visibleProducts[index].second.getName().data();
-      productCategory = visibleProducts[index].first.data();
-      productPrice = QString::number(visibleProducts[index].second.getPrice(),
-                                     'f', 2);
+      const Product& product = *visibleProducts[index].product;
+      productID = std::to_string(product.getID()).data();
+      productName = product.getName().data();
+      productCategory = visibleProducts[index].category->data();
+      productPrice = Util::formatMoney(product.getPrice());
       productIngredients = this->model.formatProductIngredients(
-          visibleProducts[index].second.getIngredients());
+          product.getIngredients());
     }
     // Updates the the different labels for each product information that is
     // displayed in the UI.
@@ -163,8 +162,8 @@ void ProductsCatalog::delete_button_clicked() {
       // Obtain the index of the display button.
       const size_t buttonIndex = button->property("index").toUInt();
       qDebug() << "Button clicked, index:" << buttonIndex;
-      if (buttonIndex < this->model.getProductsForPage(
-          this->currentPageIndex, this->itemsPerPage).size()) {
+      if (this->currentPageIndex * this->itemsPerPage + buttonIndex
+          < this->model.getNumberOfProducts()) {
         // Delete the registered product.
         this->deleteRegisteredProduct(buttonIndex);
       }
@@ -184,8 +183,8 @@ void ProductsCatalog::edit_button_clicked() {
       // Obtain the index of the display button.    
       const size_t buttonIndex = button->property("index").toUInt();
       qDebug() << "Button clicked, index:" << buttonIndex;
-      if (buttonIndex < this->model.getProductsForPage(
-          this->currentPageIndex, this->itemsPerPage).size()) {
+      if (this->currentPageIndex * this->itemsPerPage + buttonIndex
+          < this->model.getNumberOfProducts()) {
         // Edit the product.
         this->editProductInformation(buttonIndex);
       }
@@ -224,11 +223,12 @@ void ProductsCatalog::previousPage_button_clicked() {
 }
 
 void ProductsCatalog::deleteRegisteredProduct(size_t index) {
-  auto productsForPage = this->model.getProductsForPage(
-      this->currentPageIndex, this->itemsPerPage);
-  if (index < productsForPage.size()) {
-    // Find a reference to the product to delete.
-    std::pair<std::string, Product> element = productsForPage[index];
+  const size_t position = this->currentPageIndex * this->itemsPerPage + index;
+  if (index < this->itemsPerPage
+      && position < this->model.getNumberOfProducts()) {
+    // Copies the product, the row is invalidated by the changes.
+    const ProductView::Row row = this->model.getProductRow(position);
+    const std::pair<std::string, Product> element(*row.category, *row.product);
     // Try to delete the product from the registers.
     if (this->model.removeProduct(element.first, element.second)) {
       // Refresh the products display.
@@ -241,11 +241,12 @@ void ProductsCatalog::deleteRegisteredProduct(size_t index) {
 }
 
 void ProductsCatalog::editProductInformation(size_t index) {
-  auto productsForPage = this->model.getProductsForPage(
-      this->currentPageIndex, this->itemsPerPage);
-  if (index < productsForPage.size()) {
-    // Find a reference to the product to delete.
-    std::pair<std::string, Product> element = productsForPage[index];
+  const size_t position = this->currentPageIndex * this->itemsPerPage + index;
+  if (index < this->itemsPerPage
+      && position < this->model.getNumberOfProducts()) {
+    // Copies the product, the row is invalidated by the changes.
+    const ProductView::Row row = this->model.getProductRow(position);
+    const std::pair<std::string, Product> element(*row.category, *row.product);
     // Try to delete the product from the registers.
     // Checks that the product to edit aren't a blank one.
     if (!(element.second == Product())) {
@@ -50,11 +50,11 @@ protected:
 private:
   /**
    * @brief Updates the UI to display the products on the current page.
-   * @param visibleProducts Vector of pairs containing a category name and a Product object representing the visible products.
+   * @param visibleProducts Rows with the category and the product of the visible products.
    * @param items Number of items to display.
    */
   void refreshProductDisplay(
-      std::vector<std::pair<std::string, Product>> visibleProducts
+      const std::vector<ProductView::Row>& visibleProducts
       ,const size_t items);
   
   /**
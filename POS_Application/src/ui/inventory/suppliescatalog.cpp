@@ -62,7 +62,7 @@ void SuppliesCatalog::setupConnections() {
 }
 
 void SuppliesCatalog::refreshSuppliesDisplay(
-    const std::vector<Supply>& visibleSupplies
+    const PageView<Supply>& visibleSupplies
     , const size_t items) {
   // Initiazates the label index iterator.
   size_t labelIt = 0;
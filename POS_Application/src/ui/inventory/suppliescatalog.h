@@ -50,10 +50,10 @@ protected:
 private:
   /**
    * @brief Updates the UI to display the supplies on the current page.
-   * @param visibleSupplies Vector of Supply objects representing the supplies to be displayed.
+   * @param visibleSupplies View of the supplies to be displayed.
    * @param items Number of items to display.
    */
-  void refreshSuppliesDisplay(const std::vector<Supply>& visibleSupplies
+  void refreshSuppliesDisplay(const PageView<Supply>& visibleSupplies
       , const size_t items);
   
 private slots:
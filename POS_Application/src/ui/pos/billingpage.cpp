@@ -13,6 +13,7 @@
 #include "order.h"
 #include "orderselectionbutton.h"
 #include "processorderdialog.h"
+#include "util.h"
 
 BillingPage::BillingPage(QWidget *parent, POS_Model& appmodel)
     : QWidget(parent)
@@ -145,14 +146,31 @@ void BillingPage::on_payOrder_button_clicked() {
       if (widget) {
         // Cast the order widget from the stack.
         Order* order = qobject_cast<Order*>(widget);
-        qDebug() << "precio del recibo: " << order->getOrderPrice();
+        qDebug() << "precio del recibo: "
+            << Util::formatMoney(order->getOrderPrice());
         if (order->getOrderProducts().empty()) {
           return;
         }
         
         ProcessOrderDialog processOrderDialog(this, *order);
         if (processOrderDialog.exec() == QDialog::Accepted) {
-          this->printReceipt(*order);
+          // Registers the receipt, then prints it as it was stored.
+          std::vector<Supply> shortages;
+          this->model.generateReceipt(*order, shortages);
+          printReceipt(this, this->model.getOngoingReceipts().back());
+          // Warns about the supplies that the order used without stock.
+          if (!shortages.empty()) {
+            QString missing;
+            for (const Supply& shortage : shortages) {
+              missing += QString("- %1: faltan %2 %3\n")
+                  .arg(QString::fromStdString(shortage.getName()))
+                  .arg(shortage.getQuantity())
+                  .arg(QString::fromStdString(shortage.getMeasure()));
+            }
+            QMessageBox::warning(this, "Suministros insuficientes."
+                , "La orden uso suministros que no estaban en inventario:\n"
+                + missing);
+          }
           
           // Eliminar la orden impresa de la pila
           this->ordersStack->removeWidget(widget);
@@ -183,7 +201,6 @@ void BillingPage::on_payOrder_button_clicked() {
           // Actualizar la UI
           this->update();
           
-          this->model.generateReceipt(*order);
           emit this->orderProcessed();
           qDebug() << "Rastreo: Se emitio la senal";
         }
@@ -195,7 +212,8 @@ void BillingPage::on_payOrder_button_clicked() {
   }
 }
 
-void BillingPage::printReceipt(const Order& order) {  
+void BillingPage::printReceipt(QWidget* parent, const Receipt& receipt
+    , const bool reprint) {
   QList<QPrinterInfo> printers = QPrinterInfo::availablePrinters();
 
   QPrinter printer;
@@ -209,7 +227,7 @@ void BillingPage::printReceipt(const Order& order) {
   
   qDebug() << "nombre de la impresora: " << printer.printerName();
   if (printer.printerName() != macanasPosPrinter) {
-    QPrintDialog printDialog(&printer, this);
+    QPrintDialog printDialog(&printer, parent);
     if (printDialog.exec() != QDialog::Accepted) {
       qDebug() << "Impresión cancelada por el usuario.";
       return;
@@ -218,13 +236,13 @@ void BillingPage::printReceipt(const Order& order) {
 
   // Verificar que la impresora seleccionada es válida
   if (!printer.isValid()) {
-    QMessageBox::critical(this, "Error", "No se encontró una impresora válida.");
+    QMessageBox::critical(parent, "Error", "No se encontró una impresora válida.");
     return;
   }
   
   // Si el usuario seleccionó una impresora PDF, pedirle un archivo de salida
   if (printer.printerName().contains("PDF", Qt::CaseInsensitive)) {
-    QString filePath = QFileDialog::getSaveFileName(this
+    QString filePath = QFileDialog::getSaveFileName(parent
         , "Guardar Recibo como PDF", "", "Archivos PDF (*.pdf)");
     if (filePath.isEmpty()) {
       qDebug() << "El usuario canceló la selección del archivo.";
@@ -246,12 +264,13 @@ void BillingPage::printReceipt(const Order& order) {
   printer.setFullPage(true);
   
   // Pintar el recibo
-  this->paintReceipt(printer, order);
+  paintReceipt(printer, receipt, reprint);
   
   qDebug() << "Rastreo: sale de paintReceipt";
 }
 
-void BillingPage::paintReceipt(QPrinter& printer, const Order& order) {
+void BillingPage::paintReceipt(QPrinter& printer, const Receipt& receipt
+    , const bool reprint) {
   QPainter painter(&printer);
   if (!painter.isActive()) {
     qDebug() << "Error: No se pudo iniciar el pintor.";
@@ -293,36 +312,40 @@ void BillingPage::paintReceipt(QPrinter& printer, const Order& order) {
   };
   
   int y = 10;
-  printWrappedLine("Macana's Place", y, true);
-  printWrappedLine("Nº Recibo: "
-      + QString::number(this->model.getNextReceiptID()), y);
-  printWrappedLine("Usuario: "
-      + QString(this->model.getCurrentUser().getUsername().data()), y);
+  printWrappedLine(receipt.getBusinessName(), y, true);
+  // The copies of the receipts of the history are marked.
+  if (reprint) {
+    printWrappedLine("*** Reimpresión ***", y, true);
+  }
+  printWrappedLine("Nº Recibo: " + QString::number(receipt.getID()), y);
+  printWrappedLine("Usuario: " + receipt.getUser(), y);
   printWrappedLine("Fecha: "
-      + QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm:ss"), y);
+      + QDateTime::fromSecsSinceEpoch(receipt.getTimestamp())
+          .toString("dd/MM/yyyy hh:mm:ss"), y);
   printWrappedLine("==============================", y);
   
-  for (const auto& product : order.getOrderProducts()) {
+  for (const Receipt::LineItem& line : receipt.getLines()) {
     printWrappedLine(QString("%1 x %2")
-                      .arg(product.second)
-                      .arg(product.first.getName().data()), y);
-    printWrappedLine(QString("₡%1").arg(product.first.getPrice()), y);
+                      .arg(line.quantity)
+                      .arg(QString::fromStdString(
+                          Receipt::getProductName(line))), y);
+    printWrappedLine(QString("₡%1").arg(Util::formatMoney(line.price)), y);
   }
   
   printWrappedLine("==============================", y);
   printWrappedLine("Cantidad de artículos: "
-      + QString::number(order.getOrderProducts().size()), y);
+      + QString::number(receipt.getLines().size()), y);
   printWrappedLine("==============================", y);
   printWrappedLine("Monto total: ₡"
-      + QString::number(order.getOrderPrice(), 'f', 2), y, true);
+      + Util::formatMoney(receipt.getPrice()), y, true);
   printWrappedLine("==============================", y);
   
-  double receivedMoney = order.getReceivedMoney();
-  double changeMoney = receivedMoney - order.getOrderPrice();
-  printWrappedLine("Método de pago: " + order.getPaymentMethod(), y);
-  printWrappedLine("Recibido: ₡" + QString::number(receivedMoney, 'f', 2), y);
+  const Money receivedMoney = receipt.getReceivedAmount();
+  const Money changeMoney = receivedMoney - receipt.getPrice();
+  printWrappedLine("Método de pago: " + receipt.getPaymentMethod(), y);
+  printWrappedLine("Recibido: ₡" + Util::formatMoney(receivedMoney), y);
   printWrappedLine("Dinero a entregar: ₡"
-      + QString::number(changeMoney, 'f', 2), y);
+      + Util::formatMoney(changeMoney), y);
   
   painter.end();
 }
@@ -343,15 +366,12 @@ void BillingPage::createSelectProductButtons(size_t numberOfProducts) {
   // Variables that calculates each widget coordinates.
   size_t x_position = 0;
   size_t y_position = 0;
-  // Vector of the registered products in the model.
-  std::vector<std::pair<std::string, Product>>& products
-      = this->model.getRegisteredProductsVector();
   // Iterates through all the registered products, creating a selection button
   // for each one.
-  for (const auto& product : products) {
+  for (size_t index = 0; index < this->model.getNumberOfProducts(); ++index) {
     // Creates a product selection button for the actual product.
-    ProductSelectionButton* button =
-        new ProductSelectionButton(this, product.second);
+    ProductSelectionButton* button = new ProductSelectionButton(this
+        , *this->model.getProductRow(index).product);
     
     // Connects the button clicked signal with the pos slot ot handle it.
     this->connect(button
@@ -6,6 +6,7 @@
 #include <QPrinter>
 
 #include "posmodel.h"
+#include "receipt.h"
 
 namespace Ui {
 class BillingPage;
@@ -55,6 +56,28 @@ public:
    * @param product The Product to add to the order.
    */
   void addProductToOrder(const Product& product);
+  
+  /**
+   * @brief Prints a receipt on the receipts printer.
+   *
+   * Asks for a printer if the receipts printer isn't available.
+   *
+   * @param parent Parent widget of the printing dialogs.
+   * @param receipt The receipt to print.
+   * @param reprint True if it's a copy of a receipt of the history.
+   */
+  static void printReceipt(QWidget* parent, const Receipt& receipt
+      , const bool reprint = false);
+  
+  /**
+   * @brief Paints the layout of a receipt.
+   *
+   * @param printer Printer where the receipt is painted.
+   * @param receipt The receipt.
+   * @param reprint True if it's a copy of a receipt of the history.
+   */
+  static void paintReceipt(QPrinter& printer, const Receipt& receipt
+      , const bool reprint = false);
 private:
   /**
    * @brief Creates and prepare the necesary initial state of some ui elements.
@@ -95,17 +118,6 @@ private slots:
    */
   void on_payOrder_button_clicked();
   
-  /**
-   * @brief Slot for handling print preview.
-   *
-   * Renders the current order's content to the provided printer.
-   *
-   * @param printer Pointer to the QPrinter object used for printing.
-   */
-  void printReceipt(const Order& order);
-  
-  void paintReceipt(QPrinter& printer, const Order& order);
-  
 signals:
   void orderProcessed();
 };
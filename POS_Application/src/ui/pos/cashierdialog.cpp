@@ -9,16 +9,17 @@
 
 #include "expenselabel.h"
 #include "incomelabel.h"
+#include "util.h"
 
 CashierDialog::CashierDialog(QWidget *parent
     , const QVector<IncomeLabel*>& cashierIncomes
     , const QVector<ExpenseLabel*>& cashierExpenses
-    , const std::vector<Receipt> &cashierReceipts)
+    , const CashierSession& cashierSession)
     : QDialog(parent)
     , ui(new Ui::CashierDialog)
     , incomes(cashierIncomes)
     , expenses(cashierExpenses)
-    , receipts(cashierReceipts){
+    , session(cashierSession) {
   ui->setupUi(this);
   
   this->connect(this->ui->accept_button, &QPushButton::clicked
@@ -42,31 +43,21 @@ CashierDialog::CashierDialog(QWidget *parent
   expensesLayout->setAlignment(Qt::AlignTop);
   this->ui->ExpensesAreaWidgetContents->setLayout(expensesLayout);
   
-  double expensesCost = 0;
   for (const auto& expense : this->expenses) {
-    expensesCost += expense->getAmount();
     expensesLayout->addWidget(expense);
     expensesLayout->update();
   }
   
-  std::vector<double> amounts(3, 0);
-  for (const auto receipt : this->receipts) {
-    if (receipt.getPaymentMethod() == "Efectivo") {
-      amounts[0] += receipt.getPrice();
-    } else if (receipt.getPaymentMethod() == "Sinpe") {
-      amounts[1] += receipt.getPrice();
-    } else if (receipt.getPaymentMethod() == "Tarjeta") {
-      amounts[2] += receipt.getPrice();
-    }
-  }
-  amounts[0] += 30000 - expensesCost;
-  
-  this->ui->cash_label->setText("Efectivo: ₡" + QString::number(amounts[0], 'f', 2));
-  this->ui->sinpe_label->setText("Sinpe: ₡" + QString::number(amounts[1], 'f', 2));
-  this->ui->card_label->setText("Tarjeta: ₡" + QString::number(amounts[2], 'f', 2));
+  // Reads the running totals of the session, the cash pays the expenses.
+  const Money cash = this->session.getCashInRegister();
+  const Money sinpe = this->session.getTotal(Receipt::PAYMENT_SINPE);
+  const Money card = this->session.getTotal(Receipt::PAYMENT_CARD);
+  this->ui->cash_label->setText("Efectivo: ₡" + Util::formatMoney(cash));
+  this->ui->sinpe_label->setText("Sinpe: ₡" + Util::formatMoney(sinpe));
+  this->ui->card_label->setText("Tarjeta: ₡" + Util::formatMoney(card));
   
-  const double total = amounts[0] + amounts[1] + amounts[2];
-  this->ui->total_label->setText("Total: ₡" + QString::number(total, 'f', 2));
+  const Money total = cash + sinpe + card;
+  this->ui->total_label->setText("Total: ₡" + Util::formatMoney(total));
   
   this->update();
 }
@@ -3,9 +3,9 @@
 
 #include <QDialog.h>
 
+#include "cashiersession.h"
 #include "expenselabel.h"
 #include "incomelabel.h"
-#include "receipt.h"
 
 namespace Ui {
 class CashierDialog;
@@ -18,13 +18,13 @@ private:
   Ui::CashierDialog *ui;
   const QVector<IncomeLabel*>& incomes;
   const QVector<ExpenseLabel*>& expenses;
-  const std::vector<Receipt>& receipts;
+  const CashierSession& session;  ///< Totals of the closed cashier.
   
 public:
   explicit CashierDialog(QWidget *parent
       , const QVector<IncomeLabel*>& cashierIncomes
       , const QVector<ExpenseLabel*>& cashierExpenses
-      , const std::vector<Receipt>& cashierReceipts);
+      , const CashierSession& cashierSession);
   ~CashierDialog();
 
 private:
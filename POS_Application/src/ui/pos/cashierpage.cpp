@@ -3,10 +3,10 @@
 #include "expensedialog.h"
 #include "incomelabel.h"
 #include "ui_cashierpage.h"
+#include "util.h"
 
 #include <QString>
 #include <QDatetime>
-#include <QRegularexpression>
 #include <QMessageBox>
 
 CashierPage::CashierPage(QWidget *parent, POS_Model& appmodel)
@@ -18,6 +18,7 @@ CashierPage::CashierPage(QWidget *parent, POS_Model& appmodel)
   QVBoxLayout* layout = new QVBoxLayout();
   layout->setAlignment(Qt::AlignTop);
   this->ui->cashierReceipts_content->setLayout(layout);
+  this->restoreCashierSession();
 }
 
 CashierPage::~CashierPage() {
@@ -27,12 +28,8 @@ CashierPage::~CashierPage() {
 void CashierPage::on_openCashier_button_clicked() {
   if (!this->model.isCashierOpened()) {
     this->model.openCashier();
-    this->ui->cashierInformationlabel->setText(
-        QString("Caja abierta por: %1, a las %2.")
-        .arg(this->model.getCurrentUser().getUsername().data())
-        .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"))
-    );
-    this->ui->totalAmount_label->setText("Monto total de la caja: ₡30000.00");
+    this->refreshCashierInformation();
+    this->refreshTotalAmount();
     this->update();
   } else {
     // Displays a warning message box to show the error to the user.
@@ -47,20 +44,18 @@ void CashierPage::on_closeCashier_button_clicked() {
     if (layout->isEmpty()) {
       this->model.closeCashier();
       
-      this->ui->cashierInformationlabel->setText(
-          "No hay ninguna caja abierta.");
-      this->ui->totalAmount_label->setText("Monto total de la caja: ₡00.00");
+      this->refreshCashierInformation();
+      this->refreshTotalAmount();
       this->update();
       return;
     }
     CashierDialog cashierDialog(this, this->incomes
-        , this->expenses, this->model.getOngoingReceipts());
+        , this->expenses, this->model.getCashierSession());
     
     if (cashierDialog.exec() == QDialog::Accepted) {
       this->model.closeCashier();
       
-      this->ui->cashierInformationlabel->setText(
-          "No hay ninguna caja abierta.");
+      this->refreshCashierInformation();
             
       if (!layout) return;
       while (QLayoutItem* item = layout->takeAt(0)) {
@@ -70,8 +65,10 @@ void CashierPage::on_closeCashier_button_clicked() {
         }
         delete item;  // Solo elimina el item, pero no los widgets
       }
+      this->incomes.clear();
+      this->expenses.clear();
       
-      this->ui->totalAmount_label->setText("Monto total de la caja: ₡00.00");
+      this->refreshTotalAmount();
       this->update();
     } else {
       this->reloadCashierElements();
@@ -107,59 +104,76 @@ void CashierPage::on_addExpense_button_clicked() {
 }
 
 void CashierPage::handleCreatedExpense(const QString expenseName
-    , const double expensePrice) {
-  QLayout* layout = this->ui->cashierReceipts_content->layout();
-  ExpenseLabel* expense = new ExpenseLabel(
-      this, expenseName
-      , QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")
-      , expensePrice
-  );
-  
-  layout->addWidget(expense);
-  
-  this->ui->totalAmount_label->setText(
-      QString("Monto total de la caja: %1")
-          .arg(QString::number(this->obtainTotalAmount() - expensePrice))
-  );
+    , const Money expensePrice) {
+  // The model takes the expense from the session totals.
+  this->addExpenseLabel(
+      this->model.addExpense(expenseName.toStdString(), expensePrice));
+  this->refreshTotalAmount();
   this->update();
-  this->expenses.emplace_back(expense);
 }
 
 void CashierPage::addProcessedReceipt() {
-  QLayout* layout = this->ui->cashierReceipts_content->layout();  
-  Receipt newReceipt = this->model.getOngoingReceipts().back();
-  
+  // The model already added the receipt to the session totals.
+  this->addIncomeLabel(this->model.getOngoingReceipts().back());
+  this->refreshTotalAmount();
+  this->update();
+}
+
+void CashierPage::restoreCashierSession() {
+  this->refreshCashierInformation();
+  if (this->model.isCashierOpened()) {
+    for (const Receipt& receipt : this->model.getOngoingReceipts()) {
+      this->addIncomeLabel(receipt);
+    }
+    for (const CashierSession::Expense& expense
+        : this->model.getCashierSession().getExpenses()) {
+      this->addExpenseLabel(expense);
+    }
+  }
+  this->refreshTotalAmount();
+}
+
+void CashierPage::refreshCashierInformation() {
+  const CashierSession& session = this->model.getCashierSession();
+  if (!session.isOpen()) {
+    this->ui->cashierInformationlabel->setText(
+        "No hay ninguna caja abierta.");
+    return;
+  }
+  this->ui->cashierInformationlabel->setText(
+      QString("Caja abierta por: %1, a las %2.")
+      .arg(QString::fromStdString(session.getUser()))
+      .arg(QDateTime::fromSecsSinceEpoch(session.getOpenedAt())
+          .toString(Receipt::DATE_TIME_FORMAT))
+  );
+}
+
+void CashierPage::refreshTotalAmount() {
+  // Reads the running balance of the session, without adding the labels.
+  this->ui->totalAmount_label->setText(QString("Monto total de la caja: ₡%1")
+      .arg(Util::formatMoney(this->model.getCashierSession().getBalance())));
+}
+
+void CashierPage::addIncomeLabel(const Receipt& receipt) {
+  QLayout* layout = this->ui->cashierReceipts_content->layout();
   IncomeLabel* incomeLabel = new IncomeLabel(
       this
-      , newReceipt.getID(), newReceipt.getDateTime()
-      , newReceipt.getPaymentMethod(), newReceipt.getPrice()
+      , receipt.getID(), receipt.getDateTime()
+      , receipt.getPaymentMethod(), receipt.getPrice()
   );
-  
   layout->addWidget(incomeLabel);
   layout->update();
-  
-  if (/*newReceipt.getPaymentMethod() == "Efectivo"*/ 1) {
-    this->ui->totalAmount_label->setText(
-        QString("Monto total de la caja: %1")
-            .arg(QString::number(this->obtainTotalAmount()
-            + newReceipt.getPrice()))
-    );
-  }
-  
   this->incomes.emplace_back(incomeLabel);
-  this->update();
 }
 
-double CashierPage::obtainTotalAmount() {
-  QString mixedStr = this->ui->totalAmount_label->text();
-  QRegularExpression regex("(\\d+\\.?\\d*)");
-  QRegularExpressionMatch match = regex.match(mixedStr);
-  
-  if (match.hasMatch()) {
-    double extractedValue = match.captured(1).toDouble();
-    qDebug() << "Número extraído:" << extractedValue;
-    return extractedValue;
-  }
-  
-  return 0;
+void CashierPage::addExpenseLabel(const CashierSession::Expense& expense) {
+  QLayout* layout = this->ui->cashierReceipts_content->layout();
+  ExpenseLabel* expenseLabel = new ExpenseLabel(
+      this, QString::fromStdString(expense.name)
+      , QDateTime::fromSecsSinceEpoch(expense.timestamp)
+          .toString(Receipt::DATE_TIME_FORMAT)
+      , expense.amount
+  );
+  layout->addWidget(expenseLabel);
+  this->expenses.emplace_back(expenseLabel);
 }
@@ -26,15 +26,43 @@ public:
   
   ~CashierPage();
 private:
-  double obtainTotalAmount();
   void reloadCashierElements();
   
+  /**
+   * @brief Shows the opened cashier and its receipts and expenses.
+   *
+   * Rebuilds the labels of a session restored from the last run.
+   */
+  void restoreCashierSession();
+  
+  /**
+   * @brief Shows who opened the cashier and when.
+   */
+  void refreshCashierInformation();
+  
+  /**
+   * @brief Shows the money in the cashier, from the session totals.
+   */
+  void refreshTotalAmount();
+  
+  /**
+   * @brief Adds the label of a receipt.
+   * @param receipt The receipt.
+   */
+  void addIncomeLabel(const Receipt& receipt);
+  
+  /**
+   * @brief Adds the label of an expense.
+   * @param expense The expense.
+   */
+  void addExpenseLabel(const CashierSession::Expense& expense);
+  
 private slots:  
   void on_openCashier_button_clicked();
   void on_closeCashier_button_clicked();
   void on_addExpense_button_clicked();
   void handleCreatedExpense(const QString expenseName
-      , const double expensePrice);
+      , const Money expensePrice);
   
 public slots:
   void addProcessedReceipt();
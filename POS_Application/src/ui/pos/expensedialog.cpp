@@ -13,7 +13,8 @@ ExpenseDialog::~ExpenseDialog() {
 
 void ExpenseDialog::on_acceptExpense_button_clicked() {
   const QString expenseName = this->ui->expenseName_lineEdit->text();
-  const double expenseCost = this->ui->expensePrice_doubleSpinBox->value();
+  const Money expenseCost = Money::fromDouble(
+      this->ui->expensePrice_doubleSpinBox->value());
   emit this->expenseCreated(expenseName, expenseCost);
   this->accept();
 }
@@ -3,6 +3,8 @@
 
 #include <QDialog>
 
+#include "money.h"
+
 namespace Ui {
 class ExpenseDialog;
 }
@@ -21,7 +23,7 @@ private slots:
   void on_acceptExpense_button_clicked();
   void on_cancelExpense_button_clicked();
 signals:
-  void expenseCreated(const QString expenseName, const double expenseCost);
+  void expenseCreated(const QString expenseName, const Money expenseCost);
 };
 
 #endif // EXPENSEDIALOG_H
@@ -1,17 +1,19 @@
 #include "expenselabel.h"
 #include "ui_expenselabel.h"
 
+#include "util.h"
+
 ExpenseLabel::ExpenseLabel(QWidget *parent
     , const QString expenseName
     , const QString expenseTime
-    , const double expenseAmount)
+    , const Money expenseAmount)
     : QWidget(parent)
     , ui(new Ui::ExpenseLabel)
     , amount(expenseAmount) {
   ui->setupUi(this);
   this->ui->name_label->setText(expenseName);
   this->ui->time_label->setText("Hora: " + expenseTime);
-  this->ui->amount_label->setText("Monto: ₡" + QString::number(expenseAmount, 'f', 2));
+  this->ui->amount_label->setText("Monto: ₡" + Util::formatMoney(expenseAmount));
   this->update();
 }
 
@@ -3,6 +3,8 @@
 
 #include <QWidget>
 
+#include "money.h"
+
 namespace Ui {
 class ExpenseLabel;
 }
@@ -14,15 +16,15 @@ public:
   explicit ExpenseLabel(QWidget *parent = nullptr
       , const QString expenseName = QString()
       , const QString expenseTime = QString()
-      , const double expenseAmount = 0);
+      , const Money expenseAmount = Money());
   ~ExpenseLabel();
   
 public:
-  double getAmount() {return this->amount;};
+  Money getAmount() {return this->amount;};
 
 private:
   Ui::ExpenseLabel *ui;
-  const double amount;
+  const Money amount;
 };
 
 #endif // EXPENSELABEL_H
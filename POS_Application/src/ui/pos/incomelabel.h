@@ -3,6 +3,8 @@
 
 #include <QWidget>
 
+#include "money.h"
+
 namespace Ui {
 class IncomeLabel;
 }
@@ -15,7 +17,7 @@ public:
                        , const size_t receiptID = 0
                        , const QString time = QString()
                        , const QString paymentMethod = QString()
-                       , const double amount = 0);
+                       , const Money amount = Money());
   ~IncomeLabel();
 
 private:
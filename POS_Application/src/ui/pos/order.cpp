@@ -4,6 +4,7 @@
 #include <QDateTime>
 
 #include "orderelement.h"
+#include "util.h"
 
 Order::Order(QWidget *parent)
     : QWidget(parent)
@@ -46,8 +47,10 @@ void Order::addProduct(const Product &product) {
   // Update the total order price, adding the price of the new product
   //  product.
   this->totalPrice += product.getPrice();
-  qDebug() << "anadiendo el precio del producto: " << this->totalPrice;
-  this->ui->totalOrderPrice_label->setText(QString::number(this->totalPrice, 'f', 2));
+  qDebug() << "anadiendo el precio del producto: "
+      << Util::formatMoney(this->totalPrice);
+  this->ui->totalOrderPrice_label->setText(
+      Util::formatMoney(this->totalPrice));
   // Insert the object into the order ui.
   this->ui->order_WidgetContents->layout()->addWidget(productOnOrder);
   // Force the update of the ui.
@@ -58,7 +61,8 @@ void Order::increaseOrderPrice(const Product &product) {
   // Adds up the product price.
   this->totalPrice += product.getPrice();
   // Updates the order ui price.
-  this->ui->totalOrderPrice_label->setText(QString::number(this->totalPrice, 'f', 2));
+  this->ui->totalOrderPrice_label->setText(
+      Util::formatMoney(this->totalPrice));
   this->update();
 }
 
@@ -66,7 +70,8 @@ void Order::reduceOrderPrice(const Product &product) {
   // Substract the product price;
   this->totalPrice -= product.getPrice();
   // Update the order ui price.
-  this->ui->totalOrderPrice_label->setText(QString::number(this->totalPrice, 'f', 2));
+  this->ui->totalOrderPrice_label->setText(
+      Util::formatMoney(this->totalPrice));
   this->update();
 }
 
@@ -22,8 +22,8 @@ class Order : public QWidget {
 private:
   Ui::Order* ui = nullptr;   ///< Pointer to the UI elements for the order.
   QString paymentMethod = QString();
-  double receivedMoney = 0;
-  double totalPrice = 0;       ///< Accumulated total price of the order.
+  Money receivedMoney;
+  Money totalPrice;            ///< Accumulated total price of the order.
   
 public:
   /**
@@ -58,15 +58,15 @@ public:
     this->paymentMethod = orderPaymentMethod;
   }
   
-  void setReceivedMoney(const double orderReceivedMoney) {
+  void setReceivedMoney(const Money orderReceivedMoney) {
     this->receivedMoney = orderReceivedMoney;
   }
   
-  const double getOrderPrice() const {return this->totalPrice;}
+  Money getOrderPrice() const {return this->totalPrice;}
   
   const QString getPaymentMethod() const {return this->paymentMethod;} 
   
-  const double getReceivedMoney() const {return this->receivedMoney;}
+  Money getReceivedMoney() const {return this->receivedMoney;}
 protected:
   /**
    * @brief Sets up the order display.
@@ -1,6 +1,8 @@
 #include "orderelement.h"
 #include "ui_orderelement.h"
 
+#include "util.h"
+
 OrderElement::OrderElement(QWidget *parent, const Product& myProduct)
     : QWidget(parent)
     , ui(new Ui::OrderElement)
@@ -19,7 +21,7 @@ OrderElement::~OrderElement() {
 void OrderElement::refreshDisplay() {
   // Updates/sets the ui labels to contain the product's information.
   this->ui->productName_label->setText(this->product.getName().data());
-  QString productPrice = QString::number(this->product.getPrice(), 'f', 2);
+  QString productPrice = Util::formatMoney(this->product.getPrice());
   this->ui->productPrice_label->setText(productPrice);
   this->ui->totalPrice_label->setText(productPrice);
 }
@@ -53,9 +55,10 @@ void OrderElement::incrementQuantity_button_clicked() {
   // Updates the quantity label text to show the new value.
   this->ui->quantity_label->setText(QString::number(this->quantity));
   // Calculates the new product's total price.
-  this->totalPrice = this->quantity * this->product.getPrice();
+  this->totalPrice = this->product.getPrice() * this->quantity;
   // Updates the product's total price label to show the new value.
-  this->ui->totalPrice_label->setText(QString::number(this->totalPrice));
+  this->ui->totalPrice_label->setText(
+      Util::formatMoney(this->totalPrice));
   // Emits the signal indicating that the product's quantity has changed.
   emit this->quantityIncreased(this->product);
   // Force the update of the order element ui.
@@ -70,9 +73,10 @@ void OrderElement::reduceQuantity_button_clicked() {
     // Updates/sets the product's quantity number label to show the new value.
     this->ui->quantity_label->setText(QString::number(this->quantity));
     // Calculates the new product's total price.
-    this->totalPrice = this->quantity * this->product.getPrice();
+    this->totalPrice = this->product.getPrice() * this->quantity;
     // Updates the product's total price label to show the new value.    
-    this->ui->totalPrice_label->setText(QString::number(this->totalPrice));
+    this->ui->totalPrice_label->setText(
+        Util::formatMoney(this->totalPrice));
   } else {
     // Deletes the order element.
     this->deleteSelf();
@@ -30,7 +30,7 @@ private:
   Ui::OrderElement* ui = nullptr; ///< Pointer to the UI elements.
   const Product& product;           ///< Reference to the associated Product.
   size_t quantity = 0;              ///< Current quantity of the product in the order.
-  double totalPrice = 0;            ///< Total price calculated as quantity * product price.
+  Money totalPrice;                 ///< Total price calculated as quantity * product price.
   
 public:
   /**
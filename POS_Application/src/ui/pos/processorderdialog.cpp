@@ -1,15 +1,21 @@
 #include "processorderdialog.h"
 #include "ui_processorderdialog.h"
 
+#include "receipt.h"
+#include "util.h"
+
 ProcessOrderDialog::ProcessOrderDialog(QWidget* parent
     , Order& orderToProcess)
     : QDialog(parent)
     , ui(new Ui::ProcessOrderDialog)
     , order(orderToProcess) {
   ui->setupUi(this);
-  this->ui->paymentMethod_comboBox->addItem("Efectivo");
-  this->ui->paymentMethod_comboBox->addItem("Tarjeta");
-  this->ui->paymentMethod_comboBox->addItem("Sinpe");
+  this->ui->paymentMethod_comboBox->addItem(
+      Receipt::PAYMENT_METHOD_NAMES[Receipt::PAYMENT_CASH]);
+  this->ui->paymentMethod_comboBox->addItem(
+      Receipt::PAYMENT_METHOD_NAMES[Receipt::PAYMENT_CARD]);
+  this->ui->paymentMethod_comboBox->addItem(
+      Receipt::PAYMENT_METHOD_NAMES[Receipt::PAYMENT_SINPE]);
   this->connect(this->ui->receivedAmount_doubleSpinBox
     , &QDoubleSpinBox::valueChanged
     , this
@@ -30,8 +36,9 @@ ProcessOrderDialog::~ProcessOrderDialog() {
 }
 
 void ProcessOrderDialog::on_accept_button_clicked() {
-  const double orderPrice = this->order.getOrderPrice();
-  const double receivedAmount = this->ui->receivedAmount_doubleSpinBox->value();
+  const Money orderPrice = this->order.getOrderPrice();
+  const Money receivedAmount = Money::fromDouble(
+      this->ui->receivedAmount_doubleSpinBox->value());
   if (receivedAmount >= orderPrice) {
     this->order.setPaymentMethod(
         this->ui->paymentMethod_comboBox->currentText());
@@ -47,17 +54,19 @@ void ProcessOrderDialog::on_accept_button_clicked() {
 // }
 
 void ProcessOrderDialog::updateChangeLabel(double value) {
-  this->order.setReceivedMoney(value);
+  // The spin box has two decimals, the amount is kept in céntimos.
+  const Money receivedAmount = Money::fromDouble(value);
+  this->order.setReceivedMoney(receivedAmount);
   if (this->ui->paymentMethod_comboBox->currentIndex() == 0) {
-    if (value < this->order.getOrderPrice()) {
+    if (receivedAmount < this->order.getOrderPrice()) {
       this->ui->changeAmount_label->setText("Error en monto recibido");
     } else {
-      const double change = value - this->order.getOrderPrice();
-      this->ui->changeAmount_label->setText(QString::number(change, 'f', 2));
+      const Money change = receivedAmount - this->order.getOrderPrice();
+      this->ui->changeAmount_label->setText(Util::formatMoney(change));
     }
   } else {
     this->ui->receivedAmount_doubleSpinBox->setValue(
-        this->order.getOrderPrice());
+        this->order.getOrderPrice().toDouble());
     this->ui->changeAmount_label->setText("Pago exacto (sin cambio)");
     this->order.setReceivedMoney(order.getOrderPrice());
   }
@@ -5,6 +5,8 @@
 #include <QPainterPath>
 #include <QString>
 
+#include "util.h"
+
 ProductSelectionButton::ProductSelectionButton(QWidget* parent
     , const Product& myProduct)
     : QWidget(parent)
@@ -22,15 +24,16 @@ void ProductSelectionButton::refreshDisplay() {
   // Updates/sets the product's infroamtion as the value of the ui labels.
   this->ui->name_label->setText(this->product.getName().data());
   this->ui->name_label->adjustSize();
-  QString price = QString::number(this->product.getPrice());
+  QString price = Util::formatMoney(this->product.getPrice());
   this->ui->price_label->setText(price);
   this->ui->price_label->adjustSize();
   this->update();
 }
 
 void ProductSelectionButton::paintEvent(QPaintEvent* event) {
-  // Obstains product's pixmap.
-  QPixmap pixmap = this->product.getImage();
+  // Obstains product's pixmap, the store decodes it the first time.
+  QPixmap pixmap
+      = ImageStore::getInstance().getPixmap(this->product.getImage());
   // Paints the background only if the pixmap contains information.
   if (!pixmap.isNull()) {
     // Creates a painter for this ui.
@@ -5,54 +5,162 @@
 #include <QDataStream>
 #include <QDatetime>
 
+#include "binaryreader.h"
+#include "binarywriter.h"
+
 Receipt::Receipt(const QString myBusinessName
     , const size_t myID
     , const QString myDateTime
     , const QString myUser
     , const std::vector<std::pair<Product, size_t>> myProducts
     , const QString myPaymentMethod
-    , const double myReceivedAmount
-    , const double myPrice)
-    : businessName(myBusinessName)
-    , ID(myID)
-    , dateTime(myDateTime)
-    , user(myUser)
-    , products(myProducts)
-    , paymentMethod(myPaymentMethod)
-    , receivedAmount(myReceivedAmount)
-    , price(myPrice) {
+    , const Money myReceivedAmount
+    , const Money myPrice)
+    : Receipt(myBusinessName.toStdString(), myID, parseDateTime(myDateTime)
+    , myUser.toStdString(), toLines(myProducts)
+    , myPaymentMethod.toStdString(), myReceivedAmount, myPrice) {
 }
 
-Receipt::Receipt(const Receipt& other)
-    : businessName(other.businessName),
-    ID(other.ID),
-    dateTime(other.dateTime),
-    user(other.user),
-    products(other.products),
-    paymentMethod(other.paymentMethod),
-    receivedAmount(other.receivedAmount),
-    price(other.price) {
+Receipt::Receipt(const std::string_view myBusinessName
+    , const size_t myID
+    , const int64_t myTimestamp
+    , const std::string_view myUser
+    , std::vector<LineItem> myLines
+    , const std::string_view myPaymentMethod
+    , const Money myReceivedAmount
+    , const Money myPrice)
+    : ID(myID)
+    , timestamp(myTimestamp)
+    , businessName(StringPool::getInstance().intern(myBusinessName))
+    , user(StringPool::getInstance().intern(myUser))
+    , paymentMethod(StringPool::getInstance().intern(myPaymentMethod))
+    , receivedAmount(myReceivedAmount)
+    , price(myPrice)
+    , lines(std::move(myLines)) {
 }
 
 Receipt::Receipt(const QString bussinessName
     , const size_t id
     , const QString username
     , const Order& order)
-    : businessName(bussinessName),  // Puedes cambiarlo según corresponda
-    ID(id),  // Asignar un ID único según la lógica de la aplicación
-    dateTime(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")),
-    user(username),  // Si el Order tiene usuario, puedes extraerlo
-    products(order.getOrderProducts()),  // Copia los productos desde Order
-    paymentMethod(order.getPaymentMethod()),
-    receivedAmount(order.getReceivedMoney()),
-    price(order.getOrderPrice()) {
+    : Receipt(bussinessName.toStdString(), id
+    , QDateTime::currentSecsSinceEpoch(), username.toStdString()
+    , toLines(order.getOrderProducts())
+    , order.getPaymentMethod().toStdString(), order.getReceivedMoney()
+    , order.getOrderPrice()) {
 }
 
 Receipt::~Receipt() {
 
 }
 
-std::ofstream& operator<<(std::ofstream& out, const Receipt& receipt) {
+int64_t Receipt::parseDateTime(const QString& dateTime) {
+  const QDateTime parsed = QDateTime::fromString(dateTime, DATE_TIME_FORMAT);
+  return parsed.isValid() ? parsed.toSecsSinceEpoch() : 0;
+}
+
+QString Receipt::getDateTime() const {
+  return QDateTime::fromSecsSinceEpoch(this->timestamp)
+      .toString(DATE_TIME_FORMAT);
+}
+
+Receipt::PaymentMethod Receipt::getPaymentMethodCode() const {
+  // Interns the names once, then the codes are found by their IDs.
+  static const std::vector<StringPool::StringID> methodIDs = [] {
+    std::vector<StringPool::StringID> ids;
+    for (const char* name : PAYMENT_METHOD_NAMES) {
+      ids.push_back(StringPool::getInstance().intern(name));
+    }
+    return ids;
+  }();
+  for (uint8_t method = PAYMENT_CASH; method < PAYMENT_METHOD_COUNT; ++method) {
+    if (methodIDs[method] == this->paymentMethod) {
+      return static_cast<PaymentMethod>(method);
+    }
+  }
+  return PAYMENT_OTHER;
+}
+
+QString Receipt::fromPool(const StringPool::StringID id) {
+  const std::string& text = StringPool::getInstance().lookup(id);
+  return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+}
+
+std::vector<Receipt::LineItem> Receipt::toLines(
+    const std::vector<std::pair<Product, size_t>>& products) {
+  std::vector<LineItem> lines;
+  lines.reserve(products.size());
+  // Keeps only the fields of the products needed by the receipts.
+  for (const auto& [product, quantity] : products) {
+    lines.push_back(LineItem{product.getID()
+        , StringPool::getInstance().intern(product.getName())
+        , static_cast<uint32_t>(quantity), product.getPrice()});
+  }
+  return lines;
+}
+
+void Receipt::encode(BinaryWriter& writer) const {
+  // Fixed-width fields first, then the strings and the products.
+  const StringPool& pool = StringPool::getInstance();
+  writer.writeU64(this->ID);
+  writer.writeU64(static_cast<uint64_t>(this->timestamp));
+  writer.writeString(pool.lookup(this->businessName));
+  writer.writeString(pool.lookup(this->user));
+  writer.writeU32(static_cast<uint32_t>(this->lines.size()));
+  // The products are referenced by their ID, the name and the price are
+  // kept for the reprints of the products that change later.
+  for (const LineItem& line : this->lines) {
+    writer.writeU64(line.productID);
+    writer.writeString(pool.lookup(line.name));
+    writer.writeU64(line.quantity);
+    writer.writeMoney(line.price);
+  }
+  writer.writeString(pool.lookup(this->paymentMethod));
+  writer.writeMoney(this->receivedAmount);
+  writer.writeMoney(this->price);
+}
+
+bool Receipt::decode(BinaryReader& reader, Receipt& receipt) {
+  uint64_t id = 0;
+  uint64_t timestamp = 0;
+  std::string businessName, user, paymentMethod;
+  uint32_t productCount = 0;
+  reader.readU64(id);
+  reader.readU64(timestamp);
+  reader.readString(businessName);
+  reader.readString(user);
+  // Each product takes at least its ID, name length, quantity and price.
+  reader.readCount(productCount, 28);
+  std::vector<LineItem> lines;
+  lines.reserve(reader.isValid() ? productCount : 0);
+  for (uint32_t i = 0; reader.isValid() && i < productCount; ++i) {
+    uint64_t productID = 0;
+    std::string productName;
+    uint64_t quantity = 0;
+    Money productPrice;
+    reader.readU64(productID);
+    reader.readString(productName);
+    reader.readU64(quantity);
+    reader.readMoney(productPrice);
+    lines.push_back(LineItem{productID
+        , StringPool::getInstance().intern(productName)
+        , static_cast<uint32_t>(quantity), productPrice});
+  }
+  Money receivedAmount;
+  Money price;
+  reader.readString(paymentMethod);
+  reader.readMoney(receivedAmount);
+  reader.readMoney(price);
+  // Any failed read invalidates the whole receipt.
+  if (!reader.isValid()) {
+    return false;
+  }
+  receipt = Receipt(businessName, id, static_cast<int64_t>(timestamp), user
+      , std::move(lines), paymentMethod, receivedAmount, price);
+  return true;
+}
+
+std::ostream& operator<<(std::ostream& out, const Receipt& receipt) {
   auto writeQString = [&](const QString& qstr) {
     std::string str = qstr.toUtf8().toStdString();  // Convertir QString a std::string en UTF-8
     size_t length = str.size();
@@ -68,17 +176,19 @@ std::ofstream& operator<<(std::ofstream& out, const Receipt& receipt) {
   writeQString(receipt.getDateTime());
   writeQString(receipt.getUser());
   
-  size_t productCount = receipt.getProducts().size();
+  size_t productCount = receipt.getLines().size();
   out.write(reinterpret_cast<const char*>(&productCount), sizeof(productCount));
   
-  for (const auto& productPair : receipt.getProducts()) {
-    writeQString(QString(productPair.first.getName().data()));
-    out.write(reinterpret_cast<const char*>(&productPair.second), sizeof(productPair.second));
+  for (const Receipt::LineItem& line : receipt.getLines()) {
+    writeQString(QString::fromStdString(Receipt::getProductName(line)));
+    size_t quantity = line.quantity;
+    out.write(reinterpret_cast<const char*>(&quantity), sizeof(quantity));
   }
   
   writeQString(receipt.getPaymentMethod());
-  double receivedAmount = receipt.getReceivedAmount();
-  double price = receipt.getPrice();
+  // The legacy format stored the amounts as doubles.
+  double receivedAmount = receipt.getReceivedAmount().toDouble();
+  double price = receipt.getPrice().toDouble();
   
   out.write(reinterpret_cast<const char*>(&receivedAmount), sizeof(receivedAmount));
   out.write(reinterpret_cast<const char*>(&price), sizeof(price));
@@ -86,17 +196,22 @@ std::ofstream& operator<<(std::ofstream& out, const Receipt& receipt) {
   return out;
 }
 
-std::ifstream& operator>>(std::ifstream& in, Receipt& receipt) {
+std::istream& operator>>(std::istream& in, Receipt& receipt) {
   size_t id;
   size_t productCount;
   double receivedAmount, price;
   std::string businessName, dateTime, user, paymentMethod;
-  std::vector<std::pair<Product, size_t>> products;
+  std::vector<Receipt::LineItem> lines;
   
   // Leer cadenas con su tamaño
   auto readString = [&](std::string& str) {
-    size_t length;
+    size_t length = 0;
     in.read(reinterpret_cast<char*>(&length), sizeof(length));
+    // Rejects corrupted lengths before allocating the string.
+    if (!in || length > BinaryReader::MAX_STRING_LENGTH) {
+      in.setstate(std::ios::failbit);
+      return;
+    }
     
     str.resize(length);
     in.read(&str[0], length);
@@ -110,25 +225,27 @@ std::ifstream& operator>>(std::ifstream& in, Receipt& receipt) {
   
   in.read(reinterpret_cast<char*>(&productCount), sizeof(productCount));  
   // Leer productos
-  for (size_t i = 0; i < productCount; ++i) {
+  for (size_t i = 0; in && i < productCount; ++i) {
     std::string productName;
     size_t quantity;
     readString(productName);
     in.read(reinterpret_cast<char*>(&quantity), sizeof(quantity));
     
-    Product blankProduct;
-    blankProduct.setName(productName);
-    products.emplace_back(blankProduct, quantity);
+    Receipt::LineItem line;
+    line.name = StringPool::getInstance().intern(productName);
+    line.quantity = static_cast<uint32_t>(quantity);
+    lines.push_back(line);
   }
   
   readString(paymentMethod);
   in.read(reinterpret_cast<char*>(&receivedAmount), sizeof(receivedAmount));
   in.read(reinterpret_cast<char*>(&price), sizeof(price));
   
-  receipt = Receipt(businessName.data(), id
-                    , dateTime.data(), user.data()
-                    , products, paymentMethod.data()
-                    , receivedAmount, price
+  receipt = Receipt(businessName, id
+                    , Receipt::parseDateTime(QString::fromStdString(dateTime))
+                    , user, std::move(lines), paymentMethod
+                    , Money::fromDouble(receivedAmount)
+                    , Money::fromDouble(price)
                     );
   
   return in;
@@ -140,16 +257,16 @@ QDataStream& operator<<(QDataStream& out, const Receipt& receipt) {
       << static_cast<quint64>(receipt.getID())  // size_t no es garantizado igual en todas las plataformas, mejor cast a tipo fijo
       << receipt.getDateTime()
       << receipt.getUser()
-      << static_cast<quint32>(receipt.getProducts().size());  // Guardamos primero el tamaño de la lista
+      << static_cast<quint32>(receipt.getLines().size());  // Guardamos primero el tamaño de la lista
   
-  for (const auto& productPair : receipt.getProducts()) {
-    out << QString(productPair.first.getName().data())  // Product también debe implementar << y >>
-        << static_cast<quint64>(productPair.second);  // cantidad
+  for (const Receipt::LineItem& line : receipt.getLines()) {
+    out << QString::fromStdString(Receipt::getProductName(line))
+        << static_cast<quint64>(line.quantity);  // cantidad
   }
   
   out << receipt.getPaymentMethod()
-      << receipt.getReceivedAmount()
-      << receipt.getPrice();
+      << receipt.getReceivedAmount().toDouble()
+      << receipt.getPrice().toDouble();
   
   return out;
 }
@@ -161,15 +278,15 @@ QDebug operator<<(QDebug dbg, const Receipt& receipt) {
   << "\nDate/Time: " << receipt.getDateTime()
   << "\nUser: " << receipt.getUser()
   << "\nPayment Method: " << receipt.getPaymentMethod()
-  << "\nReceived Amount: " << receipt.getReceivedAmount()
-  << "\nTotal Price: " << receipt.getPrice()
+  << "\nReceived Amount: " << receipt.getReceivedAmount().toDouble()
+  << "\nTotal Price: " << receipt.getPrice().toDouble()
   << "\nProducts: \n";
   
   // Mostrar los productos del recibo
-  for (const auto& productPair : receipt.getProducts()) {
+  for (const Receipt::LineItem& line : receipt.getLines()) {
     dbg.nospace() << "  Product: "
-  	    << QString(productPair.first.getName().data())
-    << " Quantity: " << productPair.second << "\n";
+  	    << QString::fromStdString(Receipt::getProductName(line))
+    << " Quantity: " << line.quantity << "\n";
   }
   
   return dbg;
@@ -182,7 +299,7 @@ QDataStream& operator>>(QDataStream& in, Receipt& receipt) {
   QString dateTime;
   QString user;
   quint32 productCount;
-  std::vector<std::pair<Product, size_t>> products;
+  std::vector<Receipt::LineItem> lines;
   QString paymentMethod;
   double receivedAmount;
   double price;
@@ -198,9 +315,10 @@ QDataStream& operator>>(QDataStream& in, Receipt& receipt) {
     quint64 quantity;
     
     in >> productName >> quantity;
-    Product blankProduct;
-    blankProduct.setName(productName.toStdString());
-    products.emplace_back(blankProduct, static_cast<size_t>(quantity));
+    Receipt::LineItem line;
+    line.name = StringPool::getInstance().intern(productName.toStdString());
+    line.quantity = static_cast<uint32_t>(quantity);
+    lines.push_back(line);
   }
   
   in >> paymentMethod
@@ -208,8 +326,11 @@ QDataStream& operator>>(QDataStream& in, Receipt& receipt) {
       >> price;
   
   // Crear un nuevo Receipt usando un constructor adecuado (recomendado) o setters.
-  receipt = Receipt(businessName, static_cast<size_t>(id), dateTime, user,
-                    products, paymentMethod, receivedAmount, price);
+  receipt = Receipt(businessName.toStdString(), static_cast<size_t>(id)
+                    , Receipt::parseDateTime(dateTime), user.toStdString()
+                    , std::move(lines), paymentMethod.toStdString()
+                    , Money::fromDouble(receivedAmount)
+                    , Money::fromDouble(price));
   
   return in;
 }
@@ -217,15 +338,13 @@ QDataStream& operator>>(QDataStream& in, Receipt& receipt) {
 QString Receipt::formatProductList() {
   QString formattedList;
   
-  for (const auto& productPair : this->products) {
-    const Product& product = productPair.first;
-    size_t quantity = productPair.second;
-    double totalPrice = quantity * product.getPrice();
+  for (const LineItem& line : this->lines) {
+    const Money totalPrice = line.price * line.quantity;
     
     formattedList += QString("%1 x %2 : %3\n")
-        .arg(quantity)
-        .arg(QString::fromStdString(product.getName()))
-        .arg(totalPrice, 0, 'f', 2); // Formato con 2 decimales
+        .arg(line.quantity)
+        .arg(QString::fromStdString(getProductName(line)))
+        .arg(QString::fromStdString(totalPrice.toString()));
   }
   
   return formattedList.trimmed();  // Elimina el último salto de línea extra
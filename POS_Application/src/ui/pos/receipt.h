@@ -3,23 +3,64 @@
 
 #include <QWidget>
 #include <QString>
+#include <cstdint>
+#include <string_view>
 
 #include "product.h"
+#include "money.h"
 #include "order.h"
+#include "stringpool.h"
+
+class BinaryReader;
+class BinaryWriter;
 
 class Receipt {
+public:
+  /**
+   * @struct LineItem
+   * @brief Product sold in a receipt.
+   *
+   * The name of the product is interned, the price is the one it had when it
+   * was sold, kept for the reprints of the products that change later.
+   */
+  struct LineItem {
+    uint64_t productID = 0;           ///< ID of the product.
+    StringPool::StringID name = StringPool::EMPTY;  ///< Name of the product.
+    uint32_t quantity = 0;            ///< Units sold.
+    Money price;                      ///< Unit price of the product.
+  };
+  
+  /**
+   * @enum PaymentMethod
+   * @brief Codes of the payment methods, also stored in the sales archive.
+   */
+  enum PaymentMethod : uint8_t {
+    PAYMENT_OTHER = 0,
+    PAYMENT_CASH,
+    PAYMENT_SINPE,
+    PAYMENT_CARD,
+    PAYMENT_METHOD_COUNT
+  };
+  
+  /// Names of the payment methods offered by the billing page, by code.
+  static constexpr const char* PAYMENT_METHOD_NAMES[PAYMENT_METHOD_COUNT] = {
+    "", "Efectivo", "Sinpe", "Tarjeta"
+  };
   
 private:
-  QString businessName; ///< Nombre del negocio
-  size_t ID;            ///< Identificador único del recibo
-  QString dateTime;     ///< Fecha y hora
-  QString user;         ///< Usuario
-  std::vector<std::pair<Product, size_t>> products; ///< Productos en el recibo (producto, cantidad)
-  QString paymentMethod; ///< Método de pago
-  double receivedAmount; ///< Cantidad recibida
-  double price;          ///< Precio total
-
+  size_t ID;             ///< Identificador único del recibo
+  int64_t timestamp;     ///< Fecha y hora, en segundos desde la época
+  StringPool::StringID businessName;  ///< Perfil del negocio, compartido
+  StringPool::StringID user;          ///< Usuario
+  StringPool::StringID paymentMethod; ///< Método de pago
+  Money receivedAmount;  ///< Cantidad recibida
+  Money price;           ///< Precio total
+  std::vector<LineItem> lines;  ///< Productos en el recibo
+  
 public:  
+  /// Format of the date and time of the receipts.
+  static constexpr const char* DATE_TIME_FORMAT = "yyyy-MM-dd HH:mm:ss";
+  
   explicit Receipt(const QString myBusinessName = QString()
       , const size_t myID = 0
       , const QString myDateTime = QString()
@@ -27,10 +68,31 @@ public:
       , const std::vector<std::pair<Product, size_t>> myProducts
       = std::vector<std::pair<Product, size_t>>()
       , const QString myPaymentMethod = QString()
-      , const double myReceivedAmount = 0
-      , const double myPrice = 0);
+      , const Money myReceivedAmount = Money()
+      , const Money myPrice = Money());
   
-  Receipt(const Receipt& other);
+  /**
+   * @brief Constructs a receipt from its compact fields.
+   *
+   * @param myBusinessName Name of the business.
+   * @param myID ID of the receipt.
+   * @param myTimestamp Date and time, in seconds since the epoch.
+   * @param myUser Name of the user.
+   * @param myLines Products sold.
+   * @param myPaymentMethod Payment method.
+   * @param myReceivedAmount Money received.
+   * @param myPrice Total price.
+   */
+  Receipt(const std::string_view myBusinessName
+      , const size_t myID
+      , const int64_t myTimestamp
+      , const std::string_view myUser
+      , std::vector<LineItem> myLines
+      , const std::string_view myPaymentMethod
+      , const Money myReceivedAmount
+      , const Money myPrice);
+  
+  Receipt(const Receipt& other) = default;
   
   Receipt(const QString bussinessName
       , const size_t id
@@ -41,38 +103,83 @@ public:
   
   Receipt& operator=(const Receipt&) = default;
   
-  friend std::ifstream& operator>>(std::ifstream& in, Receipt& receipt);
-  friend std::ofstream& operator<<(std::ifstream& in, Receipt& receipt);
+  friend std::istream& operator>>(std::istream& in, Receipt& receipt);
+  friend std::ostream& operator<<(std::ostream& out, const Receipt& receipt);
+  
+  /**
+   * @brief Encodes the receipt in the portable binary format of the backups.
+   * @param writer Writer where the receipt is encoded.
+   */
+  void encode(BinaryWriter& writer) const;
+  
+  /**
+   * @brief Decodes a receipt written by encode().
+   * @param reader Reader positioned at the receipt.
+   * @param receipt Receipt where the decoded receipt is stored.
+   * @return True if the receipt was complete and valid.
+   */
+  static bool decode(BinaryReader& reader, Receipt& receipt);
+  
+  /**
+   * @brief Converts a date and time in the format of the receipts.
+   * @param dateTime Date and time in local time.
+   * @return Seconds since the epoch, 0 if the text isn't valid.
+   */
+  static int64_t parseDateTime(const QString& dateTime);
 public:
   // Getters públicos para cada atributo (necesarios para el operador de flujo)
-  QString getBusinessName() const { return businessName; }
+  QString getBusinessName() const { return fromPool(businessName); }
   size_t getID() const { return ID; }
-  QString getDateTime() const { return dateTime; }
-  QString getUser() const { return user; }
-  std::vector<std::pair<Product, size_t>> getProducts() const { return products; }
-  QString getPaymentMethod() const { return paymentMethod; }
-  double getReceivedAmount() const { return receivedAmount; }
-  double getPrice() const { return price; }
+  int64_t getTimestamp() const { return timestamp; }
+  QString getDateTime() const;
+  QString getUser() const { return fromPool(user); }
+  const std::vector<LineItem>& getLines() const { return lines; }
+  QString getPaymentMethod() const { return fromPool(paymentMethod); }
+  StringPool::StringID getPaymentMethodID() const { return paymentMethod; }
+  
+  /**
+   * @brief Gets the code of the payment method.
+   *
+   * Compares the interned ID of the payment method, without comparing text.
+   *
+   * @return Code of the payment method, PAYMENT_OTHER if it's unknown.
+   */
+  PaymentMethod getPaymentMethodCode() const;
+  Money getReceivedAmount() const { return receivedAmount; }
+  Money getPrice() const { return price; }
+  
+  /**
+   * @brief Gets the name of a product of the receipt.
+   * @param line The line of the product.
+   * @return Name of the product.
+   */
+  static const std::string& getProductName(const LineItem& line) {
+    return StringPool::getInstance().lookup(line.name);
+  }
   
   QString formatProductList();
   
 private:
-  // Setters privados
-  void setBusinessName(const QString& name) { businessName = name; }
-  void setID(size_t id) { ID = id; }
-  void setDateTime(const QString& date) { dateTime = date; }
-  void setUser(const QString& userName) { user = userName; }
-  void setProducts(const std::vector<std::pair<Product, size_t>>& productList) { products = productList; }
-  void setPaymentMethod(const QString& method) { paymentMethod = method; }
-  void setReceivedAmount(double amount) { receivedAmount = amount; }
-  void setPrice(double totalPrice) { price = totalPrice; }
+  /**
+   * @brief Gets an interned string as a QString.
+   * @param id ID of the string.
+   * @return The string.
+   */
+  static QString fromPool(const StringPool::StringID id);
   
+  /**
+   * @brief Builds the lines of a list of products.
+   * @param products The products and their quantities.
+   * @return The lines of the products.
+   */
+  static std::vector<LineItem> toLines(
+      const std::vector<std::pair<Product, size_t>>& products);
 };
 
 // Declaraciones externas para los operadores de flujo
 QDataStream& operator<<(QDataStream& out, const Receipt& receipt);
-std::ifstream& operator>>(std::ifstream& in, Receipt& receipt);
-std::ofstream& operator<<(std::ofstream& out, const Receipt& receipt);
+std::istream& operator>>(std::istream& in, Receipt& receipt);
+std::ostream& operator<<(std::ostream& out, const Receipt& receipt);
 QDebug operator<<(QDebug dbg, const Receipt& receipt);
 
 #endif // RECEIPT_H
@@ -0,0 +1,102 @@
+#include "receiptsearchdialog.h"
+#include "ui_receiptsearchdialog.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTableWidgetItem>
+
+#include "billingpage.h"
+#include "util.h"
+
+ReceiptSearchDialog::ReceiptSearchDialog(QWidget *parent
+    , POS_Model& appModel)
+    : QDialog(parent)
+    , ui(new Ui::ReceiptSearchDialog)
+    , model(appModel) {
+  ui->setupUi(this);
+  // Offers the payment methods of the billing page, the first one is any.
+  this->ui->payment_comboBox->addItem("Todos");
+  for (size_t method = Receipt::PAYMENT_CASH
+      ; method < Receipt::PAYMENT_METHOD_COUNT; ++method) {
+    this->ui->payment_comboBox->addItem(Receipt::PAYMENT_METHOD_NAMES[method]);
+  }
+  // The range of dates starts disabled, on today.
+  const QDateTime now = QDateTime::currentDateTime();
+  this->ui->from_dateTimeEdit->setDateTime(QDateTime(now.date(), QTime(0, 0)));
+  this->ui->to_dateTimeEdit->setDateTime(now);
+  this->on_dateRange_checkBox_toggled(false);
+  this->ui->reprint_button->setEnabled(false);
+  // Shows the size of the history, without reading it.
+  this->ui->status_label->setText(QString("%1 recibos en el historial.")
+      .arg(this->model.getReceiptsCount()));
+}
+
+ReceiptSearchDialog::~ReceiptSearchDialog() {
+  delete ui;
+}
+
+ReceiptSearchIndex::Query ReceiptSearchDialog::buildQuery() const {
+  ReceiptSearchIndex::Query query;
+  query.receiptID = this->ui->receiptNumber_lineEdit->text().trimmed()
+      .toULongLong();
+  if (this->ui->dateRange_checkBox->isChecked()) {
+    query.from = this->ui->from_dateTimeEdit->dateTime().toSecsSinceEpoch();
+    query.to = this->ui->to_dateTimeEdit->dateTime().toSecsSinceEpoch();
+  }
+  query.user = this->ui->user_lineEdit->text().trimmed().toStdString();
+  // The first payment method matches any of them.
+  if (this->ui->payment_comboBox->currentIndex() > 0) {
+    query.paymentMethod
+        = this->ui->payment_comboBox->currentText().toStdString();
+  }
+  query.productName = this->ui->product_lineEdit->text().trimmed()
+      .toStdString();
+  return query;
+}
+
+void ReceiptSearchDialog::showResults() {
+  this->ui->results_table->setRowCount(static_cast<int>(this->results.size()));
+  for (size_t row = 0; row < this->results.size(); ++row) {
+    const Receipt& receipt = this->results[row];
+    const int tableRow = static_cast<int>(row);
+    this->ui->results_table->setItem(tableRow, 0
+        , new QTableWidgetItem(QString::number(receipt.getID())));
+    this->ui->results_table->setItem(tableRow, 1
+        , new QTableWidgetItem(receipt.getDateTime()));
+    this->ui->results_table->setItem(tableRow, 2
+        , new QTableWidgetItem(receipt.getUser()));
+    this->ui->results_table->setItem(tableRow, 3
+        , new QTableWidgetItem(receipt.getPaymentMethod()));
+    this->ui->results_table->setItem(tableRow, 4
+        , new QTableWidgetItem("₡" + Util::formatMoney(receipt.getPrice())));
+  }
+  this->ui->reprint_button->setEnabled(!this->results.empty());
+}
+
+void ReceiptSearchDialog::on_search_button_clicked() {
+  QElapsedTimer timer;
+  timer.start();
+  this->results = this->model.searchReceipts(this->buildQuery(), MAX_RESULTS);
+  this->showResults();
+  this->ui->status_label->setText(QString("%1 recibos encontrados.")
+      .arg(this->results.size()));
+  qDebug() << "Busqueda de recibos en" << timer.elapsed() << "ms.";
+}
+
+void ReceiptSearchDialog::on_reprint_button_clicked() {
+  const int row = this->ui->results_table->currentRow();
+  if (row < 0 || static_cast<size_t>(row) >= this->results.size()) {
+    return;
+  }
+  // Reprints the receipt with the layout of the billing page.
+  BillingPage::printReceipt(this, this->results[row], true);
+}
+
+void ReceiptSearchDialog::on_close_button_clicked() {
+  this->accept();
+}
+
+void ReceiptSearchDialog::on_dateRange_checkBox_toggled(bool checked) {
+  this->ui->from_dateTimeEdit->setEnabled(checked);
+  this->ui->to_dateTimeEdit->setEnabled(checked);
+}
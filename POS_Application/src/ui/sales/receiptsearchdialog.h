@@ -0,0 +1,56 @@
+#ifndef RECEIPTSEARCHDIALOG_H
+#define RECEIPTSEARCHDIALOG_H
+
+#include <QDialog>
+#include <vector>
+
+#include "posmodel.h"
+#include "receipt.h"
+
+namespace Ui {
+class ReceiptSearchDialog;
+}
+
+/**
+ * @class ReceiptSearchDialog
+ * @brief Searches the receipts history and reprints the found receipts.
+ *
+ * The receipts are searched by number, range of dates, user, payment method
+ * and product, through the indexes of the receipts backup.
+ */
+class ReceiptSearchDialog : public QDialog {
+  Q_OBJECT
+
+public:
+  static const size_t MAX_RESULTS = 200;  ///< Receipts shown by a search.
+
+private:
+  Ui::ReceiptSearchDialog *ui;
+  POS_Model& model;               ///< Reference to the POS_Model singleton.
+  std::vector<Receipt> results;   ///< Receipts of the last search.
+
+public:
+  explicit ReceiptSearchDialog(QWidget *parent = nullptr
+      , POS_Model& appModel = POS_Model::getInstance());
+  ~ReceiptSearchDialog();
+
+private:
+  /**
+   * @brief Builds the query from the fields of the dialog.
+   * @return The query of the search.
+   */
+  ReceiptSearchIndex::Query buildQuery() const;
+
+  /**
+   * @brief Shows the receipts of the last search.
+   */
+  void showResults();
+
+private slots:
+  void on_search_button_clicked();
+  void on_reprint_button_clicked();
+  void on_close_button_clicked();
+  void on_dateRange_checkBox_toggled(bool checked);
+};
+
+#endif // RECEIPTSEARCHDIALOG_H
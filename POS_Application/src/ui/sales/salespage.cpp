@@ -0,0 +1,256 @@
+#include "salespage.h"
+#include "ui_salespage.h"
+
+#include <QElapsedTimer>
+#include <QMessageBox>
+#include <QThread>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "receipt.h"
+#include "receiptsearchdialog.h"
+#include "util.h"
+
+SalesPage::SalesPage(QWidget *parent, POS_Model& appModel)
+    : QWidget(parent)
+    , ui(new Ui::SalesPage)
+    , model(appModel) {
+  ui->setupUi(this);
+  // The dashboard is read when the page is shown.
+  this->ui->today_button->setChecked(true);
+}
+
+SalesPage::~SalesPage() {
+  delete ui;
+}
+
+void SalesPage::showEvent(QShowEvent* event) {
+  QWidget::showEvent(event);
+  // The totals change with every receipt, they are read again when shown.
+  this->refreshDashboard();
+}
+
+void SalesPage::on_today_button_clicked() {
+  this->showPeriod(TODAY);
+}
+
+void SalesPage::on_week_button_clicked() {
+  this->showPeriod(WEEK);
+}
+
+void SalesPage::on_month_button_clicked() {
+  this->showPeriod(MONTH);
+}
+
+void SalesPage::on_search_button_clicked() {
+  // Searches the receipts history, to find and reprint old receipts.
+  ReceiptSearchDialog searchDialog(this, this->model);
+  searchDialog.exec();
+}
+
+void SalesPage::on_zReport_button_clicked() {
+  // Builds the report of the shown period from the sales segments, in its
+  // own thread, so the page keeps responding while the days are read.
+  const QDate today = QDate::currentDate();
+  const QDate firstDay = firstDayOf(today, this->period);
+  const std::shared_ptr<ReportEngine::ZReport> report
+      = std::make_shared<ReportEngine::ZReport>();
+  const std::shared_ptr<std::string> error = std::make_shared<std::string>();
+  QThread* builder = QThread::create(
+      [&appModel = this->model, report, error, firstDay, today] {
+        try {
+          *report = appModel.getZReport(firstDay, today);
+        } catch (const std::exception& exception) {
+          *error = exception.what();
+        }
+      });
+  // Shows the report in the GUI thread, if the page still exists.
+  this->ui->zReport_button->setEnabled(false);
+  this->connect(builder, &QThread::finished, this, [this, report, error] {
+    this->ui->zReport_button->setEnabled(true);
+    if (error->empty()) {
+      QMessageBox::information(this, "Reporte Z", formatZReport(*report));
+    } else {
+      QMessageBox::warning(this, "No se generó el reporte Z."
+          , QString::fromStdString(*error));
+    }
+  });
+  this->connect(builder, &QThread::finished, builder, &QObject::deleteLater);
+  builder->start();
+}
+
+void SalesPage::showPeriod(const Period shownPeriod) {
+  this->period = shownPeriod;
+  // Checks only the button of the shown period.
+  this->ui->today_button->setChecked(shownPeriod == TODAY);
+  this->ui->week_button->setChecked(shownPeriod == WEEK);
+  this->ui->month_button->setChecked(shownPeriod == MONTH);
+  this->refreshDashboard();
+}
+
+QDate SalesPage::firstDayOf(const QDate& today, const Period shownPeriod) {
+  switch (shownPeriod) {
+    case WEEK:
+      // The weeks start on monday.
+      return today.addDays(1 - today.dayOfWeek());
+    case MONTH:
+      return QDate(today.year(), today.month(), 1);
+    default:
+      return today;
+  }
+}
+
+void SalesPage::refreshDashboard() {
+  QElapsedTimer timer;
+  timer.start();
+  // Merges the totals of the days of the period.
+  const QDate today = QDate::currentDate();
+  const SalesRollups::Totals summary = this->model.getSalesSummary(
+      firstDayOf(today, this->period), today);
+
+  // Shows the totals of the receipts and their payment methods.
+  const Money average = summary.receiptCount == 0 ? Money()
+      : Money::fromCents(summary.total.toCents()
+          / static_cast<int64_t>(summary.receiptCount));
+  this->ui->total_label->setText(
+      "Total: ₡" + Util::formatMoney(summary.total));
+  this->ui->receipts_label->setText(
+      QString("Recibos: %1").arg(summary.receiptCount));
+  this->ui->averageTicket_label->setText(
+      "Promedio: ₡" + Util::formatMoney(average));
+  this->ui->cash_label->setText("Efectivo: ₡" + Util::formatMoney(
+      summary.byPaymentMethod[Receipt::PAYMENT_CASH]));
+  this->ui->sinpe_label->setText("Sinpe: ₡" + Util::formatMoney(
+      summary.byPaymentMethod[Receipt::PAYMENT_SINPE]));
+  this->ui->card_label->setText("Tarjeta: ₡" + Util::formatMoney(
+      summary.byPaymentMethod[Receipt::PAYMENT_CARD]));
+
+  this->refreshProducts(summary);
+  this->refreshCategories(summary);
+  this->refreshHours(summary);
+  qDebug() << "Tablero de ventas mostrado en" << timer.elapsed() << "ms.";
+}
+
+void SalesPage::refreshProducts(const SalesRollups::Totals& summary) {
+  // Sorts the products by the amount sold, without copying them.
+  std::vector<const SalesRollups::ProductTotal*> products;
+  products.reserve(summary.products.size());
+  for (const auto& [key, product] : summary.products) {
+    products.push_back(&product);
+  }
+  std::sort(products.begin(), products.end()
+      , [](const SalesRollups::ProductTotal* first
+          , const SalesRollups::ProductTotal* second) {
+        return first->amount > second->amount;
+      });
+  const StringPool& pool = StringPool::getInstance();
+  this->ui->products_table->setRowCount(static_cast<int>(products.size()));
+  for (size_t row = 0; row < products.size(); ++row) {
+    setRow(this->ui->products_table, static_cast<int>(row)
+        , QString::fromStdString(pool.lookup(products[row]->name))
+        , QString::number(products[row]->quantity), products[row]->amount);
+  }
+}
+
+void SalesPage::refreshCategories(const SalesRollups::Totals& summary) {
+  // Sorts the categories by the amount sold.
+  std::vector<std::pair<StringPool::StringID, SalesRollups::ItemTotal>>
+      categories(summary.categories.begin(), summary.categories.end());
+  std::sort(categories.begin(), categories.end()
+      , [](const auto& first, const auto& second) {
+        return first.second.amount > second.second.amount;
+      });
+  const StringPool& pool = StringPool::getInstance();
+  this->ui->categories_table->setRowCount(
+      static_cast<int>(categories.size()));
+  for (size_t row = 0; row < categories.size(); ++row) {
+    const auto& [category, categoryTotal] = categories[row];
+    // The products without category are the ones removed from the catalog.
+    const QString name = category == StringPool::EMPTY
+        ? QString("Sin categoría")
+        : QString::fromStdString(pool.lookup(category));
+    setRow(this->ui->categories_table, static_cast<int>(row), name
+        , QString::number(categoryTotal.quantity), categoryTotal.amount);
+  }
+}
+
+void SalesPage::refreshHours(const SalesRollups::Totals& summary) {
+  // Shows only the hours with sales.
+  this->ui->hours_table->setRowCount(0);
+  for (size_t hour = 0; hour < SalesRollups::HOURS_PER_DAY; ++hour) {
+    if (summary.receiptsByHour[hour] == 0) {
+      continue;
+    }
+    const int row = this->ui->hours_table->rowCount();
+    this->ui->hours_table->insertRow(row);
+    setRow(this->ui->hours_table, row
+        , QString("%1:00").arg(hour, 2, 10, QChar('0'))
+        , QString::number(summary.receiptsByHour[hour])
+        , summary.byHour[hour]);
+  }
+}
+
+QString SalesPage::formatZReport(const ReportEngine::ZReport& report) {
+  QString text = QString("Días con ventas: %1\nRecibos: %2\nTotal: ₡%3\n")
+      .arg(report.dayCount).arg(report.receiptCount)
+      .arg(Util::formatMoney(report.total));
+  if (report.damagedDays > 0) {
+    text += QString("Días dañados: %1\n").arg(report.damagedDays);
+  }
+  // Totals by payment method.
+  text += "\nMétodos de pago:\n";
+  for (size_t method = Receipt::PAYMENT_CASH
+      ; method < Receipt::PAYMENT_METHOD_COUNT; ++method) {
+    text += QString("  %1: ₡%2\n").arg(Receipt::PAYMENT_METHOD_NAMES[method])
+        .arg(Util::formatMoney(report.byPaymentMethod[method]));
+  }
+  if (report.byPaymentMethod[Receipt::PAYMENT_OTHER].toCents() != 0) {
+    text += QString("  Otros: ₡%1\n").arg(
+        Util::formatMoney(report.byPaymentMethod[Receipt::PAYMENT_OTHER]));
+  }
+  // Totals by user.
+  text += "\nUsuarios:\n";
+  for (const auto& [user, userTotal] : report.users) {
+    text += QString("  %1: %2 recibos, ₡%3\n")
+        .arg(QString::fromStdString(user)).arg(userTotal.receiptCount)
+        .arg(Util::formatMoney(userTotal.amount));
+  }
+  // Products, the best sellers first.
+  std::vector<const ReportEngine::ProductTotal*> products;
+  products.reserve(report.products.size());
+  for (const auto& [key, product] : report.products) {
+    products.push_back(&product);
+  }
+  std::sort(products.begin(), products.end()
+      , [](const ReportEngine::ProductTotal* first
+          , const ReportEngine::ProductTotal* second) {
+        return first->amount > second->amount;
+      });
+  text += "\nProductos:\n";
+  for (const ReportEngine::ProductTotal* product : products) {
+    text += QString("  %1 x %2: ₡%3\n").arg(product->quantity)
+        .arg(QString::fromStdString(product->name))
+        .arg(Util::formatMoney(product->amount));
+  }
+  // Hours with sales.
+  text += "\nHoras:\n";
+  for (size_t hour = 0; hour < SalesArchive::HOURS_PER_DAY; ++hour) {
+    if (report.receiptsByHour[hour] > 0) {
+      text += QString("  %1:00: %2 recibos, ₡%3\n")
+          .arg(hour, 2, 10, QChar('0')).arg(report.receiptsByHour[hour])
+          .arg(Util::formatMoney(report.byHour[hour]));
+    }
+  }
+  return text;
+}
+
+void SalesPage::setRow(QTableWidget* table, const int row
+    , const QString& name, const QString& count, const Money amount) {
+  table->setItem(row, 0, new QTableWidgetItem(name));
+  table->setItem(row, 1, new QTableWidgetItem(count));
+  table->setItem(row, 2, new QTableWidgetItem(
+      "₡" + Util::formatMoney(amount)));
+}
@@ -0,0 +1,119 @@
+#ifndef SALESPAGE_H
+#define SALESPAGE_H
+
+#include <QDate>
+#include <QTableWidget>
+#include <QWidget>
+
+#include "posmodel.h"
+#include "reportengine.h"
+#include "salesrollups.h"
+
+namespace Ui {
+class SalesPage;
+}
+
+/**
+ * @class SalesPage
+ * @brief Dashboards of the sales of today, this week and this month.
+ *
+ * The dashboards are built from the sales totals that the model keeps by
+ * day, so showing a period only merges the totals of its days.
+ */
+class SalesPage : public QWidget {
+  Q_OBJECT
+
+public:
+  /**
+   * @enum Period
+   * @brief Periods of the dashboards.
+   */
+  enum Period {
+    TODAY,
+    WEEK,
+    MONTH
+  };
+
+private:
+  Ui::SalesPage *ui;
+  POS_Model& model;         ///< Reference to the POS_Model singleton.
+  Period period = TODAY;    ///< Period of the shown dashboard.
+
+public:
+  explicit SalesPage(QWidget *parent = nullptr
+      , POS_Model& appModel = POS_Model::getInstance());
+  ~SalesPage();
+
+protected:
+  /**
+   * @brief Refreshes the dashboard every time the page is shown.
+   * @param event The show event.
+   */
+  void showEvent(QShowEvent* event) override;
+
+private:
+  /**
+   * @brief Shows the dashboard of a period.
+   * @param shownPeriod The period.
+   */
+  void showPeriod(const Period shownPeriod);
+
+  /**
+   * @brief Shows the totals of the current period.
+   */
+  void refreshDashboard();
+
+  /**
+   * @brief Gets the first day of a period that ends today.
+   * @param today The current day.
+   * @param shownPeriod The period.
+   * @return First day of the period.
+   */
+  static QDate firstDayOf(const QDate& today, const Period shownPeriod);
+
+  /**
+   * @brief Shows the products sold, the best sellers first.
+   * @param summary Totals of the period.
+   */
+  void refreshProducts(const SalesRollups::Totals& summary);
+
+  /**
+   * @brief Shows the categories sold, the best sellers first.
+   * @param summary Totals of the period.
+   */
+  void refreshCategories(const SalesRollups::Totals& summary);
+
+  /**
+   * @brief Shows the sales of each hour of the day.
+   * @param summary Totals of the period.
+   */
+  void refreshHours(const SalesRollups::Totals& summary);
+
+  /**
+   * @brief Formats a Z report as text.
+   * @param report The report.
+   * @return Text of the report.
+   */
+  static QString formatZReport(const ReportEngine::ZReport& report);
+
+  /**
+   * @brief Sets the cells of a row of a table.
+   *
+   * @param table The table.
+   * @param row Row of the cells.
+   * @param name Text of the first column.
+   * @param count Text of the second column.
+   * @param amount Amount of the third column.
+   */
+  static void setRow(QTableWidget* table, const int row, const QString& name
+      , const QString& count, const Money amount);
+
+private slots:
+  void on_today_button_clicked();
+  void on_week_button_clicked();
+  void on_month_button_clicked();
+  void on_search_button_clicked();
+  void on_zReport_button_clicked();
+};
+
+#endif // SALESPAGE_H
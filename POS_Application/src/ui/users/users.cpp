@@ -19,7 +19,7 @@ Users::~Users() {
 }
 
 void Users::refreshDisplay(const size_t items) {
-  std::vector<User> visibleUsers
+  const PageView<User> visibleUsers
       = this->model.getUsersForPage(this->currentPageIndex, items);
   // Initiazates the label index iterator.
   size_t labelIt = 0;